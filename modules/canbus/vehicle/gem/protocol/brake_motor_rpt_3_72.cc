@@ -16,89 +16,43 @@
 
 #include "modules/canbus/vehicle/gem/protocol/brake_motor_rpt_3_72.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-Brakemotorrpt372::Brakemotorrpt372() {}
-const int32_t Brakemotorrpt372::ID = 0x72;
-
-void Brakemotorrpt372::Parse(const std::uint8_t* bytes, int32_t length,
-                             ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_brake_motor_rpt_3_72()->set_torque_output(
-      torque_output(bytes, length));
-  chassis->mutable_gem()->mutable_brake_motor_rpt_3_72()->set_torque_input(
-      torque_input(bytes, length));
-}
+namespace {
 
 // config detail: {'name': 'torque_output', 'offset': 0.0, 'precision': 0.001,
 // 'len': 32, 'is_signed_var': True, 'physical_range':
 // '[-2147483.648|2147483.647]', 'bit': 7, 'type': 'double', 'order':
 // 'motorola', 'physical_unit': 'N-m'}
-double Brakemotorrpt372::torque_output(const std::uint8_t* bytes,
-                                       int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 1);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  Byte t2(bytes + 2);
-  t = t2.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  Byte t3(bytes + 3);
-  t = t3.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  x <<= 0;
-  x >>= 0;
-
-  double ret = x * 0.001000;
-  return ret;
-}
+constexpr CanSignal<7, 32, ByteOrder::MOTOROLA, true> kTorqueOutput(0.001);
 
 // config detail: {'name': 'torque_input', 'offset': 0.0, 'precision': 0.001,
 // 'len': 32, 'is_signed_var': True, 'physical_range':
 // '[-2147483.648|2147483.647]', 'bit': 39, 'type': 'double', 'order':
 // 'motorola', 'physical_unit': 'N-m'}
-double Brakemotorrpt372::torque_input(const std::uint8_t* bytes,
-                                      int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 5);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  Byte t2(bytes + 6);
-  t = t2.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+constexpr CanSignal<39, 32, ByteOrder::MOTOROLA, true> kTorqueInput(0.001);
 
-  Byte t3(bytes + 7);
-  t = t3.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+}  // namespace
 
-  x <<= 0;
-  x >>= 0;
+Brakemotorrpt372::Brakemotorrpt372() {}
+const int32_t Brakemotorrpt372::ID = 0x72;
 
-  double ret = x * 0.001000;
-  return ret;
+void Brakemotorrpt372::Parse(const std::uint8_t* bytes, int32_t length,
+                             ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_brake_motor_rpt_3_72();
+  report->set_torque_output(kTorqueOutput.Decode(frame));
+  report->set_torque_input(kTorqueInput.Decode(frame));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -16,96 +16,55 @@
 
 #include "modules/canbus/vehicle/gem/protocol/brake_rpt_6c.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-Brakerpt6c::Brakerpt6c() {}
-const int32_t Brakerpt6c::ID = 0x6C;
-
-void Brakerpt6c::Parse(const std::uint8_t* bytes, int32_t length,
-                       ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_brake_rpt_6c()->set_manual_input(
-      manual_input(bytes, length));
-  chassis->mutable_gem()->mutable_brake_rpt_6c()->set_commanded_value(
-      commanded_value(bytes, length));
-  chassis->mutable_gem()->mutable_brake_rpt_6c()->set_output_value(
-      output_value(bytes, length));
-  chassis->mutable_gem()->mutable_brake_rpt_6c()->set_brake_on_off(
-      brake_on_off(bytes, length));
-}
+namespace {
 
 // config detail: {'name': 'manual_input', 'offset': 0.0, 'precision': 0.001,
 // 'len': 16, 'is_signed_var': False, 'physical_range': '[0|1]', 'bit': 7,
 // 'type': 'double', 'order': 'motorola', 'physical_unit': '%'}
-double Brakerpt6c::manual_input(const std::uint8_t* bytes,
-                                int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 1);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  double ret = x * 0.001000;
-  return ret;
-}
+constexpr CanSignal<7, 16, ByteOrder::MOTOROLA> kManualInput(0.001);
 
 // config detail: {'name': 'commanded_value', 'offset': 0.0, 'precision': 0.001,
 // 'len': 16, 'is_signed_var': False, 'physical_range': '[0|1]', 'bit': 23,
 // 'type': 'double', 'order': 'motorola', 'physical_unit': '%'}
-double Brakerpt6c::commanded_value(const std::uint8_t* bytes,
-                                   int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 3);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  double ret = x * 0.001000;
-  return ret;
-}
+constexpr CanSignal<23, 16, ByteOrder::MOTOROLA> kCommandedValue(0.001);
 
 // config detail: {'name': 'output_value', 'offset': 0.0, 'precision': 0.001,
 // 'len': 16, 'is_signed_var': False, 'physical_range': '[0|1]', 'bit': 39,
 // 'type': 'double', 'order': 'motorola', 'physical_unit': '%'}
-double Brakerpt6c::output_value(const std::uint8_t* bytes,
-                                int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
+constexpr CanSignal<39, 16, ByteOrder::MOTOROLA> kOutputValue(0.001);
 
-  Byte t1(bytes + 5);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+// config detail: {'physical_range': '[0|1]', 'name': 'brake_on_off', 'enum':
+// {0: 'BRAKE_ON_OFF_OFF', 1: 'BRAKE_ON_OFF_ON'}, 'precision': 1.0, 'len': 1,
+// 'is_signed_var': False, 'offset': 0.0, 'bit': 48, 'type': 'enum', 'order':
+// 'motorola', 'physical_unit': ''}
+constexpr CanSignal<48, 1, ByteOrder::MOTOROLA> kBrakeOnOff;
 
-  double ret = x * 0.001000;
-  return ret;
-}
+}  // namespace
 
-// config detail: {'name': 'brake_on_off', 'enum': {0: 'BRAKE_ON_OFF_OFF', 1:
-// 'BRAKE_ON_OFF_ON'}, 'precision': 1.0, 'len': 1, 'is_signed_var': False,
-// 'offset': 0.0, 'physical_range': '[0|1]', 'bit': 48, 'type': 'enum', 'order':
-// 'motorola', 'physical_unit': ''}
-Brake_rpt_6c::Brake_on_offType Brakerpt6c::brake_on_off(
-    const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 6);
-  int32_t x = t0.get_byte(0, 1);
+Brakerpt6c::Brakerpt6c() {}
+const int32_t Brakerpt6c::ID = 0x6C;
 
-  Brake_rpt_6c::Brake_on_offType ret =
-      static_cast<Brake_rpt_6c::Brake_on_offType>(x);
-  return ret;
+void Brakerpt6c::Parse(const std::uint8_t* bytes, int32_t length,
+                       ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_brake_rpt_6c();
+  report->set_manual_input(kManualInput.Decode(frame));
+  report->set_commanded_value(kCommandedValue.Decode(frame));
+  report->set_output_value(kOutputValue.Decode(frame));
+  report->set_brake_on_off(static_cast<Brake_rpt_6c::Brake_on_offType>(
+      kBrakeOnOff.Raw(frame)));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
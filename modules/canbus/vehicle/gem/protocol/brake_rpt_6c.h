@@ -31,29 +31,6 @@ class Brakerpt6c : public ::apollo::drivers::canbus::ProtocolData<
   Brakerpt6c();
   void Parse(const std::uint8_t* bytes, int32_t length,
              ChassisDetail* chassis) const override;
-
- private:
-  // config detail: {'name': 'MANUAL_INPUT', 'offset': 0.0, 'precision': 0.001,
-  // 'len': 16, 'is_signed_var': False, 'physical_range': '[0|1]', 'bit': 7,
-  // 'type': 'double', 'order': 'motorola', 'physical_unit': '%'}
-  double manual_input(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'COMMANDED_VALUE', 'offset': 0.0, 'precision':
-  // 0.001, 'len': 16, 'is_signed_var': False, 'physical_range': '[0|1]', 'bit':
-  // 23, 'type': 'double', 'order': 'motorola', 'physical_unit': '%'}
-  double commanded_value(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'OUTPUT_VALUE', 'offset': 0.0, 'precision': 0.001,
-  // 'len': 16, 'is_signed_var': False, 'physical_range': '[0|1]', 'bit': 39,
-  // 'type': 'double', 'order': 'motorola', 'physical_unit': '%'}
-  double output_value(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'BRAKE_ON_OFF', 'enum': {0: 'BRAKE_ON_OFF_OFF', 1:
-  // 'BRAKE_ON_OFF_ON'}, 'precision': 1.0, 'len': 1, 'is_signed_var': False,
-  // 'offset': 0.0, 'physical_range': '[0|1]', 'bit': 48, 'type': 'enum',
-  // 'order': 'motorola', 'physical_unit': ''}
-  Brake_rpt_6c::Brake_on_offType brake_on_off(const std::uint8_t* bytes,
-                                              const int32_t length) const;
 };
 
 }  // namespace gem
@@ -16,103 +16,65 @@
 
 #include "modules/canbus/vehicle/gem/protocol/date_time_rpt_83.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
-
-Datetimerpt83::Datetimerpt83() {}
-const int32_t Datetimerpt83::ID = 0x83;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-void Datetimerpt83::Parse(const std::uint8_t* bytes, int32_t length,
-                          ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_date_time_rpt_83()->set_time_second(
-      time_second(bytes, length));
-  chassis->mutable_gem()->mutable_date_time_rpt_83()->set_time_minute(
-      time_minute(bytes, length));
-  chassis->mutable_gem()->mutable_date_time_rpt_83()->set_time_hour(
-      time_hour(bytes, length));
-  chassis->mutable_gem()->mutable_date_time_rpt_83()->set_date_day(
-      date_day(bytes, length));
-  chassis->mutable_gem()->mutable_date_time_rpt_83()->set_date_month(
-      date_month(bytes, length));
-  chassis->mutable_gem()->mutable_date_time_rpt_83()->set_date_year(
-      date_year(bytes, length));
-}
+namespace {
 
 // config detail: {'name': 'time_second', 'offset': 0.0, 'precision': 1.0,
 // 'len': 8, 'is_signed_var': False, 'physical_range': '[0|60]', 'bit': 47,
 // 'type': 'int', 'order': 'motorola', 'physical_unit': 'sec'}
-int Datetimerpt83::time_second(const std::uint8_t* bytes,
-                               int32_t length) const {
-  Byte t0(bytes + 5);
-  int32_t x = t0.get_byte(0, 8);
-
-  int ret = x;
-  return ret;
-}
+constexpr CanSignal<47, 8, ByteOrder::MOTOROLA> kTimeSecond;
 
 // config detail: {'name': 'time_minute', 'offset': 0.0, 'precision': 1.0,
 // 'len': 8, 'is_signed_var': False, 'physical_range': '[0|60]', 'bit': 39,
 // 'type': 'int', 'order': 'motorola', 'physical_unit': 'min'}
-int Datetimerpt83::time_minute(const std::uint8_t* bytes,
-                               int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
-
-  int ret = x;
-  return ret;
-}
+constexpr CanSignal<39, 8, ByteOrder::MOTOROLA> kTimeMinute;
 
 // config detail: {'name': 'time_hour', 'offset': 0.0, 'precision': 1.0, 'len':
 // 8, 'is_signed_var': False, 'physical_range': '[0|23]', 'bit': 31, 'type':
 // 'int', 'order': 'motorola', 'physical_unit': 'hr'}
-int Datetimerpt83::time_hour(const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 3);
-  int32_t x = t0.get_byte(0, 8);
-
-  int ret = x;
-  return ret;
-}
+constexpr CanSignal<31, 8, ByteOrder::MOTOROLA> kTimeHour;
 
 // config detail: {'name': 'date_day', 'offset': 1.0, 'precision': 1.0, 'len':
 // 8, 'is_signed_var': False, 'physical_range': '[1|31]', 'bit': 23, 'type':
 // 'int', 'order': 'motorola', 'physical_unit': 'dy'}
-int Datetimerpt83::date_day(const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
-
-  int ret = x + 1.000000;
-  return ret;
-}
+constexpr CanSignal<23, 8, ByteOrder::MOTOROLA> kDateDay(1.0, 1.0);
 
 // config detail: {'name': 'date_month', 'offset': 1.0, 'precision': 1.0, 'len':
 // 8, 'is_signed_var': False, 'physical_range': '[1|12]', 'bit': 15, 'type':
 // 'int', 'order': 'motorola', 'physical_unit': 'mon'}
-int Datetimerpt83::date_month(const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
-
-  int ret = x + 1.000000;
-  return ret;
-}
+constexpr CanSignal<15, 8, ByteOrder::MOTOROLA> kDateMonth(1.0, 1.0);
 
 // config detail: {'name': 'date_year', 'offset': 2000.0, 'precision': 1.0,
 // 'len': 8, 'is_signed_var': False, 'physical_range': '[2000|2255]', 'bit': 7,
 // 'type': 'int', 'order': 'motorola', 'physical_unit': 'yr'}
-int Datetimerpt83::date_year(const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
+constexpr CanSignal<7, 8, ByteOrder::MOTOROLA> kDateYear(1.0, 2000.0);
+
+}  // namespace
 
-  int ret = x + 2000.000000;
-  return ret;
+Datetimerpt83::Datetimerpt83() {}
+const int32_t Datetimerpt83::ID = 0x83;
+
+void Datetimerpt83::Parse(const std::uint8_t* bytes, int32_t length,
+                          ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_date_time_rpt_83();
+  report->set_time_second(static_cast<int>(kTimeSecond.Raw(frame)));
+  report->set_time_minute(static_cast<int>(kTimeMinute.Raw(frame)));
+  report->set_time_hour(static_cast<int>(kTimeHour.Raw(frame)));
+  report->set_date_day(static_cast<int>(kDateDay.Decode(frame)));
+  report->set_date_month(static_cast<int>(kDateMonth.Decode(frame)));
+  report->set_date_year(static_cast<int>(kDateYear.Decode(frame)));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -16,74 +16,57 @@
 
 #include "modules/canbus/vehicle/gem/protocol/headlight_rpt_77.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-Headlightrpt77::Headlightrpt77() {}
-const int32_t Headlightrpt77::ID = 0x77;
+namespace {
 
-void Headlightrpt77::Parse(const std::uint8_t* bytes, int32_t length,
-                           ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_headlight_rpt_77()->set_output_value(
-      output_value(bytes, length));
-  chassis->mutable_gem()->mutable_headlight_rpt_77()->set_manual_input(
-      manual_input(bytes, length));
-  chassis->mutable_gem()->mutable_headlight_rpt_77()->set_commanded_value(
-      commanded_value(bytes, length));
-}
-
-// config detail: {'name': 'output_value', 'enum': {0:
-// 'OUTPUT_VALUE_HEADLIGHTS_OFF', 1: 'OUTPUT_VALUE_LOW_BEAMS', 2:
+// config detail: {'physical_range': '[0|2]', 'name': 'output_value', 'enum':
+// {0: 'OUTPUT_VALUE_HEADLIGHTS_OFF', 1: 'OUTPUT_VALUE_LOW_BEAMS', 2:
 // 'OUTPUT_VALUE_HIGH_BEAMS'}, 'precision': 1.0, 'len': 8, 'is_signed_var':
-// False, 'offset': 0.0, 'physical_range': '[0|2]', 'bit': 23, 'type': 'enum',
-// 'order': 'motorola', 'physical_unit': ''}
-Headlight_rpt_77::Output_valueType Headlightrpt77::output_value(
-    const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
-
-  Headlight_rpt_77::Output_valueType ret =
-      static_cast<Headlight_rpt_77::Output_valueType>(x);
-  return ret;
-}
+// False, 'offset': 0.0, 'bit': 23, 'type': 'enum', 'order': 'motorola',
+// 'physical_unit': ''}
+constexpr CanSignal<23, 8, ByteOrder::MOTOROLA> kOutputValue;
 
-// config detail: {'name': 'manual_input', 'enum': {0:
-// 'MANUAL_INPUT_HEADLIGHTS_OFF', 1: 'MANUAL_INPUT_LOW_BEAMS', 2:
+// config detail: {'physical_range': '[0|2]', 'name': 'manual_input', 'enum':
+// {0: 'MANUAL_INPUT_HEADLIGHTS_OFF', 1: 'MANUAL_INPUT_LOW_BEAMS', 2:
 // 'MANUAL_INPUT_HIGH_BEAMS'}, 'precision': 1.0, 'len': 8, 'is_signed_var':
-// False, 'offset': 0.0, 'physical_range': '[0|2]', 'bit': 7, 'type': 'enum',
-// 'order': 'motorola', 'physical_unit': ''}
-Headlight_rpt_77::Manual_inputType Headlightrpt77::manual_input(
-    const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
+// False, 'offset': 0.0, 'bit': 7, 'type': 'enum', 'order': 'motorola',
+// 'physical_unit': ''}
+constexpr CanSignal<7, 8, ByteOrder::MOTOROLA> kManualInput;
 
-  Headlight_rpt_77::Manual_inputType ret =
-      static_cast<Headlight_rpt_77::Manual_inputType>(x);
-  return ret;
-}
-
-// config detail: {'name': 'commanded_value', 'enum': {0:
-// 'COMMANDED_VALUE_HEADLIGHTS_OFF', 1: 'COMMANDED_VALUE_LOW_BEAMS', 2:
+// config detail: {'physical_range': '[0|2]', 'name': 'commanded_value', 'enum':
+// {0: 'COMMANDED_VALUE_HEADLIGHTS_OFF', 1: 'COMMANDED_VALUE_LOW_BEAMS', 2:
 // 'COMMANDED_VALUE_HIGH_BEAMS'}, 'precision': 1.0, 'len': 8, 'is_signed_var':
-// False, 'offset': 0.0, 'physical_range': '[0|2]', 'bit': 15, 'type': 'enum',
-// 'order': 'motorola', 'physical_unit': ''}
-Headlight_rpt_77::Commanded_valueType Headlightrpt77::commanded_value(
-    const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
+// False, 'offset': 0.0, 'bit': 15, 'type': 'enum', 'order': 'motorola',
+// 'physical_unit': ''}
+constexpr CanSignal<15, 8, ByteOrder::MOTOROLA> kCommandedValue;
+
+}  // namespace
 
-  Headlight_rpt_77::Commanded_valueType ret =
-      static_cast<Headlight_rpt_77::Commanded_valueType>(x);
-  return ret;
+Headlightrpt77::Headlightrpt77() {}
+const int32_t Headlightrpt77::ID = 0x77;
+
+void Headlightrpt77::Parse(const std::uint8_t* bytes, int32_t length,
+                           ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_headlight_rpt_77();
+  report->set_output_value(static_cast<Headlight_rpt_77::Output_valueType>(
+      kOutputValue.Raw(frame)));
+  report->set_manual_input(static_cast<Headlight_rpt_77::Manual_inputType>(
+      kManualInput.Raw(frame)));
+  report->set_commanded_value(
+      static_cast<Headlight_rpt_77::Commanded_valueType>(
+          kCommandedValue.Raw(frame)));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -16,71 +16,53 @@
 
 #include "modules/canbus/vehicle/gem/protocol/horn_rpt_79.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
-
-Hornrpt79::Hornrpt79() {}
-const int32_t Hornrpt79::ID = 0x79;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-void Hornrpt79::Parse(const std::uint8_t* bytes, int32_t length,
-                      ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_horn_rpt_79()->set_output_value(
-      output_value(bytes, length));
-  chassis->mutable_gem()->mutable_horn_rpt_79()->set_commanded_value(
-      commanded_value(bytes, length));
-  chassis->mutable_gem()->mutable_horn_rpt_79()->set_manual_input(
-      manual_input(bytes, length));
-}
+namespace {
 
-// config detail: {'name': 'output_value', 'enum': {0: 'OUTPUT_VALUE_OFF', 1:
-// 'OUTPUT_VALUE_ON'}, 'precision': 1.0, 'len': 8, 'is_signed_var': False,
-// 'offset': 0.0, 'physical_range': '[0|1]', 'bit': 23, 'type': 'enum', 'order':
+// config detail: {'physical_range': '[0|1]', 'name': 'output_value', 'enum':
+// {0: 'OUTPUT_VALUE_OFF', 1: 'OUTPUT_VALUE_ON'}, 'precision': 1.0, 'len': 8,
+// 'is_signed_var': False, 'offset': 0.0, 'bit': 23, 'type': 'enum', 'order':
 // 'motorola', 'physical_unit': ''}
-Horn_rpt_79::Output_valueType Hornrpt79::output_value(const std::uint8_t* bytes,
-                                                      int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
+constexpr CanSignal<23, 8, ByteOrder::MOTOROLA> kOutputValue;
 
-  Horn_rpt_79::Output_valueType ret =
-      static_cast<Horn_rpt_79::Output_valueType>(x);
-  return ret;
-}
+// config detail: {'physical_range': '[0|1]', 'name': 'commanded_value', 'enum':
+// {0: 'COMMANDED_VALUE_OFF', 1: 'COMMANDED_VALUE_ON'}, 'precision': 1.0, 'len':
+// 8, 'is_signed_var': False, 'offset': 0.0, 'bit': 15, 'type': 'enum', 'order':
+// 'motorola', 'physical_unit': ''}
+constexpr CanSignal<15, 8, ByteOrder::MOTOROLA> kCommandedValue;
 
-// config detail: {'name': 'commanded_value', 'enum': {0: 'COMMANDED_VALUE_OFF',
-// 1: 'COMMANDED_VALUE_ON'}, 'precision': 1.0, 'len': 8, 'is_signed_var': False,
-// 'offset': 0.0, 'physical_range': '[0|1]', 'bit': 15, 'type': 'enum', 'order':
+// config detail: {'physical_range': '[0|1]', 'name': 'manual_input', 'enum':
+// {0: 'MANUAL_INPUT_OFF', 1: 'MANUAL_INPUT_ON'}, 'precision': 1.0, 'len': 8,
+// 'is_signed_var': False, 'offset': 0.0, 'bit': 7, 'type': 'enum', 'order':
 // 'motorola', 'physical_unit': ''}
-Horn_rpt_79::Commanded_valueType Hornrpt79::commanded_value(
-    const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
+constexpr CanSignal<7, 8, ByteOrder::MOTOROLA> kManualInput;
 
-  Horn_rpt_79::Commanded_valueType ret =
-      static_cast<Horn_rpt_79::Commanded_valueType>(x);
-  return ret;
-}
+}  // namespace
 
-// config detail: {'name': 'manual_input', 'enum': {0: 'MANUAL_INPUT_OFF', 1:
-// 'MANUAL_INPUT_ON'}, 'precision': 1.0, 'len': 8, 'is_signed_var': False,
-// 'offset': 0.0, 'physical_range': '[0|1]', 'bit': 7, 'type': 'enum', 'order':
-// 'motorola', 'physical_unit': ''}
-Horn_rpt_79::Manual_inputType Hornrpt79::manual_input(const std::uint8_t* bytes,
-                                                      int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
+Hornrpt79::Hornrpt79() {}
+const int32_t Hornrpt79::ID = 0x79;
 
-  Horn_rpt_79::Manual_inputType ret =
-      static_cast<Horn_rpt_79::Manual_inputType>(x);
-  return ret;
+void Hornrpt79::Parse(const std::uint8_t* bytes, int32_t length,
+                      ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_horn_rpt_79();
+  report->set_output_value(static_cast<Horn_rpt_79::Output_valueType>(
+      kOutputValue.Raw(frame)));
+  report->set_commanded_value(static_cast<Horn_rpt_79::Commanded_valueType>(
+      kCommandedValue.Raw(frame)));
+  report->set_manual_input(static_cast<Horn_rpt_79::Manual_inputType>(
+      kManualInput.Raw(frame)));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
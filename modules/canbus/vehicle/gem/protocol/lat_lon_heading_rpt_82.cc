@@ -16,153 +16,71 @@
 
 #include "modules/canbus/vehicle/gem/protocol/lat_lon_heading_rpt_82.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
-
-Latlonheadingrpt82::Latlonheadingrpt82() {}
-const int32_t Latlonheadingrpt82::ID = 0x82;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-void Latlonheadingrpt82::Parse(const std::uint8_t* bytes, int32_t length,
-                               ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_lat_lon_heading_rpt_82()->set_heading(
-      heading(bytes, length));
-  chassis->mutable_gem()
-      ->mutable_lat_lon_heading_rpt_82()
-      ->set_longitude_seconds(longitude_seconds(bytes, length));
-  chassis->mutable_gem()
-      ->mutable_lat_lon_heading_rpt_82()
-      ->set_longitude_minutes(longitude_minutes(bytes, length));
-  chassis->mutable_gem()
-      ->mutable_lat_lon_heading_rpt_82()
-      ->set_longitude_degrees(longitude_degrees(bytes, length));
-  chassis->mutable_gem()
-      ->mutable_lat_lon_heading_rpt_82()
-      ->set_latitude_seconds(latitude_seconds(bytes, length));
-  chassis->mutable_gem()
-      ->mutable_lat_lon_heading_rpt_82()
-      ->set_latitude_minutes(latitude_minutes(bytes, length));
-  chassis->mutable_gem()
-      ->mutable_lat_lon_heading_rpt_82()
-      ->set_latitude_degrees(latitude_degrees(bytes, length));
-}
+namespace {
 
 // config detail: {'name': 'heading', 'offset': 0.0, 'precision': 0.01, 'len':
 // 16, 'is_signed_var': True, 'physical_range': '[-327.68|327.67]', 'bit': 55,
 // 'type': 'double', 'order': 'motorola', 'physical_unit': 'deg'}
-double Latlonheadingrpt82::heading(const std::uint8_t* bytes,
-                                   int32_t length) const {
-  Byte t0(bytes + 6);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 7);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  x <<= 16;
-  x >>= 16;
-
-  double ret = x * 0.010000;
-  return ret;
-}
+constexpr CanSignal<55, 16, ByteOrder::MOTOROLA, true> kHeading(0.01);
 
 // config detail: {'name': 'longitude_seconds', 'offset': 0.0, 'precision': 1.0,
 // 'len': 8, 'is_signed_var': True, 'physical_range': '[-128|127]', 'bit': 47,
 // 'type': 'int', 'order': 'motorola', 'physical_unit': 'sec'}
-int Latlonheadingrpt82::longitude_seconds(const std::uint8_t* bytes,
-                                          int32_t length) const {
-  Byte t0(bytes + 5);
-  int32_t x = t0.get_byte(0, 8);
-
-  x <<= 24;
-  x >>= 24;
-
-  int ret = x;
-  return ret;
-}
+constexpr CanSignal<47, 8, ByteOrder::MOTOROLA, true> kLongitudeSeconds;
 
 // config detail: {'name': 'longitude_minutes', 'offset': 0.0, 'precision': 1.0,
 // 'len': 8, 'is_signed_var': True, 'physical_range': '[-128|127]', 'bit': 39,
 // 'type': 'int', 'order': 'motorola', 'physical_unit': 'min'}
-int Latlonheadingrpt82::longitude_minutes(const std::uint8_t* bytes,
-                                          int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
-
-  x <<= 24;
-  x >>= 24;
-
-  int ret = x;
-  return ret;
-}
+constexpr CanSignal<39, 8, ByteOrder::MOTOROLA, true> kLongitudeMinutes;
 
 // config detail: {'name': 'longitude_degrees', 'offset': 0.0, 'precision': 1.0,
 // 'len': 8, 'is_signed_var': True, 'physical_range': '[-128|127]', 'bit': 31,
 // 'type': 'int', 'order': 'motorola', 'physical_unit': 'deg'}
-int Latlonheadingrpt82::longitude_degrees(const std::uint8_t* bytes,
-                                          int32_t length) const {
-  Byte t0(bytes + 3);
-  int32_t x = t0.get_byte(0, 8);
-
-  x <<= 24;
-  x >>= 24;
-
-  int ret = x;
-  return ret;
-}
+constexpr CanSignal<31, 8, ByteOrder::MOTOROLA, true> kLongitudeDegrees;
 
 // config detail: {'name': 'latitude_seconds', 'offset': 0.0, 'precision': 1.0,
 // 'len': 8, 'is_signed_var': True, 'physical_range': '[-128|127]', 'bit': 23,
 // 'type': 'int', 'order': 'motorola', 'physical_unit': 'sec'}
-int Latlonheadingrpt82::latitude_seconds(const std::uint8_t* bytes,
-                                         int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
-
-  x <<= 24;
-  x >>= 24;
-
-  int ret = x;
-  return ret;
-}
+constexpr CanSignal<23, 8, ByteOrder::MOTOROLA, true> kLatitudeSeconds;
 
 // config detail: {'name': 'latitude_minutes', 'offset': 0.0, 'precision': 1.0,
 // 'len': 8, 'is_signed_var': True, 'physical_range': '[-128|127]', 'bit': 15,
 // 'type': 'int', 'order': 'motorola', 'physical_unit': 'min'}
-int Latlonheadingrpt82::latitude_minutes(const std::uint8_t* bytes,
-                                         int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
-
-  x <<= 24;
-  x >>= 24;
-
-  int ret = x;
-  return ret;
-}
+constexpr CanSignal<15, 8, ByteOrder::MOTOROLA, true> kLatitudeMinutes;
 
 // config detail: {'name': 'latitude_degrees', 'offset': 0.0, 'precision': 1.0,
 // 'len': 8, 'is_signed_var': True, 'physical_range': '[-128|127]', 'bit': 7,
 // 'type': 'int', 'order': 'motorola', 'physical_unit': 'deg'}
-int Latlonheadingrpt82::latitude_degrees(const std::uint8_t* bytes,
-                                         int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
+constexpr CanSignal<7, 8, ByteOrder::MOTOROLA, true> kLatitudeDegrees;
 
-  x <<= 24;
-  x >>= 24;
+}  // namespace
+
+Latlonheadingrpt82::Latlonheadingrpt82() {}
+const int32_t Latlonheadingrpt82::ID = 0x82;
 
-  int ret = x;
-  return ret;
+void Latlonheadingrpt82::Parse(const std::uint8_t* bytes, int32_t length,
+                               ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_lat_lon_heading_rpt_82();
+  report->set_heading(kHeading.Decode(frame));
+  report->set_longitude_seconds(static_cast<int>(kLongitudeSeconds.Raw(frame)));
+  report->set_longitude_minutes(static_cast<int>(kLongitudeMinutes.Raw(frame)));
+  report->set_longitude_degrees(static_cast<int>(kLongitudeDegrees.Raw(frame)));
+  report->set_latitude_seconds(static_cast<int>(kLatitudeSeconds.Raw(frame)));
+  report->set_latitude_minutes(static_cast<int>(kLatitudeMinutes.Raw(frame)));
+  report->set_latitude_degrees(static_cast<int>(kLatitudeDegrees.Raw(frame)));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -31,48 +31,6 @@ class Latlonheadingrpt82 : public ::apollo::drivers::canbus::ProtocolData<
   Latlonheadingrpt82();
   void Parse(const std::uint8_t* bytes, int32_t length,
              ChassisDetail* chassis) const override;
-
- private:
-  // config detail: {'name': 'HEADING', 'offset': 0.0, 'precision': 0.01, 'len':
-  // 16, 'is_signed_var': True, 'physical_range': '[-327.68|327.67]', 'bit': 55,
-  // 'type': 'double', 'order': 'motorola', 'physical_unit': 'deg'}
-  double heading(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'LONGITUDE_SECONDS', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 8, 'is_signed_var': True, 'physical_range':
-  // '[-128|127]', 'bit': 47, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'sec'}
-  int longitude_seconds(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'LONGITUDE_MINUTES', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 8, 'is_signed_var': True, 'physical_range':
-  // '[-128|127]', 'bit': 39, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'min'}
-  int longitude_minutes(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'LONGITUDE_DEGREES', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 8, 'is_signed_var': True, 'physical_range':
-  // '[-128|127]', 'bit': 31, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'deg'}
-  int longitude_degrees(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'LATITUDE_SECONDS', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 8, 'is_signed_var': True, 'physical_range':
-  // '[-128|127]', 'bit': 23, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'sec'}
-  int latitude_seconds(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'LATITUDE_MINUTES', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 8, 'is_signed_var': True, 'physical_range':
-  // '[-128|127]', 'bit': 15, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'min'}
-  int latitude_minutes(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'LATITUDE_DEGREES', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 8, 'is_signed_var': True, 'physical_range':
-  // '[-128|127]', 'bit': 7, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'deg'}
-  int latitude_degrees(const std::uint8_t* bytes, const int32_t length) const;
 };
 
 }  // namespace gem
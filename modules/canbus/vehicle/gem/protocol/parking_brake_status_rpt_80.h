@@ -31,15 +31,6 @@ class Parkingbrakestatusrpt80 : public ::apollo::drivers::canbus::ProtocolData<
   Parkingbrakestatusrpt80();
   void Parse(const std::uint8_t* bytes, int32_t length,
              ChassisDetail* chassis) const override;
-
- private:
-  // config detail: {'name': 'PARKING_BRAKE_ENABLED', 'enum': {0:
-  // 'PARKING_BRAKE_ENABLED_OFF', 1: 'PARKING_BRAKE_ENABLED_ON'},
-  // 'precision': 1.0, 'len': 1, 'is_signed_var': False, 'offset': 0.0,
-  // 'physical_range': '[0|1]', 'bit': 0, 'type': 'enum', 'order': 'motorola',
-  // 'physical_unit': ''}
-  Parking_brake_status_rpt_80::Parking_brake_enabledType parking_brake_enabled(
-      const std::uint8_t* bytes, const int32_t length) const;
 };
 
 }  // namespace gem
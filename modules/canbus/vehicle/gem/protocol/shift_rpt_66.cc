@@ -16,75 +16,57 @@
 
 #include "modules/canbus/vehicle/gem/protocol/shift_rpt_66.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
-
-Shiftrpt66::Shiftrpt66() {}
-const int32_t Shiftrpt66::ID = 0x66;
-
-void Shiftrpt66::Parse(const std::uint8_t* bytes, int32_t length,
-                       ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_shift_rpt_66()->set_manual_input(
-      manual_input(bytes, length));
-  chassis->mutable_gem()->mutable_shift_rpt_66()->set_commanded_value(
-      commanded_value(bytes, length));
-  chassis->mutable_gem()->mutable_shift_rpt_66()->set_output_value(
-      output_value(bytes, length));
-}
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-// config detail: {'name': 'manual_input', 'enum': {0: 'MANUAL_INPUT_PARK', 1:
-// 'MANUAL_INPUT_REVERSE', 2: 'MANUAL_INPUT_NEUTRAL', 3: 'MANUAL_INPUT_FORWARD',
-// 4: 'MANUAL_INPUT_HIGH'}, 'precision': 1.0, 'len': 8, 'is_signed_var': False,
-// 'offset': 0.0, 'physical_range': '[0|4]', 'bit': 7, 'type': 'enum', 'order':
-// 'motorola', 'physical_unit': ''}
-Shift_rpt_66::Manual_inputType Shiftrpt66::manual_input(
-    const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
+namespace {
 
-  Shift_rpt_66::Manual_inputType ret =
-      static_cast<Shift_rpt_66::Manual_inputType>(x);
-  return ret;
-}
+// config detail: {'physical_range': '[0|4]', 'name': 'manual_input', 'enum':
+// {0: 'MANUAL_INPUT_PARK', 1: 'MANUAL_INPUT_REVERSE', 2:
+// 'MANUAL_INPUT_NEUTRAL', 3: 'MANUAL_INPUT_FORWARD', 4: 'MANUAL_INPUT_HIGH'},
+// 'precision': 1.0, 'len': 8, 'is_signed_var': False, 'offset': 0.0, 'bit': 7,
+// 'type': 'enum', 'order': 'motorola', 'physical_unit': ''}
+constexpr CanSignal<7, 8, ByteOrder::MOTOROLA> kManualInput;
 
-// config detail: {'name': 'commanded_value', 'enum': {0:
-// 'COMMANDED_VALUE_PARK', 1: 'COMMANDED_VALUE_REVERSE', 2:
+// config detail: {'physical_range': '[0|4]', 'name': 'commanded_value', 'enum':
+// {0: 'COMMANDED_VALUE_PARK', 1: 'COMMANDED_VALUE_REVERSE', 2:
 // 'COMMANDED_VALUE_NEUTRAL', 3: 'COMMANDED_VALUE_FORWARD', 4:
 // 'COMMANDED_VALUE_HIGH'}, 'precision': 1.0, 'len': 8, 'is_signed_var': False,
-// 'offset': 0.0, 'physical_range': '[0|4]', 'bit': 15, 'type': 'enum', 'order':
-// 'motorola', 'physical_unit': ''}
-Shift_rpt_66::Commanded_valueType Shiftrpt66::commanded_value(
-    const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
+// 'offset': 0.0, 'bit': 15, 'type': 'enum', 'order': 'motorola',
+// 'physical_unit': ''}
+constexpr CanSignal<15, 8, ByteOrder::MOTOROLA> kCommandedValue;
 
-  Shift_rpt_66::Commanded_valueType ret =
-      static_cast<Shift_rpt_66::Commanded_valueType>(x);
-  return ret;
-}
+// config detail: {'physical_range': '[0|4]', 'name': 'output_value', 'enum':
+// {0: 'OUTPUT_VALUE_PARK', 1: 'OUTPUT_VALUE_REVERSE', 2:
+// 'OUTPUT_VALUE_NEUTRAL', 3: 'OUTPUT_VALUE_FORWARD', 4: 'OUTPUT_VALUE_HIGH'},
+// 'precision': 1.0, 'len': 8, 'is_signed_var': False, 'offset': 0.0, 'bit': 23,
+// 'type': 'enum', 'order': 'motorola', 'physical_unit': ''}
+constexpr CanSignal<23, 8, ByteOrder::MOTOROLA> kOutputValue;
 
-// config detail: {'name': 'output_value', 'enum': {0: 'OUTPUT_VALUE_PARK', 1:
-// 'OUTPUT_VALUE_REVERSE', 2: 'OUTPUT_VALUE_NEUTRAL', 3: 'OUTPUT_VALUE_FORWARD',
-// 4: 'OUTPUT_VALUE_HIGH'}, 'precision': 1.0, 'len': 8, 'is_signed_var': False,
-// 'offset': 0.0, 'physical_range': '[0|4]', 'bit': 23, 'type': 'enum', 'order':
-// 'motorola', 'physical_unit': ''}
-Shift_rpt_66::Output_valueType Shiftrpt66::output_value(
-    const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
+}  // namespace
+
+Shiftrpt66::Shiftrpt66() {}
+const int32_t Shiftrpt66::ID = 0x66;
 
-  Shift_rpt_66::Output_valueType ret =
-      static_cast<Shift_rpt_66::Output_valueType>(x);
-  return ret;
+void Shiftrpt66::Parse(const std::uint8_t* bytes, int32_t length,
+                       ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_shift_rpt_66();
+  report->set_manual_input(static_cast<Shift_rpt_66::Manual_inputType>(
+      kManualInput.Raw(frame)));
+  report->set_commanded_value(static_cast<Shift_rpt_66::Commanded_valueType>(
+      kCommandedValue.Raw(frame)));
+  report->set_output_value(static_cast<Shift_rpt_66::Output_valueType>(
+      kOutputValue.Raw(frame)));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -31,32 +31,6 @@ class Shiftrpt66 : public ::apollo::drivers::canbus::ProtocolData<
   Shiftrpt66();
   void Parse(const std::uint8_t* bytes, int32_t length,
              ChassisDetail* chassis) const override;
-
- private:
-  // config detail: {'name': 'MANUAL_INPUT', 'enum': {0: 'MANUAL_INPUT_PARK', 1:
-  // 'MANUAL_INPUT_REVERSE', 2: 'MANUAL_INPUT_NEUTRAL', 3:
-  // 'MANUAL_INPUT_FORWARD', 4: 'MANUAL_INPUT_HIGH'}, 'precision': 1.0, 'len':
-  // 8, 'is_signed_var': False, 'offset': 0.0, 'physical_range': '[0|4]', 'bit':
-  // 7, 'type': 'enum', 'order': 'motorola', 'physical_unit': ''}
-  Shift_rpt_66::Manual_inputType manual_input(const std::uint8_t* bytes,
-                                              const int32_t length) const;
-
-  // config detail: {'name': 'COMMANDED_VALUE', 'enum': {0:
-  // 'COMMANDED_VALUE_PARK', 1: 'COMMANDED_VALUE_REVERSE', 2:
-  // 'COMMANDED_VALUE_NEUTRAL', 3: 'COMMANDED_VALUE_FORWARD', 4:
-  // 'COMMANDED_VALUE_HIGH'}, 'precision': 1.0, 'len': 8, 'is_signed_var':
-  // False, 'offset': 0.0, 'physical_range': '[0|4]', 'bit': 15, 'type': 'enum',
-  // 'order': 'motorola', 'physical_unit': ''}
-  Shift_rpt_66::Commanded_valueType commanded_value(const std::uint8_t* bytes,
-                                                    const int32_t length) const;
-
-  // config detail: {'name': 'OUTPUT_VALUE', 'enum': {0: 'OUTPUT_VALUE_PARK', 1:
-  // 'OUTPUT_VALUE_REVERSE', 2: 'OUTPUT_VALUE_NEUTRAL', 3:
-  // 'OUTPUT_VALUE_FORWARD', 4: 'OUTPUT_VALUE_HIGH'}, 'precision': 1.0, 'len':
-  // 8, 'is_signed_var': False, 'offset': 0.0, 'physical_range': '[0|4]', 'bit':
-  // 23, 'type': 'enum', 'order': 'motorola', 'physical_unit': ''}
-  Shift_rpt_66::Output_valueType output_value(const std::uint8_t* bytes,
-                                              const int32_t length) const;
 };
 
 }  // namespace gem
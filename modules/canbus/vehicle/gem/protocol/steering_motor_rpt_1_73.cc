@@ -16,85 +16,42 @@
 
 #include "modules/canbus/vehicle/gem/protocol/steering_motor_rpt_1_73.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-Steeringmotorrpt173::Steeringmotorrpt173() {}
-const int32_t Steeringmotorrpt173::ID = 0x73;
-
-void Steeringmotorrpt173::Parse(const std::uint8_t* bytes, int32_t length,
-                                ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_steering_motor_rpt_1_73()->set_motor_current(
-      motor_current(bytes, length));
-  chassis->mutable_gem()->mutable_steering_motor_rpt_1_73()->set_shaft_position(
-      shaft_position(bytes, length));
-}
+namespace {
 
 // config detail: {'name': 'motor_current', 'offset': 0.0, 'precision': 0.001,
 // 'len': 32, 'is_signed_var': False, 'physical_range': '[0|4294967.295]',
 // 'bit': 7, 'type': 'double', 'order': 'motorola', 'physical_unit': 'amps'}
-double Steeringmotorrpt173::motor_current(const std::uint8_t* bytes,
-                                          int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 1);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  Byte t2(bytes + 2);
-  t = t2.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  Byte t3(bytes + 3);
-  t = t3.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  double ret = x * 0.001000;
-  return ret;
-}
+constexpr CanSignal<7, 32, ByteOrder::MOTOROLA> kMotorCurrent(0.001);
 
 // config detail: {'name': 'shaft_position', 'offset': 0.0, 'precision': 0.001,
 // 'len': 32, 'is_signed_var': True, 'physical_range':
 // '[-2147483.648|2147483.647]', 'bit': 39, 'type': 'double', 'order':
 // 'motorola', 'physical_unit': 'amps'}
-double Steeringmotorrpt173::shaft_position(const std::uint8_t* bytes,
-                                           int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 5);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+constexpr CanSignal<39, 32, ByteOrder::MOTOROLA, true> kShaftPosition(0.001);
 
-  Byte t2(bytes + 6);
-  t = t2.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+}  // namespace
 
-  Byte t3(bytes + 7);
-  t = t3.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  x <<= 0;
-  x >>= 0;
+Steeringmotorrpt173::Steeringmotorrpt173() {}
+const int32_t Steeringmotorrpt173::ID = 0x73;
 
-  double ret = x * 0.001000;
-  return ret;
+void Steeringmotorrpt173::Parse(const std::uint8_t* bytes, int32_t length,
+                                ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_steering_motor_rpt_1_73();
+  report->set_motor_current(kMotorCurrent.Decode(frame));
+  report->set_shaft_position(kShaftPosition.Decode(frame));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -31,18 +31,6 @@ class Steeringmotorrpt173 : public ::apollo::drivers::canbus::ProtocolData<
   Steeringmotorrpt173();
   void Parse(const std::uint8_t* bytes, int32_t length,
              ChassisDetail* chassis) const override;
-
- private:
-  // config detail: {'name': 'MOTOR_CURRENT', 'offset': 0.0, 'precision': 0.001,
-  // 'len': 32, 'is_signed_var': False, 'physical_range': '[0|4294967.295]',
-  // 'bit': 7, 'type': 'double', 'order': 'motorola', 'physical_unit': 'amps'}
-  double motor_current(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'SHAFT_POSITION', 'offset': 0.0, 'precision':
-  // 0.001, 'len': 32, 'is_signed_var': True, 'physical_range':
-  // '[-2147483.648|2147483.647]', 'bit': 39, 'type': 'double', 'order':
-  // 'motorola', 'physical_unit': 'amps'}
-  double shaft_position(const std::uint8_t* bytes, const int32_t length) const;
 };
 
 }  // namespace gem
@@ -16,89 +16,47 @@
 
 #include "modules/canbus/vehicle/gem/protocol/steering_rpt_1_6e.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-Steeringrpt16e::Steeringrpt16e() {}
-const int32_t Steeringrpt16e::ID = 0x6E;
-
-void Steeringrpt16e::Parse(const std::uint8_t* bytes, int32_t length,
-                           ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_steering_rpt_1_6e()->set_manual_input(
-      manual_input(bytes, length));
-  chassis->mutable_gem()->mutable_steering_rpt_1_6e()->set_commanded_value(
-      commanded_value(bytes, length));
-  chassis->mutable_gem()->mutable_steering_rpt_1_6e()->set_output_value(
-      output_value(bytes, length));
-}
+namespace {
 
 // config detail: {'name': 'manual_input', 'offset': 0.0, 'precision': 0.001,
 // 'len': 16, 'is_signed_var': True, 'physical_range': '[-32.768|32.767]',
 // 'bit': 7, 'type': 'double', 'order': 'motorola', 'physical_unit': 'rad/s'}
-double Steeringrpt16e::manual_input(const std::uint8_t* bytes,
-                                    int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 1);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  x <<= 16;
-  x >>= 16;
-
-  double ret = x * 0.001000;
-  return ret;
-}
+constexpr CanSignal<7, 16, ByteOrder::MOTOROLA, true> kManualInput(0.001);
 
 // config detail: {'name': 'commanded_value', 'offset': 0.0, 'precision': 0.001,
 // 'len': 16, 'is_signed_var': True, 'physical_range': '[-32.768|32.767]',
 // 'bit': 23, 'type': 'double', 'order': 'motorola', 'physical_unit': 'rad/s'}
-double Steeringrpt16e::commanded_value(const std::uint8_t* bytes,
-                                       int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 3);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  x <<= 16;
-  x >>= 16;
-
-  double ret = x * 0.001000;
-  return ret;
-}
+constexpr CanSignal<23, 16, ByteOrder::MOTOROLA, true> kCommandedValue(0.001);
 
 // config detail: {'name': 'output_value', 'offset': 0.0, 'precision': 0.001,
 // 'len': 16, 'is_signed_var': True, 'physical_range': '[-32.768|32.767]',
 // 'bit': 39, 'type': 'double', 'order': 'motorola', 'physical_unit': 'rad/s'}
-double Steeringrpt16e::output_value(const std::uint8_t* bytes,
-                                    int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
+constexpr CanSignal<39, 16, ByteOrder::MOTOROLA, true> kOutputValue(0.001);
 
-  Byte t1(bytes + 5);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+}  // namespace
 
-  x <<= 16;
-  x >>= 16;
+Steeringrpt16e::Steeringrpt16e() {}
+const int32_t Steeringrpt16e::ID = 0x6E;
 
-  double ret = x * 0.001000;
-  return ret;
+void Steeringrpt16e::Parse(const std::uint8_t* bytes, int32_t length,
+                           ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_steering_rpt_1_6e();
+  report->set_manual_input(kManualInput.Decode(frame));
+  report->set_commanded_value(kCommandedValue.Decode(frame));
+  report->set_output_value(kOutputValue.Decode(frame));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -31,23 +31,6 @@ class Steeringrpt16e : public ::apollo::drivers::canbus::ProtocolData<
   Steeringrpt16e();
   void Parse(const std::uint8_t* bytes, int32_t length,
              ChassisDetail* chassis) const override;
-
- private:
-  // config detail: {'name': 'MANUAL_INPUT', 'offset': 0.0, 'precision': 0.001,
-  // 'len': 16, 'is_signed_var': True, 'physical_range': '[-32.768|32.767]',
-  // 'bit': 7, 'type': 'double', 'order': 'motorola', 'physical_unit': 'rad/s'}
-  double manual_input(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'COMMANDED_VALUE', 'offset': 0.0, 'precision':
-  // 0.001, 'len': 16, 'is_signed_var': True, 'physical_range':
-  // '[-32.768|32.767]', 'bit': 23, 'type': 'double', 'order': 'motorola',
-  // 'physical_unit': 'rad/s'}
-  double commanded_value(const std::uint8_t* bytes, const int32_t length) const;
-
-  // config detail: {'name': 'OUTPUT_VALUE', 'offset': 0.0, 'precision': 0.001,
-  // 'len': 16, 'is_signed_var': True, 'physical_range': '[-32.768|32.767]',
-  // 'bit': 39, 'type': 'double', 'order': 'motorola', 'physical_unit': 'rad/s'}
-  double output_value(const std::uint8_t* bytes, const int32_t length) const;
 };
 
 }  // namespace gem
@@ -16,74 +16,56 @@
 
 #include "modules/canbus/vehicle/gem/protocol/turn_rpt_64.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-Turnrpt64::Turnrpt64() {}
-const int32_t Turnrpt64::ID = 0x64;
+namespace {
 
-void Turnrpt64::Parse(const std::uint8_t* bytes, int32_t length,
-                      ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_turn_rpt_64()->set_manual_input(
-      manual_input(bytes, length));
-  chassis->mutable_gem()->mutable_turn_rpt_64()->set_commanded_value(
-      commanded_value(bytes, length));
-  chassis->mutable_gem()->mutable_turn_rpt_64()->set_output_value(
-      output_value(bytes, length));
-}
-
-// config detail: {'name': 'manual_input', 'enum': {0: 'MANUAL_INPUT_RIGHT', 1:
-// 'MANUAL_INPUT_NONE', 2: 'MANUAL_INPUT_LEFT', 3: 'MANUAL_INPUT_HAZARD'},
-// 'precision': 1.0, 'len': 8, 'is_signed_var': False, 'offset': 0.0,
-// 'physical_range': '[0|3]', 'bit': 7, 'type': 'enum', 'order': 'motorola',
+// config detail: {'physical_range': '[0|3]', 'name': 'manual_input', 'enum':
+// {0: 'MANUAL_INPUT_RIGHT', 1: 'MANUAL_INPUT_NONE', 2: 'MANUAL_INPUT_LEFT', 3:
+// 'MANUAL_INPUT_HAZARD'}, 'precision': 1.0, 'len': 8, 'is_signed_var': False,
+// 'offset': 0.0, 'bit': 7, 'type': 'enum', 'order': 'motorola',
 // 'physical_unit': ''}
-Turn_rpt_64::Manual_inputType Turnrpt64::manual_input(const std::uint8_t* bytes,
-                                                      int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
-
-  Turn_rpt_64::Manual_inputType ret =
-      static_cast<Turn_rpt_64::Manual_inputType>(x);
-  return ret;
-}
+constexpr CanSignal<7, 8, ByteOrder::MOTOROLA> kManualInput;
 
-// config detail: {'name': 'commanded_value', 'enum': {0:
-// 'COMMANDED_VALUE_RIGHT', 1: 'COMMANDED_VALUE_NONE', 2:
+// config detail: {'physical_range': '[0|3]', 'name': 'commanded_value', 'enum':
+// {0: 'COMMANDED_VALUE_RIGHT', 1: 'COMMANDED_VALUE_NONE', 2:
 // 'COMMANDED_VALUE_LEFT', 3: 'COMMANDED_VALUE_HAZARD'}, 'precision': 1.0,
-// 'len': 8, 'is_signed_var': False, 'offset': 0.0, 'physical_range': '[0|3]',
-// 'bit': 15, 'type': 'enum', 'order': 'motorola', 'physical_unit': ''}
-Turn_rpt_64::Commanded_valueType Turnrpt64::commanded_value(
-    const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
+// 'len': 8, 'is_signed_var': False, 'offset': 0.0, 'bit': 15, 'type': 'enum',
+// 'order': 'motorola', 'physical_unit': ''}
+constexpr CanSignal<15, 8, ByteOrder::MOTOROLA> kCommandedValue;
 
-  Turn_rpt_64::Commanded_valueType ret =
-      static_cast<Turn_rpt_64::Commanded_valueType>(x);
-  return ret;
-}
-
-// config detail: {'name': 'output_value', 'enum': {0: 'OUTPUT_VALUE_RIGHT', 1:
-// 'OUTPUT_VALUE_NONE', 2: 'OUTPUT_VALUE_LEFT', 3: 'OUTPUT_VALUE_HAZARD'},
-// 'precision': 1.0, 'len': 8, 'is_signed_var': False, 'offset': 0.0,
-// 'physical_range': '[0|3]', 'bit': 23, 'type': 'enum', 'order': 'motorola',
+// config detail: {'physical_range': '[0|3]', 'name': 'output_value', 'enum':
+// {0: 'OUTPUT_VALUE_RIGHT', 1: 'OUTPUT_VALUE_NONE', 2: 'OUTPUT_VALUE_LEFT', 3:
+// 'OUTPUT_VALUE_HAZARD'}, 'precision': 1.0, 'len': 8, 'is_signed_var': False,
+// 'offset': 0.0, 'bit': 23, 'type': 'enum', 'order': 'motorola',
 // 'physical_unit': ''}
-Turn_rpt_64::Output_valueType Turnrpt64::output_value(const std::uint8_t* bytes,
-                                                      int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
+constexpr CanSignal<23, 8, ByteOrder::MOTOROLA> kOutputValue;
+
+}  // namespace
 
-  Turn_rpt_64::Output_valueType ret =
-      static_cast<Turn_rpt_64::Output_valueType>(x);
-  return ret;
+Turnrpt64::Turnrpt64() {}
+const int32_t Turnrpt64::ID = 0x64;
+
+void Turnrpt64::Parse(const std::uint8_t* bytes, int32_t length,
+                      ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_turn_rpt_64();
+  report->set_manual_input(static_cast<Turn_rpt_64::Manual_inputType>(
+      kManualInput.Raw(frame)));
+  report->set_commanded_value(static_cast<Turn_rpt_64::Commanded_valueType>(
+      kCommandedValue.Raw(frame)));
+  report->set_output_value(static_cast<Turn_rpt_64::Output_valueType>(
+      kOutputValue.Raw(frame)));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -31,31 +31,6 @@ class Turnrpt64 : public ::apollo::drivers::canbus::ProtocolData<
   Turnrpt64();
   void Parse(const std::uint8_t* bytes, int32_t length,
              ChassisDetail* chassis) const override;
-
- private:
-  // config detail: {'name': 'MANUAL_INPUT', 'enum': {0: 'MANUAL_INPUT_RIGHT',
-  // 1: 'MANUAL_INPUT_NONE', 2: 'MANUAL_INPUT_LEFT', 3: 'MANUAL_INPUT_HAZARD'},
-  // 'precision': 1.0, 'len': 8, 'is_signed_var': False, 'offset': 0.0,
-  // 'physical_range': '[0|3]', 'bit': 7, 'type': 'enum', 'order': 'motorola',
-  // 'physical_unit': ''}
-  Turn_rpt_64::Manual_inputType manual_input(const std::uint8_t* bytes,
-                                             const int32_t length) const;
-
-  // config detail: {'name': 'COMMANDED_VALUE', 'enum': {0:
-  // 'COMMANDED_VALUE_RIGHT', 1: 'COMMANDED_VALUE_NONE', 2:
-  // 'COMMANDED_VALUE_LEFT', 3: 'COMMANDED_VALUE_HAZARD'}, 'precision': 1.0,
-  // 'len': 8, 'is_signed_var': False, 'offset': 0.0, 'physical_range': '[0|3]',
-  // 'bit': 15, 'type': 'enum', 'order': 'motorola', 'physical_unit': ''}
-  Turn_rpt_64::Commanded_valueType commanded_value(const std::uint8_t* bytes,
-                                                   const int32_t length) const;
-
-  // config detail: {'name': 'OUTPUT_VALUE', 'enum': {0: 'OUTPUT_VALUE_RIGHT',
-  // 1: 'OUTPUT_VALUE_NONE', 2: 'OUTPUT_VALUE_LEFT', 3: 'OUTPUT_VALUE_HAZARD'},
-  // 'precision': 1.0, 'len': 8, 'is_signed_var': False, 'offset': 0.0,
-  // 'physical_range': '[0|3]', 'bit': 23, 'type': 'enum', 'order': 'motorola',
-  // 'physical_unit': ''}
-  Turn_rpt_64::Output_valueType output_value(const std::uint8_t* bytes,
-                                             const int32_t length) const;
 };
 
 }  // namespace gem
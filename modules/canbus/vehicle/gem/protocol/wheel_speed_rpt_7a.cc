@@ -16,118 +16,57 @@
 
 #include "modules/canbus/vehicle/gem/protocol/wheel_speed_rpt_7a.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
-
-Wheelspeedrpt7a::Wheelspeedrpt7a() {}
-const int32_t Wheelspeedrpt7a::ID = 0x7A;
-
-void Wheelspeedrpt7a::Parse(const std::uint8_t* bytes, int32_t length,
-                            ChassisDetail* chassis) const {
-  chassis->mutable_gem()
-      ->mutable_wheel_speed_rpt_7a()
-      ->set_wheel_spd_rear_right(wheel_spd_rear_right(bytes, length));
-  chassis->mutable_gem()->mutable_wheel_speed_rpt_7a()->set_wheel_spd_rear_left(
-      wheel_spd_rear_left(bytes, length));
-  chassis->mutable_gem()
-      ->mutable_wheel_speed_rpt_7a()
-      ->set_wheel_spd_front_right(wheel_spd_front_right(bytes, length));
-  chassis->mutable_gem()
-      ->mutable_wheel_speed_rpt_7a()
-      ->set_wheel_spd_front_left(wheel_spd_front_left(bytes, length));
-}
-
-// config detail: {'name': 'wheel_spd_rear_right', 'offset': 0.0,
-// 'precision': 1.0, 'len': 16, 'is_signed_var': True, 'physical_range':
-// '[-32768|32767]', 'bit': 55, 'type': 'int', 'order': 'motorola',
-// 'physical_unit': 'rad/s'}
-int Wheelspeedrpt7a::wheel_spd_rear_right(const std::uint8_t* bytes,
-                                          int32_t length) const {
-  Byte t0(bytes + 6);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 7);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  x <<= 16;
-  x >>= 16;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-  int ret = x;
-  return ret;
-}
-
-// config detail: {'name': 'wheel_spd_rear_left', 'offset': 0.0,
-// 'precision': 1.0, 'len': 16, 'is_signed_var': True, 'physical_range':
-// '[-32768|32767]', 'bit': 39, 'type': 'int', 'order': 'motorola',
-// 'physical_unit': 'rad/s'}
-int Wheelspeedrpt7a::wheel_spd_rear_left(const std::uint8_t* bytes,
-                                         int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
+namespace {
 
-  Byte t1(bytes + 5);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+// config detail: {'name': 'wheel_spd_rear_right', 'offset': 0.0, 'precision':
+// 1.0, 'len': 16, 'is_signed_var': True, 'physical_range': '[-32768|32767]',
+// 'bit': 55, 'type': 'int', 'order': 'motorola', 'physical_unit': 'rad/s'}
+constexpr CanSignal<55, 16, ByteOrder::MOTOROLA, true> kWheelSpdRearRight;
 
-  x <<= 16;
-  x >>= 16;
+// config detail: {'name': 'wheel_spd_rear_left', 'offset': 0.0, 'precision':
+// 1.0, 'len': 16, 'is_signed_var': True, 'physical_range': '[-32768|32767]',
+// 'bit': 39, 'type': 'int', 'order': 'motorola', 'physical_unit': 'rad/s'}
+constexpr CanSignal<39, 16, ByteOrder::MOTOROLA, true> kWheelSpdRearLeft;
 
-  int ret = x;
-  return ret;
-}
+// config detail: {'name': 'wheel_spd_front_right', 'offset': 0.0, 'precision':
+// 1.0, 'len': 16, 'is_signed_var': True, 'physical_range': '[-32768|32767]',
+// 'bit': 23, 'type': 'int', 'order': 'motorola', 'physical_unit': 'rad/s'}
+constexpr CanSignal<23, 16, ByteOrder::MOTOROLA, true> kWheelSpdFrontRight;
 
-// config detail: {'name': 'wheel_spd_front_right', 'offset': 0.0,
-// 'precision': 1.0, 'len': 16, 'is_signed_var': True, 'physical_range':
-// '[-32768|32767]', 'bit': 23, 'type': 'int', 'order': 'motorola',
-// 'physical_unit': 'rad/s'}
-int Wheelspeedrpt7a::wheel_spd_front_right(const std::uint8_t* bytes,
-                                           int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
+// config detail: {'name': 'wheel_spd_front_left', 'offset': 0.0, 'precision':
+// 1.0, 'len': 16, 'is_signed_var': True, 'physical_range': '[-32768|32767]',
+// 'bit': 7, 'type': 'int', 'order': 'motorola', 'physical_unit': 'rad/s'}
+constexpr CanSignal<7, 16, ByteOrder::MOTOROLA, true> kWheelSpdFrontLeft;
 
-  Byte t1(bytes + 3);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+}  // namespace
 
-  x <<= 16;
-  x >>= 16;
+Wheelspeedrpt7a::Wheelspeedrpt7a() {}
+const int32_t Wheelspeedrpt7a::ID = 0x7A;
 
-  int ret = x;
-  return ret;
+void Wheelspeedrpt7a::Parse(const std::uint8_t* bytes, int32_t length,
+                            ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_wheel_speed_rpt_7a();
+  report->set_wheel_spd_rear_right(
+      static_cast<int>(kWheelSpdRearRight.Raw(frame)));
+  report->set_wheel_spd_rear_left(
+      static_cast<int>(kWheelSpdRearLeft.Raw(frame)));
+  report->set_wheel_spd_front_right(
+      static_cast<int>(kWheelSpdFrontRight.Raw(frame)));
+  report->set_wheel_spd_front_left(
+      static_cast<int>(kWheelSpdFrontLeft.Raw(frame)));
 }
 
-// config detail: {'name': 'wheel_spd_front_left', 'offset': 0.0,
-// 'precision': 1.0, 'len': 16, 'is_signed_var': True, 'physical_range':
-// '[-32768|32767]', 'bit': 7, 'type': 'int', 'order': 'motorola',
-// 'physical_unit': 'rad/s'}
-int Wheelspeedrpt7a::wheel_spd_front_left(const std::uint8_t* bytes,
-                                          int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 1);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  x <<= 16;
-  x >>= 16;
-
-  int ret = x;
-  return ret;
-}
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -31,35 +31,6 @@ class Wheelspeedrpt7a : public ::apollo::drivers::canbus::ProtocolData<
   Wheelspeedrpt7a();
   void Parse(const std::uint8_t* bytes, int32_t length,
              ChassisDetail* chassis) const override;
-
- private:
-  // config detail: {'name': 'WHEEL_SPD_REAR_RIGHT', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 16, 'is_signed_var': True, 'physical_range':
-  // '[-32768|32767]', 'bit': 55, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'rad/s'}
-  int wheel_spd_rear_right(const std::uint8_t* bytes,
-                           const int32_t length) const;
-
-  // config detail: {'name': 'WHEEL_SPD_REAR_LEFT', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 16, 'is_signed_var': True, 'physical_range':
-  // '[-32768|32767]', 'bit': 39, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'rad/s'}
-  int wheel_spd_rear_left(const std::uint8_t* bytes,
-                          const int32_t length) const;
-
-  // config detail: {'name': 'WHEEL_SPD_FRONT_RIGHT', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 16, 'is_signed_var': True, 'physical_range':
-  // '[-32768|32767]', 'bit': 23, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'rad/s'}
-  int wheel_spd_front_right(const std::uint8_t* bytes,
-                            const int32_t length) const;
-
-  // config detail: {'name': 'WHEEL_SPD_FRONT_LEFT', 'offset': 0.0,
-  // 'precision': 1.0, 'len': 16, 'is_signed_var': True, 'physical_range':
-  // '[-32768|32767]', 'bit': 7, 'type': 'int', 'order': 'motorola',
-  // 'physical_unit': 'rad/s'}
-  int wheel_spd_front_left(const std::uint8_t* bytes,
-                           const int32_t length) const;
 };
 
 }  // namespace gem
@@ -16,44 +16,35 @@
 
 #include "modules/canbus/vehicle/gem/protocol/yaw_rate_rpt_81.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace gem {
 
-using ::apollo::drivers::canbus::Byte;
-
-Yawraterpt81::Yawraterpt81() {}
-const int32_t Yawraterpt81::ID = 0x81;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
 
-void Yawraterpt81::Parse(const std::uint8_t* bytes, int32_t length,
-                         ChassisDetail* chassis) const {
-  chassis->mutable_gem()->mutable_yaw_rate_rpt_81()->set_yaw_rate(
-      yaw_rate(bytes, length));
-}
+namespace {
 
 // config detail: {'name': 'yaw_rate', 'offset': 0.0, 'precision': 0.01, 'len':
 // 16, 'is_signed_var': True, 'physical_range': '[-327.68|327.67]', 'bit': 7,
 // 'type': 'double', 'order': 'motorola', 'physical_unit': 'rad/s'}
-double Yawraterpt81::yaw_rate(const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
+constexpr CanSignal<7, 16, ByteOrder::MOTOROLA, true> kYawRate(0.01);
 
-  Byte t1(bytes + 1);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+}  // namespace
 
-  x <<= 16;
-  x >>= 16;
+Yawraterpt81::Yawraterpt81() {}
+const int32_t Yawraterpt81::ID = 0x81;
 
-  double ret = x * 0.010000;
-  return ret;
+void Yawraterpt81::Parse(const std::uint8_t* bytes, int32_t length,
+                         ChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+  auto* report = chassis->mutable_gem()->mutable_yaw_rate_rpt_81();
+  report->set_yaw_rate(kYawRate.Decode(frame));
 }
+
 }  // namespace gem
 }  // namespace canbus
 }  // namespace apollo
@@ -31,12 +31,6 @@ class Yawraterpt81 : public ::apollo::drivers::canbus::ProtocolData<
   Yawraterpt81();
   void Parse(const std::uint8_t* bytes, int32_t length,
              ChassisDetail* chassis) const override;
-
- private:
-  // config detail: {'name': 'YAW_RATE', 'offset': 0.0, 'precision': 0.01,
-  // 'len': 16, 'is_signed_var': True, 'physical_range': '[-327.68|327.67]',
-  // 'bit': 7, 'type': 'double', 'order': 'motorola', 'physical_unit': 'rad/s'}
-  double yaw_rate(const std::uint8_t* bytes, const int32_t length) const;
 };
 
 }  // namespace gem
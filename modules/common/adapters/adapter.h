@@ -21,12 +21,14 @@
 #ifndef MODULES_ADAPTERS_ADAPTER_H_
 #define MODULES_ADAPTERS_ADAPTER_H_
 
+#include <atomic>
 #include <functional>
 #include <limits>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -35,12 +37,16 @@
 #include "google/protobuf/message.h"
 
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/adapters/shm_transport.h"
+#include "modules/common/adapters/topic_stats.h"
 #include "modules/common/proto/header.pb.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/file.h"
 #include "modules/common/util/string_util.h"
 #include "modules/common/util/util.h"
 
+#include "ros/include/ros/callback_queue.h"
+#include "ros/include/ros/ros.h"
 #include "sensor_msgs/CompressedImage.h"
 #include "sensor_msgs/Image.h"
 #include "sensor_msgs/PointCloud2.h"
@@ -101,6 +107,12 @@ class AdapterBase {
    * @brief Dumps the latest received data to file.
    */
   virtual bool DumpLatestMessage() = 0;
+
+  /**
+   * @brief Gets the statistics of the received messages, or nullptr unless
+   * FLAGS_enable_topic_stats is set.
+   */
+  virtual TopicStats* GetStats() = 0;
 };
 
 /**
@@ -152,6 +164,9 @@ class Adapter : public AdapterBase {
         message_num_(message_num),
         enable_dump_(FLAGS_enable_adapter_dump),
         dump_path_(dump_dir + "/" + adapter_name) {
+    if (FLAGS_enable_topic_stats) {
+      stats_.reset(new TopicStats());
+    }
     if (HasSequenceNumber<D>()) {
       if (!apollo::common::util::EnsureDirectory(dump_path_)) {
         AERROR << "Cannot enable dumping for '" << adapter_name
@@ -169,11 +184,72 @@ class Adapter : public AdapterBase {
     }
   }
 
+  ~Adapter() {
+    if (shm_thread_.joinable()) {
+      shm_transport_->Interrupt();
+      shm_thread_.join();
+    }
+    if (shm_callback_queue_ != nullptr) {
+      // Waits for a running callback, and drops the queued ones.
+      shm_callback_queue_->removeByID(reinterpret_cast<uint64_t>(this));
+    }
+  }
+
   /**
    * @brief returns the topic name that this adapter listens to.
    */
   const std::string& topic_name() const override { return topic_name_; }
 
+  /**
+   * @brief Passes the messages of the topic through shared memory instead of
+   * ROS, see \class ShmTransport. Received messages are deserialized from
+   * the shared memory by a thread of the adapter, and RosCallback() is then
+   * queued on the global ROS callback queue like the ROS subscriptions, or
+   * invoked by that thread if ROS is not initialized.
+   * @param num_slots the number of slots in the shared memory.
+   * @param slot_size the max size of a serialized message in bytes.
+   * @param receive whether to receive the messages of the topic.
+   * @param latch whether to receive the latest message published before,
+   * like a latched ROS topic.
+   * @return false if the shared memory cannot be used.
+   */
+  bool EnableSharedMemory(const uint32_t num_slots, const uint32_t slot_size,
+                          const bool receive, const bool latch = false) {
+    std::unique_ptr<ShmTransport> transport(
+        new ShmTransport(topic_name_, num_slots, slot_size));
+    if (!transport->Init()) {
+      return false;
+    }
+    shm_transport_ = std::move(transport);
+    if (receive) {
+      // Otherwise a restarted subscriber gets the last message again.
+      const uint64_t sequence_num =
+          latch ? 0 : shm_transport_->LatestSequenceNum();
+      if (ros::isInitialized()) {
+        shm_callback_queue_ = ros::getGlobalCallbackQueue();
+      }
+      shm_thread_ =
+          std::thread(&Adapter<D>::ShmReceiveLoop, this, sequence_num);
+    }
+    return true;
+  }
+
+  /**
+   * @brief returns TRUE if the messages pass through shared memory.
+   */
+  bool UseSharedMemory() const { return shm_transport_ != nullptr; }
+
+  /**
+   * @brief serializes the message straight into the shared memory.
+   * @return false if it is too large or all the slots are in use.
+   */
+  bool PublishSharedMemory(const D& data) {
+    const uint64_t size = MessageSize<D>(data);
+    return shm_transport_->Publish(size, [&data, size](uint8_t* buffer) {
+      return SerializeToArray<D>(data, buffer, size);
+    });
+  }
+
   /**
    * @brief reads the proto message from the file, and push it into
    * the adapter's data queue.
@@ -367,6 +443,11 @@ class Adapter : public AdapterBase {
     return false;
   }
 
+  /**
+   * @brief Gets the statistics of the received messages.
+   */
+  TopicStats* GetStats() override { return stats_.get(); }
+
  private:
   template <typename T>
   struct IdentifierType {};
@@ -468,6 +549,132 @@ class Adapter : public AdapterBase {
         message, util::StrCat(dump_path_, "/", sequence_num, ".pb.txt"));
   }
 
+  // HeaderTime returns the header timestamp of the message, or 0 if it has
+  // none.
+  template <typename T>
+  static auto HeaderTime(const T& message, int)
+      -> decltype(message.header().timestamp_sec()) {
+    return message.header().timestamp_sec();
+  }
+  template <typename T>
+  static auto HeaderTime(const T& message, int)
+      -> decltype(message.header.stamp.toSec()) {
+    return message.header.stamp.toSec();
+  }
+  template <typename T>
+  static double HeaderTime(const T& message, int64_t) {
+    return 0.0;
+  }
+
+  // MessageSize returns the serialized size of the message.
+  template <typename InputMessageType>
+  static uint64_t MessageSize(
+      const enable_if_t<std::is_base_of<google::protobuf::Message,
+                                        InputMessageType>::value,
+                        InputMessageType>& message) {
+    return message.ByteSizeLong();
+  }
+  template <typename InputMessageType>
+  static uint64_t MessageSize(
+      const enable_if_t<!std::is_base_of<google::protobuf::Message,
+                                         InputMessageType>::value,
+                        InputMessageType>& message) {
+    return ros::serialization::serializationLength(message);
+  }
+
+  // SerializeToArray serializes the message into a buffer of its size, which
+  // MessageSize() has just returned.
+  template <typename InputMessageType>
+  static bool SerializeToArray(
+      const enable_if_t<std::is_base_of<google::protobuf::Message,
+                                        InputMessageType>::value,
+                        InputMessageType>& message,
+      uint8_t* buffer, const uint64_t size) {
+    return message.SerializeWithCachedSizesToArray(buffer) == buffer + size;
+  }
+  template <typename InputMessageType>
+  static bool SerializeToArray(
+      const enable_if_t<!std::is_base_of<google::protobuf::Message,
+                                         InputMessageType>::value,
+                        InputMessageType>& message,
+      uint8_t* buffer, const uint64_t size) {
+    ros::serialization::OStream stream(buffer, static_cast<uint32_t>(size));
+    ros::serialization::serialize(stream, message);
+    return true;
+  }
+
+  // ParseFromArray deserializes the message from a buffer.
+  template <typename InputMessageType>
+  static bool ParseFromArray(
+      const uint8_t* buffer, const uint64_t size,
+      enable_if_t<std::is_base_of<google::protobuf::Message,
+                                  InputMessageType>::value,
+                  InputMessageType>* message) {
+    return message->ParseFromArray(buffer, static_cast<int>(size));
+  }
+  template <typename InputMessageType>
+  static bool ParseFromArray(
+      const uint8_t* buffer, const uint64_t size,
+      enable_if_t<!std::is_base_of<google::protobuf::Message,
+                                   InputMessageType>::value,
+                  InputMessageType>* message) {
+    // IStream only reads from the buffer.
+    ros::serialization::IStream stream(const_cast<uint8_t*>(buffer),
+                                       static_cast<uint32_t>(size));
+    ros::serialization::deserialize(stream, *message);
+    return true;
+  }
+
+  /**
+   * @class ShmCallback
+   * @brief Invokes RosCallback() with a message received from shared memory,
+   * in the thread spinning the ROS callback queue.
+   */
+  class ShmCallback : public ros::CallbackInterface {
+   public:
+    ShmCallback(Adapter<D>* adapter, DataPtr message)
+        : adapter_(adapter), message_(message) {}
+
+    CallResult call() override {
+      adapter_->RosCallback(message_);
+      return Success;
+    }
+
+   private:
+    Adapter<D>* adapter_;
+    DataPtr message_;
+  };
+
+  /**
+   * @brief Loop of the thread receiving the messages from shared memory,
+   * until the adapter is destroyed.
+   * @param sequence_num the sequence number of the last message received
+   * before.
+   */
+  void ShmReceiveLoop(uint64_t sequence_num) {
+    ShmTransport::View view;
+    // Returns false once interrupted by the destructor.
+    while (shm_transport_->WaitForLatest(sequence_num, -1, &view)) {
+      sequence_num = view.sequence_num();
+      boost::shared_ptr<D> message = boost::make_shared<D>();
+      const bool parsed =
+          ParseFromArray<D>(view.data(), view.size(), message.get());
+      view.Reset();
+      if (!parsed) {
+        AERROR << "Failed to parse message " << sequence_num << " of "
+               << topic_name_ << " from shared memory.";
+        continue;
+      }
+      if (shm_callback_queue_ != nullptr) {
+        shm_callback_queue_->addCallback(
+            boost::make_shared<ShmCallback>(this, message),
+            reinterpret_cast<uint64_t>(this));
+      } else {
+        RosCallback(message);
+      }
+    }
+  }
+
   /**
    * @brief the ROS callback that will be invoked whenever a new
    * message is received.
@@ -475,6 +682,10 @@ class Adapter : public AdapterBase {
    */
   void RosCallback(DataPtr message) {
     last_receive_time_ = apollo::common::time::Clock::NowInSeconds();
+    if (stats_) {
+      stats_->Record(last_receive_time_, HeaderTime(*message, 0),
+                     MessageSize<D>(*message));
+    }
     EnqueueData(message);
     FireCallbacks(*message);
   }
@@ -546,6 +757,15 @@ class Adapter : public AdapterBase {
 
   double last_receive_time_ = 0;
 
+  /// Statistics of the received messages, if enabled.
+  std::unique_ptr<TopicStats> stats_;
+
+  /// The shared memory of the topic, if enabled, the thread receiving from
+  /// it and the queue of the callbacks of the received messages.
+  std::unique_ptr<ShmTransport> shm_transport_;
+  std::thread shm_thread_;
+  ros::CallbackQueue* shm_callback_queue_ = nullptr;
+
   friend class AdapterManager;
 };
 
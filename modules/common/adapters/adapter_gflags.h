@@ -20,6 +20,7 @@
 #include "gflags/gflags.h"
 
 DECLARE_bool(enable_adapter_dump);
+DECLARE_bool(enable_topic_stats);
 DECLARE_string(monitor_topic);
 DECLARE_string(gps_topic);
 DECLARE_string(imu_topic);
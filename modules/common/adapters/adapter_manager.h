@@ -117,12 +117,22 @@ namespace adapter {
                             const AdapterConfig &config) {                     \
     name##_.reset(                                                             \
         new name##Adapter(#name, topic_name, config.message_history_limit())); \
-    if (config.mode() != AdapterConfig::PUBLISH_ONLY && IsRos()) {             \
+    const bool use_shared_memory =                                             \
+        config.use_shared_memory() &&                                          \
+        name##_->EnableSharedMemory(                                           \
+            config.shared_memory_slots(), config.shared_memory_slot_size(),    \
+            config.mode() != AdapterConfig::PUBLISH_ONLY, config.latch());     \
+    if (config.use_shared_memory() && !use_shared_memory) {                    \
+      AERROR << #name << " falls back to ROS without shared memory.";          \
+    }                                                                          \
+    if (config.mode() != AdapterConfig::PUBLISH_ONLY && IsRos() &&             \
+        !use_shared_memory) {                                                  \
       name##subscriber_ =                                                      \
           node_handle_->subscribe(topic_name, config.message_history_limit(),  \
                                   &name##Adapter::RosCallback, name##_.get()); \
     }                                                                          \
-    if (config.mode() != AdapterConfig::RECEIVE_ONLY && IsRos()) {             \
+    if (config.mode() != AdapterConfig::RECEIVE_ONLY && IsRos() &&             \
+        !use_shared_memory) {                                                  \
       name##publisher_ = node_handle_->advertise<name##Adapter::DataType>(     \
           topic_name, config.message_history_limit(), config.latch());         \
     }                                                                          \
@@ -132,8 +142,12 @@ namespace adapter {
   }                                                                            \
   name##Adapter *InternalGet##name() { return name##_.get(); }                 \
   void InternalPublish##name(const name##Adapter::DataType &data) {            \
-    /* Only publish ROS msg if node handle is initialized. */                  \
-    if (IsRos()) {                                                             \
+    if (name##_->UseSharedMemory()) {                                          \
+      if (!name##_->PublishSharedMemory(data)) {                               \
+        AERROR << "Failed to publish " << #name << " to shared memory.";       \
+      }                                                                        \
+    } else if (IsRos()) {                                                      \
+      /* Only publish ROS msg if node handle is initialized. */                \
       if (!name##publisher_.getTopic().empty()) {                              \
         name##publisher_.publish(data);                                        \
       } else {                                                                 \
@@ -16,7 +16,11 @@
 
 #include "modules/common/adapters/adapter.h"
 
+#include <unistd.h>
+
+#include <chrono>
 #include <cmath>
+#include <future>
 #include <string>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -164,6 +168,87 @@ TEST(AdapterTest, Dump) {
   EXPECT_TRUE(adapter.DumpLatestMessage());
 }
 
+TEST(AdapterTest, SharedMemory) {
+  FLAGS_enable_adapter_dump = false;
+  const std::string topic =
+      "/apollo/test/adapter_" + std::to_string(getpid());
+  ShmTransport::Remove(topic);
+  {
+    MyLocalizationAdapter publisher("local", topic, 3);
+    MyLocalizationAdapter subscriber("local", topic, 3);
+    ASSERT_TRUE(publisher.EnableSharedMemory(4, 4096, false));
+    ASSERT_TRUE(subscriber.EnableSharedMemory(4, 4096, true));
+    EXPECT_TRUE(subscriber.UseSharedMemory());
+
+    std::promise<double> received;
+    subscriber.AddCallback(
+        [&received](const localization::LocalizationEstimate &msg) {
+          received.set_value(msg.pose().position().x());
+        });
+
+    localization::LocalizationEstimate msg;
+    msg.mutable_pose()->mutable_position()->set_x(1.5);
+    EXPECT_TRUE(publisher.PublishSharedMemory(msg));
+    auto future = received.get_future();
+    ASSERT_EQ(std::future_status::ready,
+              future.wait_for(std::chrono::seconds(1)));
+    EXPECT_DOUBLE_EQ(1.5, future.get());
+  }
+  ShmTransport::Remove(topic);
+}
+
+TEST(AdapterTest, SharedMemoryLatch) {
+  FLAGS_enable_adapter_dump = false;
+  const std::string topic =
+      "/apollo/test/adapter_latch_" + std::to_string(getpid());
+  ShmTransport::Remove(topic);
+  {
+    MyLocalizationAdapter publisher("local", topic, 3);
+    ASSERT_TRUE(publisher.EnableSharedMemory(4, 4096, false));
+    localization::LocalizationEstimate msg;
+    msg.mutable_pose()->mutable_position()->set_x(1.5);
+    EXPECT_TRUE(publisher.PublishSharedMemory(msg));
+
+    // Like a restarted subscriber, which does not get the last message again
+    // unless latched.
+    MyLocalizationAdapter subscriber("local", topic, 3);
+    MyLocalizationAdapter latched("local", topic, 3);
+    std::promise<double> received;
+    subscriber.AddCallback(
+        [&received](const localization::LocalizationEstimate &msg) {
+          received.set_value(msg.pose().position().x());
+        });
+    std::promise<double> received_latched;
+    bool first_latched = true;
+    latched.AddCallback([&received_latched, &first_latched](
+                            const localization::LocalizationEstimate &msg) {
+      if (first_latched) {
+        first_latched = false;
+        received_latched.set_value(msg.pose().position().x());
+      }
+    });
+    // Without ROS, the callbacks are invoked by the receiving thread as soon
+    // as it starts.
+    ASSERT_TRUE(subscriber.EnableSharedMemory(4, 4096, true));
+    ASSERT_TRUE(latched.EnableSharedMemory(4, 4096, true, true));
+
+    auto future_latched = received_latched.get_future();
+    ASSERT_EQ(std::future_status::ready,
+              future_latched.wait_for(std::chrono::seconds(1)));
+    EXPECT_DOUBLE_EQ(1.5, future_latched.get());
+    auto future = received.get_future();
+    EXPECT_EQ(std::future_status::timeout,
+              future.wait_for(std::chrono::milliseconds(50)));
+
+    msg.mutable_pose()->mutable_position()->set_x(2.5);
+    EXPECT_TRUE(publisher.PublishSharedMemory(msg));
+    ASSERT_EQ(std::future_status::ready,
+              future.wait_for(std::chrono::seconds(1)));
+    EXPECT_DOUBLE_EQ(2.5, future.get());
+  }
+  ShmTransport::Remove(topic);
+}
+
 }  // namespace adapter
 }  // namespace common
 }  // namespace apollo
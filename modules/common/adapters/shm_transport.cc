@@ -0,0 +1,402 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/adapters/shm_transport.h"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+              "Atomics in shared memory must be lock free.");
+
+namespace {
+
+constexpr uint32_t kMaxNumSlots = 1 << 16;
+// The max number of Views of a slot at a time, a subscriber asking for one
+// more waits for the next message.
+constexpr int kMaxNumReaders = 16;
+constexpr size_t kAlignment = 64;
+
+enum HeaderState : uint32_t {
+  UNINITIALIZED = 0,
+  INITIALIZING = 1,
+  READY = 2,
+};
+
+size_t Align(const size_t size) {
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+uint64_t PackLatest(const uint64_t sequence_num, const uint32_t slot) {
+  return (sequence_num << 16) | slot;
+}
+
+// Waits until the word is not the expected value any more, a wake up or the
+// timeout, or forever if the timeout is negative.
+void FutexWait(std::atomic<uint32_t> *word, const uint32_t expected,
+               const std::chrono::nanoseconds timeout) {
+  struct timespec ts;
+  ts.tv_sec = timeout.count() / 1000000000;
+  ts.tv_nsec = timeout.count() % 1000000000;
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, expected,
+          timeout.count() < 0 ? nullptr : &ts, nullptr, 0);
+}
+
+void FutexWakeAll(std::atomic<uint32_t> *word) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, INT_MAX,
+          nullptr, nullptr, 0);
+}
+
+// A process of another user is alive as well, as long as it exists.
+bool IsAlive(const pid_t pid) { return kill(pid, 0) == 0 || errno != ESRCH; }
+
+}  // namespace
+
+struct ShmTransport::Header {
+  std::atomic<uint32_t> state;
+  uint32_t num_slots;
+  uint32_t slot_size;
+  // Futex word bumped on every message.
+  std::atomic<uint32_t> notify;
+  // The sequence number of the latest message packed with its slot, or 0.
+  std::atomic<uint64_t> latest;
+  // The last sequence number assigned.
+  std::atomic<uint64_t> sequence_num;
+};
+
+// The writer and the readers of a slot are recorded in words of their own,
+// so that each of them can be released at once when its process died. A
+// writer and a reader first record themselves and then check for the other,
+// so that at most one of them gets the slot.
+struct ShmTransport::Slot {
+  // The process writing the slot, or 0.
+  std::atomic<pid_t> writer;
+  // The processes holding a View of the slot, one entry per View, or 0.
+  std::atomic<pid_t> readers[kMaxNumReaders];
+  // The sequence number of the message in the slot, or 0 while it is being
+  // written.
+  std::atomic<uint64_t> sequence_num;
+  uint64_t size;
+};
+
+ShmTransport::View::View(View &&other) { *this = std::move(other); }
+
+ShmTransport::View &ShmTransport::View::operator=(View &&other) {
+  if (this != &other) {
+    Reset();
+    reader_ = other.reader_;
+    data_ = other.data_;
+    size_ = other.size_;
+    sequence_num_ = other.sequence_num_;
+    other.reader_ = nullptr;
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+void ShmTransport::View::Reset() {
+  if (reader_ != nullptr) {
+    reader_->store(0, std::memory_order_release);
+  }
+  reader_ = nullptr;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+ShmTransport::ShmTransport(const std::string &topic_name,
+                           const uint32_t num_slots, const uint32_t slot_size)
+    : segment_name_(SegmentName(topic_name)),
+      num_slots_(num_slots),
+      slot_size_(slot_size) {
+  CHECK_GT(num_slots_, 0);
+  CHECK_LE(num_slots_, kMaxNumSlots);
+  segment_size_ = Align(sizeof(Header)) +
+                  num_slots_ * (Align(sizeof(Slot)) + Align(slot_size_));
+}
+
+ShmTransport::~ShmTransport() {
+  if (segment_ != nullptr) {
+    munmap(segment_, segment_size_);
+  }
+}
+
+std::string ShmTransport::SegmentName(const std::string &topic_name) {
+  std::string name = "/";
+  for (const char c : topic_name) {
+    if (c != '/') {
+      name.push_back(c);
+    } else if (name.size() > 1) {
+      name.push_back('_');
+    }
+  }
+  return name;
+}
+
+void ShmTransport::Remove(const std::string &topic_name) {
+  shm_unlink(SegmentName(topic_name).c_str());
+}
+
+bool ShmTransport::Init() {
+  const int fd = shm_open(segment_name_.c_str(), O_RDWR | O_CREAT, 0666);
+  if (fd < 0) {
+    AERROR << "Failed to open shared memory " << segment_name_ << ": "
+           << std::strerror(errno);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    AERROR << "Failed to stat shared memory " << segment_name_ << ": "
+           << std::strerror(errno);
+    close(fd);
+    return false;
+  }
+  // The creator may not have sized it yet, sizing it twice is harmless.
+  if (st.st_size == 0 &&
+      ftruncate(fd, static_cast<off_t>(segment_size_)) != 0) {
+    AERROR << "Failed to size shared memory " << segment_name_ << ": "
+           << std::strerror(errno);
+    close(fd);
+    return false;
+  }
+  if (st.st_size != 0 && static_cast<size_t>(st.st_size) != segment_size_) {
+    AERROR << "Shared memory " << segment_name_ << " has " << st.st_size
+           << " bytes instead of " << segment_size_
+           << ", check the slot config of all the processes.";
+    close(fd);
+    return false;
+  }
+  segment_ = mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                  fd, 0);
+  close(fd);
+  if (segment_ == MAP_FAILED) {
+    AERROR << "Failed to map shared memory " << segment_name_ << ": "
+           << std::strerror(errno);
+    segment_ = nullptr;
+    return false;
+  }
+  header_ = static_cast<Header *>(segment_);
+  pid_ = getpid();
+  return InitHeader();
+}
+
+bool ShmTransport::InitHeader() {
+  // A new segment is zero filled, i.e. UNINITIALIZED.
+  uint32_t state = UNINITIALIZED;
+  if (header_->state.compare_exchange_strong(state, INITIALIZING)) {
+    header_->num_slots = num_slots_;
+    header_->slot_size = slot_size_;
+    header_->state.store(READY, std::memory_order_release);
+    return true;
+  }
+  // Another process is initializing it.
+  for (int i = 0; i < 1000; ++i) {
+    if (header_->state.load(std::memory_order_acquire) == READY) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (header_->state.load(std::memory_order_acquire) != READY) {
+    AERROR << "Shared memory " << segment_name_ << " is not initialized.";
+    return false;
+  }
+  if (header_->num_slots != num_slots_ || header_->slot_size != slot_size_) {
+    AERROR << "Shared memory " << segment_name_ << " has "
+           << header_->num_slots << " slots of " << header_->slot_size
+           << " bytes instead of " << num_slots_ << " slots of " << slot_size_
+           << " bytes.";
+    return false;
+  }
+  return true;
+}
+
+ShmTransport::Slot *ShmTransport::GetSlot(const uint32_t index) const {
+  uint8_t *slots = static_cast<uint8_t *>(segment_) + Align(sizeof(Header));
+  return reinterpret_cast<Slot *>(
+      slots + index * (Align(sizeof(Slot)) + Align(slot_size_)));
+}
+
+bool ShmTransport::LockForWriting(Slot *slot) const {
+  pid_t writer = 0;
+  if (!slot->writer.compare_exchange_strong(writer, pid_)) {
+    return false;
+  }
+  for (const auto &reader : slot->readers) {
+    if (reader.load() != 0) {
+      slot->writer.store(0, std::memory_order_release);
+      return false;
+    }
+  }
+  // Readers of the previous message do not take the slot from now on.
+  slot->sequence_num.store(0, std::memory_order_relaxed);
+  return true;
+}
+
+bool ShmTransport::LockForReading(Slot *slot, const uint64_t sequence_num,
+                                  View *view) const {
+  for (auto &reader : slot->readers) {
+    pid_t pid = 0;
+    if (!reader.compare_exchange_strong(pid, pid_)) {
+      continue;
+    }
+    if (slot->writer.load() != 0 ||
+        slot->sequence_num.load(std::memory_order_relaxed) != sequence_num) {
+      reader.store(0, std::memory_order_release);
+      return false;
+    }
+    view->reader_ = &reader;
+    view->data_ = reinterpret_cast<const uint8_t *>(slot) + Align(sizeof(Slot));
+    view->size_ = slot->size;
+    view->sequence_num_ = sequence_num;
+    return true;
+  }
+  return false;
+}
+
+void ShmTransport::Recover(Slot *slot) const {
+  pid_t writer = slot->writer.load();
+  if (writer != 0 && !IsAlive(writer) &&
+      slot->writer.compare_exchange_strong(writer, 0)) {
+    AWARN << "Recovered a slot of " << segment_name_
+          << " from dead writer process " << writer;
+  }
+  for (auto &reader : slot->readers) {
+    pid_t pid = reader.load();
+    if (pid != 0 && !IsAlive(pid) && reader.compare_exchange_strong(pid, 0)) {
+      AWARN << "Recovered a slot of " << segment_name_
+            << " from dead reader process " << pid;
+    }
+  }
+}
+
+bool ShmTransport::Publish(const size_t size,
+                           const std::function<bool(uint8_t *)> &writer) {
+  CHECK_NOTNULL(header_);
+  if (size > slot_size_) {
+    AERROR << "Message of " << size << " bytes exceeds the slots of "
+           << slot_size_ << " bytes of " << segment_name_;
+    return false;
+  }
+  Slot *slot = nullptr;
+  uint32_t index = next_slot_;
+  // Looks for the slots held by dead processes only once all are in use.
+  for (int pass = 0; pass < 2 && slot == nullptr; ++pass) {
+    for (uint32_t i = 0; i < num_slots_; ++i) {
+      index = (next_slot_ + i) % num_slots_;
+      if (pass > 0) {
+        Recover(GetSlot(index));
+      }
+      if (LockForWriting(GetSlot(index))) {
+        slot = GetSlot(index);
+        break;
+      }
+    }
+  }
+  if (slot == nullptr) {
+    AWARN << "All the slots of " << segment_name_ << " are in use.";
+    return false;
+  }
+  next_slot_ = (index + 1) % num_slots_;
+
+  uint8_t *data = reinterpret_cast<uint8_t *>(slot) + Align(sizeof(Slot));
+  if (!writer(data)) {
+    slot->writer.store(0, std::memory_order_release);
+    return false;
+  }
+  const uint64_t sequence_num = header_->sequence_num.fetch_add(1) + 1;
+  slot->size = size;
+  slot->sequence_num.store(sequence_num, std::memory_order_relaxed);
+  slot->writer.store(0, std::memory_order_release);
+
+  // With several publishers, keep the newest message as the latest one.
+  uint64_t latest = header_->latest.load(std::memory_order_relaxed);
+  while ((latest >> 16) < sequence_num &&
+         !header_->latest.compare_exchange_weak(
+             latest, PackLatest(sequence_num, index),
+             std::memory_order_release)) {
+  }
+  header_->notify.fetch_add(1, std::memory_order_release);
+  FutexWakeAll(&header_->notify);
+  return true;
+}
+
+uint64_t ShmTransport::LatestSequenceNum() const {
+  CHECK_NOTNULL(header_);
+  return header_->latest.load(std::memory_order_acquire) >> 16;
+}
+
+bool ShmTransport::WaitForLatest(const uint64_t last_sequence_num,
+                                 const int timeout_ms, View *view) {
+  CHECK_NOTNULL(header_);
+  CHECK_NOTNULL(view);
+  view->Reset();
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(timeout_ms);
+  while (!interrupted_.load()) {
+    const uint32_t notify = header_->notify.load(std::memory_order_acquire);
+    const uint64_t latest = header_->latest.load(std::memory_order_acquire);
+    const uint64_t sequence_num = latest >> 16;
+    // Otherwise the slot is being overwritten by a newer message, which
+    // bumps the notify word once it becomes the latest one.
+    if (sequence_num > last_sequence_num &&
+        LockForReading(GetSlot(static_cast<uint32_t>(latest & 0xffff)),
+                       sequence_num, view)) {
+      return true;
+    }
+    if (timeout_ms < 0) {
+      FutexWait(&header_->notify, notify, std::chrono::nanoseconds(-1));
+      continue;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      return false;
+    }
+    FutexWait(&header_->notify, notify, deadline - now);
+  }
+  return false;
+}
+
+void ShmTransport::Interrupt() {
+  interrupted_ = true;
+  if (header_ != nullptr) {
+    // Bumped so that a wait about to start returns at once, the other waiters
+    // just find no new message.
+    header_->notify.fetch_add(1, std::memory_order_release);
+    FutexWakeAll(&header_->notify);
+  }
+}
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_ADAPTERS_SHM_TRANSPORT_H_
+#define MODULES_ADAPTERS_SHM_TRANSPORT_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @namespace apollo::common::adapter
+ * @brief apollo::common::adapter
+ */
+namespace apollo {
+namespace common {
+namespace adapter {
+
+/**
+ * @class ShmTransport
+ * @brief Passes the messages of one topic between the processes of a host
+ * through a POSIX shared memory segment, instead of a socket per subscriber.
+ *
+ * The segment is a slab of fixed-size slots. The publisher serializes each
+ * message straight into a free slot, and the subscribers read it in place
+ * through a View, which holds a reference to the slot so that it is not
+ * reused until every View is released. Subscribers always get the latest
+ * message, and skip the older ones if they fall behind.
+ *
+ * The writer and the Views of a slot are recorded by process id. When all
+ * the slots are in use, the publisher takes back the ones held by processes
+ * which died writing them or holding a View of them.
+ *
+ * Whichever process opens the segment first creates it, the others attach to
+ * it, so that publishers and subscribers may start in any order. The segment
+ * outlives the processes, and is named after the topic, see SegmentName().
+ */
+class ShmTransport {
+ public:
+  /**
+   * @class View
+   * @brief A read-only view of a message in a slot of the segment, valid
+   * until the View is destroyed or reset.
+   */
+  class View {
+   public:
+    View() = default;
+    ~View() { Reset(); }
+    View(View &&other);
+    View &operator=(View &&other);
+    View(const View &) = delete;
+    View &operator=(const View &) = delete;
+
+    const uint8_t *data() const { return data_; }
+    size_t size() const { return size_; }
+    uint64_t sequence_num() const { return sequence_num_; }
+    bool empty() const { return data_ == nullptr; }
+
+    /**
+     * @brief Releases the slot to the publisher.
+     */
+    void Reset();
+
+   private:
+    friend class ShmTransport;
+
+    // The entry of the slot recording this View.
+    std::atomic<pid_t> *reader_ = nullptr;
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    uint64_t sequence_num_ = 0;
+  };
+
+  /**
+   * @param topic_name the topic of the messages.
+   * @param num_slots the number of slots in the segment.
+   * @param slot_size the max size of a serialized message in bytes.
+   */
+  ShmTransport(const std::string &topic_name, const uint32_t num_slots,
+               const uint32_t slot_size);
+  ~ShmTransport();
+
+  /**
+   * @brief Creates the segment or attaches to it.
+   * @return false if it failed, or if the existing segment has another
+   * layout.
+   */
+  bool Init();
+
+  /**
+   * @brief Publishes a message, which the writer serializes into the given
+   * buffer of the given size.
+   * @return false if the message does not fit in a slot, all the slots are
+   * in use, or the writer failed.
+   */
+  bool Publish(const size_t size, const std::function<bool(uint8_t *)> &writer);
+
+  /**
+   * @brief Waits for a message newer than last_sequence_num.
+   * @param last_sequence_num the sequence number of the last message read,
+   * or 0 for none.
+   * @param timeout_ms how long to wait for, or forever if negative.
+   * @param view output of the latest message.
+   * @return false on timeout, or once interrupted.
+   */
+  bool WaitForLatest(const uint64_t last_sequence_num, const int timeout_ms,
+                     View *view);
+
+  /**
+   * @brief The sequence number of the latest message, or 0 for none, e.g. to
+   * only wait for the messages published from now on.
+   */
+  uint64_t LatestSequenceNum() const;
+
+  /**
+   * @brief Makes the pending and later WaitForLatest() calls on this
+   * instance return false, e.g. to stop a receiving thread.
+   */
+  void Interrupt();
+
+  /**
+   * @brief The name of the segment of a topic, e.g. /apollo_sensor_camera for
+   * /apollo/sensor/camera.
+   */
+  static std::string SegmentName(const std::string &topic_name);
+
+  /**
+   * @brief Removes the segment of a topic. The processes which mapped it keep
+   * their mapping.
+   *
+   * The adapters never remove their segments, which are reused as the
+   * modules restart. It is up to tests and tools, e.g. before changing the
+   * slot config of a topic.
+   */
+  static void Remove(const std::string &topic_name);
+
+ private:
+  struct Header;
+  struct Slot;
+
+  Slot *GetSlot(const uint32_t index) const;
+  bool InitHeader();
+  bool LockForWriting(Slot *slot) const;
+  bool LockForReading(Slot *slot, const uint64_t sequence_num,
+                      View *view) const;
+  // Releases the slot from the dead processes holding it.
+  void Recover(Slot *slot) const;
+
+  const std::string segment_name_;
+  const uint32_t num_slots_;
+  const uint32_t slot_size_;
+
+  void *segment_ = nullptr;
+  size_t segment_size_ = 0;
+  Header *header_ = nullptr;
+  pid_t pid_ = 0;
+  // The slot which the next message is written to first.
+  uint32_t next_slot_ = 0;
+  std::atomic<bool> interrupted_{false};
+};
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_ADAPTERS_SHM_TRANSPORT_H_
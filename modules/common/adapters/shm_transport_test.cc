@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/adapters/shm_transport.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+class ShmTransportTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    topic_ = "/apollo/test/shm_transport_" + std::to_string(getpid());
+    ShmTransport::Remove(topic_);
+  }
+
+  void TearDown() override { ShmTransport::Remove(topic_); }
+
+  static bool Publish(const std::string &message, ShmTransport *transport) {
+    return transport->Publish(message.size(), [&message](uint8_t *buffer) {
+      std::memcpy(buffer, message.data(), message.size());
+      return true;
+    });
+  }
+
+  static std::string ToString(const ShmTransport::View &view) {
+    return std::string(reinterpret_cast<const char *>(view.data()),
+                       view.size());
+  }
+
+  std::string topic_;
+};
+
+TEST_F(ShmTransportTest, PublishAndReceive) {
+  EXPECT_EQ("/apollo_sensor_camera",
+            ShmTransport::SegmentName("/apollo/sensor/camera"));
+
+  // Two mappings of the segment, like two processes.
+  ShmTransport publisher(topic_, 4, 64);
+  ShmTransport subscriber(topic_, 4, 64);
+  ASSERT_TRUE(subscriber.Init());
+  ASSERT_TRUE(publisher.Init());
+
+  ShmTransport::View view;
+  EXPECT_FALSE(subscriber.WaitForLatest(0, 10, &view));
+  EXPECT_TRUE(view.empty());
+  EXPECT_EQ(0, subscriber.LatestSequenceNum());
+
+  EXPECT_TRUE(Publish("first", &publisher));
+  EXPECT_TRUE(Publish("second", &publisher));
+  EXPECT_EQ(2, subscriber.LatestSequenceNum());
+  ASSERT_TRUE(subscriber.WaitForLatest(0, 10, &view));
+  EXPECT_EQ("second", ToString(view));
+  EXPECT_EQ(2, view.sequence_num());
+  EXPECT_FALSE(subscriber.WaitForLatest(view.sequence_num(), 10, &view));
+
+  std::thread thread([&publisher]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    Publish("third", &publisher);
+  });
+  ASSERT_TRUE(subscriber.WaitForLatest(2, 1000, &view));
+  EXPECT_EQ("third", ToString(view));
+  thread.join();
+
+  EXPECT_FALSE(Publish(std::string(65, 'x'), &publisher));
+
+  ShmTransport other_layout(topic_, 2, 64);
+  EXPECT_FALSE(other_layout.Init());
+}
+
+TEST_F(ShmTransportTest, SlotsInUse) {
+  ShmTransport publisher(topic_, 2, 64);
+  ShmTransport subscriber(topic_, 2, 64);
+  ASSERT_TRUE(publisher.Init());
+  ASSERT_TRUE(subscriber.Init());
+
+  ShmTransport::View first;
+  ShmTransport::View second;
+  EXPECT_TRUE(Publish("first", &publisher));
+  ASSERT_TRUE(subscriber.WaitForLatest(0, 10, &first));
+  EXPECT_TRUE(Publish("second", &publisher));
+  ASSERT_TRUE(subscriber.WaitForLatest(1, 10, &second));
+
+  // Both slots are held by the views, which stay intact.
+  EXPECT_FALSE(Publish("third", &publisher));
+  EXPECT_EQ("first", ToString(first));
+  EXPECT_EQ("second", ToString(second));
+
+  first.Reset();
+  EXPECT_TRUE(Publish("third", &publisher));
+  EXPECT_EQ("second", ToString(second));
+  ShmTransport::View moved(std::move(second));
+  EXPECT_TRUE(second.empty());
+  EXPECT_EQ("second", ToString(moved));
+}
+
+TEST_F(ShmTransportTest, RecoverFromDeadProcesses) {
+  ShmTransport publisher(topic_, 1, 64);
+  ASSERT_TRUE(publisher.Init());
+  EXPECT_TRUE(Publish("first", &publisher));
+
+  // A subscriber which dies holding a view of the only slot.
+  const std::string topic = topic_;
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    ShmTransport subscriber(topic, 1, 64);
+    ShmTransport::View view;
+    _exit(subscriber.Init() && subscriber.WaitForLatest(0, 10, &view) ? 0
+                                                                        : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  ASSERT_EQ(0, WEXITSTATUS(status));
+  EXPECT_TRUE(Publish("second", &publisher));
+
+  // A publisher which dies writing the only slot.
+  pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    ShmTransport other_publisher(topic, 1, 64);
+    if (other_publisher.Init()) {
+      other_publisher.Publish(5, [](uint8_t *) -> bool { _exit(0); });
+    }
+    _exit(1);
+  }
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  ASSERT_EQ(0, WEXITSTATUS(status));
+  EXPECT_TRUE(Publish("third", &publisher));
+
+  ShmTransport subscriber(topic_, 1, 64);
+  ASSERT_TRUE(subscriber.Init());
+  ShmTransport::View view;
+  ASSERT_TRUE(subscriber.WaitForLatest(0, 10, &view));
+  EXPECT_EQ("third", ToString(view));
+  EXPECT_EQ(3, view.sequence_num());
+}
+
+TEST_F(ShmTransportTest, Interrupt) {
+  ShmTransport subscriber(topic_, 2, 64);
+  ASSERT_TRUE(subscriber.Init());
+  bool received = true;
+  std::thread thread([&subscriber, &received]() {
+    ShmTransport::View view;
+    received = subscriber.WaitForLatest(0, -1, &view);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  subscriber.Interrupt();
+  thread.join();
+  EXPECT_FALSE(received);
+}
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
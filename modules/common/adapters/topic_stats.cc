@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/adapters/topic_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+constexpr int LogHistogram::kSubBucketBits;
+constexpr int LogHistogram::kNumBuckets;
+
+int LogHistogram::BucketIndex(const uint64_t value) {
+  constexpr uint64_t kSubBucketCount = uint64_t{1} << kSubBucketBits;
+  if (value < kSubBucketCount) {
+    return static_cast<int>(value);
+  }
+  const int msb = 63 - __builtin_clzll(value);
+  const int shift = msb - kSubBucketBits;
+  return ((shift + 1) << kSubBucketBits) +
+         static_cast<int>((value >> shift) & (kSubBucketCount - 1));
+}
+
+uint64_t LogHistogram::BucketUpperBound(const int index) {
+  constexpr int kSubBucketCount = 1 << kSubBucketBits;
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const int shift = (index >> kSubBucketBits) - 1;
+  const uint64_t lower =
+      static_cast<uint64_t>(kSubBucketCount + (index & (kSubBucketCount - 1)))
+      << shift;
+  return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void LogHistogram::Add(const uint64_t value) {
+  ++counts_[BucketIndex(value)];
+  ++count_;
+  sum_ += value;
+  max_ = std::max(max_, value);
+}
+
+void LogHistogram::Clear() {
+  counts_.fill(0);
+  count_ = 0;
+  sum_ = 0;
+  max_ = 0;
+}
+
+double LogHistogram::mean() const {
+  return count_ == 0 ? 0.0 : static_cast<double>(sum_) / count_;
+}
+
+uint64_t LogHistogram::Percentile(const double q) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_))));
+  uint64_t seen = 0;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return std::min(BucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+void TopicStats::Record(const double receive_time, const double header_time,
+                        const uint64_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (last_receive_time_ > 0.0 && receive_time >= last_receive_time_) {
+    window_.interval_us.Add(
+        std::llround((receive_time - last_receive_time_) * 1e6));
+  }
+  last_receive_time_ = receive_time;
+  // Messages stamped in the future, e.g. by a host with a skewed clock, have
+  // no meaningful latency.
+  if (header_time > 0.0 && receive_time >= header_time) {
+    window_.latency_us.Add(std::llround((receive_time - header_time) * 1e6));
+  }
+  window_.size_bytes.Add(size);
+}
+
+void TopicStats::TakeSnapshot(const double current_time, Snapshot *snapshot) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  *snapshot = window_;
+  snapshot->window_sec =
+      window_start_time_ > 0.0 ? current_time - window_start_time_ : 0.0;
+  window_.interval_us.Clear();
+  window_.latency_us.Clear();
+  window_.size_bytes.Clear();
+  window_start_time_ = current_time;
+}
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
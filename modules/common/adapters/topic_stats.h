@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_ADAPTERS_TOPIC_STATS_H_
+#define MODULES_ADAPTERS_TOPIC_STATS_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @namespace apollo::common::adapter
+ * @brief apollo::common::adapter
+ */
+namespace apollo {
+namespace common {
+namespace adapter {
+
+/**
+ * @class LogHistogram
+ * @brief A histogram of non-negative integers with a fixed relative error,
+ * like an HDR histogram. Values below 16 have their own buckets, and every
+ * power of 2 above is split into 16 buckets, so that percentiles are within
+ * 1/16 of the true value, with a fixed size and no allocation.
+ */
+class LogHistogram {
+ public:
+  LogHistogram() { Clear(); }
+
+  void Add(const uint64_t value);
+
+  void Clear();
+
+  uint64_t count() const { return count_; }
+  uint64_t max() const { return max_; }
+  double mean() const;
+
+  /**
+   * @brief Gets the value which the fraction q of the values is below, e.g.
+   * 0.99 for the 99th percentile. It is 0 if the histogram is empty.
+   */
+  uint64_t Percentile(const double q) const;
+
+ private:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr int kNumBuckets = (64 - kSubBucketBits + 1)
+                                     << kSubBucketBits;
+
+  static int BucketIndex(const uint64_t value);
+  static uint64_t BucketUpperBound(const int index);
+
+  std::array<uint32_t, kNumBuckets> counts_;
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t max_ = 0;
+};
+
+/**
+ * @class TopicStats
+ * @brief Streaming statistics of the messages received on a topic: the
+ * inter-arrival time and the header-to-receive latency in microseconds, and
+ * the message size in bytes. Thread-safe.
+ */
+class TopicStats {
+ public:
+  struct Snapshot {
+    // Duration of the window the snapshot covers, in seconds.
+    double window_sec = 0.0;
+    LogHistogram interval_us;
+    LogHistogram latency_us;
+    LogHistogram size_bytes;
+  };
+
+  /**
+   * @brief Records a message.
+   * @param receive_time the time the message was received, in seconds.
+   * @param header_time the timestamp of the message header, in seconds, or 0
+   * if it has none.
+   * @param size the size of the message in bytes.
+   */
+  void Record(const double receive_time, const double header_time,
+              const uint64_t size);
+
+  /**
+   * @brief Takes the statistics of the messages received since the last
+   * snapshot, and starts a new window.
+   * @param current_time the current time, in seconds.
+   * @param snapshot output of the statistics.
+   */
+  void TakeSnapshot(const double current_time, Snapshot *snapshot);
+
+ private:
+  std::mutex mutex_;
+  Snapshot window_;
+  double window_start_time_ = 0.0;
+  double last_receive_time_ = 0.0;
+};
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_ADAPTERS_TOPIC_STATS_H_
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/adapters/topic_stats.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+TEST(LogHistogramTest, Percentile) {
+  LogHistogram histogram;
+  EXPECT_EQ(0, histogram.Percentile(0.5));
+
+  for (uint64_t value = 1; value <= 1000; ++value) {
+    histogram.Add(value);
+  }
+  EXPECT_EQ(1000, histogram.count());
+  EXPECT_EQ(1000, histogram.max());
+  EXPECT_DOUBLE_EQ(500.5, histogram.mean());
+  for (const double q : {0.01, 0.5, 0.9, 0.99}) {
+    const double expected = q * 1000.0;
+    EXPECT_GE(histogram.Percentile(q), expected);
+    EXPECT_LE(histogram.Percentile(q), expected * (1.0 + 1.0 / 16.0));
+  }
+  EXPECT_EQ(1000, histogram.Percentile(1.0));
+
+  histogram.Add(uint64_t{1} << 62);
+  EXPECT_EQ(uint64_t{1} << 62, histogram.Percentile(1.0));
+
+  histogram.Clear();
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(0, histogram.Percentile(0.99));
+}
+
+TEST(TopicStatsTest, Snapshot) {
+  TopicStats stats;
+  TopicStats::Snapshot snapshot;
+  stats.TakeSnapshot(100.0, &snapshot);
+  EXPECT_EQ(0, snapshot.size_bytes.count());
+
+  // 10Hz with 5ms of latency, and a message stamped in the future.
+  for (int i = 1; i <= 10; ++i) {
+    stats.Record(100.0 + i * 0.1, 100.0 + i * 0.1 - 0.005, 1000);
+  }
+  stats.Record(101.1, 102.0, 2000);
+  stats.TakeSnapshot(101.1, &snapshot);
+  EXPECT_NEAR(1.1, snapshot.window_sec, 1e-9);
+  EXPECT_EQ(11, snapshot.size_bytes.count());
+  EXPECT_EQ(2000, snapshot.size_bytes.max());
+  EXPECT_EQ(10, snapshot.interval_us.count());
+  EXPECT_NEAR(100000, snapshot.interval_us.Percentile(0.5), 100000 / 16);
+  EXPECT_EQ(10, snapshot.latency_us.count());
+  EXPECT_NEAR(5000, snapshot.latency_us.Percentile(0.99), 5000 / 16);
+
+  // A new window.
+  stats.TakeSnapshot(102.0, &snapshot);
+  EXPECT_EQ(0, snapshot.size_bytes.count());
+}
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
@@ -22,7 +22,12 @@
 #ifndef MODULES_COMMON_MATH_LINEAR_QUADRATIC_REGULATOR_H_
 #define MODULES_COMMON_MATH_LINEAR_QUADRATIC_REGULATOR_H_
 
+#include <limits>
+
 #include "Eigen/Core"
+#include "Eigen/Dense"
+
+#include "modules/common/log.h"
 
 /**
  * @namespace apollo::common::math
@@ -48,6 +53,72 @@ void SolveLQRProblem(const Eigen::MatrixXd &A, const Eigen::MatrixXd &B,
                      const double tolerance, const uint max_num_iteration,
                      Eigen::MatrixXd *ptr_K);
 
+/**
+ * @brief Solver for discrete-time linear quadratic problem, warm-started
+ *        from a previous solution of the Riccati equation. With fixed N and M
+ *        all matrices live on the stack; Eigen::Dynamic is accepted as well.
+ * @param A The system dynamic matrix
+ * @param B The control matrix
+ * @param Q The cost matrix for system state
+ * @param R The cost matrix for control output
+ * @param tolerance The numerical tolerance for solving
+ *        Algebraic Riccati equation (ARE)
+ * @param max_num_iteration The maximum iterations for solving ARE
+ * @param ptr_P The ARE solution (pointer). On input the initial guess, e.g.
+ *        the solution of the previous control cycle; an empty or all-zero
+ *        matrix starts from Q. On output the last iterate.
+ * @param ptr_K The feedback control matrix (pointer)
+ * @return The number of iterations performed
+ */
+template <int N, int M>
+uint SolveLQRProblem(const Eigen::Matrix<double, N, N> &A,
+                     const Eigen::Matrix<double, N, M> &B,
+                     const Eigen::Matrix<double, N, N> &Q,
+                     const Eigen::Matrix<double, M, M> &R,
+                     const double tolerance, const uint max_num_iteration,
+                     Eigen::Matrix<double, N, N> *ptr_P,
+                     Eigen::Matrix<double, M, N> *ptr_K) {
+  typedef Eigen::Matrix<double, N, N> MatrixNN;
+  typedef Eigen::Matrix<double, M, N> MatrixMN;
+
+  if (A.rows() != A.cols() || B.rows() != A.rows() || Q.rows() != Q.cols() ||
+      Q.rows() != A.rows() || R.rows() != R.cols() || R.rows() != B.cols()) {
+    AERROR << "LQR solver: one or more matrices have incompatible dimensions.";
+    return 0;
+  }
+
+  MatrixNN &P = *ptr_P;
+  if (P.rows() != A.rows() || P.cols() != A.cols() || P.isZero(0.0)) {
+    P = Q;
+  }
+
+  const MatrixMN BT = B.transpose();
+  uint num_iteration = 0;
+  double diff = std::numeric_limits<double>::max();
+  while (num_iteration < max_num_iteration && diff > tolerance) {
+    ++num_iteration;
+    const MatrixNN AT_P = A.transpose() * P;
+    const MatrixMN BT_P = BT * P;
+    // (R + B'PB)^-1 * B'PA, solved through a factorization
+    const MatrixMN K = (R + BT_P * B).ldlt().solve(BT_P * A);
+    const MatrixNN P_next = AT_P * A - AT_P * B * K + Q;
+    diff = (P_next - P).cwiseAbs().maxCoeff();
+    P = P_next;
+  }
+
+  if (diff > tolerance) {
+    AWARN << "LQR solver cannot converge to a solution, "
+             "last consecutive result diff. is:"
+          << diff;
+  } else {
+    ADEBUG << "LQR solver converged at iteration: " << num_iteration
+           << ", max consecutive result diff.: " << diff;
+  }
+  const MatrixMN BT_P = BT * P;
+  *ptr_K = (R + BT_P * B).ldlt().solve(BT_P * A);
+  return num_iteration;
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
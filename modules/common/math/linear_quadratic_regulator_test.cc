@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/linear_quadratic_regulator.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// Discretized lateral error dynamics in the shape used by the control module.
+void BuildLateralModel(const double v, Eigen::Matrix<double, 4, 4> *A,
+                       Eigen::Matrix<double, 4, 1> *B) {
+  const double ts = 0.01;
+  const double cf = 155494.663;
+  const double cr = 155494.663;
+  const double mass = 2080.0;
+  const double lf = 1.42;
+  const double lr = 1.43;
+  const double iz = lf * lf * 1040.0 + lr * lr * 1040.0;
+
+  Eigen::Matrix<double, 4, 4> a = Eigen::Matrix<double, 4, 4>::Zero();
+  a(0, 1) = 1.0;
+  a(1, 1) = -(cf + cr) / mass / v;
+  a(1, 2) = (cf + cr) / mass;
+  a(1, 3) = (lr * cr - lf * cf) / mass / v;
+  a(2, 3) = 1.0;
+  a(3, 1) = (lr * cr - lf * cf) / iz / v;
+  a(3, 2) = (lf * cf - lr * cr) / iz;
+  a(3, 3) = -1.0 * (lf * lf * cf + lr * lr * cr) / iz / v;
+  const Eigen::Matrix<double, 4, 4> I = Eigen::Matrix<double, 4, 4>::Identity();
+  *A = (I - ts * 0.5 * a).inverse() * (I + ts * 0.5 * a);
+
+  B->setZero();
+  (*B)(1, 0) = cf / mass * ts;
+  (*B)(3, 0) = lf * cf / iz * ts;
+}
+
+}  // namespace
+
+TEST(LinearQuadraticRegulatorTest, FixedSizeMatchesDynamic) {
+  Eigen::Matrix<double, 4, 4> A;
+  Eigen::Matrix<double, 4, 1> B;
+  BuildLateralModel(10.0, &A, &B);
+  Eigen::Matrix<double, 4, 4> Q = Eigen::Matrix<double, 4, 4>::Zero();
+  Q(0, 0) = 0.05;
+  Q(2, 2) = 1.0;
+  Eigen::Matrix<double, 1, 1> R = Eigen::Matrix<double, 1, 1>::Identity();
+
+  Eigen::MatrixXd K_dynamic;
+  SolveLQRProblem(Eigen::MatrixXd(A), Eigen::MatrixXd(B), Eigen::MatrixXd(Q),
+                  Eigen::MatrixXd(R), 1e-10, 100000, &K_dynamic);
+
+  Eigen::Matrix<double, 4, 4> P = Eigen::Matrix<double, 4, 4>::Zero();
+  Eigen::Matrix<double, 1, 4> K;
+  SolveLQRProblem(A, B, Q, R, 1e-10, 100000, &P, &K);
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NEAR(K_dynamic(0, i), K(0, i), 1e-6);
+  }
+}
+
+TEST(LinearQuadraticRegulatorTest, WarmStart) {
+  Eigen::Matrix<double, 4, 4> A;
+  Eigen::Matrix<double, 4, 1> B;
+  Eigen::Matrix<double, 4, 4> Q = Eigen::Matrix<double, 4, 4>::Zero();
+  Q(0, 0) = 0.05;
+  Q(2, 2) = 1.0;
+  Eigen::Matrix<double, 1, 1> R = Eigen::Matrix<double, 1, 1>::Identity();
+
+  BuildLateralModel(10.0, &A, &B);
+  Eigen::Matrix<double, 4, 4> P = Eigen::Matrix<double, 4, 4>::Zero();
+  Eigen::Matrix<double, 1, 4> K;
+  const uint cold_iterations = SolveLQRProblem(A, B, Q, R, 1e-6, 10000, &P, &K);
+
+  // a slightly different speed, as in the next control cycle
+  BuildLateralModel(10.1, &A, &B);
+  Eigen::Matrix<double, 4, 4> P_cold = Eigen::Matrix<double, 4, 4>::Zero();
+  Eigen::Matrix<double, 1, 4> K_cold;
+  SolveLQRProblem(A, B, Q, R, 1e-6, 10000, &P_cold, &K_cold);
+  const uint warm_iterations = SolveLQRProblem(A, B, Q, R, 1e-6, 10000, &P, &K);
+
+  EXPECT_LT(warm_iterations, cold_iterations);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NEAR(K_cold(0, i), K(0, i), 1e-3);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,544 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file: admm_qp_solver.cc
+ **/
+
+#include "modules/common/math/qp_solver/admm_qp_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using SparseMatrix = Eigen::SparseMatrix<double>;
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+// bounds beyond this value are treated as infinite
+constexpr double kMaxFiniteBound = 1e20;
+constexpr double kRhoMin = 1e-6;
+constexpr double kRhoMax = 1e6;
+// equality rows use a stiffer penalty, as in OSQP
+constexpr double kRhoEqualityScale = 1e3;
+constexpr double kEqualityTolerance = 1e-4;
+constexpr int kRhoUpdateInterval = 25;
+constexpr double kRhoUpdateRatio = 5.0;
+constexpr int kPolishIterations = 10;
+constexpr int kScalingIterations = 10;
+constexpr double kMinScaling = 1e-4;
+constexpr double kMaxScaling = 1e4;
+
+double ClampScaling(const double norm) {
+  if (norm < kMinScaling) {
+    return 1.0;
+  }
+  return std::min(norm, kMaxScaling);
+}
+
+double InfNorm(const VectorXd& v) {
+  return v.size() == 0 ? 0.0 : v.lpNorm<Eigen::Infinity>();
+}
+
+}  // namespace
+
+void AdmmQpSolver::Reset() {
+  x_.resize(0);
+  z_.resize(0);
+  y_.resize(0);
+  solution_.resize(0);
+  outer_index_.clear();
+  inner_index_.clear();
+  has_factorization_ = false;
+  num_symbolic_factorizations_ = 0;
+  rho_ = initial_rho_;
+}
+
+void AdmmQpSolver::Scale(SparseMatrix* P, VectorXd* q, SparseMatrix* A) {
+  const int n = P->rows();
+  const int m = A->rows();
+  scale_d_ = VectorXd::Ones(n);
+  scale_e_ = VectorXd::Ones(m);
+  scale_c_ = 1.0;
+
+  VectorXd d(n);
+  VectorXd e(m);
+  for (int iter = 0; iter < kScalingIterations; ++iter) {
+    // inf norms of the columns of the KKT matrix [P A'; A 0]
+    d.setZero();
+    e.setZero();
+    for (int k = 0; k < P->outerSize(); ++k) {
+      for (SparseMatrix::InnerIterator it(*P, k); it; ++it) {
+        d(it.col()) = std::max(d(it.col()), std::fabs(it.value()));
+      }
+    }
+    for (int k = 0; k < A->outerSize(); ++k) {
+      for (SparseMatrix::InnerIterator it(*A, k); it; ++it) {
+        d(it.col()) = std::max(d(it.col()), std::fabs(it.value()));
+        e(it.row()) = std::max(e(it.row()), std::fabs(it.value()));
+      }
+    }
+    for (int i = 0; i < n; ++i) {
+      d(i) = 1.0 / std::sqrt(ClampScaling(d(i)));
+    }
+    for (int i = 0; i < m; ++i) {
+      e(i) = 1.0 / std::sqrt(ClampScaling(e(i)));
+    }
+
+    for (int k = 0; k < P->outerSize(); ++k) {
+      for (SparseMatrix::InnerIterator it(*P, k); it; ++it) {
+        it.valueRef() *= d(it.row()) * d(it.col());
+      }
+    }
+    for (int k = 0; k < A->outerSize(); ++k) {
+      for (SparseMatrix::InnerIterator it(*A, k); it; ++it) {
+        it.valueRef() *= e(it.row()) * d(it.col());
+      }
+    }
+    *q = q->cwiseProduct(d);
+    scale_d_ = scale_d_.cwiseProduct(d);
+    scale_e_ = scale_e_.cwiseProduct(e);
+
+    // cost scaling
+    VectorXd column_norm = VectorXd::Zero(n);
+    for (int k = 0; k < P->outerSize(); ++k) {
+      for (SparseMatrix::InnerIterator it(*P, k); it; ++it) {
+        column_norm(it.col()) =
+            std::max(column_norm(it.col()), std::fabs(it.value()));
+      }
+    }
+    const double mean_norm = n > 0 ? column_norm.mean() : 0.0;
+    const double gamma =
+        1.0 / ClampScaling(std::max(mean_norm, InfNorm(*q)));
+    *P *= gamma;
+    *q *= gamma;
+    scale_c_ *= gamma;
+  }
+}
+
+void AdmmQpSolver::UpdateRhoVector(const VectorXd& l, const VectorXd& u) {
+  rho_vec_.resize(l.size());
+  for (int i = 0; i < l.size(); ++i) {
+    if (l(i) == -kInfinity && u(i) == kInfinity) {
+      rho_vec_(i) = kRhoMin;
+    } else if (u(i) - l(i) < kEqualityTolerance) {
+      rho_vec_(i) = kRhoEqualityScale * rho_;
+    } else {
+      rho_vec_(i) = rho_;
+    }
+  }
+}
+
+bool AdmmQpSolver::SamePattern(const SparseMatrix& matrix) const {
+  if (!has_factorization_ ||
+      static_cast<int>(outer_index_.size()) != matrix.outerSize() + 1 ||
+      static_cast<int>(inner_index_.size()) != matrix.nonZeros()) {
+    return false;
+  }
+  return std::equal(outer_index_.begin(), outer_index_.end(),
+                    matrix.outerIndexPtr()) &&
+         std::equal(inner_index_.begin(), inner_index_.end(),
+                    matrix.innerIndexPtr());
+}
+
+bool AdmmQpSolver::Factorize(const SparseMatrix& P, const SparseMatrix& A) {
+  SparseMatrix rho_a = A;
+  for (int k = 0; k < rho_a.outerSize(); ++k) {
+    for (SparseMatrix::InnerIterator it(rho_a, k); it; ++it) {
+      it.valueRef() *= rho_vec_(it.row());
+    }
+  }
+  SparseMatrix identity(P.rows(), P.cols());
+  identity.setIdentity();
+  SparseMatrix kkt =
+      SparseMatrix(A.transpose()) * rho_a + P + sigma_ * identity;
+  kkt.makeCompressed();
+
+  if (!SamePattern(kkt)) {
+    ldlt_.analyzePattern(kkt);
+    outer_index_.assign(kkt.outerIndexPtr(),
+                        kkt.outerIndexPtr() + kkt.outerSize() + 1);
+    inner_index_.assign(kkt.innerIndexPtr(),
+                        kkt.innerIndexPtr() + kkt.nonZeros());
+    has_factorization_ = true;
+    ++num_symbolic_factorizations_;
+  }
+  ldlt_.factorize(kkt);
+  if (ldlt_.info() != Eigen::Success) {
+    AERROR << "ADMM QP solver failed to factorize the linear system.";
+    has_factorization_ = false;
+    return false;
+  }
+  return true;
+}
+
+bool AdmmQpSolver::Solve(const SparseMatrix& P, const VectorXd& q,
+                         const SparseMatrix& A, const VectorXd& l,
+                         const VectorXd& u) {
+  const int n = P.rows();
+  const int m = A.rows();
+  if (P.cols() != n || q.size() != n || A.cols() != n || l.size() != m ||
+      u.size() != m) {
+    AERROR << "ADMM QP solver: inconsistent problem dimensions.";
+    return false;
+  }
+
+  SparseMatrix p_scaled = P;
+  SparseMatrix a_scaled = A;
+  VectorXd q_scaled = q;
+  Scale(&p_scaled, &q_scaled, &a_scaled);
+
+  VectorXd l_scaled(m);
+  VectorXd u_scaled(m);
+  for (int i = 0; i < m; ++i) {
+    l_scaled(i) =
+        l(i) < -kMaxFiniteBound ? -kInfinity : l(i) * scale_e_(i);
+    u_scaled(i) = u(i) > kMaxFiniteBound ? kInfinity : u(i) * scale_e_(i);
+  }
+
+  // warm start from the previous solution
+  VectorXd x = VectorXd::Zero(n);
+  VectorXd z = VectorXd::Zero(m);
+  VectorXd y = VectorXd::Zero(m);
+  if (x_.size() == n && z_.size() == m && y_.size() == m) {
+    x = x_.cwiseQuotient(scale_d_);
+    z = z_.cwiseProduct(scale_e_);
+    y = scale_c_ * y_.cwiseQuotient(scale_e_);
+  }
+
+  UpdateRhoVector(l_scaled, u_scaled);
+  if (!Factorize(p_scaled, a_scaled)) {
+    return false;
+  }
+
+  const SparseMatrix a_transpose = a_scaled.transpose();
+  bool converged = false;
+  for (num_iterations_ = 1; num_iterations_ <= max_iteration_;
+       ++num_iterations_) {
+    const VectorXd rhs = sigma_ * x - q_scaled +
+                         a_transpose * (rho_vec_.cwiseProduct(z) - y);
+    const VectorXd x_tilde = ldlt_.solve(rhs);
+    const VectorXd z_tilde = a_scaled * x_tilde;
+
+    x = alpha_ * x_tilde + (1.0 - alpha_) * x;
+    const VectorXd z_relaxed = alpha_ * z_tilde + (1.0 - alpha_) * z;
+    z = (z_relaxed + y.cwiseQuotient(rho_vec_))
+            .cwiseMax(l_scaled)
+            .cwiseMin(u_scaled);
+    y += rho_vec_.cwiseProduct(z_relaxed - z);
+
+    double prim_residual = 0.0;
+    double prim_norm = 0.0;
+    double dual_residual = 0.0;
+    double dual_norm = 0.0;
+    ComputeResiduals(p_scaled, q_scaled, a_scaled, x, z, y, &prim_residual,
+                     &prim_norm, &dual_residual, &dual_norm);
+    if (prim_residual <= eps_abs_ + eps_rel_ * prim_norm &&
+        dual_residual <= eps_abs_ + eps_rel_ * dual_norm) {
+      converged = true;
+      break;
+    }
+
+    // balance the residuals, only the numeric factorization is redone
+    if (num_iterations_ % kRhoUpdateInterval == 0) {
+      const double ratio =
+          std::sqrt((prim_residual / (prim_norm + 1e-10)) /
+                    (dual_residual / (dual_norm + 1e-10) + 1e-10));
+      const double new_rho = std::min(std::max(rho_ * ratio, kRhoMin), kRhoMax);
+      if (new_rho > rho_ * kRhoUpdateRatio ||
+          new_rho < rho_ / kRhoUpdateRatio) {
+        rho_ = new_rho;
+        UpdateRhoVector(l_scaled, u_scaled);
+        if (!Factorize(p_scaled, a_scaled)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  if (!converged) {
+    AERROR << "ADMM QP solver did not converge in " << max_iteration_
+           << " iterations.";
+    num_iterations_ = max_iteration_;
+    // do not warm start the next solve from a diverged point
+    x_.resize(0);
+    z_.resize(0);
+    y_.resize(0);
+    solution_ = x.cwiseProduct(scale_d_);
+    return false;
+  }
+
+  // the unpolished iterates are kept as warm start, they are consistent
+  // with the ADMM fixed point
+  x_ = x.cwiseProduct(scale_d_);
+  z_ = z.cwiseQuotient(scale_e_);
+  y_ = y.cwiseProduct(scale_e_) / scale_c_;
+
+  Polish(p_scaled, q_scaled, a_scaled, l_scaled, u_scaled, &x, &z, &y);
+  solution_ = x.cwiseProduct(scale_d_);
+  return true;
+}
+
+bool AdmmQpSolver::Solve(const MatrixXd& kernel_matrix, const MatrixXd& offset,
+                         const MatrixXd& inequality_matrix,
+                         const MatrixXd& inequality_boundary,
+                         const MatrixXd& equality_matrix,
+                         const MatrixXd& equality_boundary,
+                         const double param_bound,
+                         const double constraint_bound) {
+  const int n = kernel_matrix.rows();
+  const int num_equality = equality_matrix.rows();
+  const int num_inequality = inequality_matrix.rows();
+  if (kernel_matrix.cols() != n || offset.rows() != n ||
+      (num_equality > 0 && equality_matrix.cols() != n) ||
+      (num_inequality > 0 && inequality_matrix.cols() != n) ||
+      equality_boundary.rows() != num_equality ||
+      inequality_boundary.rows() != num_inequality) {
+    AERROR << "ADMM QP solver: inconsistent problem dimensions.";
+    return false;
+  }
+
+  // the kernels are assembled densely, only their non-zeros are kept
+  const MatrixXd symmetric_kernel =
+      0.5 * (kernel_matrix + kernel_matrix.transpose());
+  const SparseMatrix P = symmetric_kernel.sparseView();
+  const VectorXd q = offset.col(0);
+
+  const int m = num_equality + num_inequality + n;
+  std::vector<Eigen::Triplet<double>> triplets;
+  VectorXd l(m);
+  VectorXd u(m);
+  int row = 0;
+  for (int r = 0; r < num_equality; ++r, ++row) {
+    for (int c = 0; c < n; ++c) {
+      if (equality_matrix(r, c) != 0.0) {
+        triplets.emplace_back(row, c, equality_matrix(r, c));
+      }
+    }
+    l(row) = equality_boundary(r, 0);
+    u(row) = equality_boundary(r, 0);
+  }
+  for (int r = 0; r < num_inequality; ++r, ++row) {
+    for (int c = 0; c < n; ++c) {
+      if (inequality_matrix(r, c) != 0.0) {
+        triplets.emplace_back(row, c, inequality_matrix(r, c));
+      }
+    }
+    l(row) = inequality_boundary(r, 0);
+    u(row) = constraint_bound;
+  }
+  for (int c = 0; c < n; ++c, ++row) {
+    triplets.emplace_back(row, c, 1.0);
+    l(row) = -param_bound;
+    u(row) = param_bound;
+  }
+  SparseMatrix A(m, n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+
+  return Solve(P, q, A, l, u);
+}
+
+void AdmmQpSolver::ComputeResiduals(const SparseMatrix& P, const VectorXd& q,
+                                    const SparseMatrix& A, const VectorXd& x,
+                                    const VectorXd& z, const VectorXd& y,
+                                    double* prim_residual, double* prim_norm,
+                                    double* dual_residual,
+                                    double* dual_norm) const {
+  // residuals of the unscaled problem
+  const VectorXd ax = A * x;
+  const VectorXd px = P * x;
+  const VectorXd aty = A.transpose() * y;
+  *prim_residual = InfNorm((ax - z).cwiseQuotient(scale_e_));
+  *prim_norm = std::max(InfNorm(ax.cwiseQuotient(scale_e_)),
+                        InfNorm(z.cwiseQuotient(scale_e_)));
+  *dual_residual =
+      InfNorm((px + q + aty).cwiseQuotient(scale_d_)) / scale_c_;
+  *dual_norm = std::max(std::max(InfNorm(px.cwiseQuotient(scale_d_)),
+                                 InfNorm(aty.cwiseQuotient(scale_d_))),
+                        InfNorm(q.cwiseQuotient(scale_d_))) /
+               scale_c_;
+}
+
+bool AdmmQpSolver::SolveActiveSet(const SparseMatrix& P, const VectorXd& q,
+                                  const SparseMatrix& A, const VectorXd& l,
+                                  const VectorXd& u,
+                                  const std::vector<int>& status, VectorXd* x,
+                                  VectorXd* y) const {
+  const int n = P.rows();
+  const int m = A.rows();
+  std::vector<int> active_index(m, -1);
+  std::vector<int> active_rows;
+  for (int i = 0; i < m; ++i) {
+    if (status[i] != 0) {
+      active_index[i] = active_rows.size();
+      active_rows.push_back(i);
+    }
+  }
+  const int num_active = active_rows.size();
+
+  // regularized KKT system [P + delta * I, A'; A, -delta * I]
+  constexpr double kDelta = 1e-6;
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int k = 0; k < P.outerSize(); ++k) {
+    for (SparseMatrix::InnerIterator it(P, k); it; ++it) {
+      triplets.emplace_back(it.row(), it.col(), it.value());
+    }
+  }
+  for (int k = 0; k < A.outerSize(); ++k) {
+    for (SparseMatrix::InnerIterator it(A, k); it; ++it) {
+      const int row = active_index[it.row()];
+      if (row >= 0) {
+        triplets.emplace_back(n + row, it.col(), it.value());
+        triplets.emplace_back(it.col(), n + row, it.value());
+      }
+    }
+  }
+  SparseMatrix kkt(n + num_active, n + num_active);
+  kkt.setFromTriplets(triplets.begin(), triplets.end());
+  SparseMatrix regularization(n + num_active, n + num_active);
+  for (int i = 0; i < n + num_active; ++i) {
+    regularization.insert(i, i) = i < n ? kDelta : -kDelta;
+  }
+  const SparseMatrix regularized_kkt = kkt + regularization;
+
+  Eigen::SimplicialLDLT<SparseMatrix> ldlt(regularized_kkt);
+  if (ldlt.info() != Eigen::Success) {
+    ADEBUG << "ADMM QP solver: polishing factorization failed.";
+    return false;
+  }
+  VectorXd rhs(n + num_active);
+  rhs.head(n) = -q;
+  for (int k = 0; k < num_active; ++k) {
+    const int i = active_rows[k];
+    rhs(n + k) = status[i] < 0 ? l(i) : u(i);
+  }
+  // iterative refinement against the unregularized system
+  VectorXd solution = ldlt.solve(rhs);
+  constexpr int kRefinementIterations = 3;
+  for (int i = 0; i < kRefinementIterations; ++i) {
+    const VectorXd residual = rhs - kkt * solution;
+    solution += ldlt.solve(residual);
+  }
+
+  *x = solution.head(n);
+  *y = VectorXd::Zero(m);
+  for (int k = 0; k < num_active; ++k) {
+    (*y)(active_rows[k]) = solution(n + k);
+  }
+  return true;
+}
+
+bool AdmmQpSolver::UpdateActiveSet(const SparseMatrix& A, const VectorXd& l,
+                                   const VectorXd& u, const VectorXd& x,
+                                   const VectorXd& y,
+                                   std::vector<int>* status) const {
+  const VectorXd ax = A * x;
+  bool changed = false;
+  for (int i = 0; i < A.rows(); ++i) {
+    int row_status = (*status)[i];
+    const bool is_equality = u(i) - l(i) < kEqualityTolerance;
+    if (row_status == 0) {
+      if (ax(i) < l(i) - eps_abs_) {
+        row_status = -1;
+      } else if (ax(i) > u(i) + eps_abs_) {
+        row_status = 1;
+      }
+    } else if (!is_equality && y(i) * row_status < -eps_abs_) {
+      // an inequality pushing the wrong way is released
+      row_status = 0;
+    }
+    if (row_status != (*status)[i]) {
+      (*status)[i] = row_status;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+void AdmmQpSolver::Polish(const SparseMatrix& P, const VectorXd& q,
+                          const SparseMatrix& A, const VectorXd& l,
+                          const VectorXd& u, VectorXd* x, VectorXd* z,
+                          VectorXd* y) const {
+  const int m = A.rows();
+  // active sets guessed from the multipliers (as OSQP) and from the
+  // projected iterate, -1 for the lower and 1 for the upper bound
+  std::vector<std::vector<int>> guesses(2, std::vector<int>(m, 0));
+  for (int i = 0; i < m; ++i) {
+    if ((*z)(i) - l(i) < -(*y)(i)) {
+      guesses[0][i] = -1;
+    } else if (u(i) - (*z)(i) < (*y)(i)) {
+      guesses[0][i] = 1;
+    }
+    if ((*z)(i) <= l(i)) {
+      guesses[1][i] = -1;
+    } else if ((*z)(i) >= u(i)) {
+      guesses[1][i] = 1;
+    }
+  }
+
+  double prim_residual = 0.0;
+  double dual_residual = 0.0;
+  double norm = 0.0;
+  ComputeResiduals(P, q, A, *x, *z, *y, &prim_residual, &norm,
+                   &dual_residual, &norm);
+  for (auto& status : guesses) {
+    // correct the guess with the violated rows and the wrong multipliers
+    VectorXd polished_x;
+    VectorXd polished_y;
+    bool settled = false;
+    for (int i = 0; i < kPolishIterations; ++i) {
+      if (!SolveActiveSet(P, q, A, l, u, status, &polished_x, &polished_y)) {
+        break;
+      }
+      if (!UpdateActiveSet(A, l, u, polished_x, polished_y, &status)) {
+        settled = true;
+        break;
+      }
+    }
+    if (!settled) {
+      continue;
+    }
+    const VectorXd polished_z = (A * polished_x).cwiseMax(l).cwiseMin(u);
+    double polished_prim_residual = 0.0;
+    double polished_dual_residual = 0.0;
+    ComputeResiduals(P, q, A, polished_x, polished_z, polished_y,
+                     &polished_prim_residual, &norm, &polished_dual_residual,
+                     &norm);
+    // the guessed active set may be wrong, keep the better solution
+    constexpr double kResidualFloor = 1e-9;
+    if (polished_prim_residual <= std::max(prim_residual, kResidualFloor) &&
+        polished_dual_residual <= std::max(dual_residual, kResidualFloor)) {
+      *x = polished_x;
+      *z = polished_z;
+      *y = polished_y;
+      return;
+    }
+  }
+  ADEBUG << "ADMM QP solver: polishing did not improve the solution.";
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file: admm_qp_solver.h
+ * @brief: sparse ADMM solver for convex quadratic programs
+ *
+ *        min_x  : q(x) = 0.5 * x^T * P * x  + x^T q
+ *        with respect to:  l <= A * x <= u
+ **/
+
+#ifndef MODULES_COMMON_MATH_QP_SOLVER_ADMM_QP_SOLVER_H_
+#define MODULES_COMMON_MATH_QP_SOLVER_ADMM_QP_SOLVER_H_
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "Eigen/SparseCholesky"
+#include "Eigen/SparseCore"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class AdmmQpSolver
+ * @brief Operator splitting (ADMM) solver in the form used by OSQP.
+ *
+ * Each iteration solves one linear system with the constant matrix
+ * P + sigma * I + A^T * diag(rho) * A, which is factorized with a sparse
+ * LDLT. The solver is meant to be kept alive across planning cycles: the
+ * symbolic factorization is reused as long as the sparsity pattern of the
+ * problem does not change, and the iterates of the previous solve are used
+ * as warm start if the dimensions match. The problem is equilibrated with
+ * Ruiz scaling before solving, and the ADMM solution is polished by solving
+ * the KKT system of its active set.
+ */
+class AdmmQpSolver {
+ public:
+  AdmmQpSolver() = default;
+
+  /**
+   * @brief solve the problem in the form l <= A * x <= u. Bounds with an
+   * absolute value above 1e20 are treated as infinite.
+   */
+  bool Solve(const Eigen::SparseMatrix<double>& P, const Eigen::VectorXd& q,
+             const Eigen::SparseMatrix<double>& A, const Eigen::VectorXd& l,
+             const Eigen::VectorXd& u);
+
+  /**
+   * @brief solve the problem in the convention of QpSolver,
+   * equality_matrix * x = equality_boundary and
+   * inequality_matrix * x >= inequality_boundary, with the additional
+   * bounds |x| <= param_bound and inequality_matrix * x <= constraint_bound.
+   */
+  bool Solve(const Eigen::MatrixXd& kernel_matrix,
+             const Eigen::MatrixXd& offset,
+             const Eigen::MatrixXd& inequality_matrix,
+             const Eigen::MatrixXd& inequality_boundary,
+             const Eigen::MatrixXd& equality_matrix,
+             const Eigen::MatrixXd& equality_boundary,
+             const double param_bound, const double constraint_bound);
+
+  /**
+   * @brief drop the warm start, the adapted rho and the cached
+   * factorization.
+   */
+  void Reset();
+
+  const Eigen::VectorXd& params() const { return solution_; }
+
+  int num_iterations() const { return num_iterations_; }
+  // number of symbolic factorizations since construction or Reset()
+  int num_symbolic_factorizations() const {
+    return num_symbolic_factorizations_;
+  }
+
+  void set_max_iteration(const int max_iteration) {
+    max_iteration_ = max_iteration;
+  }
+  void set_eps_abs(const double eps_abs) { eps_abs_ = eps_abs; }
+  void set_eps_rel(const double eps_rel) { eps_rel_ = eps_rel; }
+
+ private:
+  void Scale(Eigen::SparseMatrix<double>* P, Eigen::VectorXd* q,
+             Eigen::SparseMatrix<double>* A);
+
+  void UpdateRhoVector(const Eigen::VectorXd& l, const Eigen::VectorXd& u);
+
+  bool Factorize(const Eigen::SparseMatrix<double>& P,
+                 const Eigen::SparseMatrix<double>& A);
+
+  bool SamePattern(const Eigen::SparseMatrix<double>& matrix) const;
+
+  void ComputeResiduals(const Eigen::SparseMatrix<double>& P,
+                        const Eigen::VectorXd& q,
+                        const Eigen::SparseMatrix<double>& A,
+                        const Eigen::VectorXd& x, const Eigen::VectorXd& z,
+                        const Eigen::VectorXd& y, double* prim_residual,
+                        double* prim_norm, double* dual_residual,
+                        double* dual_norm) const;
+
+  /**
+   * @brief solve the KKT system with the rows of the given status (-1 lower
+   * bound, 1 upper bound, 0 inactive) as equalities.
+   */
+  bool SolveActiveSet(const Eigen::SparseMatrix<double>& P,
+                      const Eigen::VectorXd& q,
+                      const Eigen::SparseMatrix<double>& A,
+                      const Eigen::VectorXd& l, const Eigen::VectorXd& u,
+                      const std::vector<int>& status, Eigen::VectorXd* x,
+                      Eigen::VectorXd* y) const;
+
+  /**
+   * @brief add the violated rows to the active set and release the
+   * inequalities with a multiplier of the wrong sign. Returns true if the
+   * active set changed.
+   */
+  bool UpdateActiveSet(const Eigen::SparseMatrix<double>& A,
+                       const Eigen::VectorXd& l, const Eigen::VectorXd& u,
+                       const Eigen::VectorXd& x, const Eigen::VectorXd& y,
+                       std::vector<int>* status) const;
+
+  /**
+   * @brief refine the ADMM solution by solving the equality constrained
+   * problem of the active constraints guessed from the multipliers, the
+   * guess is corrected for a few iterations.
+   */
+  void Polish(const Eigen::SparseMatrix<double>& P, const Eigen::VectorXd& q,
+              const Eigen::SparseMatrix<double>& A, const Eigen::VectorXd& l,
+              const Eigen::VectorXd& u, Eigen::VectorXd* x,
+              Eigen::VectorXd* z, Eigen::VectorXd* y) const;
+
+  // settings
+  int max_iteration_ = 4000;
+  double eps_abs_ = 1e-4;
+  double eps_rel_ = 1e-4;
+  double sigma_ = 1e-6;
+  double alpha_ = 1.6;
+  double initial_rho_ = 0.1;
+
+  // adapted to the residuals, kept across the solves until Reset()
+  double rho_ = initial_rho_;
+
+  // scaling of the current problem: x = D * x_scaled, y = E * y_scaled / c
+  Eigen::VectorXd scale_d_;
+  Eigen::VectorXd scale_e_;
+  double scale_c_ = 1.0;
+
+  Eigen::VectorXd rho_vec_;
+  // pattern of the last factorized linear system
+  std::vector<int> outer_index_;
+  std::vector<int> inner_index_;
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt_;
+  bool has_factorization_ = false;
+
+  // unscaled ADMM iterates, kept as warm start
+  Eigen::VectorXd x_;
+  Eigen::VectorXd z_;
+  Eigen::VectorXd y_;
+  // polished solution of the last Solve()
+  Eigen::VectorXd solution_;
+
+  int num_iterations_ = 0;
+  int num_symbolic_factorizations_ = 0;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_MATH_QP_SOLVER_ADMM_QP_SOLVER_H_
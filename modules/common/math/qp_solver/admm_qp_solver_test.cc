@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file: admm_qp_solver_test.cc
+ **/
+
+#include "modules/common/math/qp_solver/admm_qp_solver.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+TEST(AdmmQpSolverTest, Unconstrained) {
+  // min (x0 - 1)^2 + (x1 + 2)^2
+  Eigen::MatrixXd kernel_matrix = Eigen::MatrixXd::Identity(2, 2) * 2.0;
+  Eigen::MatrixXd offset(2, 1);
+  offset << -2.0, 4.0;
+  Eigen::MatrixXd empty_matrix(0, 2);
+  Eigen::MatrixXd empty_boundary(0, 1);
+
+  AdmmQpSolver solver;
+  EXPECT_TRUE(solver.Solve(kernel_matrix, offset, empty_matrix,
+                           empty_boundary, empty_matrix, empty_boundary, 1e3,
+                           1e3));
+  EXPECT_NEAR(1.0, solver.params()(0), 1e-4);
+  EXPECT_NEAR(-2.0, solver.params()(1), 1e-4);
+}
+
+TEST(AdmmQpSolverTest, Constrained) {
+  // min x0^2 + x1^2 + x2^2, x0 + x1 + x2 = 3, x0 >= 1.5
+  Eigen::MatrixXd kernel_matrix = Eigen::MatrixXd::Identity(3, 3) * 2.0;
+  Eigen::MatrixXd offset = Eigen::MatrixXd::Zero(3, 1);
+  Eigen::MatrixXd equality_matrix(1, 3);
+  equality_matrix << 1.0, 1.0, 1.0;
+  Eigen::MatrixXd equality_boundary(1, 1);
+  equality_boundary << 3.0;
+  Eigen::MatrixXd inequality_matrix(1, 3);
+  inequality_matrix << 1.0, 0.0, 0.0;
+  Eigen::MatrixXd inequality_boundary(1, 1);
+  inequality_boundary << 1.5;
+
+  AdmmQpSolver solver;
+  EXPECT_TRUE(solver.Solve(kernel_matrix, offset, inequality_matrix,
+                           inequality_boundary, equality_matrix,
+                           equality_boundary, 1e3, 1e3));
+  EXPECT_NEAR(1.5, solver.params()(0), 1e-4);
+  EXPECT_NEAR(0.75, solver.params()(1), 1e-4);
+  EXPECT_NEAR(0.75, solver.params()(2), 1e-4);
+}
+
+TEST(AdmmQpSolverTest, WarmStart) {
+  // a chain of points pulled towards a reference, with bounded differences
+  const int n = 40;
+  Eigen::MatrixXd kernel_matrix = Eigen::MatrixXd::Zero(n, n);
+  for (int i = 0; i + 1 < n; ++i) {
+    kernel_matrix(i, i) += 10.0;
+    kernel_matrix(i + 1, i + 1) += 10.0;
+    kernel_matrix(i, i + 1) -= 10.0;
+    kernel_matrix(i + 1, i) -= 10.0;
+  }
+  kernel_matrix += Eigen::MatrixXd::Identity(n, n);
+  Eigen::MatrixXd offset(n, 1);
+  Eigen::MatrixXd inequality_matrix = Eigen::MatrixXd::Zero(n - 1, n);
+  Eigen::MatrixXd inequality_boundary(n - 1, 1);
+  for (int i = 0; i + 1 < n; ++i) {
+    inequality_matrix(i, i) = -1.0;
+    inequality_matrix(i, i + 1) = 1.0;
+    inequality_boundary(i, 0) = 0.0;
+  }
+  Eigen::MatrixXd equality_matrix = Eigen::MatrixXd::Zero(1, n);
+  equality_matrix(0, 0) = 1.0;
+  Eigen::MatrixXd equality_boundary(1, 1);
+  equality_boundary << 0.0;
+
+  AdmmQpSolver solver;
+  for (int i = 0; i < n; ++i) {
+    offset(i, 0) = -std::sin(0.2 * i) * 5.0;
+  }
+  EXPECT_TRUE(solver.Solve(kernel_matrix, offset, inequality_matrix,
+                           inequality_boundary, equality_matrix,
+                           equality_boundary, 1e3, 1e3));
+  const int cold_iterations = solver.num_iterations();
+  const Eigen::VectorXd cold_params = solver.params();
+  for (int i = 1; i < n; ++i) {
+    EXPECT_GE(cold_params(i) - cold_params(i - 1), -1e-4);
+  }
+
+  // the next cycle: slightly different reference, same structure
+  for (int i = 0; i < n; ++i) {
+    offset(i, 0) = -std::sin(0.2 * i + 0.01) * 5.0;
+  }
+  EXPECT_TRUE(solver.Solve(kernel_matrix, offset, inequality_matrix,
+                           inequality_boundary, equality_matrix,
+                           equality_boundary, 1e3, 1e3));
+  EXPECT_LT(solver.num_iterations(), cold_iterations);
+  EXPECT_EQ(1, solver.num_symbolic_factorizations());
+
+  AdmmQpSolver cold_solver;
+  EXPECT_TRUE(cold_solver.Solve(kernel_matrix, offset, inequality_matrix,
+                                inequality_boundary, equality_matrix,
+                                equality_boundary, 1e3, 1e3));
+  for (int i = 0; i < n; ++i) {
+    EXPECT_NEAR(cold_solver.params()(i), solver.params()(i), 1e-4);
+  }
+}
+
+TEST(AdmmQpSolverTest, Reset) {
+  // a chain of points pulled towards a reference, with bounded differences
+  const int n = 40;
+  Eigen::MatrixXd kernel_matrix = Eigen::MatrixXd::Zero(n, n);
+  for (int i = 0; i + 1 < n; ++i) {
+    kernel_matrix(i, i) += 10.0;
+    kernel_matrix(i + 1, i + 1) += 10.0;
+    kernel_matrix(i, i + 1) -= 10.0;
+    kernel_matrix(i + 1, i) -= 10.0;
+  }
+  kernel_matrix += Eigen::MatrixXd::Identity(n, n);
+  Eigen::MatrixXd offset(n, 1);
+  // pulled far enough for rho to be adapted
+  for (int i = 0; i < n; ++i) {
+    offset(i, 0) = -std::sin(0.2 * i) * 100.0;
+  }
+  Eigen::MatrixXd inequality_matrix = Eigen::MatrixXd::Zero(n - 1, n);
+  Eigen::MatrixXd inequality_boundary = Eigen::MatrixXd::Zero(n - 1, 1);
+  for (int i = 0; i + 1 < n; ++i) {
+    inequality_matrix(i, i) = -1.0;
+    inequality_matrix(i, i + 1) = 1.0;
+  }
+  Eigen::MatrixXd equality_matrix = Eigen::MatrixXd::Zero(1, n);
+  equality_matrix(0, 0) = 1.0;
+  Eigen::MatrixXd equality_boundary = Eigen::MatrixXd::Zero(1, 1);
+
+  AdmmQpSolver solver;
+  EXPECT_TRUE(solver.Solve(kernel_matrix, offset, inequality_matrix,
+                           inequality_boundary, equality_matrix,
+                           equality_boundary, 1e3, 1e3));
+  const int cold_iterations = solver.num_iterations();
+  const Eigen::VectorXd cold_params = solver.params();
+
+  // a reset solver runs exactly as a new one, with the initial rho
+  solver.Reset();
+  EXPECT_EQ(0, solver.num_symbolic_factorizations());
+  EXPECT_TRUE(solver.Solve(kernel_matrix, offset, inequality_matrix,
+                           inequality_boundary, equality_matrix,
+                           equality_boundary, 1e3, 1e3));
+  EXPECT_EQ(cold_iterations, solver.num_iterations());
+  EXPECT_EQ(1, solver.num_symbolic_factorizations());
+  for (int i = 0; i < n; ++i) {
+    EXPECT_DOUBLE_EQ(cold_params(i), solver.params()(i));
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
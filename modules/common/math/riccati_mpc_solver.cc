@@ -0,0 +1,280 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/riccati_mpc_solver.h"
+
+#include <algorithm>
+
+#include "Eigen/Dense"
+
+#include "modules/common/log.h"
+#include "modules/common/math/mpc_solver.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+using Matrix = Eigen::MatrixXd;
+using Vector = Eigen::VectorXd;
+
+namespace {
+
+// tolerance used to decide whether a control sits on its bound
+const double kBoundTolerance = 1e-9;
+
+}  // namespace
+
+void RiccatiMpcSolver::Reset() { has_previous_solution_ = false; }
+
+void RiccatiMpcSolver::Resize(const int horizon, const int num_states,
+                              const int num_controls) {
+  if (horizon == horizon_ && num_states == num_states_ &&
+      num_controls == num_controls_) {
+    return;
+  }
+  horizon_ = horizon;
+  num_states_ = num_states;
+  num_controls_ = num_controls;
+  status_.assign(horizon, Eigen::VectorXi::Zero(num_controls));
+  gains_.assign(horizon, Matrix::Zero(num_controls, num_states));
+  offsets_.assign(horizon, Vector::Zero(num_controls));
+  states_.assign(horizon + 1, Vector::Zero(num_states));
+  controls_.assign(horizon, Vector::Zero(num_controls));
+  gradients_.assign(horizon, Vector::Zero(num_controls));
+  previous_controls_.assign(horizon, Vector::Zero(num_controls));
+  has_previous_solution_ = false;
+}
+
+void RiccatiMpcSolver::InitActiveSet(const Vector &lower, const Vector &upper) {
+  for (int i = 0; i < horizon_; ++i) {
+    status_[i].setZero();
+    if (!has_previous_solution_) {
+      continue;
+    }
+    // shift the previous solution by one step, repeat the last control
+    const Vector &guess = previous_controls_[std::min(i + 1, horizon_ - 1)];
+    for (int j = 0; j < num_controls_; ++j) {
+      if (guess(j) <= lower(j) + kBoundTolerance) {
+        status_[i](j) = AT_LOWER;
+      } else if (guess(j) >= upper(j) - kBoundTolerance) {
+        status_[i](j) = AT_UPPER;
+      }
+    }
+  }
+}
+
+// Value function at x(i) is 0.5 * x' * P * x + p' * x. The controls fixed by
+// the active set enter the stage as known inputs, the free ones are solved
+// as u_free = gain * x + offset.
+void RiccatiMpcSolver::BackwardPass(const Matrix &matrix_a,
+                                    const Matrix &matrix_b,
+                                    const Vector &vector_c,
+                                    const Matrix &matrix_q,
+                                    const Matrix &matrix_r,
+                                    const Vector &lower, const Vector &upper,
+                                    const std::vector<Matrix> &reference) {
+  Matrix P = matrix_q;
+  Vector p = -matrix_q * reference[horizon_ - 1];
+
+  std::vector<int> free_index;
+  free_index.reserve(num_controls_);
+  for (int i = horizon_ - 1; i >= 0; --i) {
+    free_index.clear();
+    Vector fixed_control = Vector::Zero(num_controls_);
+    for (int j = 0; j < num_controls_; ++j) {
+      if (status_[i](j) == AT_LOWER) {
+        fixed_control(j) = lower(j);
+      } else if (status_[i](j) == AT_UPPER) {
+        fixed_control(j) = upper(j);
+      } else {
+        free_index.push_back(j);
+      }
+    }
+    const int num_free = static_cast<int>(free_index.size());
+
+    // stage data restricted to the free controls
+    Matrix matrix_b_free(num_states_, num_free);
+    Matrix matrix_r_free(num_free, num_free);
+    Vector vector_r_free(num_free);
+    const Vector vector_r_fixed = matrix_r * fixed_control;
+    for (int a = 0; a < num_free; ++a) {
+      matrix_b_free.col(a) = matrix_b.col(free_index[a]);
+      vector_r_free(a) = vector_r_fixed(free_index[a]);
+      for (int b = 0; b < num_free; ++b) {
+        matrix_r_free(a, b) = matrix_r(free_index[a], free_index[b]);
+      }
+    }
+    const Vector vector_c_stage = vector_c + matrix_b * fixed_control;
+
+    const Vector p_next = P * vector_c_stage + p;
+    Matrix matrix_a_closed = matrix_a;
+    Vector vector_e = vector_c_stage;
+    gains_[i].resize(num_free, num_states_);
+    offsets_[i].resize(num_free);
+    if (num_free > 0) {
+      const Matrix BT_P = matrix_b_free.transpose() * P;
+      const Eigen::LDLT<Matrix> ldlt(matrix_r_free + BT_P * matrix_b_free);
+      gains_[i] = -ldlt.solve(BT_P * matrix_a);
+      offsets_[i] =
+          -ldlt.solve(matrix_b_free.transpose() * p_next + vector_r_free);
+      matrix_a_closed += matrix_b_free * gains_[i];
+      vector_e += matrix_b_free * offsets_[i];
+    }
+
+    p = matrix_a.transpose() * (P * vector_e + p);
+    P = matrix_a.transpose() * P * matrix_a_closed;
+    if (i > 0) {
+      // state cost of x(i), which tracks reference[i - 1]
+      P += matrix_q;
+      p -= matrix_q * reference[i - 1];
+    }
+    P = 0.5 * (P + P.transpose());
+  }
+}
+
+void RiccatiMpcSolver::ForwardPass(const Matrix &matrix_a,
+                                   const Matrix &matrix_b,
+                                   const Vector &vector_c,
+                                   const Vector &initial_state) {
+  states_[0] = initial_state;
+  for (int i = 0; i < horizon_; ++i) {
+    // controls_ still holds the fixed values written by UpdateActiveSet()
+    const Vector free_control = gains_[i] * states_[i] + offsets_[i];
+    for (int j = 0, k = 0; j < num_controls_; ++j) {
+      if (status_[i](j) == FREE) {
+        controls_[i](j) = free_control(k++);
+      }
+    }
+    states_[i + 1] = matrix_a * states_[i] + matrix_b * controls_[i] + vector_c;
+  }
+}
+
+void RiccatiMpcSolver::ComputeGradients(const Matrix &matrix_a,
+                                        const Matrix &matrix_b,
+                                        const Matrix &matrix_q,
+                                        const Matrix &matrix_r,
+                                        const std::vector<Matrix> &reference) {
+  // costate of x(i + 1), i.e. the derivative of the remaining cost
+  Vector costate = Vector::Zero(num_states_);
+  for (int i = horizon_ - 1; i >= 0; --i) {
+    costate = matrix_q * (states_[i + 1] - reference[i]) +
+              matrix_a.transpose() * costate;
+    gradients_[i] = matrix_r * controls_[i] + matrix_b.transpose() * costate;
+  }
+}
+
+bool RiccatiMpcSolver::UpdateActiveSet(const Vector &lower,
+                                       const Vector &upper, const double eps) {
+  bool changed = false;
+  for (int i = 0; i < horizon_; ++i) {
+    for (int j = 0; j < num_controls_; ++j) {
+      const double u = controls_[i](j);
+      const double gradient = gradients_[i](j);
+      int status = status_[i](j);
+      if (status == FREE) {
+        if (u < lower(j) - kBoundTolerance) {
+          status = AT_LOWER;
+        } else if (u > upper(j) + kBoundTolerance) {
+          status = AT_UPPER;
+        }
+      } else if (status == AT_LOWER && gradient < -eps) {
+        status = FREE;
+      } else if (status == AT_UPPER && gradient > eps) {
+        status = FREE;
+      }
+      if (status != status_[i](j)) {
+        status_[i](j) = status;
+        changed = true;
+      }
+      if (status == AT_LOWER) {
+        controls_[i](j) = lower(j);
+      } else if (status == AT_UPPER) {
+        controls_[i](j) = upper(j);
+      }
+    }
+  }
+  return changed;
+}
+
+bool RiccatiMpcSolver::Solve(const Matrix &matrix_a, const Matrix &matrix_b,
+                             const Matrix &matrix_c, const Matrix &matrix_q,
+                             const Matrix &matrix_r,
+                             const Matrix &matrix_lower,
+                             const Matrix &matrix_upper,
+                             const Matrix &matrix_initial_state,
+                             const std::vector<Matrix> &reference,
+                             const double eps, const int max_iter,
+                             std::vector<Matrix> *control) {
+  if (matrix_a.rows() != matrix_a.cols() ||
+      matrix_b.rows() != matrix_a.rows() ||
+      matrix_lower.rows() != matrix_upper.rows() ||
+      matrix_lower.rows() != matrix_b.cols() || reference.empty() ||
+      control->size() != reference.size()) {
+    AERROR << "One or more matrices have incompatible dimensions. Aborting.";
+    return false;
+  }
+
+  const int horizon = static_cast<int>(reference.size());
+  Resize(horizon, matrix_a.rows(), matrix_b.cols());
+
+  const Vector lower = matrix_lower.col(0);
+  const Vector upper = matrix_upper.col(0);
+  const Vector vector_c = matrix_c.col(0);
+  const Vector initial_state = matrix_initial_state.col(0);
+
+  InitActiveSet(lower, upper);
+  for (int i = 0; i < horizon_; ++i) {
+    for (int j = 0; j < num_controls_; ++j) {
+      if (status_[i](j) == AT_LOWER) {
+        controls_[i](j) = lower(j);
+      } else if (status_[i](j) == AT_UPPER) {
+        controls_[i](j) = upper(j);
+      }
+    }
+  }
+
+  bool converged = false;
+  for (num_iterations_ = 1; num_iterations_ <= max_iter; ++num_iterations_) {
+    BackwardPass(matrix_a, matrix_b, vector_c, matrix_q, matrix_r, lower,
+                 upper, reference);
+    ForwardPass(matrix_a, matrix_b, vector_c, initial_state);
+    ComputeGradients(matrix_a, matrix_b, matrix_q, matrix_r, reference);
+    if (!UpdateActiveSet(lower, upper, eps)) {
+      converged = true;
+      break;
+    }
+  }
+
+  if (!converged) {
+    AWARN << "Riccati MPC active set did not settle after " << max_iter
+          << " iterations, falling back to the dense solver";
+    has_previous_solution_ = false;
+    return SolveLinearMPC(matrix_a, matrix_b, matrix_c, matrix_q, matrix_r,
+                          matrix_lower, matrix_upper, matrix_initial_state,
+                          reference, eps, max_iter, control);
+  }
+
+  for (int i = 0; i < horizon_; ++i) {
+    (*control)[i] = controls_[i];
+    previous_controls_[i] = controls_[i];
+  }
+  has_previous_solution_ = true;
+  return true;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file riccati_mpc_solver.h
+ * @brief Structured solver for box-constrained linear MPC problems.
+ */
+
+#ifndef MODULES_COMMON_MATH_RICCATI_MPC_SOLVER_H_
+#define MODULES_COMMON_MATH_RICCATI_MPC_SOLVER_H_
+
+#include <vector>
+
+#include "Eigen/Core"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class RiccatiMpcSolver
+ * @brief Solves the same problem as SolveLinearMPC() without condensing it.
+ *
+ * Instead of building the dense horizon matrices, each iteration runs one
+ * backward Riccati recursion over the horizon with the controls of the
+ * current active set fixed at their bounds, so the cost grows linearly with
+ * the horizon. The active set is updated from primal violations and the
+ * signs of the multipliers (primal-dual active set method) and is warm
+ * started from the previous solution shifted by one step. Workspaces are
+ * kept between calls. If the active set does not settle within max_iter
+ * iterations the dense SolveLinearMPC() is used instead.
+ */
+class RiccatiMpcSolver {
+ public:
+  /**
+   * @brief Solver for discrete-time model predictive control problem.
+   * @param matrix_a The system dynamic matrix
+   * @param matrix_b The control matrix
+   * @param matrix_c The disturbance matrix
+   * @param matrix_q The cost matrix for control state
+   * @param matrix_r The cost matrix for control input
+   * @param matrix_lower The lower bound control constrain matrix
+   * @param matrix_upper The upper bound control constrain matrix
+   * @param matrix_initial_state The initial state matrix
+   * @param reference The control reference vector with respect to time
+   * @param eps The tolerance on the multiplier signs
+   * @param max_iter The maximum active set iterations
+   * @param control The feedback control matrix (pointer)
+   * @return true if a solution was found
+   */
+  bool Solve(const Eigen::MatrixXd &matrix_a, const Eigen::MatrixXd &matrix_b,
+             const Eigen::MatrixXd &matrix_c, const Eigen::MatrixXd &matrix_q,
+             const Eigen::MatrixXd &matrix_r,
+             const Eigen::MatrixXd &matrix_lower,
+             const Eigen::MatrixXd &matrix_upper,
+             const Eigen::MatrixXd &matrix_initial_state,
+             const std::vector<Eigen::MatrixXd> &reference, const double eps,
+             const int max_iter, std::vector<Eigen::MatrixXd> *control);
+
+  /**
+   * @brief Forget the previous solution, the next Solve() starts cold.
+   */
+  void Reset();
+
+  /**
+   * @brief Number of active set iterations used by the last Solve().
+   */
+  int num_iterations() const { return num_iterations_; }
+
+ private:
+  enum BoundStatus { FREE = 0, AT_LOWER = -1, AT_UPPER = 1 };
+
+  void Resize(const int horizon, const int num_states, const int num_controls);
+
+  void InitActiveSet(const Eigen::VectorXd &lower,
+                     const Eigen::VectorXd &upper);
+
+  void BackwardPass(const Eigen::MatrixXd &matrix_a,
+                    const Eigen::MatrixXd &matrix_b,
+                    const Eigen::VectorXd &vector_c,
+                    const Eigen::MatrixXd &matrix_q,
+                    const Eigen::MatrixXd &matrix_r,
+                    const Eigen::VectorXd &lower, const Eigen::VectorXd &upper,
+                    const std::vector<Eigen::MatrixXd> &reference);
+
+  void ForwardPass(const Eigen::MatrixXd &matrix_a,
+                   const Eigen::MatrixXd &matrix_b,
+                   const Eigen::VectorXd &vector_c,
+                   const Eigen::VectorXd &initial_state);
+
+  void ComputeGradients(const Eigen::MatrixXd &matrix_a,
+                        const Eigen::MatrixXd &matrix_b,
+                        const Eigen::MatrixXd &matrix_q,
+                        const Eigen::MatrixXd &matrix_r,
+                        const std::vector<Eigen::MatrixXd> &reference);
+
+  bool UpdateActiveSet(const Eigen::VectorXd &lower,
+                       const Eigen::VectorXd &upper, const double eps);
+
+  int horizon_ = 0;
+  int num_states_ = 0;
+  int num_controls_ = 0;
+  int num_iterations_ = 0;
+
+  // bound status of every control component, per stage
+  std::vector<Eigen::VectorXi> status_;
+  // feedback gains and offsets of the free control components, per stage
+  std::vector<Eigen::MatrixXd> gains_;
+  std::vector<Eigen::VectorXd> offsets_;
+  // states x(0) ... x(horizon), controls u(0) ... u(horizon - 1)
+  std::vector<Eigen::VectorXd> states_;
+  std::vector<Eigen::VectorXd> controls_;
+  // cost gradient with respect to each control
+  std::vector<Eigen::VectorXd> gradients_;
+  // solution of the previous call, used as warm start
+  std::vector<Eigen::VectorXd> previous_controls_;
+  bool has_previous_solution_ = false;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_MATH_RICCATI_MPC_SOLVER_H_
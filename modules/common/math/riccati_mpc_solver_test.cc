@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/riccati_mpc_solver.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/mpc_solver.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+class RiccatiMpcSolverTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    A_ = Eigen::MatrixXd(kStates, kStates);
+    A_ << 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1;
+    B_ = Eigen::MatrixXd(kStates, kControls);
+    B_ << 0, 1, 0, 0, 1, 0, 0, 1;
+    C_ = Eigen::MatrixXd(kStates, 1);
+    C_ << 0, 0, 0, 0.1;
+    Q_ = Eigen::MatrixXd(kStates, kStates);
+    Q_ << 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0;
+    R_ = Eigen::MatrixXd(kControls, kControls);
+    R_ << 1, 0, 0, 1;
+  }
+
+  // Solves the problem with both backends and compares the controls.
+  void ExpectSameSolution(const Eigen::MatrixXd &lower_bound,
+                          const Eigen::MatrixXd &upper_bound,
+                          const Eigen::MatrixXd &initial_state,
+                          const Eigen::MatrixXd &reference_state) {
+    std::vector<Eigen::MatrixXd> reference(kHorizon, reference_state);
+    std::vector<Eigen::MatrixXd> dense_control(
+        kHorizon, Eigen::MatrixXd::Zero(kControls, 1));
+    std::vector<Eigen::MatrixXd> riccati_control(
+        kHorizon, Eigen::MatrixXd::Zero(kControls, 1));
+    EXPECT_TRUE(SolveLinearMPC(A_, B_, C_, Q_, R_, lower_bound, upper_bound,
+                               initial_state, reference, kEps, kMaxIter,
+                               &dense_control));
+    EXPECT_TRUE(solver_.Solve(A_, B_, C_, Q_, R_, lower_bound, upper_bound,
+                              initial_state, reference, kEps, kMaxIter,
+                              &riccati_control));
+    for (int i = 0; i < kHorizon; ++i) {
+      for (int j = 0; j < kControls; ++j) {
+        EXPECT_NEAR(dense_control[i](j), riccati_control[i](j), 1e-4);
+      }
+    }
+  }
+
+ protected:
+  static const int kStates = 4;
+  static const int kControls = 2;
+  static const int kHorizon = 10;
+  static constexpr double kEps = 0.01;
+  static const int kMaxIter = 100;
+
+  Eigen::MatrixXd A_;
+  Eigen::MatrixXd B_;
+  Eigen::MatrixXd C_;
+  Eigen::MatrixXd Q_;
+  Eigen::MatrixXd R_;
+  RiccatiMpcSolver solver_;
+};
+
+TEST_F(RiccatiMpcSolverTest, Unconstrained) {
+  Eigen::MatrixXd lower_bound(kControls, 1);
+  lower_bound << -1e6, -1e6;
+  Eigen::MatrixXd upper_bound(kControls, 1);
+  upper_bound << 1e6, 1e6;
+  Eigen::MatrixXd initial_state(kStates, 1);
+  initial_state << 3, -2, 0.5, 0;
+  Eigen::MatrixXd reference_state(kStates, 1);
+  reference_state << 1, 1, 0, 0;
+  ExpectSameSolution(lower_bound, upper_bound, initial_state, reference_state);
+}
+
+TEST_F(RiccatiMpcSolverTest, Constrained) {
+  Eigen::MatrixXd lower_bound(kControls, 1);
+  lower_bound << -1, -0.5;
+  Eigen::MatrixXd upper_bound(kControls, 1);
+  upper_bound << 1, 0.5;
+  Eigen::MatrixXd initial_state(kStates, 1);
+  initial_state << 0, 0, 0, 0;
+  Eigen::MatrixXd reference_state(kStates, 1);
+  reference_state << 20, -20, 0, 0;
+  ExpectSameSolution(lower_bound, upper_bound, initial_state, reference_state);
+
+  // warm started from the previous solution
+  initial_state << 0.5, -0.5, 1, -0.5;
+  ExpectSameSolution(lower_bound, upper_bound, initial_state, reference_state);
+}
+
+TEST_F(RiccatiMpcSolverTest, SaturatedControl) {
+  Eigen::MatrixXd lower_bound(kControls, 1);
+  lower_bound << -10, -10;
+  Eigen::MatrixXd upper_bound(kControls, 1);
+  upper_bound << 10, 10;
+  Eigen::MatrixXd initial_state(kStates, 1);
+  initial_state << 0, 0, 0, 0;
+  Eigen::MatrixXd reference_state(kStates, 1);
+  reference_state << 200, 200, 0, 0;
+  std::vector<Eigen::MatrixXd> reference(kHorizon, reference_state);
+  std::vector<Eigen::MatrixXd> control(kHorizon,
+                                       Eigen::MatrixXd::Zero(kControls, 1));
+  for (int i = 0; i < kHorizon; ++i) {
+    EXPECT_TRUE(solver_.Solve(A_, B_, C_, Q_, R_, lower_bound, upper_bound,
+                              initial_state, reference, kEps, kMaxIter,
+                              &control));
+    EXPECT_FLOAT_EQ(upper_bound(0), control[0](0));
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
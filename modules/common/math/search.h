@@ -22,7 +22,10 @@
 #ifndef MODULES_COMMON_MATH_SEARCH_H_
 #define MODULES_COMMON_MATH_SEARCH_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <iterator>
 
 /**
  * @namespace apollo::common::math
@@ -46,6 +49,43 @@ double GoldenSectionSearch(const std::function<double(double)> &func,
                            const double lower_bound, const double upper_bound,
                            const double tol = 1e-6);
 
+/**
+ * @brief Same as std::lower_bound, but the search starts from the result of
+ *        the previous query, so that a sequence of non-decreasing queries
+ *        takes amortized constant time instead of a full binary search each.
+ * @param first The beginning of the sorted range.
+ * @param last The end of the sorted range.
+ * @param value The value to search for.
+ * @param comp The comparison, as the one of std::lower_bound.
+ * @param hint The index of the previous result, 0 for the first query. It is
+ *        updated to the index of the result.
+ * @return The first element not less than value.
+ */
+template <typename RandomIt, typename T, typename Compare>
+RandomIt HintedLowerBound(RandomIt first, RandomIt last, const T &value,
+                          Compare comp, std::size_t *hint) {
+  const std::size_t size = std::distance(first, last);
+  const std::size_t start = std::min(*hint, size);
+  RandomIt result;
+  if (start == 0 || comp(*(first + (start - 1)), value)) {
+    // gallop forward from the hint
+    std::size_t low = start;
+    std::size_t high = start;
+    std::size_t step = 1;
+    while (high < size && comp(*(first + high), value)) {
+      low = high + 1;
+      high = start + step;
+      step *= 2;
+    }
+    result = std::lower_bound(first + low, first + std::min(high, size), value,
+                              comp);
+  } else {
+    result = std::lower_bound(first, first + start, value, comp);
+  }
+  *hint = std::distance(first, result);
+  return result;
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
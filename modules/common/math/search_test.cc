@@ -17,6 +17,7 @@
 #include "modules/common/math/search.h"
 
 #include <cmath>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -51,6 +52,28 @@ TEST(SearchTest, GoldenSectionSearch) {
   EXPECT_NEAR(sin_argmin, 1.5 * M_PI, 1e-5);
 }
 
+TEST(SearchTest, HintedLowerBound) {
+  const std::vector<double> values = {0.0, 0.5, 0.5, 1.0, 2.0, 3.5,
+                                      4.0, 4.0, 6.0, 7.5, 9.0};
+  const std::vector<double> queries = {-1.0, 0.0, 0.5, 0.7, 0.7, 3.0,
+                                       4.0,  4.1, 8.0, 9.0, 10.0};
+  std::size_t hint = 0;
+  for (const double query : queries) {
+    const auto expected =
+        std::lower_bound(values.begin(), values.end(), query);
+    const auto result = HintedLowerBound(values.begin(), values.end(), query,
+                                         std::less<double>(), &hint);
+    EXPECT_EQ(expected, result);
+    EXPECT_EQ(std::distance(values.begin(), expected), hint);
+  }
+  // decreasing queries fall back to the binary search
+  for (auto it = queries.rbegin(); it != queries.rend(); ++it) {
+    const auto expected = std::lower_bound(values.begin(), values.end(), *it);
+    EXPECT_EQ(expected, HintedLowerBound(values.begin(), values.end(), *it,
+                                         std::less<double>(), &hint));
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
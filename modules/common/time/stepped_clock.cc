@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/time/stepped_clock.h"
+
+#include <utility>
+
+namespace apollo {
+namespace common {
+namespace time {
+
+SteppedClock::SteppedClock(const Duration &step, const Timestamp &start)
+    : step_(step), now_(start) {
+  CHECK_GT(step_.count(), 0);
+  Clock::SetMode(Clock::MOCK);
+  Clock::SetNow(now_.time_since_epoch());
+}
+
+void SteppedClock::AddTask(const Duration &period,
+                           std::function<void()> task) {
+  CHECK_GT(period.count(), 0);
+  CHECK_EQ(0, period.count() % step_.count())
+      << "The period of a task must be a multiple of the step.";
+  tasks_.push_back({period, now_ + period, std::move(task)});
+}
+
+void SteppedClock::Step() {
+  now_ += step_;
+  ++num_steps_;
+  Clock::SetNow(now_.time_since_epoch());
+  for (auto &task : tasks_) {
+    if (task.next_run <= now_) {
+      task.next_run += task.period;
+      task.run();
+    }
+  }
+}
+
+void SteppedClock::StepUntil(const Timestamp &end) {
+  while (now_ < end) {
+    Step();
+  }
+}
+
+}  // namespace time
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_COMMON_TIME_STEPPED_CLOCK_H_
+#define MODULES_COMMON_TIME_STEPPED_CLOCK_H_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "modules/common/macro.h"
+#include "modules/common/time/time.h"
+
+/**
+ * @namespace apollo::common::time
+ * @brief apollo::common::time
+ */
+namespace apollo {
+namespace common {
+namespace time {
+
+/**
+ * @class SteppedClock
+ * @brief Drives the mock \class Clock in fixed steps, and runs periodic tasks
+ * in lockstep with it instead of on ROS timers.
+ *
+ * With the adapters in non-ROS mode, messages are delivered synchronously,
+ * so the timer driven modules of a closed-loop simulation (e.g. planning and
+ * SimControl) can be registered as tasks and stepped as fast as the CPU
+ * allows, while the message driven ones (e.g. prediction) run in the step
+ * their input is published. Tasks which are due on the same step run in the
+ * order they were added, so that a simulation is deterministic.
+ *
+ * NOTE: \class Clock is a process-wide singleton, so there can only be one
+ * SteppedClock in use at a time.
+ */
+class SteppedClock {
+ public:
+  /**
+   * @brief Switches \class Clock to the mock mode, starting at start.
+   * @param step the duration of a step.
+   * @param start the time of the clock before the first step.
+   */
+  SteppedClock(const Duration &step, const Timestamp &start);
+
+  /**
+   * @brief Adds a task which is due every period, first one period after
+   * the current time.
+   * @param period the period of the task, a multiple of the step.
+   * @param task the task to run.
+   */
+  void AddTask(const Duration &period, std::function<void()> task);
+
+  /**
+   * @brief Advances the clock by one step, and runs the tasks which are due.
+   */
+  void Step();
+
+  /**
+   * @brief Steps until the clock has reached end.
+   */
+  void StepUntil(const Timestamp &end);
+
+  Timestamp now() const { return now_; }
+
+  uint64_t num_steps() const { return num_steps_; }
+
+ private:
+  struct Task {
+    Duration period;
+    Timestamp next_run;
+    std::function<void()> run;
+  };
+
+  const Duration step_;
+  Timestamp now_;
+  uint64_t num_steps_ = 0;
+  std::vector<Task> tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(SteppedClock);
+};
+
+}  // namespace time
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_TIME_STEPPED_CLOCK_H_
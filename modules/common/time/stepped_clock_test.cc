@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/time/stepped_clock.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace time {
+
+TEST(SteppedClockTest, Step) {
+  SteppedClock clock(millis(10), From(100.0));
+  EXPECT_EQ(Clock::MOCK, Clock::mode());
+  EXPECT_DOUBLE_EQ(100.0, Clock::NowInSeconds());
+
+  std::string runs;
+  clock.AddTask(millis(10), [&runs]() { runs += "c"; });
+  clock.AddTask(millis(30), [&runs]() { runs += "p"; });
+  for (int i = 0; i < 6; ++i) {
+    clock.Step();
+    runs += "|";
+  }
+  EXPECT_EQ("c|c|cp|c|c|cp|", runs);
+  EXPECT_EQ(6, clock.num_steps());
+  EXPECT_EQ(FromInt64<millis>(100060), clock.now());
+  EXPECT_EQ(FromInt64<millis>(100060), Clock::Now());
+
+  // No drift after many steps.
+  clock.StepUntil(FromInt64<seconds>(1100));
+  EXPECT_EQ(100000, clock.num_steps());
+  EXPECT_EQ(FromInt64<seconds>(1100), Clock::Now());
+  Clock::SetMode(Clock::SYSTEM);
+}
+
+}  // namespace time
+}  // namespace common
+}  // namespace apollo
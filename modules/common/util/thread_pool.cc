@@ -18,28 +18,357 @@
 * @file
 **/
 
-#include "glog/logging.h"
-
 #include "modules/common/util/thread_pool.h"
 
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "modules/common/log.h"
+
 namespace apollo {
 namespace common {
 namespace util {
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Task {
+  std::function<void()> func;
+  Clock::time_point queued_time;
+};
+
+void UpdateMax(const uint64_t value, std::atomic<uint64_t>* max) {
+  uint64_t current = max->load(std::memory_order_relaxed);
+  while (current < value &&
+         !max->compare_exchange_weak(current, value,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t ElapsedNs(const Clock::time_point start, const Clock::time_point end) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+      .count();
+}
+
+}  // namespace
+
+class ThreadPool::Executor {
+ public:
+  explicit Executor(const ThreadPoolOptions& options);
+  ~Executor();
+
+  int size() const { return static_cast<int>(workers_.size()); }
+
+  void Schedule(std::function<void()> func);
+  bool RunPendingTask();
+  ThreadPoolStats GetStats() const;
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+
+  void WorkerLoop(const int index);
+  void ConfigureWorker(const int index) const;
+  // Pops a task of the given worker, or steals one of another worker if the
+  // index is negative or its deque is empty.
+  bool PopTask(const int index, Task* task);
+  void RunTask(Task* task);
+
+  const ThreadPoolOptions options_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Idle workers sleep on it until a task is queued.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+
+  std::atomic<std::size_t> num_queued_{0};
+  std::atomic<uint32_t> next_worker_{0};
+
+  std::atomic<uint64_t> num_tasks_{0};
+  std::atomic<uint64_t> num_stolen_{0};
+  std::atomic<uint64_t> num_inline_{0};
+  std::atomic<uint64_t> max_queue_depth_{0};
+  std::atomic<uint64_t> total_wait_ns_{0};
+  std::atomic<uint64_t> max_wait_ns_{0};
+  std::atomic<uint64_t> total_run_ns_{0};
+  std::atomic<uint64_t> max_run_ns_{0};
+
+  // The executor and the index of the worker of the calling thread.
+  static thread_local const Executor* current_executor_;
+  static thread_local int current_worker_;
+};
+
+thread_local const ThreadPool::Executor*
+    ThreadPool::Executor::current_executor_ = nullptr;
+thread_local int ThreadPool::Executor::current_worker_ = -1;
+
+ThreadPool::Executor::Executor(const ThreadPoolOptions& options)
+    : options_(options) {
+  CHECK_GT(options_.num_threads, 0);
+  CHECK_GT(options_.max_queue_size, 0);
+  for (const int cpu : options_.cpus) {
+    CHECK_GE(cpu, 0);
+    CHECK_LT(cpu, CPU_SETSIZE);
+  }
+  for (int i = 0; i < options_.num_threads; ++i) {
+    workers_.emplace_back(new Worker());
+  }
+  // Started once all the deques exist, as the workers steal from each other.
+  for (int i = 0; i < options_.num_threads; ++i) {
+    workers_[i]->thread = std::thread(&Executor::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::Executor::~Executor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void ThreadPool::Executor::Schedule(std::function<void()> func) {
+  // A worker queues its own tasks, the other threads spread them.
+  const int index =
+      current_executor_ == this
+          ? current_worker_
+          : static_cast<int>(next_worker_.fetch_add(1) % workers_.size());
+  Worker* worker = workers_[index].get();
+  bool queued = false;
+  {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    if (worker->tasks.size() < options_.max_queue_size) {
+      worker->tasks.push_back(Task{std::move(func), Clock::now()});
+      UpdateMax(num_queued_.fetch_add(1) + 1, &max_queue_depth_);
+      queued = true;
+    }
+  }
+  if (!queued) {
+    // The queue is full, which also bounds the latency of the queued tasks.
+    num_inline_.fetch_add(1, std::memory_order_relaxed);
+    func();
+    return;
+  }
+  {
+    // Not to notify a worker between its check and its wait.
+    std::lock_guard<std::mutex> lock(mutex_);
+  }
+  cv_.notify_one();
+}
+
+bool ThreadPool::Executor::PopTask(const int index, Task* task) {
+  if (index >= 0) {
+    Worker* worker = workers_[index].get();
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    if (!worker->tasks.empty()) {
+      *task = std::move(worker->tasks.back());
+      worker->tasks.pop_back();
+      num_queued_.fetch_sub(1);
+      return true;
+    }
+  }
+  const int num_workers = size();
+  for (int i = 1; i <= num_workers; ++i) {
+    Worker* victim = workers_[(index + i + num_workers) % num_workers].get();
+    std::lock_guard<std::mutex> lock(victim->mutex);
+    if (!victim->tasks.empty()) {
+      *task = std::move(victim->tasks.front());
+      victim->tasks.pop_front();
+      num_queued_.fetch_sub(1);
+      num_stolen_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::Executor::RunTask(Task* task) {
+  const auto start_time = Clock::now();
+  task->func();
+  const auto end_time = Clock::now();
+
+  const uint64_t wait_ns = ElapsedNs(task->queued_time, start_time);
+  const uint64_t run_ns = ElapsedNs(start_time, end_time);
+  num_tasks_.fetch_add(1, std::memory_order_relaxed);
+  total_wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+  UpdateMax(wait_ns, &max_wait_ns_);
+  total_run_ns_.fetch_add(run_ns, std::memory_order_relaxed);
+  UpdateMax(run_ns, &max_run_ns_);
+}
+
+bool ThreadPool::Executor::RunPendingTask() {
+  Task task;
+  if (!PopTask(current_executor_ == this ? current_worker_ : -1, &task)) {
+    return false;
+  }
+  RunTask(&task);
+  return true;
+}
+
+void ThreadPool::Executor::ConfigureWorker(const int index) const {
+  if (!options_.cpus.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const int cpu : options_.cpus) {
+      CPU_SET(cpu, &cpu_set);
+    }
+    const int error =
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (error != 0) {
+      AWARN << "Failed to set the CPU affinity of thread pool worker "
+            << index << ": " << std::strerror(error);
+    }
+  }
+  // The nice value is per thread on Linux.
+  if (options_.nice != 0 &&
+      setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)),
+                  options_.nice) != 0) {
+    AWARN << "Failed to set the nice value of thread pool worker " << index
+          << " to " << options_.nice << ": " << std::strerror(errno);
+  }
+}
+
+void ThreadPool::Executor::WorkerLoop(const int index) {
+  current_executor_ = this;
+  current_worker_ = index;
+  ConfigureWorker(index);
+  while (true) {
+    if (RunPendingTask()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return stopped_ || num_queued_.load() > 0; });
+    // The queued tasks are run before stopping.
+    if (stopped_ && num_queued_.load() == 0) {
+      break;
+    }
+  }
+}
+
+ThreadPoolStats ThreadPool::Executor::GetStats() const {
+  ThreadPoolStats stats;
+  stats.num_tasks = num_tasks_.load();
+  stats.num_stolen = num_stolen_.load();
+  stats.num_inline = num_inline_.load();
+  stats.queue_depth = num_queued_.load();
+  stats.max_queue_depth = max_queue_depth_.load();
+  if (stats.num_tasks > 0) {
+    stats.mean_wait_us = total_wait_ns_.load() * 1e-3 / stats.num_tasks;
+    stats.mean_run_us = total_run_ns_.load() * 1e-3 / stats.num_tasks;
+  }
+  stats.max_wait_us = max_wait_ns_.load() * 1e-3;
+  stats.max_run_us = max_run_ns_.load() * 1e-3;
+  return stats;
+}
+
+std::string ThreadPoolStats::DebugString() const {
+  std::ostringstream ss;
+  ss << "tasks: " << num_tasks << ", stolen: " << num_stolen
+     << ", inline: " << num_inline << ", queue depth: " << queue_depth
+     << ", max queue depth: " << max_queue_depth
+     << ", wait us (mean/max): " << mean_wait_us << "/" << max_wait_us
+     << ", run us (mean/max): " << mean_run_us << "/" << max_run_us;
+  return ss.str();
+}
+
 ThreadPool::ThreadPool() {}
 
+ThreadPool::~ThreadPool() {}
+
 void ThreadPool::Init(int pool_size) {
-  instance()->pool_.reset(new ctpl::thread_pool(pool_size));
+  ThreadPoolOptions options;
+  options.num_threads = pool_size;
+  Init(options);
 }
 
-ctpl::thread_pool* ThreadPool::pool() {
-  return CHECK_NOTNULL(instance()->pool_.get());
+void ThreadPool::Init(const ThreadPoolOptions& options) {
+  Stop();
+  instance()->executor_.reset(new Executor(options));
 }
 
 void ThreadPool::Stop() {
-  if (instance()->pool_) {
-    instance()->pool_->stop(true);
+  auto& executor = instance()->executor_;
+  if (executor) {
+    executor.reset();
+  }
+}
+
+int ThreadPool::size() {
+  const auto& executor = instance()->executor_;
+  return executor ? executor->size() : 0;
+}
+
+ThreadPoolStats ThreadPool::GetStats() {
+  const auto& executor = instance()->executor_;
+  return executor ? executor->GetStats() : ThreadPoolStats();
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  const auto& executor = instance()->executor_;
+  if (executor) {
+    executor->Schedule(std::move(task));
+  } else {
+    task();
+  }
+}
+
+bool ThreadPool::RunPendingTask() {
+  const auto& executor = instance()->executor_;
+  return executor && executor->RunPendingTask();
+}
+
+void TaskGroup::Run(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_pending_;
+  }
+  ThreadPool::Schedule([this, task]() {
+    task();
+    // Notified under the lock, as the group may be destroyed as soon as
+    // Wait() sees no pending task.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--num_pending_ == 0) {
+      cv_.notify_all();
+    }
+  });
+}
+
+void TaskGroup::Wait() {
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (num_pending_ == 0) {
+        return;
+      }
+    }
+    // Helps with the queued tasks, so that a worker waiting for a nested
+    // group does not block the tasks of the group.
+    if (!ThreadPool::RunPendingTask()) {
+      break;
+    }
   }
+  // The pending tasks of the group are all running.
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return num_pending_ == 0; });
 }
 
 }  // namespace util
@@ -21,36 +21,125 @@
 #ifndef MODULES_COMMON_UTIL_THREAD_POOL_H_
 #define MODULES_COMMON_UTIL_THREAD_POOL_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
-#include "ctpl/ctpl_stl.h"
 #include "modules/common/macro.h"
 
 namespace apollo {
 namespace common {
 namespace util {
 
+struct ThreadPoolOptions {
+  int num_threads = 1;
+  // The max number of tasks queued on a worker. A task submitted to a full
+  // queue is run by the submitting thread instead.
+  std::size_t max_queue_size = 256;
+  // The CPUs which the workers are pinned to, in [0, CPU_SETSIZE), any CPU
+  // if empty.
+  std::vector<int> cpus;
+  // The nice value of the workers, 0 to inherit the one of the process.
+  int nice = 0;
+};
+
+struct ThreadPoolStats {
+  // The tasks run by the workers, and how many of them were stolen.
+  uint64_t num_tasks = 0;
+  uint64_t num_stolen = 0;
+  // The tasks run by the submitting thread, as the queue was full.
+  uint64_t num_inline = 0;
+  std::size_t queue_depth = 0;
+  std::size_t max_queue_depth = 0;
+  // How long the tasks waited in the queues, and ran for.
+  double mean_wait_us = 0.0;
+  double max_wait_us = 0.0;
+  double mean_run_us = 0.0;
+  double max_run_us = 0.0;
+
+  std::string DebugString() const;
+};
+
 /**
 * @class ThreadPool
 *
-* @brief A wrapper around ctpl thread pool.
-* TODO(authors): Eventually migrate other threadpool usages to this.
+* @brief The thread pool shared by the tasks of a module.
+*
+* Every worker has its own deque of tasks. A worker runs the tasks it submits
+* itself last in first out, and steals the oldest tasks of the other workers
+* when it runs out of them. Tasks are submitted through a TaskGroup.
 */
-
 class ThreadPool {
  public:
   static void Init(int pool_size);
 
-  static ctpl::thread_pool* pool();
+  static void Init(const ThreadPoolOptions& options);
 
+  /**
+   * @brief Runs the queued tasks and joins the workers. The tasks submitted
+   * afterwards are run by the submitting thread.
+   */
   static void Stop();
 
+  /**
+   * @brief The number of workers, or 0 if the pool is not running.
+   */
+  static int size();
+
+  static ThreadPoolStats GetStats();
+
  private:
-  std::unique_ptr<ctpl::thread_pool> pool_;
+  class Executor;
+  friend class TaskGroup;
+
+  static void Schedule(std::function<void()> task);
+  // Runs a queued task in the calling thread, if any.
+  static bool RunPendingTask();
+
+  ~ThreadPool();
+
+  std::unique_ptr<Executor> executor_;
 
   DECLARE_SINGLETON(ThreadPool);
 };
 
+/**
+* @class TaskGroup
+*
+* @brief Runs tasks in the ThreadPool and waits for them, e.g.
+*
+*   TaskGroup group;
+*   for (...) {
+*     group.Run([...]() { ... });
+*   }
+*   group.Wait();
+*
+* Wait() runs the queued tasks while it waits, so that groups may be nested
+* in the tasks of other groups.
+*/
+class TaskGroup {
+ public:
+  TaskGroup() = default;
+  ~TaskGroup() { Wait(); }
+
+  void Run(std::function<void()> task);
+
+  void Wait();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int num_pending_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskGroup);
+};
+
 }  // namespace util
 }  // namespace common
 }  // namespace apollo
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+class ThreadPoolTest : public ::testing::Test {
+ protected:
+  void TearDown() override { ThreadPool::Stop(); }
+};
+
+TEST_F(ThreadPoolTest, NotRunning) {
+  EXPECT_EQ(0, ThreadPool::size());
+  int result = 0;
+  TaskGroup group;
+  group.Run([&result]() { result = 1; });
+  EXPECT_EQ(1, result);
+  group.Wait();
+}
+
+TEST_F(ThreadPoolTest, RunTasks) {
+  ThreadPool::Init(3);
+  EXPECT_EQ(3, ThreadPool::size());
+
+  std::vector<int> results(100, 0);
+  TaskGroup group;
+  for (int i = 0; i < 100; ++i) {
+    group.Run([&results, i]() { results[i] = i * i; });
+  }
+  group.Wait();
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i * i, results[i]);
+  }
+
+  const ThreadPoolStats stats = ThreadPool::GetStats();
+  EXPECT_EQ(100, stats.num_tasks + stats.num_inline);
+  EXPECT_EQ(0, stats.queue_depth);
+  EXPECT_LE(stats.max_queue_depth, 100);
+  EXPECT_GE(stats.max_wait_us, stats.mean_wait_us);
+}
+
+TEST_F(ThreadPoolTest, NestedGroups) {
+  // More nested waits than workers.
+  ThreadPool::Init(2);
+  std::atomic<int> count(0);
+  TaskGroup group;
+  for (int i = 0; i < 8; ++i) {
+    group.Run([&count]() {
+      TaskGroup nested;
+      for (int j = 0; j < 8; ++j) {
+        nested.Run([&count]() { ++count; });
+      }
+      nested.Wait();
+    });
+  }
+  group.Wait();
+  EXPECT_EQ(64, count.load());
+}
+
+TEST_F(ThreadPoolTest, FullQueue) {
+  ThreadPoolOptions options;
+  options.num_threads = 1;
+  options.max_queue_size = 1;
+  options.cpus = {0};
+  options.nice = 1;
+  ThreadPool::Init(options);
+
+  std::atomic<bool> release(false);
+  std::atomic<int> count(0);
+  TaskGroup group;
+  group.Run([&release, &count]() {
+    while (!release.load()) {
+    }
+    ++count;
+  });
+  for (int i = 0; i < 10; ++i) {
+    group.Run([&count]() { ++count; });
+  }
+  // At most one task is queued behind the blocked one, the others were run
+  // by this thread.
+  EXPECT_GE(count.load(), 8);
+  release = true;
+  group.Wait();
+  EXPECT_EQ(11, count.load());
+  EXPECT_GE(ThreadPool::GetStats().num_inline, 8);
+}
+
+TEST_F(ThreadPoolTest, StopRunsQueuedTasks) {
+  ThreadPool::Init(1);
+  std::atomic<int> count(0);
+  {
+    TaskGroup group;
+    for (int i = 0; i < 10; ++i) {
+      group.Run([&count]() { ++count; });
+    }
+  }
+  EXPECT_EQ(10, count.load());
+  ThreadPool::Stop();
+  EXPECT_EQ(0, ThreadPool::size());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 #include "modules/common/log.h"
@@ -28,11 +29,18 @@
 namespace math = apollo::common::math;
 using apollo::common::PathPoint;
 using apollo::common::TrajectoryPoint;
+using apollo::common::math::AABoxKDTreeParams;
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
 
 namespace apollo {
 namespace control {
 namespace {
 
+// Number of points scanned on each side of the local minimum, so that small
+// wiggles of the trajectory do not stop the search early.
+const size_t kSearchWindow = 10;
+
 // Squared distance from the point to (x, y).
 double PointDistanceSquare(const TrajectoryPoint &point, const double x,
                            const double y) {
@@ -41,6 +49,25 @@ double PointDistanceSquare(const TrajectoryPoint &point, const double x,
   return dx * dx + dy * dy;
 }
 
+// Squared distance from the segment (p0, p1) to (x, y).
+double SegmentDistanceSquare(const TrajectoryPoint &p0,
+                             const TrajectoryPoint &p1, const double x,
+                             const double y) {
+  const double x0 = p0.path_point().x();
+  const double y0 = p0.path_point().y();
+  const double dx = p1.path_point().x() - x0;
+  const double dy = p1.path_point().y() - y0;
+  const double length_sqr = dx * dx + dy * dy;
+  double ratio = 0.0;
+  if (length_sqr > 0.0) {
+    ratio = ((x - x0) * dx + (y - y0) * dy) / length_sqr;
+    ratio = std::max(0.0, std::min(1.0, ratio));
+  }
+  const double ex = x0 + ratio * dx - x;
+  const double ey = y0 + ratio * dy - y;
+  return ex * ex + ey * ey;
+}
+
 PathPoint TrajectoryPointToPathPoint(const TrajectoryPoint &point) {
   if (point.has_path_point()) {
     return point.path_point();
@@ -65,18 +92,7 @@ TrajectoryAnalyzer::TrajectoryAnalyzer(
 
 PathPoint TrajectoryAnalyzer::QueryMatchedPathPoint(const double x,
                                                     const double y) const {
-  CHECK_GT(trajectory_points_.size(), 0);
-
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
-
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
-    if (d_temp < d_min) {
-      d_min = d_temp;
-      index_min = i;
-    }
-  }
+  const size_t index_min = QueryNearestPointIndex(x, y);
 
   size_t index_start = index_min == 0 ? index_min : index_min - 1;
   size_t index_end =
@@ -93,6 +109,37 @@ PathPoint TrajectoryAnalyzer::QueryMatchedPathPoint(const double x,
                               trajectory_points_[index_end], x, y);
 }
 
+PathPoint TrajectoryAnalyzer::QueryProjectedPathPoint(const double x,
+                                                      const double y) const {
+  CHECK_GT(trajectory_points_.size(), 0);
+  if (trajectory_points_.size() == 1) {
+    return TrajectoryPointToPathPoint(trajectory_points_.front());
+  }
+
+  const size_t index = QueryNearestSegmentIndex(x, y);
+  const PathPoint &p0 = trajectory_points_[index].path_point();
+  const PathPoint &p1 = trajectory_points_[index + 1].path_point();
+
+  const double dx = p1.x() - p0.x();
+  const double dy = p1.y() - p0.y();
+  const double length_sqr = dx * dx + dy * dy;
+  const double kEpsilon = 1e-6;
+  if (length_sqr < kEpsilon * kEpsilon) {
+    return p0;
+  }
+  double ratio = ((x - p0.x()) * dx + (y - p0.y()) * dy) / length_sqr;
+  ratio = std::max(0.0, std::min(1.0, ratio));
+
+  PathPoint p = p0;
+  p.set_x(math::lerp(p0.x(), 0.0, p1.x(), 1.0, ratio));
+  p.set_y(math::lerp(p0.y(), 0.0, p1.y(), 1.0, ratio));
+  p.set_s(math::lerp(p0.s(), 0.0, p1.s(), 1.0, ratio));
+  p.set_theta(math::slerp(p0.theta(), 0.0, p1.theta(), 1.0, ratio));
+  p.set_kappa(math::lerp(p0.kappa(), 0.0, p1.kappa(), 1.0, ratio));
+  p.set_dkappa(math::lerp(p0.dkappa(), 0.0, p1.dkappa(), 1.0, ratio));
+  return p;
+}
+
 // reference: Optimal trajectory generation for dynamic street scenarios in a
 // Frenét Frame,
 // Moritz Werling, Julius Ziegler, Sören Kammel and Sebastian Thrun, ICRA 2010
@@ -177,19 +224,124 @@ TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByRelativeTime(
 
 TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByPosition(
     const double x, const double y) const {
+  return trajectory_points_[QueryNearestPointIndex(x, y)];
+}
+
+size_t TrajectoryAnalyzer::QueryNearestPointIndex(const double x,
+                                                  const double y) const {
   CHECK_GT(trajectory_points_.size(), 0);
+  const size_t num_points = trajectory_points_.size();
 
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
+  // ties are resolved towards the smaller index, as a linear scan would
   size_t index_min = 0;
+  double d_min = std::numeric_limits<double>::infinity();
+  auto update = [&](const size_t i) {
+    const double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
+    if (d_temp < d_min || (d_temp == d_min && i < index_min)) {
+      d_min = d_temp;
+      index_min = i;
+    }
+  };
 
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
+  // short trajectories are cheaper to scan than to search
+  if (num_points <= 2 * kSearchWindow + 1) {
+    for (size_t i = 0; i < num_points; ++i) {
+      update(i);
+    }
+    last_match_index_ = index_min;
+    return index_min;
+  }
+
+  // descend from the previous match to a local minimum
+  index_min = std::min(last_match_index_, num_points - 1);
+  d_min = PointDistanceSquare(trajectory_points_[index_min], x, y);
+  while (index_min + 1 < num_points) {
+    const double d_temp =
+        PointDistanceSquare(trajectory_points_[index_min + 1], x, y);
+    if (d_temp >= d_min) {
+      break;
+    }
+    d_min = d_temp;
+    ++index_min;
+  }
+  while (index_min > 0) {
+    const double d_temp =
+        PointDistanceSquare(trajectory_points_[index_min - 1], x, y);
+    if (d_temp > d_min) {
+      break;
+    }
+    d_min = d_temp;
+    --index_min;
+  }
+
+  const size_t begin =
+      index_min > kSearchWindow ? index_min - kSearchWindow : 0;
+  const size_t end = std::min(num_points, index_min + kSearchWindow + 1);
+  for (size_t i = begin; i < end; ++i) {
+    update(i);
+  }
+
+  // Any point closer than the local match is an end point of a segment
+  // within the same distance, e.g. where the trajectory folds back or
+  // crosses itself. The query is cheap when the local match is close.
+  if (segment_kdtree_ == nullptr) {
+    BuildSegmentKDTree();
+  }
+  for (const auto *box :
+       segment_kdtree_->GetObjects(Vec2d(x, y), std::sqrt(d_min))) {
+    update(box->index());
+    update(box->index() + 1);
+  }
+
+  last_match_index_ = index_min;
+  return index_min;
+}
+
+size_t TrajectoryAnalyzer::QueryNearestSegmentIndex(const double x,
+                                                    const double y) const {
+  CHECK_GT(trajectory_points_.size(), 1);
+  const size_t num_segments = trajectory_points_.size() - 1;
+
+  const size_t index = QueryNearestPointIndex(x, y);
+  const size_t begin = index > kSearchWindow ? index - kSearchWindow : 0;
+  const size_t end = std::min(num_segments, index + kSearchWindow);
+
+  size_t index_min = begin;
+  double d_min = std::numeric_limits<double>::infinity();
+  for (size_t i = begin; i < end; ++i) {
+    const double d_temp = SegmentDistanceSquare(
+        trajectory_points_[i], trajectory_points_[i + 1], x, y);
     if (d_temp < d_min) {
       d_min = d_temp;
       index_min = i;
     }
   }
-  return trajectory_points_[index_min];
+
+  if (num_segments > 2 * kSearchWindow) {
+    if (segment_kdtree_ == nullptr) {
+      BuildSegmentKDTree();
+    }
+    const auto *box = segment_kdtree_->GetNearestObject(Vec2d(x, y));
+    if (box != nullptr && box->DistanceSquareTo(Vec2d(x, y)) < d_min) {
+      index_min = box->index();
+    }
+  }
+  return index_min;
+}
+
+void TrajectoryAnalyzer::BuildSegmentKDTree() const {
+  segment_boxes_.clear();
+  segment_boxes_.reserve(trajectory_points_.size());
+  for (size_t i = 0; i + 1 < trajectory_points_.size(); ++i) {
+    const auto &p0 = trajectory_points_[i].path_point();
+    const auto &p1 = trajectory_points_[i + 1].path_point();
+    segment_boxes_.emplace_back(
+        LineSegment2d(Vec2d(p0.x(), p0.y()), Vec2d(p1.x(), p1.y())), i);
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 16;
+  segment_kdtree_.reset(new SegmentKDTree(segment_boxes_, params));
 }
 
 const std::vector<TrajectoryPoint> &TrajectoryAnalyzer::trajectory_points()
@@ -22,10 +22,14 @@
 #ifndef MODULES_CONTROL_COMMON_TRAJECTORY_ANALYZER_H_
 #define MODULES_CONTROL_COMMON_TRAJECTORY_ANALYZER_H_
 
+#include <memory>
 #include <vector>
 
 #include "modules/planning/proto/planning.pb.h"
 
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/line_segment2d.h"
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 
@@ -39,6 +43,11 @@ namespace control {
 /**
  * @class TrajectoryAnalyzer
  * @brief process point query and conversion related to trajectory
+ *
+ * Position queries walk the trajectory starting from the previous match and
+ * only fall back to a KD-tree over the trajectory segments, built on first
+ * use, when the local search cannot be trusted. The previous match is cached
+ * in the analyzer, so an instance must not be queried concurrently.
  */
 class TrajectoryAnalyzer {
  public:
@@ -60,6 +69,9 @@ class TrajectoryAnalyzer {
    */
   ~TrajectoryAnalyzer() = default;
 
+  TrajectoryAnalyzer(TrajectoryAnalyzer &&other) = default;
+  TrajectoryAnalyzer &operator=(TrajectoryAnalyzer &&other) = default;
+
   /**
    * @brief get sequence number of the trajecotry
    * @return sequence number.
@@ -102,6 +114,17 @@ class TrajectoryAnalyzer {
    */
   common::PathPoint QueryMatchedPathPoint(const double x, const double y) const;
 
+  /**
+   * @brief project the given position onto the closest segment of the
+   * trajectory.
+   * @param x value of x-coordination in the given position
+   * @param y value of y-coordination in the given position
+   * @return the foot point on the trajectory, linearly interpolated between
+   * the two end points of the closest segment
+   */
+  common::PathPoint QueryProjectedPathPoint(const double x,
+                                            const double y) const;
+
   /**
    * @brief convert a position with theta and speed to trajectory frame,
    * - longitudinal and lateral direction to the trajectory
@@ -127,6 +150,36 @@ class TrajectoryAnalyzer {
   const std::vector<common::TrajectoryPoint> &trajectory_points() const;
 
  private:
+  class SegmentBox {
+   public:
+    SegmentBox(const common::math::LineSegment2d &segment, const size_t index)
+        : segment_(segment),
+          aabox_(segment.start(), segment.end()),
+          index_(index) {}
+    const common::math::AABox2d &aabox() const { return aabox_; }
+    double DistanceTo(const common::math::Vec2d &point) const {
+      return segment_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const common::math::Vec2d &point) const {
+      return segment_.DistanceSquareTo(point);
+    }
+    const common::math::LineSegment2d &segment() const { return segment_; }
+    size_t index() const { return index_; }
+
+   private:
+    common::math::LineSegment2d segment_;
+    common::math::AABox2d aabox_;
+    // index of the start point of the segment
+    size_t index_ = 0;
+  };
+  using SegmentKDTree = common::math::AABoxKDTree2d<SegmentBox>;
+
+  size_t QueryNearestPointIndex(const double x, const double y) const;
+
+  size_t QueryNearestSegmentIndex(const double x, const double y) const;
+
+  void BuildSegmentKDTree() const;
+
   common::PathPoint FindMinDistancePoint(const common::TrajectoryPoint &p0,
                                          const common::TrajectoryPoint &p1,
                                          const double x, const double y) const;
@@ -135,6 +188,12 @@ class TrajectoryAnalyzer {
 
   double header_time_ = 0.0;
   unsigned int seq_num_ = 0;
+
+  // index of the last matched point, seeds the next position query
+  mutable size_t last_match_index_ = 0;
+  // built lazily by the first query that cannot be answered locally
+  mutable std::vector<SegmentBox> segment_boxes_;
+  mutable std::unique_ptr<SegmentKDTree> segment_kdtree_;
 };
 
 }  // namespace control
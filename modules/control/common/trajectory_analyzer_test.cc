@@ -16,7 +16,10 @@
 
 #include "modules/control/common/trajectory_analyzer.h"
 
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -171,5 +174,141 @@ TEST_F(TrajectoryAnalyzerTest, QueryNearestPointByAbsoluteTimeInterpolation) {
   EXPECT_NEAR(point_6.path_point().x(), 1.0, 1e-6);
 }
 
+TEST_F(TrajectoryAnalyzerTest, QueryNearestPointByPositionLongTrajectory) {
+  planning::ADCTrajectory adc_trajectory;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (int i = 0; i < 600; ++i) {
+    xs.push_back(0.2 * i);
+    ys.push_back(3.0 * std::sin(0.01 * i));
+  }
+  SetTrajectory(xs, ys, &adc_trajectory);
+  TrajectoryAnalyzer trajectory_analyzer(&adc_trajectory);
+
+  auto brute_force_index = [&xs, &ys](const double x, const double y) {
+    size_t index_min = 0;
+    double d_min = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < xs.size(); ++i) {
+      const double d = (xs[i] - x) * (xs[i] - x) + (ys[i] - y) * (ys[i] - y);
+      if (d < d_min) {
+        d_min = d;
+        index_min = i;
+      }
+    }
+    return index_min;
+  };
+
+  // moving along the trajectory, then jumping back and far away
+  std::vector<std::pair<double, double>> queries;
+  for (int i = 0; i < 100; ++i) {
+    queries.emplace_back(1.1 * i, 0.3);
+  }
+  queries.emplace_back(5.0, -0.2);
+  queries.emplace_back(60.0, 20.0);
+  queries.emplace_back(-10.0, 0.0);
+  queries.emplace_back(200.0, 0.0);
+  for (const auto &query : queries) {
+    const size_t index = brute_force_index(query.first, query.second);
+    TrajectoryPoint point = trajectory_analyzer.QueryNearestPointByPosition(
+        query.first, query.second);
+    EXPECT_DOUBLE_EQ(xs[index], point.path_point().x());
+    EXPECT_DOUBLE_EQ(ys[index], point.path_point().y());
+  }
+}
+
+TEST_F(TrajectoryAnalyzerTest, QueryNearestPointByPositionUTurn) {
+  planning::ADCTrajectory adc_trajectory;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (int i = 0; i < 50; ++i) {
+    xs.push_back(0.5 * i);
+    ys.push_back(0.0);
+  }
+  for (int i = 49; i >= 0; --i) {
+    xs.push_back(0.5 * i);
+    ys.push_back(5.0);
+  }
+  SetTrajectory(xs, ys, &adc_trajectory);
+  TrajectoryAnalyzer trajectory_analyzer(&adc_trajectory);
+
+  // the first leg is a local minimum, the second leg is closer
+  TrajectoryPoint point =
+      trajectory_analyzer.QueryNearestPointByPosition(1.0, 3.0);
+  EXPECT_DOUBLE_EQ(1.0, point.path_point().x());
+  EXPECT_DOUBLE_EQ(5.0, point.path_point().y());
+
+  point = trajectory_analyzer.QueryNearestPointByPosition(1.0, 1.0);
+  EXPECT_DOUBLE_EQ(1.0, point.path_point().x());
+  EXPECT_DOUBLE_EQ(0.0, point.path_point().y());
+}
+
+TEST_F(TrajectoryAnalyzerTest, QueryNearestPointByPositionSelfOverlapping) {
+  planning::ADCTrajectory adc_trajectory;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  // forward, then reversing back 0.6m aside, as in open space maneuvers,
+  // then crossing both legs
+  for (int i = 0; i < 50; ++i) {
+    xs.push_back(0.5 * i);
+    ys.push_back(0.0);
+  }
+  for (int i = 49; i >= 0; --i) {
+    xs.push_back(0.5 * i);
+    ys.push_back(0.6);
+  }
+  for (int i = 0; i < 20; ++i) {
+    xs.push_back(5.0);
+    ys.push_back(-2.0 + 0.25 * i);
+  }
+  SetTrajectory(xs, ys, &adc_trajectory);
+  TrajectoryAnalyzer trajectory_analyzer(&adc_trajectory);
+
+  auto brute_force_index = [&xs, &ys](const double x, const double y) {
+    size_t index_min = 0;
+    double d_min = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < xs.size(); ++i) {
+      const double d = (xs[i] - x) * (xs[i] - x) + (ys[i] - y) * (ys[i] - y);
+      if (d < d_min) {
+        d_min = d;
+        index_min = i;
+      }
+    }
+    return index_min;
+  };
+
+  // the local match on one leg is within 1m, the other leg is closer
+  std::vector<std::pair<double, double>> queries = {
+      {2.0, 0.1}, {2.0, 0.5}, {2.1, 0.05}, {4.9, 0.35}, {5.1, 0.25},
+      {5.0, -1.0}, {5.05, 0.58}, {12.0, 0.2}, {12.0, 0.45}};
+  for (const auto &query : queries) {
+    const size_t index = brute_force_index(query.first, query.second);
+    TrajectoryPoint point = trajectory_analyzer.QueryNearestPointByPosition(
+        query.first, query.second);
+    EXPECT_DOUBLE_EQ(xs[index], point.path_point().x())
+        << query.first << ", " << query.second;
+    EXPECT_DOUBLE_EQ(ys[index], point.path_point().y())
+        << query.first << ", " << query.second;
+  }
+}
+
+TEST_F(TrajectoryAnalyzerTest, QueryProjectedPathPoint) {
+  planning::ADCTrajectory adc_trajectory;
+  std::vector<double> xs = {1.0, 1.1, 1.2, 1.3, 1.8};
+  std::vector<double> ys = {1.0, 1.1, 1.2, 1.3, 1.8};
+  std::vector<double> ss = {1.0, 1.1, 1.2, 1.3, 1.8};
+  SetTrajectory(xs, ys, ss, &adc_trajectory);
+  TrajectoryAnalyzer trajectory_analyzer(&adc_trajectory);
+
+  PathPoint point = trajectory_analyzer.QueryProjectedPathPoint(1.56, 1.50);
+  EXPECT_NEAR(point.x(), 1.53, 1e-6);
+  EXPECT_NEAR(point.y(), 1.53, 1e-6);
+  EXPECT_NEAR(point.s(), 1.53, 1e-6);
+
+  // beyond the end of the trajectory
+  point = trajectory_analyzer.QueryProjectedPathPoint(3.0, 2.0);
+  EXPECT_NEAR(point.x(), 1.8, 1e-6);
+  EXPECT_NEAR(point.y(), 1.8, 1e-6);
+}
+
 }  // namespace control
 }  // namespace apollo
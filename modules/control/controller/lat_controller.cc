@@ -48,6 +48,10 @@ using apollo::common::time::Clock;
 
 namespace {
 
+// The control loop carries the riccati solution over cycles, while a gain
+// table entry is solved once, so it gets this many times the iterations.
+constexpr int kLqrGainTableIterationScale = 100;
+
 std::string GetLogFileName() {
   time_t raw_time;
   char name_buffer[80];
@@ -226,9 +230,14 @@ Status LatController::Init(const ControlConf *control_conf) {
   }
 
   matrix_q_updated_ = matrix_q_;
+  matrix_p_ = Matrix::Zero(matrix_size, matrix_size);
   InitializeFilters(control_conf);
   auto &lat_controller_conf = control_conf->lat_controller_conf();
   LoadLatGainScheduler(lat_controller_conf);
+  lqr_gain_table_.clear();
+  if (lat_controller_conf.enable_lqr_gain_table()) {
+    BuildLqrGainTable(lat_controller_conf);
+  }
   LogInitParameters();
   return Status::OK();
 }
@@ -263,6 +272,75 @@ void LatController::LoadLatGainScheduler(
       << "Fail to load heading error gain scheduler";
 }
 
+void LatController::BuildLqrGainTable(
+    const LatControllerConf &lat_controller_conf) {
+  lqr_gain_table_resolution_ =
+      lat_controller_conf.lqr_gain_table_speed_resolution();
+  CHECK_GT(lqr_gain_table_resolution_, 0.0)
+      << "Invalid lqr gain table speed resolution";
+  const int num_entries = static_cast<int>(std::ceil(
+                              lat_controller_conf.lqr_gain_table_max_speed() /
+                              lqr_gain_table_resolution_)) +
+                          1;
+  // Speed is the only runtime input of both the discrete model and the gain
+  // scheduler, so the gains can be solved once here, each entry warm started
+  // from its neighbour.
+  lqr_gain_table_.reserve(num_entries);
+  for (int i = 0; i < num_entries; ++i) {
+    const double v = i * lqr_gain_table_resolution_;
+    UpdateMatrix(std::max(v, minimum_speed_protection_));
+    UpdateMatrixCompound();
+    UpdateMatrixQ(v);
+    ComputeLqrGain(matrix_q_updated_,
+                   lqr_max_iteration_ * kLqrGainTableIterationScale);
+    lqr_gain_table_.push_back(matrix_k_);
+  }
+  AINFO << "Lateral control lqr gain table built with " << num_entries
+        << " entries";
+}
+
+void LatController::InterpolateLqrGain(const double v) {
+  const double index = std::max(v, 0.0) / lqr_gain_table_resolution_;
+  const int lower = static_cast<int>(index);
+  const int last = static_cast<int>(lqr_gain_table_.size()) - 1;
+  if (lower >= last) {
+    matrix_k_ = lqr_gain_table_.back();
+    return;
+  }
+  const double ratio = index - lower;
+  matrix_k_ = (1.0 - ratio) * lqr_gain_table_[lower] +
+              ratio * lqr_gain_table_[lower + 1];
+}
+
+void LatController::UpdateMatrixQ(const double v) {
+  if (FLAGS_enable_gain_scheduler) {
+    matrix_q_updated_(0, 0) =
+        matrix_q_(0, 0) * lat_err_interpolation_->Interpolate(v);
+    matrix_q_updated_(2, 2) =
+        matrix_q_(2, 2) * heading_err_interpolation_->Interpolate(v);
+  } else {
+    matrix_q_updated_ = matrix_q_;
+  }
+}
+
+void LatController::ComputeLqrGain(const Matrix &matrix_q,
+                                   const int max_num_iteration) {
+  if (preview_window_ == 0) {
+    // fixed-size solve for the plain four-state model
+    Eigen::Matrix<double, 4, 4> matrix_p = matrix_p_;
+    Eigen::Matrix<double, 1, 4> matrix_k;
+    common::math::SolveLQRProblem<4, 1>(
+        matrix_adc_, matrix_bdc_, matrix_q, matrix_r_, lqr_eps_,
+        max_num_iteration, &matrix_p, &matrix_k);
+    matrix_p_ = matrix_p;
+    matrix_k_ = matrix_k;
+  } else {
+    common::math::SolveLQRProblem<Eigen::Dynamic, Eigen::Dynamic>(
+        matrix_adc_, matrix_bdc_, matrix_q, matrix_r_, lqr_eps_,
+        max_num_iteration, &matrix_p_, &matrix_k_);
+  }
+}
+
 void LatController::Stop() { CloseLogFile(); }
 
 std::string LatController::Name() const { return name_; }
@@ -351,28 +429,18 @@ Status LatController::ComputeControlCommand(
   // Error Rate, preview lateral error1 , preview lateral error2, ...]
   UpdateState(debug);
 
-  UpdateMatrix();
+  if (!lqr_gain_table_.empty()) {
+    // gains precomputed over speed at init, no riccati iterations here
+    InterpolateLqrGain(VehicleStateProvider::instance()->linear_velocity());
+  } else {
+    UpdateMatrix();
 
-  // Compound discrete matrix with road preview model
-  UpdateMatrixCompound();
+    // Compound discrete matrix with road preview model
+    UpdateMatrixCompound();
 
-  // Add gain scheduler for higher speed steering
-  if (FLAGS_enable_gain_scheduler) {
-    matrix_q_updated_(0, 0) =
-        matrix_q_(0, 0) *
-        lat_err_interpolation_->Interpolate(
-            VehicleStateProvider::instance()->linear_velocity());
-    matrix_q_updated_(2, 2) =
-        matrix_q_(2, 2) *
-        heading_err_interpolation_->Interpolate(
-            VehicleStateProvider::instance()->linear_velocity());
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
-  } else {
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
+    // Add gain scheduler for higher speed steering
+    UpdateMatrixQ(VehicleStateProvider::instance()->linear_velocity());
+    ComputeLqrGain(matrix_q_updated_, lqr_max_iteration_);
   }
 
   // feedback = - K * state
@@ -505,8 +573,11 @@ void LatController::UpdateState(SimpleLateralDebug *debug) {
 }
 
 void LatController::UpdateMatrix() {
-  const double v = std::max(VehicleStateProvider::instance()->linear_velocity(),
-                            minimum_speed_protection_);
+  UpdateMatrix(std::max(VehicleStateProvider::instance()->linear_velocity(),
+                        minimum_speed_protection_));
+}
+
+void LatController::UpdateMatrix(const double v) {
   matrix_a_(1, 1) = matrix_a_coeff_(1, 1) / v;
   matrix_a_(1, 3) = matrix_a_coeff_(1, 3) / v;
   matrix_a_(3, 1) = matrix_a_coeff_(3, 1) / v;
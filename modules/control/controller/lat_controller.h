@@ -25,6 +25,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "Eigen/Core"
 
@@ -106,8 +107,19 @@ class LatController : public Controller {
 
   void UpdateMatrix();
 
+  void UpdateMatrix(const double v);
+
   void UpdateMatrixCompound();
 
+  void UpdateMatrixQ(const double v);
+
+  void ComputeLqrGain(const Eigen::MatrixXd &matrix_q,
+                      const int max_num_iteration);
+
+  void BuildLqrGainTable(const LatControllerConf &lat_controller_conf);
+
+  void InterpolateLqrGain(const double v);
+
   double ComputeFeedForward(double ref_curvature) const;
 
   void ComputeLateralErrors(const double x, const double y, const double theta,
@@ -188,6 +200,12 @@ class LatController : public Controller {
   int lqr_max_iteration_ = 0;
   // parameters for lqr solver; threshold for computation
   double lqr_eps_ = 0.0;
+  // riccati solution of the last cycle, warm starts the lqr solver
+  Eigen::MatrixXd matrix_p_;
+
+  // lqr gains precomputed at speed i * lqr_gain_table_resolution_
+  std::vector<Eigen::MatrixXd> lqr_gain_table_;
+  double lqr_gain_table_resolution_ = 0.0;
 
   common::DigitalFilter digital_filter_;
 
@@ -19,10 +19,12 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "modules/common/log.h"
+#include "modules/common/math/linear_quadratic_regulator.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/file.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
@@ -62,6 +64,19 @@ class LatControllerTest : public ::testing::Test, LatController {
                                         trajectory_analyzer, debug);
   }
 
+  common::Status Init(const ControlConf *control_conf) {
+    return LatController::Init(control_conf);
+  }
+
+  const std::vector<Eigen::MatrixXd> &lqr_gain_table() const {
+    return lqr_gain_table_;
+  }
+
+  Eigen::MatrixXd InterpolateLqrGain(const double v) {
+    LatController::InterpolateLqrGain(v);
+    return matrix_k_;
+  }
+
  protected:
   LocalizationPb LoadLocalizaionPb(const std::string &filename) {
     LocalizationPb localization_pb;
@@ -88,6 +103,18 @@ class LatControllerTest : public ::testing::Test, LatController {
     return planning_trajectory_pb;
   }
 
+  // Gain solved directly at speed v, starting from the cost matrix.
+  Eigen::MatrixXd SolveLqrGain(const double v, const int max_num_iteration) {
+    UpdateMatrix(v);
+    UpdateMatrixCompound();
+    UpdateMatrixQ(v);
+    Eigen::MatrixXd matrix_k;
+    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
+                                  matrix_r_, lqr_eps_, max_num_iteration,
+                                  &matrix_k);
+    return matrix_k;
+  }
+
   LatControllerConf lateral_conf_;
 
   double timestamp_ = 0.0;
@@ -131,5 +158,43 @@ TEST_F(LatControllerTest, ComputeLateralErrors) {
   EXPECT_NEAR(debug->curvature(), matched_kappa_expected, 0.001);
 }
 
+TEST_F(LatControllerTest, LqrGainTable) {
+  ControlConf control_conf;
+  CHECK(apollo::common::util::GetProtoFromFile(
+      "modules/control/testdata/conf/lincoln.pb.txt", &control_conf));
+  auto *lat_controller_conf = control_conf.mutable_lat_controller_conf();
+  lat_controller_conf->set_enable_lqr_gain_table(true);
+  lat_controller_conf->set_lqr_gain_table_speed_resolution(0.5);
+  lat_controller_conf->set_lqr_gain_table_max_speed(20.0);
+  // A tight tolerance, so that the entries and the direct solves converge to
+  // the same gains and only the interpolation error is left.
+  lat_controller_conf->set_eps(1e-6);
+  lat_controller_conf->set_max_iteration(1000);
+  ASSERT_TRUE(Init(&control_conf).ok());
+  const std::vector<Eigen::MatrixXd> &table = lqr_gain_table();
+  ASSERT_EQ(41, table.size());
+
+  // Between the knots, the interpolated gain is close to the solved one.
+  for (const double v : {1.25, 5.3, 12.75, 19.9}) {
+    const Eigen::MatrixXd interpolated = InterpolateLqrGain(v);
+    const Eigen::MatrixXd solved = SolveLqrGain(v, 100000);
+    ASSERT_EQ(solved.cols(), interpolated.cols());
+    EXPECT_LT((interpolated - solved).norm(), 1e-3 * solved.norm())
+        << "v = " << v;
+  }
+
+  // At a knot, the gain is the entry.
+  EXPECT_TRUE(InterpolateLqrGain(6.0).isApprox(table[12]));
+
+  // Below the first knot, including a negative speed when reversing, the
+  // gain is the first entry.
+  EXPECT_TRUE(InterpolateLqrGain(0.0).isApprox(table.front()));
+  EXPECT_TRUE(InterpolateLqrGain(-3.0).isApprox(table.front()));
+
+  // From the last knot on, the gain is the last entry.
+  EXPECT_TRUE(InterpolateLqrGain(20.0).isApprox(table.back()));
+  EXPECT_TRUE(InterpolateLqrGain(35.0).isApprox(table.back()));
+}
+
 }  // namespace control
 }  // namespace apollo
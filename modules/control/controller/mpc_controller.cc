@@ -114,6 +114,12 @@ bool MPCController::LoadControlConf(const ControlConf *control_conf) {
   standstill_acceleration_ =
       control_conf->mpc_controller_conf().standstill_acceleration();
 
+  if (control_conf->mpc_controller_conf().use_riccati_mpc_solver()) {
+    mpc_solver_.reset(new common::math::RiccatiMpcSolver());
+  } else {
+    mpc_solver_.reset();
+  }
+
   LoadControlCalibrationTable(control_conf->mpc_controller_conf());
   AINFO << "MPC conf loaded";
   return true;
@@ -347,10 +353,19 @@ Status MPCController::ComputeControlCommand(
   double mpc_start_timestamp = Clock::NowInSeconds();
   double steer_angle_feedback = 0.0;
   double acc_feedback = 0.0;
-  if (common::math::SolveLinearMPC(
-          matrix_ad_, matrix_bd_, matrix_cd_, matrix_q_updated_,
-          matrix_r_updated_, lower_bound, upper_bound, matrix_state_, reference,
-          mpc_eps_, mpc_max_iteration_, &control) != true) {
+  bool mpc_solved = false;
+  if (mpc_solver_) {
+    mpc_solved = mpc_solver_->Solve(
+        matrix_ad_, matrix_bd_, matrix_cd_, matrix_q_updated_,
+        matrix_r_updated_, lower_bound, upper_bound, matrix_state_, reference,
+        mpc_eps_, mpc_max_iteration_, &control);
+  } else {
+    mpc_solved = common::math::SolveLinearMPC(
+        matrix_ad_, matrix_bd_, matrix_cd_, matrix_q_updated_,
+        matrix_r_updated_, lower_bound, upper_bound, matrix_state_, reference,
+        mpc_eps_, mpc_max_iteration_, &control);
+  }
+  if (!mpc_solved) {
     AERROR << "MPC solver failed";
     steer_angle_feedback = 0.0;
     acc_feedback = 0.0;
@@ -458,6 +473,9 @@ Status MPCController::ComputeControlCommand(
 Status MPCController::Reset() {
   previous_heading_error_ = 0.0;
   previous_lateral_error_ = 0.0;
+  if (mpc_solver_) {
+    mpc_solver_->Reset();
+  }
   return Status::OK();
 }
 
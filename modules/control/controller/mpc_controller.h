@@ -33,6 +33,7 @@
 #include "modules/common/filters/digital_filter.h"
 #include "modules/common/filters/digital_filter_coefficients.h"
 #include "modules/common/filters/mean_filter.h"
+#include "modules/common/math/riccati_mpc_solver.h"
 #include "modules/control/common/interpolation_1d.h"
 #include "modules/control/common/interpolation_2d.h"
 #include "modules/control/common/trajectory_analyzer.h"
@@ -214,6 +215,8 @@ class MPCController : public Controller {
   int mpc_max_iteration_ = 0;
   // parameters for mpc solver; threshold for computation
   double mpc_eps_ = 0.0;
+  // structured mpc solver, only created when enabled in the conf
+  std::unique_ptr<common::math::RiccatiMpcSolver> mpc_solver_;
 
   common::DigitalFilter digital_filter_;
 
@@ -84,7 +84,31 @@ DEFINE_double(voxel_filter_size, 0.3, "VoxelGrid pointcloud filter leaf size");
 DEFINE_double(voxel_filter_height, 0.2,
               "VoxelGrid pointcloud filter leaf height");
 
+DEFINE_int32(point_cloud_num_levels, 3,
+             "Number of levels of detail the point cloud is sent in, from 1 "
+             "to 16.");
+
+DEFINE_double(point_cloud_resolution, 0.01,
+              "Resolution in meters of the point cloud coordinates sent to "
+              "the frontend, which are 16-bit.");
+
 DEFINE_double(system_status_lifetime_seconds, 30,
               "Lifetime of a valid SystemStatus message. It's more like a "
               "replay message if the timestamp is old, where we should ignore "
               "the status change.");
+
+DEFINE_int32(sim_world_delta_history_size, 20,
+             "Number of latest simulation worlds kept as the bases of the "
+             "deltas sent to the frontend.");
+
+DEFINE_double(map_tile_size, 256.0,
+              "Width in meters of the map tiles at level of detail 0, which "
+              "doubles with each level.");
+
+DEFINE_int32(map_tile_max_lod, 4, "Coarsest level of detail of map tiles.");
+
+DEFINE_int32(map_tile_cache_size, 256, "Number of map tiles kept in memory.");
+
+DEFINE_double(map_tile_simplify_angle, 0.05,
+              "Heading change in radians accumulated along the curves of map "
+              "tiles before a point is kept, per level of detail.");
@@ -57,6 +57,20 @@ DECLARE_double(voxel_filter_size);
 
 DECLARE_double(voxel_filter_height);
 
+DECLARE_int32(point_cloud_num_levels);
+
+DECLARE_double(point_cloud_resolution);
+
 DECLARE_double(system_status_lifetime_seconds);
 
+DECLARE_int32(sim_world_delta_history_size);
+
+DECLARE_double(map_tile_size);
+
+DECLARE_int32(map_tile_max_lod);
+
+DECLARE_int32(map_tile_cache_size);
+
+DECLARE_double(map_tile_simplify_angle);
+
 #endif  // MODULES_DREAMVIEW_BACKEND_COMMON_DREAMVIEW_GFLAGS_H_
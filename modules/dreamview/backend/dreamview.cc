@@ -115,6 +115,7 @@ Status Dreamview::Init() {
   map_ws_.reset(new WebSocketHandler("Map"));
   point_cloud_ws_.reset(new WebSocketHandler("PointCloud"));
   map_service_.reset(new MapService());
+  map_tile_.reset(new MapTileHandler(map_service_.get()));
   sim_control_.reset(new SimControl(map_service_.get()));
 
   sim_world_updater_.reset(new SimulationWorldUpdater(
@@ -127,6 +128,7 @@ Status Dreamview::Init() {
   server_->addWebSocketHandler("/map", *map_ws_);
   server_->addWebSocketHandler("/pointcloud", *point_cloud_ws_);
   server_->addHandler("/image", *image_);
+  server_->addHandler("/maptile", *map_tile_);
 
   ApolloApp::SetCallbackThreadNumber(FLAGS_dreamview_worker_num);
 
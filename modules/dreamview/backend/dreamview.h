@@ -25,6 +25,7 @@
 #include "modules/common/apollo_app.h"
 
 #include "modules/dreamview/backend/handlers/image_handler.h"
+#include "modules/dreamview/backend/handlers/map_tile_handler.h"
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 #include "modules/dreamview/backend/hmi/hmi.h"
 #include "modules/dreamview/backend/map/map_service.h"
@@ -61,6 +62,7 @@ class Dreamview : public apollo::common::ApolloApp {
   std::unique_ptr<WebSocketHandler> map_ws_;
   std::unique_ptr<WebSocketHandler> point_cloud_ws_;
   std::unique_ptr<ImageHandler> image_;
+  std::unique_ptr<MapTileHandler> map_tile_;
   std::unique_ptr<MapService> map_service_;
   std::unique_ptr<HMI> hmi_;
 };
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/handlers/map_tile_handler.h"
+
+#include <cstdlib>
+#include <string>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+bool GetIntParam(struct mg_connection *conn, const char *name, int *value) {
+  std::string param;
+  if (!CivetServer::getParam(conn, name, param) || param.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  const long parsed = std::strtol(param.c_str(), &end, 10);  // NOLINT
+  if (*end != '\0') {
+    return false;
+  }
+  *value = static_cast<int>(parsed);
+  return true;
+}
+
+}  // namespace
+
+MapTileHandler::MapTileHandler(const MapService *map_service)
+    : map_service_(map_service) {}
+
+bool MapTileHandler::handleGet(CivetServer *server,
+                               struct mg_connection *conn) {
+  int x = 0;
+  int y = 0;
+  int lod = 0;
+  if (!GetIntParam(conn, "x", &x) || !GetIntParam(conn, "y", &y) ||
+      !GetIntParam(conn, "lod", &lod)) {
+    mg_printf(conn,
+              "HTTP/1.1 400 Bad Request\r\n"
+              "Connection: close\r\n"
+              "Content-Length: 0\r\n"
+              "\r\n");
+    return true;
+  }
+
+  std::string tile;
+  std::string etag;
+  if (!map_service_->RetrieveMapTile(x, y, lod, &tile, &etag)) {
+    AWARN << "Failed to retrieve map tile " << lod << "/" << x << "/" << y;
+    mg_printf(conn,
+              "HTTP/1.1 404 Not Found\r\n"
+              "Connection: close\r\n"
+              "Content-Length: 0\r\n"
+              "\r\n");
+    return true;
+  }
+
+  // The map may be reloaded, so the cached tiles are always revalidated.
+  const char *if_none_match = CivetServer::getHeader(conn, "If-None-Match");
+  if (if_none_match != nullptr && etag == if_none_match) {
+    mg_printf(conn,
+              "HTTP/1.1 304 Not Modified\r\n"
+              "Connection: close\r\n"
+              "Cache-Control: no-cache\r\n"
+              "ETag: %s\r\n"
+              "\r\n",
+              etag.c_str());
+    return true;
+  }
+
+  mg_printf(conn,
+            "HTTP/1.1 200 OK\r\n"
+            "Connection: close\r\n"
+            "Cache-Control: no-cache\r\n"
+            "ETag: %s\r\n"
+            "Content-Type: application/octet-stream\r\n"
+            "Content-Length: %zu\r\n"
+            "\r\n",
+            etag.c_str(), tile.size());
+  if (!tile.empty() && mg_write(conn, tile.data(), tile.size()) <= 0) {
+    AWARN << "Failed to send map tile " << lod << "/" << x << "/" << y;
+  }
+  return true;
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DREAMVIEW_BACKEND_HANDLERS_MAP_TILE_HANDLER_H_
+#define MODULES_DREAMVIEW_BACKEND_HANDLERS_MAP_TILE_HANDLER_H_
+
+#include "CivetServer.h"
+
+#include "modules/dreamview/backend/map/map_service.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class MapTileHandler
+ *
+ * @brief The MapTileHandler, built on top of CivetHandler, serves the map
+ * tiles of MapService at /maptile?x=<x>&y=<y>&lod=<lod> as binary hdmap::Map
+ * protos. Tiles carry an ETag, so that browsers revalidate their cached copy
+ * and only download tiles which changed with a map reload.
+ */
+class MapTileHandler : public CivetHandler {
+ public:
+  explicit MapTileHandler(const MapService *map_service);
+
+  bool handleGet(CivetServer *server, struct mg_connection *conn);
+
+ private:
+  const MapService *map_service_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
+
+#endif  // MODULES_DREAMVIEW_BACKEND_HANDLERS_MAP_TILE_HANDLER_H_
@@ -17,19 +17,27 @@
 #include "modules/dreamview/backend/map/map_service.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <functional>
+#include <utility>
 
 #include "modules/common/util/json_util.h"
+#include "modules/common/util/points_downsampler.h"
 #include "modules/common/util/string_util.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/map/hdmap/hdmap_util.h"
 
 namespace apollo {
 namespace dreamview {
 
 using apollo::common::PointENU;
+using apollo::common::util::DownsampleByAngle;
 using apollo::common::util::JsonUtil;
+using apollo::common::util::StrCat;
 using apollo::hdmap::ClearAreaInfoConstPtr;
 using apollo::hdmap::CrosswalkInfoConstPtr;
+using apollo::hdmap::Curve;
 using apollo::hdmap::HDMapUtil;
 using apollo::hdmap::Id;
 using apollo::hdmap::JunctionInfoConstPtr;
@@ -103,11 +111,52 @@ void ExtractRoadAndLaneIds(const std::vector<LaneInfoConstPtr> &lanes,
   std::sort(road_ids->begin(), road_ids->end());
 }
 
+// Keeps the points of the line segments where the heading has changed by
+// more than angle_threshold since the last kept one.
+void SimplifyCurve(const double angle_threshold, Curve *curve) {
+  for (auto &segment : *curve->mutable_segment()) {
+    if (!segment.has_line_segment()) {
+      continue;
+    }
+    auto *points = segment.mutable_line_segment()->mutable_point();
+    const std::vector<int> indices =
+        DownsampleByAngle(*points, angle_threshold);
+    if (indices.size() == static_cast<size_t>(points->size())) {
+      continue;
+    }
+    RepeatedPtrField<PointENU> sampled;
+    sampled.Reserve(static_cast<int>(indices.size()));
+    for (const int index : indices) {
+      *sampled.Add() = points->Get(index);
+    }
+    points->Swap(&sampled);
+  }
+}
+
+void SimplifyMap(const double angle_threshold, Map *map) {
+  for (auto &lane : *map->mutable_lane()) {
+    SimplifyCurve(angle_threshold, lane.mutable_central_curve());
+    SimplifyCurve(angle_threshold,
+                  lane.mutable_left_boundary()->mutable_curve());
+    SimplifyCurve(angle_threshold,
+                  lane.mutable_right_boundary()->mutable_curve());
+  }
+  for (auto &road : *map->mutable_road()) {
+    for (auto &section : *road.mutable_section()) {
+      auto *polygon = section.mutable_boundary()->mutable_outer_polygon();
+      for (auto &edge : *polygon->mutable_edge()) {
+        SimplifyCurve(angle_threshold, edge.mutable_curve());
+      }
+    }
+  }
+}
+
 }  // namespace
 
 const char MapService::kMetaFileName[] = "/metaInfo.json";
 
-MapService::MapService(bool use_sim_map) : use_sim_map_(use_sim_map) {
+MapService::MapService(bool use_sim_map)
+    : use_sim_map_(use_sim_map), tile_cache_(FLAGS_map_tile_cache_size) {
   ReloadMap(false);
 }
 
@@ -117,6 +166,11 @@ bool MapService::ReloadMap(bool force_reload) {
   if (force_reload) {
     ret = HDMapUtil::ReloadMaps();
   }
+  {
+    std::lock_guard<std::mutex> lock(tile_cache_mutex_);
+    tile_cache_.Clear();
+    ++tile_cache_generation_;
+  }
 
   // Update the x,y-offsets if present.
   UpdateOffsets();
@@ -321,6 +375,58 @@ Map MapService::RetrieveMapElements(const MapElementIds &ids) const {
   return result;
 }
 
+bool MapService::RetrieveMapTile(const int x, const int y, const int lod,
+                                 std::string *tile, std::string *etag) const {
+  if (lod < 0 || lod > FLAGS_map_tile_max_lod || !MapReady()) {
+    return false;
+  }
+  const std::string key = StrCat(lod, "/", x, "/", y);
+  uint64_t generation = 0;
+  {
+    std::lock_guard<std::mutex> lock(tile_cache_mutex_);
+    const MapTile *cached = tile_cache_.Get(key);
+    if (cached != nullptr) {
+      *tile = cached->data;
+      *etag = cached->etag;
+      return true;
+    }
+    generation = tile_cache_generation_;
+  }
+
+  const double size = FLAGS_map_tile_size * static_cast<double>(1 << lod);
+  PointENU center;
+  center.set_x((x + 0.5) * size);
+  center.set_y((y + 0.5) * size);
+  MapElementIds ids;
+  CollectMapElementIds(center, size * M_SQRT1_2, &ids);
+  if (lod > 0) {
+    // Details which are too small to see from afar.
+    ids.clear_clear_area();
+    ids.clear_crosswalk();
+    ids.clear_signal();
+    ids.clear_stop_sign();
+    ids.clear_yield();
+    ids.clear_overlap();
+  }
+  Map map = RetrieveMapElements(ids);
+  if (lod > 0) {
+    SimplifyMap(FLAGS_map_tile_simplify_angle * lod, &map);
+  }
+
+  MapTile new_tile;
+  map.SerializeToString(&new_tile.data);
+  new_tile.etag =
+      StrCat("\"", std::hash<std::string>()(new_tile.data), "\"");
+  *tile = new_tile.data;
+  *etag = new_tile.etag;
+
+  std::lock_guard<std::mutex> lock(tile_cache_mutex_);
+  if (generation == tile_cache_generation_) {
+    tile_cache_.Put(key, std::move(new_tile));
+  }
+  return true;
+}
+
 bool MapService::GetNearestLane(const double x, const double y,
                                 LaneInfoConstPtr *nearest_lane,
                                 double *nearest_s, double *nearest_l) const {
@@ -21,12 +21,14 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_MAP_MAP_SERVICE_H_
 #define MODULES_DREAMVIEW_BACKEND_MAP_MAP_SERVICE_H_
 
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "boost/thread/locks.hpp"
 #include "boost/thread/shared_mutex.hpp"
 
+#include "modules/common/util/lru_cache.h"
 #include "modules/dreamview/proto/simulation_world.pb.h"
 #include "modules/map/pnc_map/pnc_map.h"
 #include "third_party/json/json.hpp"
@@ -60,6 +62,18 @@ class MapService {
   // javascript clients.
   hdmap::Map RetrieveMapElements(const MapElementIds &ids) const;
 
+  /**
+   * @brief Retrieves a square tile of the map, as a hdmap::Map in wire
+   * format. Tiles of level of detail lod are FLAGS_map_tile_size * 2^lod
+   * wide, and tile (x, y) starts at (x, y) times that width. Above level 0
+   * only lanes, roads and junctions are kept, with simplified curves. Tiles
+   * are cached until the map is reloaded.
+   * @param etag output of a quoted tag which changes with the tile content.
+   * @return False if the map is not ready or lod is out of range.
+   */
+  bool RetrieveMapTile(const int x, const int y, const int lod,
+                       std::string *tile, std::string *etag) const;
+
   bool GetPoseWithRegardToLane(const double x, const double y, double *theta,
                                double *s) const;
 
@@ -107,6 +121,16 @@ class MapService {
 
   // RW lock to protect map data
   mutable boost::shared_mutex mutex_;
+
+  struct MapTile {
+    std::string data;
+    std::string etag;
+  };
+  // Tiles by "lod/x/y". The generation is bumped on map reload, so that
+  // tiles built from the old map are not cached.
+  mutable std::mutex tile_cache_mutex_;
+  mutable common::util::LRUCache<std::string, MapTile> tile_cache_;
+  mutable uint64_t tile_cache_generation_ = 0;
 };
 
 }  // namespace dreamview
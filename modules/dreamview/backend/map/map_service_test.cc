@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 
 #include "modules/common/configs/config_gflags.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 
 using apollo::common::PointENU;
 using apollo::hdmap::Id;
@@ -65,6 +66,40 @@ TEST_F(MapServiceTest, RetrieveMapElements) {
   EXPECT_EQ("l1", map.lane(0).id().id());
 }
 
+TEST_F(MapServiceTest, RetrieveMapTile) {
+  // The tile of level 0 with the start of l1 at (-1826, -3027).
+  std::string tile;
+  std::string etag;
+  ASSERT_TRUE(map_service->RetrieveMapTile(-8, -12, 0, &tile, &etag));
+  Map map;
+  ASSERT_TRUE(map.ParseFromString(tile));
+  ASSERT_EQ(1, map.lane_size());
+  EXPECT_EQ("l1", map.lane(0).id().id());
+
+  std::string cached_tile;
+  std::string cached_etag;
+  ASSERT_TRUE(
+      map_service->RetrieveMapTile(-8, -12, 0, &cached_tile, &cached_etag));
+  EXPECT_EQ(tile, cached_tile);
+  EXPECT_EQ(etag, cached_etag);
+
+  // The coarsest tile over the same point has the simplified lane.
+  ASSERT_TRUE(map_service->RetrieveMapTile(-1, -1, 4, &tile, &etag));
+  Map coarse_map;
+  ASSERT_TRUE(coarse_map.ParseFromString(tile));
+  ASSERT_EQ(1, coarse_map.lane_size());
+  const auto &curve = map.lane(0).central_curve();
+  const auto &coarse_curve = coarse_map.lane(0).central_curve();
+  ASSERT_EQ(curve.segment_size(), coarse_curve.segment_size());
+  for (int i = 0; i < curve.segment_size(); ++i) {
+    EXPECT_LE(coarse_curve.segment(i).line_segment().point_size(),
+              curve.segment(i).line_segment().point_size());
+  }
+
+  EXPECT_FALSE(map_service->RetrieveMapTile(
+      0, 0, FLAGS_map_tile_max_lod + 1, &tile, &etag));
+}
+
 TEST_F(MapServiceTest, GetStartPoint) {
   PointENU start_point;
   EXPECT_TRUE(map_service->GetStartPoint(&start_point));
@@ -22,9 +22,7 @@
 #include "modules/common/log.h"
 #include "modules/common/time/time.h"
 #include "modules/dreamview/backend/common/dreamview_gflags.h"
-#include "modules/dreamview/proto/point_cloud.pb.h"
-#include "pcl/filters/voxel_grid.h"
-#include "pcl_conversions/pcl_conversions.h"
+#include "sensor_msgs/point_cloud2_iterator.h"
 #include "third_party/json/json.hpp"
 
 namespace apollo {
@@ -37,7 +35,8 @@ using sensor_msgs::PointCloud2;
 using Json = nlohmann::json;
 
 PointCloudUpdater::PointCloudUpdater(WebSocketHandler *websocket)
-    : websocket_(websocket), point_cloud_str_(""), future_ready_(true) {
+    : websocket_(websocket),
+      voxelizer_(FLAGS_voxel_filter_size, FLAGS_voxel_filter_height) {
   RegisterMessageHandlers();
 }
 
@@ -55,18 +54,27 @@ void PointCloudUpdater::RegisterMessageHandlers() {
   websocket_->RegisterMessageHandler(
       "RequestPointCloud",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
-        std::string to_send;
+        std::vector<std::string> to_send;
         // If there is no point_cloud data for more than 2 seconds, reset.
-        if (point_cloud_str_ != "" &&
-            std::fabs(last_localization_time_ - last_point_cloud_time_) > 2.0) {
+        if (std::fabs(last_localization_time_ - last_point_cloud_time_) >
+            2.0) {
           boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-          point_cloud_str_ = "";
+          point_cloud_chunks_.clear();
         }
         {
           boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
-          to_send = point_cloud_str_;
+          to_send = point_cloud_chunks_;
+        }
+        if (to_send.empty()) {
+          // An empty point cloud clears the frontend.
+          websocket_->SendBinaryData(conn, "", true);
+          return;
+        }
+        // The coarse chunks go first, so that the frontend can show the
+        // sweep before the full density one has arrived.
+        for (const auto &chunk : to_send) {
+          websocket_->SendBinaryData(conn, chunk, true);
         }
-        websocket_->SendBinaryData(conn, to_send, true);
       });
   websocket_->RegisterMessageHandler(
       "TogglePointCloud",
@@ -90,6 +98,7 @@ void PointCloudUpdater::RegisterMessageHandlers() {
 }
 
 void PointCloudUpdater::Start() {
+  worker_ = std::thread(&PointCloudUpdater::FilterLoop, this);
   AdapterManager::AddPointCloudCallback(&PointCloudUpdater::UpdatePointCloud,
                                         this);
   AdapterManager::AddLocalizationCallback(
@@ -97,8 +106,13 @@ void PointCloudUpdater::Start() {
 }
 
 void PointCloudUpdater::Stop() {
-  if (enabled_) {
-    async_future_.wait();
+  {
+    std::lock_guard<std::mutex> lock(sweep_mutex_);
+    stop_ = true;
+  }
+  sweep_cvar_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
   }
 }
 
@@ -108,46 +122,48 @@ void PointCloudUpdater::UpdatePointCloud(const PointCloud2 &point_cloud) {
   }
 
   last_point_cloud_time_ = point_cloud.header.stamp.toSec();
-  // Check if last filter process has finished before processing new data.
-  if (future_ready_) {
-    future_ready_ = false;
-    // transform from ros to pcl
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr(
-        new pcl::PointCloud<pcl::PointXYZ>);
-    pcl::fromROSMsg(point_cloud, *pcl_ptr);
-    std::future<void> f =
-        std::async(std::launch::async, &PointCloudUpdater::FilterPointCloud,
-                   this, pcl_ptr);
-    async_future_ = std::move(f);
+  {
+    std::lock_guard<std::mutex> lock(sweep_mutex_);
+    // Replaces the pending sweep if the worker is still busy.
+    pending_sweep_ = point_cloud;
+    has_pending_sweep_ = true;
   }
+  sweep_cvar_.notify_one();
 }
 
-void PointCloudUpdater::FilterPointCloud(
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr) {
-  pcl::VoxelGrid<pcl::PointXYZ> voxel_grid;
-  voxel_grid.setInputCloud(pcl_ptr);
-  voxel_grid.setLeafSize(FLAGS_voxel_filter_size, FLAGS_voxel_filter_size,
-                         FLAGS_voxel_filter_height);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_filtered_ptr(
-    new pcl::PointCloud<pcl::PointXYZ>);
-  voxel_grid.filter(*pcl_filtered_ptr);
-  AINFO << "filtered point cloud data size: " << pcl_filtered_ptr->size();
-
-  PointCloud point_cloud_pb;
-  for (size_t idx = 0; idx < pcl_filtered_ptr->size(); ++idx) {
-    pcl::PointXYZ &pt = pcl_filtered_ptr->points[idx];
-    if (!std::isnan(pt.x) && !std::isnan(pt.y) && !std::isnan(pt.z)) {
-      point_cloud_pb.add_num(pt.x);
-      point_cloud_pb.add_num(pt.y);
-      // TODO(unacao): velodyne height should be updated by hmi store
-      // upon vehicle change.
-      point_cloud_pb.add_num(pt.z + 1.91f);
+void PointCloudUpdater::FilterLoop() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(sweep_mutex_);
+      sweep_cvar_.wait(lock, [this] { return stop_ || has_pending_sweep_; });
+      if (stop_) {
+        return;
+      }
+      std::swap(pending_sweep_, filtering_sweep_);
+      has_pending_sweep_ = false;
     }
+    FilterPointCloud(filtering_sweep_);
   }
+}
+
+void PointCloudUpdater::FilterPointCloud(const PointCloud2 &point_cloud) {
+  voxelizer_.Reset();
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(point_cloud, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(point_cloud, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(point_cloud, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    // TODO(unacao): velodyne height should be updated by hmi store
+    // upon vehicle change.
+    voxelizer_.AddPoint(*iter_x, *iter_y, *iter_z + 1.91f);
+  }
+  ADEBUG << "filtered point cloud data size: " << voxelizer_.size();
+
+  std::vector<std::string> chunks;
+  voxelizer_.Encode(++sequence_num_, FLAGS_point_cloud_num_levels,
+                    FLAGS_point_cloud_resolution, &chunks);
   {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-    point_cloud_pb.SerializeToString(&point_cloud_str_);
-    future_ready_ = true;
+    point_cloud_chunks_.swap(chunks);
   }
 }
 
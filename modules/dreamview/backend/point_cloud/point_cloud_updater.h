@@ -21,9 +21,11 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_UPDATER_H_
 #define MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_UPDATER_H_
 
-#include <atomic>
-#include <future>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "boost/thread/locks.hpp"
 #include "boost/thread/shared_mutex.hpp"
@@ -31,9 +33,8 @@
 #include "modules/common/log.h"
 #include "modules/common/util/string_util.h"
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
+#include "modules/dreamview/backend/point_cloud/point_cloud_voxelizer.h"
 #include "modules/localization/proto/localization.pb.h"
-#include "pcl/point_cloud.h"
-#include "pcl/point_types.h"
 #include "sensor_msgs/PointCloud2.h"
 
 /**
@@ -69,7 +70,13 @@ class PointCloudUpdater {
 
   void UpdatePointCloud(const sensor_msgs::PointCloud2 &point_cloud);
 
-  void FilterPointCloud(pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr);
+  /**
+   * @brief Loop of the worker thread, which filters the latest sweep into
+   * point_cloud_chunks_ whenever there is a new one.
+   */
+  void FilterLoop();
+
+  void FilterPointCloud(const sensor_msgs::PointCloud2 &point_cloud);
 
   void UpdateLocalizationTime(
       const apollo::localization::LocalizationEstimate &localization);
@@ -78,14 +85,28 @@ class PointCloudUpdater {
 
   bool enabled_ = false;
 
-  // The PointCloud to be pushed to frontend.
-  std::string point_cloud_str_;
+  // The PointCloud chunks of the latest sweep to be pushed to frontend, from
+  // the coarsest level of detail to the finest.
+  std::vector<std::string> point_cloud_chunks_;
 
-  // Mutex to protect concurrent access to point_cloud_str_.
+  // Mutex to protect concurrent access to point_cloud_chunks_.
   // NOTE: Use boost until we have std version of rwlock support.
   boost::shared_mutex mutex_;
-  std::future<void> async_future_;
-  std::atomic<bool> future_ready_;
+
+  // The latest sweep not yet filtered. A newer sweep replaces it, so that the
+  // worker never falls behind. It is swapped with filtering_sweep_, so the
+  // buffers of both are reused.
+  sensor_msgs::PointCloud2 pending_sweep_;
+  sensor_msgs::PointCloud2 filtering_sweep_;
+  bool has_pending_sweep_ = false;
+  bool stop_ = false;
+  std::mutex sweep_mutex_;
+  std::condition_variable sweep_cvar_;
+  std::thread worker_;
+
+  // Only used by the worker thread.
+  PointCloudVoxelizer voxelizer_;
+  uint32_t sequence_num_ = 0;
 
   double last_point_cloud_time_ = 0.0;
   double last_localization_time_ = 0.0;
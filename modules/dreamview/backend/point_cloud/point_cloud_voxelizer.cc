@@ -0,0 +1,195 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/point_cloud/point_cloud_voxelizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "modules/common/log.h"
+#include "modules/dreamview/proto/point_cloud.pb.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+// Voxel indices are offset to be non-negative and packed in 21 bits each.
+// The offset is a power of 2, so it does not change which lattices the
+// indices lie on.
+constexpr int kIndexBits = 21;
+constexpr int64_t kIndexOffset = int64_t{1} << (kIndexBits - 1);
+constexpr uint64_t kIndexMask = (uint64_t{1} << kIndexBits) - 1;
+
+constexpr std::size_t kInitialCapacity = std::size_t{1} << 16;
+constexpr int kMaxNumLevels = 16;
+
+bool ToIndex(const float value, const double leaf, uint64_t *index) {
+  const double scaled = std::floor(static_cast<double>(value) / leaf);
+  if (scaled < -kIndexOffset || scaled >= kIndexOffset) {
+    return false;
+  }
+  *index = static_cast<uint64_t>(static_cast<int64_t>(scaled) + kIndexOffset);
+  return true;
+}
+
+std::size_t Hash(const uint64_t key) {
+  uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+  hash ^= hash >> 29;
+  return static_cast<std::size_t>(hash);
+}
+
+void AppendInt16(const int value, std::string *bytes) {
+  const auto unsigned_value = static_cast<uint16_t>(value);
+  bytes->push_back(static_cast<char>(unsigned_value & 0xff));
+  bytes->push_back(static_cast<char>(unsigned_value >> 8));
+}
+
+bool Quantize(const float value, const double resolution, int *quantized) {
+  const double scaled = std::round(static_cast<double>(value) / resolution);
+  if (scaled < std::numeric_limits<int16_t>::min() ||
+      scaled > std::numeric_limits<int16_t>::max()) {
+    return false;
+  }
+  *quantized = static_cast<int>(scaled);
+  return true;
+}
+
+}  // namespace
+
+PointCloudVoxelizer::PointCloudVoxelizer(const double leaf_size,
+                                         const double leaf_height)
+    : leaf_size_(leaf_size), leaf_height_(leaf_height) {
+  CHECK_GT(leaf_size_, 0.0);
+  CHECK_GT(leaf_height_, 0.0);
+  voxels_.resize(kInitialCapacity);
+}
+
+void PointCloudVoxelizer::Reset() {
+  occupied_.clear();
+  ++stamp_;
+  if (stamp_ == 0) {
+    // Wrapped around, stamp 0 marks the voxels which were never used.
+    for (auto &voxel : voxels_) {
+      voxel.stamp = 0;
+    }
+    stamp_ = 1;
+  }
+}
+
+std::size_t PointCloudVoxelizer::Find(const uint64_t key) const {
+  const std::size_t mask = voxels_.size() - 1;
+  std::size_t index = Hash(key) & mask;
+  while (voxels_[index].stamp == stamp_ && voxels_[index].key != key) {
+    index = (index + 1) & mask;
+  }
+  return index;
+}
+
+void PointCloudVoxelizer::Grow() {
+  std::vector<Voxel> old_voxels(voxels_.size() * 2);
+  old_voxels.swap(voxels_);
+  for (auto &index : occupied_) {
+    const Voxel &voxel = old_voxels[index];
+    index = Find(voxel.key);
+    voxels_[index] = voxel;
+  }
+}
+
+void PointCloudVoxelizer::AddPoint(const float x, const float y,
+                                   const float z) {
+  if (std::isnan(x) || std::isnan(y) || std::isnan(z)) {
+    return;
+  }
+  uint64_t ix = 0;
+  uint64_t iy = 0;
+  uint64_t iz = 0;
+  if (!ToIndex(x, leaf_size_, &ix) || !ToIndex(y, leaf_size_, &iy) ||
+      !ToIndex(z, leaf_height_, &iz)) {
+    return;
+  }
+  const uint64_t key = ix | (iy << kIndexBits) | (iz << (2 * kIndexBits));
+
+  // Keep the load factor at most 1/2 for short probes.
+  if (2 * (occupied_.size() + 1) > voxels_.size()) {
+    Grow();
+  }
+  const std::size_t index = Find(key);
+  Voxel &voxel = voxels_[index];
+  if (voxel.stamp != stamp_) {
+    voxel.key = key;
+    voxel.stamp = stamp_;
+    voxel.count = 0;
+    voxel.sum_x = 0.0f;
+    voxel.sum_y = 0.0f;
+    voxel.sum_z = 0.0f;
+    occupied_.push_back(index);
+  }
+  ++voxel.count;
+  voxel.sum_x += x;
+  voxel.sum_y += y;
+  voxel.sum_z += z;
+}
+
+void PointCloudVoxelizer::Encode(const uint32_t sequence_num,
+                                 const int num_levels, const double resolution,
+                                 std::vector<std::string> *chunks) const {
+  CHECK_NOTNULL(chunks);
+  CHECK_GE(num_levels, 1);
+  CHECK_LE(num_levels, kMaxNumLevels);
+  CHECK_GT(resolution, 0.0);
+
+  std::vector<std::string> points(num_levels);
+  const int max_shift = num_levels - 1;
+  for (const std::size_t index : occupied_) {
+    const Voxel &voxel = voxels_[index];
+    const uint64_t xy = (voxel.key & kIndexMask) |
+                        ((voxel.key >> kIndexBits) & kIndexMask);
+    int shift = max_shift;
+    while (shift > 0 && (xy & ((uint64_t{1} << shift) - 1)) != 0) {
+      --shift;
+    }
+
+    const float count = static_cast<float>(voxel.count);
+    int qx = 0;
+    int qy = 0;
+    int qz = 0;
+    if (!Quantize(voxel.sum_x / count, resolution, &qx) ||
+        !Quantize(voxel.sum_y / count, resolution, &qy) ||
+        !Quantize(voxel.sum_z / count, resolution, &qz)) {
+      continue;
+    }
+    std::string *bytes = &points[max_shift - shift];
+    AppendInt16(qx, bytes);
+    AppendInt16(qy, bytes);
+    AppendInt16(qz, bytes);
+  }
+
+  chunks->resize(num_levels);
+  PointCloud point_cloud;
+  point_cloud.set_sequence_num(sequence_num);
+  point_cloud.set_num_levels(num_levels);
+  point_cloud.set_resolution(resolution);
+  for (int level = 0; level < num_levels; ++level) {
+    point_cloud.set_level(level);
+    point_cloud.mutable_points()->swap(points[level]);
+    point_cloud.SerializeToString(&(*chunks)[level]);
+  }
+}
+
+}  // namespace dreamview
+}  // namespace apollo
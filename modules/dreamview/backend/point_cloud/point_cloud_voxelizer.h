@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_VOXELIZER_H_
+#define MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_VOXELIZER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class PointCloudVoxelizer
+ * @brief Downsamples point cloud sweeps to the centroids of their occupied
+ * voxels, like a VoxelGrid filter, and encodes them as PointCloud chunks of
+ * increasing level of detail.
+ *
+ * The voxels are kept in an open addressing hash table which is reused for
+ * every sweep, so that no memory is allocated once it has grown to the size
+ * of a sweep. A voxel belongs to the coarsest level whose lattice, of stride
+ * 2^(num_levels - 1 - level) voxels in x and y, it lies on, so that each
+ * chunk refines the ones before it evenly.
+ */
+class PointCloudVoxelizer {
+ public:
+  /**
+   * @param leaf_size width of the voxels in x and y, in meters.
+   * @param leaf_height height of the voxels, in meters.
+   */
+  PointCloudVoxelizer(const double leaf_size, const double leaf_height);
+
+  /**
+   * @brief Starts a new sweep.
+   */
+  void Reset();
+
+  /**
+   * @brief Adds a point of the sweep, relative to the vehicle. NaN points are
+   * ignored.
+   */
+  void AddPoint(const float x, const float y, const float z);
+
+  /**
+   * @brief Number of occupied voxels in the sweep.
+   */
+  std::size_t size() const { return occupied_.size(); }
+
+  /**
+   * @brief Encodes the voxel centroids as PointCloud protos in wire format,
+   * one chunk per level of detail, coarsest first. Centroids beyond the
+   * int16 range of the quantized coordinates are dropped.
+   * @param sequence_num sequence number of the sweep.
+   * @param num_levels number of levels of detail, at least 1.
+   * @param resolution meters per unit of the quantized coordinates.
+   * @param chunks output of the chunks.
+   */
+  void Encode(const uint32_t sequence_num, const int num_levels,
+              const double resolution,
+              std::vector<std::string> *chunks) const;
+
+ private:
+  struct Voxel {
+    uint64_t key = 0;
+    // The voxel is empty unless its stamp is the one of the sweep.
+    uint32_t stamp = 0;
+    uint32_t count = 0;
+    float sum_x = 0.0f;
+    float sum_y = 0.0f;
+    float sum_z = 0.0f;
+  };
+
+  std::size_t Find(const uint64_t key) const;
+  void Grow();
+
+  const double leaf_size_;
+  const double leaf_height_;
+
+  std::vector<Voxel> voxels_;
+  // indices of the occupied voxels in voxels_
+  std::vector<std::size_t> occupied_;
+  uint32_t stamp_ = 1;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
+
+#endif  // MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_VOXELIZER_H_
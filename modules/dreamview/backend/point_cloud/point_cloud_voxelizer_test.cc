@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/point_cloud/point_cloud_voxelizer.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+#include "modules/dreamview/proto/point_cloud.pb.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+struct Point {
+  double x;
+  double y;
+  double z;
+};
+
+std::vector<Point> Decode(const PointCloud &point_cloud) {
+  std::vector<Point> points;
+  const std::string &bytes = point_cloud.points();
+  EXPECT_EQ(0, bytes.size() % 6);
+  auto value = [&](const std::size_t i) {
+    const auto low = static_cast<uint8_t>(bytes[i]);
+    const auto high = static_cast<uint8_t>(bytes[i + 1]);
+    return static_cast<int16_t>(low | (high << 8)) * point_cloud.resolution();
+  };
+  for (std::size_t i = 0; i + 6 <= bytes.size(); i += 6) {
+    points.push_back({value(i), value(i + 2), value(i + 4)});
+  }
+  return points;
+}
+
+}  // namespace
+
+TEST(PointCloudVoxelizerTest, Centroids) {
+  PointCloudVoxelizer voxelizer(1.0, 1.0);
+  voxelizer.AddPoint(0.25f, 0.25f, 0.5f);
+  voxelizer.AddPoint(0.75f, 0.75f, 0.5f);
+  voxelizer.AddPoint(-0.5f, 0.5f, 0.5f);
+  voxelizer.AddPoint(NAN, 0.5f, 0.5f);
+  EXPECT_EQ(2, voxelizer.size());
+
+  std::vector<std::string> chunks;
+  voxelizer.Encode(7, 1, 0.01, &chunks);
+  ASSERT_EQ(1, chunks.size());
+  PointCloud point_cloud;
+  ASSERT_TRUE(point_cloud.ParseFromString(chunks[0]));
+  EXPECT_EQ(7, point_cloud.sequence_num());
+  EXPECT_EQ(0, point_cloud.level());
+  EXPECT_EQ(1, point_cloud.num_levels());
+  const auto points = Decode(point_cloud);
+  ASSERT_EQ(2, points.size());
+  EXPECT_NEAR(0.5, points[0].x, 1e-6);
+  EXPECT_NEAR(0.5, points[0].y, 1e-6);
+  EXPECT_NEAR(-0.5, points[1].x, 1e-6);
+
+  // Out of the int16 range of the quantized coordinates.
+  voxelizer.Reset();
+  voxelizer.AddPoint(400.0f, 0.0f, 0.0f);
+  voxelizer.Encode(8, 1, 0.01, &chunks);
+  ASSERT_TRUE(point_cloud.ParseFromString(chunks[0]));
+  EXPECT_TRUE(point_cloud.points().empty());
+}
+
+TEST(PointCloudVoxelizerTest, LevelsOfDetail) {
+  PointCloudVoxelizer voxelizer(1.0, 1.0);
+  // Reused across sweeps, and grown past the initial capacity.
+  for (int sweep = 0; sweep < 2; ++sweep) {
+    voxelizer.Reset();
+    for (int i = 0; i < 256; ++i) {
+      for (int j = 0; j < 256; ++j) {
+        voxelizer.AddPoint(i + 0.5f, j + 0.5f, 0.5f);
+      }
+    }
+    EXPECT_EQ(256 * 256, voxelizer.size());
+  }
+
+  std::vector<std::string> chunks;
+  voxelizer.Encode(1, 3, 0.01, &chunks);
+  ASSERT_EQ(3, chunks.size());
+  // Every 4th voxel in x and y, then every 2nd, then the rest.
+  const std::size_t expected_sizes[] = {64 * 64, 128 * 128 - 64 * 64,
+                                        256 * 256 - 128 * 128};
+  for (int level = 0; level < 3; ++level) {
+    PointCloud point_cloud;
+    ASSERT_TRUE(point_cloud.ParseFromString(chunks[level]));
+    EXPECT_EQ(level, point_cloud.level());
+    const auto points = Decode(point_cloud);
+    EXPECT_EQ(expected_sizes[level], points.size());
+    if (level == 0) {
+      for (const auto &point : points) {
+        EXPECT_EQ(0, static_cast<int>(std::floor(point.x)) % 4);
+        EXPECT_EQ(0, static_cast<int>(std::floor(point.y)) % 4);
+      }
+    }
+  }
+}
+
+}  // namespace dreamview
+}  // namespace apollo
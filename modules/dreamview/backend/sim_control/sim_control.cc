@@ -39,6 +39,8 @@ using apollo::common::math::InterpolateUsingLinearApproximation;
 using apollo::common::math::NormalizeAngle;
 using apollo::common::math::QuaternionToHeading;
 using apollo::common::time::Clock;
+using apollo::common::time::Duration;
+using apollo::common::time::SteppedClock;
 using apollo::common::util::GetProtoFromFile;
 using apollo::localization::LocalizationEstimate;
 using apollo::routing::RoutingResponse;
@@ -84,9 +86,12 @@ void SimControl::InitAdapter() {
   AdapterManager::AddNavigationCallback(&SimControl::OnReceiveNavigationInfo,
                                         this);
 
-  // Start timer to publish localization and chassis messages.
-  sim_control_timer_ = AdapterManager::CreateTimer(
-      ros::Duration(kSimControlInterval), &SimControl::TimerCallback, this);
+  // Start timer to publish localization and chassis messages, unless the
+  // stepped clock does.
+  if (!use_stepped_clock_) {
+    sim_control_timer_ = AdapterManager::CreateTimer(
+        ros::Duration(kSimControlInterval), &SimControl::TimerCallback, this);
+  }
 
   adapter_inited_ = true;
 }
@@ -213,7 +218,9 @@ void SimControl::Start() {
     Init(AdapterManager::GetLocalization()->Empty());
 
     Reset();
-    sim_control_timer_.start();
+    if (!use_stepped_clock_) {
+      sim_control_timer_.start();
+    }
     enabled_ = true;
   }
 }
@@ -257,6 +264,19 @@ void SimControl::Freeze() {
 
 void SimControl::TimerCallback(const ros::TimerEvent& event) { RunOnce(); }
 
+void SimControl::UseSteppedClock(SteppedClock* clock) {
+  CHECK_NOTNULL(clock);
+  use_stepped_clock_ = true;
+  sim_control_timer_.stop();
+  const Duration interval(
+      static_cast<int64_t>(std::round(kSimControlInterval * 1e9)));
+  clock->AddTask(interval, [this]() {
+    if (enabled_) {
+      RunOnce();
+    }
+  });
+}
+
 void SimControl::RunOnce() {
   TrajectoryPoint trajectory_point;
   if (!PerfectControlModel(&trajectory_point)) {
@@ -28,6 +28,7 @@
 #include "modules/map/relative_map/proto/navigation.pb.h"
 
 #include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/time/stepped_clock.h"
 #include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/dreamview/backend/map/map_service.h"
 #include "modules/dreamview/backend/sim_control/sim_control_interface.h"
@@ -80,6 +81,14 @@ class SimControl : SimControlInterface {
 
   void RunOnce() override;
 
+  /**
+   * @brief Runs on the steps of the given clock instead of the ROS timer,
+   * so that a closed-loop simulation can run faster than real time.
+   * @param clock the stepped clock, which must not be stepped after
+   * SimControl is destroyed.
+   */
+  void UseSteppedClock(apollo::common::time::SteppedClock *clock);
+
  private:
   void OnPlanning(const apollo::planning::ADCTrajectory &trajectory);
   void OnRoutingResponse(const apollo::routing::RoutingResponse &routing);
@@ -117,6 +126,9 @@ class SimControl : SimControlInterface {
   // Time interval of the timer, in seconds.
   static constexpr double kSimControlInterval = 0.01;
 
+  // Whether it runs on a stepped clock instead of the timer.
+  bool use_stepped_clock_ = false;
+
   // The latest received planning trajectory.
   apollo::planning::ADCTrajectory current_trajectory_;
   // The index of the previous and next point with regard to the
@@ -155,6 +167,7 @@ class SimControl : SimControlInterface {
   relative_map::NavigationInfo navigation_info_;
 
   FRIEND_TEST(SimControlTest, Test);
+  FRIEND_TEST(SimControlTest, SteppedClock);
 };
 
 }  // namespace dreamview
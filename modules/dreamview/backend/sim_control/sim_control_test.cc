@@ -24,6 +24,7 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "modules/common/time/stepped_clock.h"
 #include "modules/common/time/time.h"
 
 #include "modules/common/adapters/adapter_manager.h"
@@ -34,6 +35,7 @@ using apollo::common::adapter::AdapterManager;
 using apollo::common::adapter::AdapterManagerConfig;
 using apollo::common::math::HeadingToQuaternion;
 using apollo::common::time::Clock;
+using apollo::common::time::SteppedClock;
 using apollo::localization::LocalizationEstimate;
 using apollo::routing::RoutingResponse;
 
@@ -200,5 +202,30 @@ TEST_F(SimControlTest, Test) {
   }
 }
 
+TEST_F(SimControlTest, SteppedClock) {
+  planning::ADCTrajectory adc_trajectory;
+  SetTrajectory({0.0, 10.0}, {0.0, 0.0}, {0.0, 10.0}, {10.0, 10.0},
+                {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 1.0},
+                &adc_trajectory);
+  adc_trajectory.mutable_header()->set_timestamp_sec(100.0);
+
+  SteppedClock clock(apollo::common::time::millis(10),
+                     apollo::common::time::From(100.0));
+  sim_control_->UseSteppedClock(&clock);
+  sim_control_->SetStartPoint(adc_trajectory.trajectory_point(0));
+  AdapterManager::PublishPlanning(adc_trajectory);
+
+  // Half a second of simulation, without waiting for it.
+  for (int i = 0; i < 50; ++i) {
+    clock.Step();
+  }
+  const LocalizationEstimate *localization =
+      AdapterManager::GetLocalization()->GetLatestPublished();
+  ASSERT_NE(nullptr, localization);
+  EXPECT_NEAR(100.5, localization->header().timestamp_sec(), 1e-6);
+  EXPECT_NEAR(5.0, localization->pose().position().x(), 1e-6);
+  Clock::SetMode(Clock::SYSTEM);
+}
+
 }  // namespace dreamview
 }  // namespace apollo
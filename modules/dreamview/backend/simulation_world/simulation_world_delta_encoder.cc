@@ -0,0 +1,236 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
+
+#include <unordered_set>
+#include <vector>
+
+#include "google/protobuf/field_mask.pb.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/util/field_mask_util.h"
+#include "google/protobuf/util/message_differencer.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace dreamview {
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::FieldMask;
+using google::protobuf::util::FieldMaskUtil;
+using google::protobuf::util::MessageDifferencer;
+
+SimulationWorldDeltaEncoder::SimulationWorldDeltaEncoder(
+    const std::size_t history_size)
+    : history_size_(history_size) {
+  CHECK_GT(history_size_, 0);
+}
+
+void SimulationWorldDeltaEncoder::Update(const SimulationWorld &world) {
+  auto latest = std::make_shared<const SimulationWorld>(world);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!history_.empty()) {
+    const uint32_t last_sequence_num = history_.back()->sequence_num();
+    if (world.sequence_num() < last_sequence_num) {
+      history_.clear();
+    } else if (world.sequence_num() == last_sequence_num) {
+      history_.pop_back();
+    }
+  }
+  history_.push_back(latest);
+  while (history_.size() > history_size_) {
+    history_.pop_front();
+  }
+  deltas_.clear();
+}
+
+bool SimulationWorldDeltaEncoder::Encode(const uint32_t base_sequence_num,
+                                         std::string *delta) {
+  CHECK_NOTNULL(delta);
+  std::shared_ptr<const SimulationWorld> base;
+  std::shared_ptr<const SimulationWorld> latest;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (history_.empty()) {
+      return false;
+    }
+    latest = history_.back();
+    if (latest->sequence_num() == base_sequence_num) {
+      delta->clear();
+      return true;
+    }
+    const auto cached = deltas_.find(base_sequence_num);
+    if (cached != deltas_.end()) {
+      *delta = cached->second;
+      return true;
+    }
+    for (const auto &world : history_) {
+      if (world->sequence_num() == base_sequence_num) {
+        base = world;
+        break;
+      }
+    }
+  }
+  if (base == nullptr) {
+    return false;
+  }
+
+  // Diff outside of the lock, the worlds are immutable once recorded.
+  SimulationWorldDelta message;
+  Diff(*base, *latest, &message);
+  message.SerializeToString(delta);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!history_.empty() && history_.back() == latest) {
+    deltas_[base_sequence_num] = *delta;
+  }
+  return true;
+}
+
+void SimulationWorldDeltaEncoder::EncodeKeyframe(const std::string &world,
+                                                 std::string *keyframe) {
+  CHECK_NOTNULL(keyframe);
+  keyframe->clear();
+  google::protobuf::io::StringOutputStream output(keyframe);
+  google::protobuf::io::CodedOutputStream coded_output(&output);
+  // A keyframe has nothing but the world field, which is length delimited
+  // (wire type 2).
+  coded_output.WriteTag((SimulationWorldDelta::kWorldFieldNumber << 3) | 2);
+  coded_output.WriteVarint32(static_cast<uint32_t>(world.size()));
+  coded_output.WriteString(world);
+}
+
+void SimulationWorldDeltaEncoder::Diff(const SimulationWorld &base,
+                                       const SimulationWorld &world,
+                                       SimulationWorldDelta *delta) {
+  CHECK_NOTNULL(delta);
+  delta->Clear();
+  delta->set_base_sequence_num(base.sequence_num());
+
+  const auto *descriptor = SimulationWorld::descriptor();
+  const auto *reflection = world.GetReflection();
+  MessageDifferencer differencer;
+  FieldMask changed_fields;
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const FieldDescriptor *field = descriptor->field(i);
+    // Objects are diffed one by one below.
+    if (field->number() == SimulationWorld::kObjectFieldNumber) {
+      continue;
+    }
+    const std::vector<const FieldDescriptor *> fields = {field};
+    if (differencer.CompareWithFields(base, world, fields, fields)) {
+      continue;
+    }
+    const bool is_set = field->is_repeated()
+                            ? reflection->FieldSize(world, field) > 0
+                            : reflection->HasField(world, field);
+    if (is_set) {
+      changed_fields.add_paths(field->name());
+    } else {
+      delta->add_cleared_field(field->number());
+    }
+  }
+  FieldMaskUtil::MergeMessageTo(world, changed_fields,
+                                FieldMaskUtil::MergeOptions(),
+                                delta->mutable_world());
+
+  std::unordered_map<std::string, const Object *> base_objects;
+  for (const auto &object : base.object()) {
+    base_objects[object.id()] = &object;
+  }
+  for (const auto &object : world.object()) {
+    const auto iter = base_objects.find(object.id());
+    if (iter == base_objects.end()) {
+      *delta->mutable_world()->add_object() = object;
+      continue;
+    }
+    if (!MessageDifferencer::Equals(*iter->second, object)) {
+      *delta->mutable_world()->add_object() = object;
+    }
+    base_objects.erase(iter);
+  }
+  for (const auto &object : base.object()) {
+    if (base_objects.count(object.id()) > 0) {
+      delta->add_removed_object_id(object.id());
+    }
+  }
+}
+
+bool SimulationWorldDeltaEncoder::Apply(const SimulationWorldDelta &delta,
+                                        SimulationWorld *world) {
+  CHECK_NOTNULL(world);
+  if (!delta.has_base_sequence_num()) {
+    *world = delta.world();
+    return true;
+  }
+  if (world->sequence_num() != delta.base_sequence_num()) {
+    return false;
+  }
+
+  const auto *descriptor = SimulationWorld::descriptor();
+  const auto *reflection = world->GetReflection();
+  std::vector<const FieldDescriptor *> fields;
+  reflection->ListFields(delta.world(), &fields);
+  FieldMask set_fields;
+  for (const auto *field : fields) {
+    if (field->number() != SimulationWorld::kObjectFieldNumber) {
+      set_fields.add_paths(field->name());
+    }
+  }
+  FieldMaskUtil::MergeOptions options;
+  options.set_replace_message_fields(true);
+  options.set_replace_repeated_fields(true);
+  FieldMaskUtil::MergeMessageTo(delta.world(), set_fields, options, world);
+  for (const uint32_t number : delta.cleared_field()) {
+    const FieldDescriptor *field = descriptor->FindFieldByNumber(number);
+    if (field != nullptr) {
+      reflection->ClearField(world, field);
+    }
+  }
+
+  std::unordered_map<std::string, const Object *> changed_objects;
+  for (const auto &object : delta.world().object()) {
+    changed_objects[object.id()] = &object;
+  }
+  const std::unordered_set<std::string> removed_objects(
+      delta.removed_object_id().begin(), delta.removed_object_id().end());
+  google::protobuf::RepeatedPtrField<Object> objects;
+  for (const auto &object : world->object()) {
+    if (removed_objects.count(object.id()) > 0) {
+      continue;
+    }
+    const auto iter = changed_objects.find(object.id());
+    if (iter == changed_objects.end()) {
+      *objects.Add() = object;
+    } else {
+      *objects.Add() = *iter->second;
+      changed_objects.erase(iter);
+    }
+  }
+  for (const auto &object : delta.world().object()) {
+    if (changed_objects.count(object.id()) > 0) {
+      *objects.Add() = object;
+    }
+  }
+  world->mutable_object()->Swap(&objects);
+  return true;
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_DELTA_ENCODER_H_
+#define MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_DELTA_ENCODER_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "modules/dreamview/proto/simulation_world.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class SimulationWorldDeltaEncoder
+ * @brief Encodes the latest SimulationWorld against the one a client already
+ * has, as a SimulationWorldDelta in wire format.
+ *
+ * A client reports the sequence number of the world it holds with each
+ * request. If that world is still in the history, the client gets the fields
+ * and objects which changed since then, otherwise a keyframe. A client which
+ * skips updates, e.g. on a slow link, therefore gets deltas against an older
+ * world instead of every intermediate one. Deltas are cached per base world
+ * until the next update, so clients in sync share one encoding.
+ */
+class SimulationWorldDeltaEncoder {
+ public:
+  /**
+   * @brief Constructor.
+   * @param history_size the number of latest worlds kept as delta bases.
+   */
+  explicit SimulationWorldDeltaEncoder(const std::size_t history_size);
+
+  /**
+   * @brief Records the latest world. The history is reset when the sequence
+   * number goes backwards, i.e. the world has been cleared.
+   * @param world the latest world, without planning data.
+   */
+  void Update(const SimulationWorld &world);
+
+  /**
+   * @brief Encodes the latest world against the given one.
+   * @param base_sequence_num sequence number of the world of the client.
+   * @param delta output of the delta in wire format, empty if the client
+   * already has the latest world.
+   * @return false if the base world is not in the history, then the client
+   * needs a keyframe.
+   */
+  bool Encode(const uint32_t base_sequence_num, std::string *delta);
+
+  /**
+   * @brief Wraps a SimulationWorld in wire format into a keyframe
+   * SimulationWorldDelta in wire format, without parsing it.
+   */
+  static void EncodeKeyframe(const std::string &world, std::string *keyframe);
+
+  /**
+   * @brief Computes the delta which turns base into world.
+   */
+  static void Diff(const SimulationWorld &base, const SimulationWorld &world,
+                   SimulationWorldDelta *delta);
+
+  /**
+   * @brief Applies a delta the way the frontend does. The order of the
+   * objects is not kept: changed ones stay in place, new ones are appended.
+   * @return false if world is not the base of the delta.
+   */
+  static bool Apply(const SimulationWorldDelta &delta, SimulationWorld *world);
+
+ private:
+  const std::size_t history_size_;
+
+  std::mutex mutex_;
+  // oldest first, the back is the latest world
+  std::deque<std::shared_ptr<const SimulationWorld>> history_;
+  // encodings of the latest world, by base sequence number
+  std::unordered_map<uint32_t, std::string> deltas_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
+
+#endif  // MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_DELTA_ENCODER_H_
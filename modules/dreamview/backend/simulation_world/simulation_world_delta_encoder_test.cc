@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
+
+#include <algorithm>
+
+#include "google/protobuf/util/message_differencer.h"
+#include "gtest/gtest.h"
+
+using google::protobuf::util::MessageDifferencer;
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+SimulationWorld MakeWorld(const uint32_t sequence_num) {
+  SimulationWorld world;
+  world.set_sequence_num(sequence_num);
+  world.set_timestamp(100.0 * sequence_num);
+  world.set_speed_limit(10.0);
+  world.mutable_auto_driving_car()->set_position_x(1.0);
+  world.add_route_path()->add_point()->set_x(1.0);
+  (*world.mutable_latency())["planning"].set_timestamp_sec(1.0);
+  for (int i = 0; i < 3; ++i) {
+    auto *object = world.add_object();
+    object->set_id(std::to_string(i));
+    object->set_position_x(static_cast<double>(i));
+  }
+  return world;
+}
+
+// The order of the objects is not kept by a delta.
+void SortObjects(SimulationWorld *world) {
+  std::sort(world->mutable_object()->begin(), world->mutable_object()->end(),
+            [](const Object &a, const Object &b) { return a.id() < b.id(); });
+}
+
+void ExpectSameWorld(SimulationWorld expected, SimulationWorld actual) {
+  SortObjects(&expected);
+  SortObjects(&actual);
+  EXPECT_TRUE(MessageDifferencer::Equals(expected, actual))
+      << "expected: " << expected.DebugString()
+      << "actual: " << actual.DebugString();
+}
+
+}  // namespace
+
+TEST(SimulationWorldDeltaEncoderTest, DiffAndApply) {
+  const SimulationWorld base = MakeWorld(1);
+  SimulationWorld world = MakeWorld(2);
+  world.clear_speed_limit();
+  world.set_engage_advice("READY_TO_ENGAGE");
+  world.mutable_auto_driving_car()->set_position_y(2.0);
+  world.mutable_route_path(0)->add_point()->set_x(2.0);
+  world.mutable_object(1)->set_position_x(5.0);
+  world.mutable_object()->DeleteSubrange(0, 1);
+  world.add_object()->set_id("3");
+
+  SimulationWorldDelta delta;
+  SimulationWorldDeltaEncoder::Diff(base, world, &delta);
+  EXPECT_EQ(1, delta.base_sequence_num());
+  ASSERT_EQ(1, delta.cleared_field_size());
+  EXPECT_EQ(SimulationWorld::kSpeedLimitFieldNumber, delta.cleared_field(0));
+  ASSERT_EQ(1, delta.removed_object_id_size());
+  EXPECT_EQ("0", delta.removed_object_id(0));
+  // Only the changed object and the new one.
+  ASSERT_EQ(2, delta.world().object_size());
+  EXPECT_EQ("1", delta.world().object(0).id());
+  EXPECT_EQ("3", delta.world().object(1).id());
+  // Unchanged fields are left out.
+  EXPECT_EQ(0, delta.world().latency_size());
+  EXPECT_TRUE(delta.world().has_auto_driving_car());
+
+  SimulationWorld applied = base;
+  EXPECT_TRUE(SimulationWorldDeltaEncoder::Apply(delta, &applied));
+  ExpectSameWorld(world, applied);
+
+  // The delta does not apply to any other world.
+  SimulationWorld other = MakeWorld(3);
+  EXPECT_FALSE(SimulationWorldDeltaEncoder::Apply(delta, &other));
+}
+
+TEST(SimulationWorldDeltaEncoderTest, EncodeKeyframe) {
+  const SimulationWorld world = MakeWorld(5);
+  std::string keyframe;
+  SimulationWorldDeltaEncoder::EncodeKeyframe(world.SerializeAsString(),
+                                              &keyframe);
+  SimulationWorldDelta delta;
+  ASSERT_TRUE(delta.ParseFromString(keyframe));
+  EXPECT_FALSE(delta.has_base_sequence_num());
+
+  SimulationWorld applied = MakeWorld(1);
+  EXPECT_TRUE(SimulationWorldDeltaEncoder::Apply(delta, &applied));
+  ExpectSameWorld(world, applied);
+}
+
+TEST(SimulationWorldDeltaEncoderTest, Encode) {
+  SimulationWorldDeltaEncoder encoder(2);
+  std::string encoded;
+  EXPECT_FALSE(encoder.Encode(0, &encoded));
+
+  for (uint32_t i = 1; i <= 3; ++i) {
+    encoder.Update(MakeWorld(i));
+  }
+  // Already the latest world.
+  EXPECT_TRUE(encoder.Encode(3, &encoded));
+  EXPECT_TRUE(encoded.empty());
+  // Out of the history.
+  EXPECT_FALSE(encoder.Encode(1, &encoded));
+
+  ASSERT_TRUE(encoder.Encode(2, &encoded));
+  SimulationWorldDelta delta;
+  ASSERT_TRUE(delta.ParseFromString(encoded));
+  EXPECT_EQ(2, delta.base_sequence_num());
+  SimulationWorld applied = MakeWorld(2);
+  EXPECT_TRUE(SimulationWorldDeltaEncoder::Apply(delta, &applied));
+  ExpectSameWorld(MakeWorld(3), applied);
+
+  // Cached until the next update.
+  std::string cached;
+  ASSERT_TRUE(encoder.Encode(2, &cached));
+  EXPECT_EQ(encoded, cached);
+
+  // The world has been reset.
+  encoder.Update(MakeWorld(1));
+  EXPECT_FALSE(encoder.Encode(2, &encoded));
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -45,7 +45,8 @@ SimulationWorldUpdater::SimulationWorldUpdater(WebSocketHandler *websocket,
       map_service_(map_service),
       websocket_(websocket),
       map_ws_(map_ws),
-      sim_control_(sim_control) {
+      sim_control_(sim_control),
+      delta_encoder_(FLAGS_sim_world_delta_history_size) {
   RegisterMessageHandlers();
 }
 
@@ -168,7 +169,25 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (planning != json.end() && planning->is_boolean()) {
           enable_pnc_monitor = json["planning"];
         }
+        // Clients which report the sequence number of the world they hold
+        // get a SimulationWorldDelta instead of the whole world.
+        bool send_delta = false;
+        uint32_t base_sequence_num = 0;
+        auto base = json.find("baseSequenceNum");
+        if (base != json.end() && base->is_number_unsigned()) {
+          send_delta = true;
+          base_sequence_num = *base;
+        }
         std::string to_send;
+        if (send_delta && !enable_pnc_monitor && base_sequence_num != 0 &&
+            delta_encoder_.Encode(base_sequence_num, &to_send)) {
+          // Nothing to send if the client is up to date.
+          if (!to_send.empty()) {
+            websocket_->SendBinaryData(conn, to_send, true);
+          }
+          return;
+        }
+
         {
           // Pay the price to copy the data instead of sending data over the
           // wire while holding the lock.
@@ -181,6 +200,11 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
           AWARN << "update size is too big:" << to_send.size();
           return;
         }
+        if (send_delta) {
+          std::string keyframe;
+          SimulationWorldDeltaEncoder::EncodeKeyframe(to_send, &keyframe);
+          to_send.swap(keyframe);
+        }
         websocket_->SendBinaryData(conn, to_send, true);
       });
 
@@ -354,6 +378,8 @@ void SimulationWorldUpdater::OnTimer(const ros::TimerEvent &event) {
     sim_world_service_.GetRelativeMap().SerializeToString(
         &relative_map_string_);
   }
+  // The planning data has been cleared from the world by now.
+  delta_encoder_.Update(sim_world_service_.world());
 }
 
 bool SimulationWorldUpdater::LoadPOI() {
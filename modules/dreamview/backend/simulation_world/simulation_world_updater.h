@@ -31,6 +31,7 @@
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 #include "modules/dreamview/backend/map/map_service.h"
 #include "modules/dreamview/backend/sim_control/sim_control.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
 #include "modules/dreamview/backend/simulation_world/simulation_world_service.h"
 #include "modules/routing/proto/poi.pb.h"
 
@@ -136,6 +137,9 @@ class SimulationWorldUpdater {
   std::string simulation_world_;
   std::string simulation_world_with_planning_data_;
 
+  // Deltas of the simulation_world for the clients which ask for them.
+  SimulationWorldDeltaEncoder delta_encoder_;
+
   // Received relative map data in wire format.
   std::string relative_map_string_;
 
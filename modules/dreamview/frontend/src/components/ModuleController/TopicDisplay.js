@@ -0,0 +1,31 @@
+import React from "react";
+import { observer } from "mobx-react";
+
+function formatMs(percentiles) {
+    return (percentiles && percentiles.p99 !== undefined)
+        ? `${percentiles.p99.toFixed(1)}ms` : '-';
+}
+
+@observer
+export default class TopicDisplay extends React.Component {
+    render() {
+        const { title, statistics } = this.props;
+
+        const rate = statistics.frameRate !== undefined
+            ? `${statistics.frameRate.toFixed(1)}Hz` : '-';
+        // The 99th percentiles of the time between messages, which is the
+        // jitter of the topic, and of the latency.
+        const interval = formatMs(statistics.interval);
+        const latency = formatMs(statistics.latency);
+
+        return (
+            <div className="topic-display">
+                <div className="name">{title}</div>
+                <div className="statistics"
+                     title="rate / p99 interval / p99 latency">
+                    {`${rate} / ${interval} / ${latency}`}
+                </div>
+            </div>
+        );
+    }
+}
@@ -3,13 +3,15 @@ import { inject, observer } from "mobx-react";
 
 import CheckboxItem from "components/common/CheckboxItem";
 import StatusDisplay from "components/ModuleController/StatusDisplay";
+import TopicDisplay from "components/ModuleController/TopicDisplay";
 import WS from "store/websocket";
 
 @inject("store") @observer
 export default class Header extends React.Component {
     render() {
         const { modes, currentMode,
-                moduleStatus, hardwareStatus, displayName } = this.props.store.hmi;
+                moduleStatus, hardwareStatus, topicStatistics,
+                displayName } = this.props.store.hmi;
 
         const liveModules = (currentMode !== 'none')
                               ? modes[currentMode].liveModules : Array.from(moduleStatus.keys());
@@ -34,6 +36,12 @@ export default class Header extends React.Component {
                                            status={hardwareStatus.get(key)}/>;
                 });
 
+        const topicEntries = Array.from(topicStatistics.keys()).sort().map((key) => {
+                  return <TopicDisplay key={key}
+                                       title={displayName[key] || key}
+                                       statistics={topicStatistics.get(key)}/>;
+                });
+
         return (
             <div className="module-controller">
                 <div className="card">
@@ -48,6 +56,13 @@ export default class Header extends React.Component {
                         {moduleEntries}
                     </div>
                 </div>
+                {topicEntries.length > 0 &&
+                    <div className="card">
+                        <div className="card-header"><span>Topics</span></div>
+                        <div className="card-content-column">
+                            {topicEntries}
+                        </div>
+                    </div>}
             </div>
         );
     }
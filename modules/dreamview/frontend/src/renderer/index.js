@@ -377,9 +377,15 @@ class Renderer {
     }
 
     updateMapIndex(hash, elementIds, radius) {
-        if (!this.routingEditor.isInEditingMode() ||
-             this.routingEditor.EDITING_MAP_RADIUS === radius) {
+        if (!this.routingEditor.isInEditingMode()) {
             this.map.updateIndex(hash, elementIds, this.scene);
+        } else if (this.routingEditor.EDITING_MAP_RADIUS === radius) {
+            // The editing view covers a large area, which is loaded from
+            // simplified map tiles around the car.
+            const center = this.adc.mesh
+                ? this.coordinates.applyOffset(this.adc.mesh.position, true) : null;
+            const tileArea = center ? { center: center, radius: radius } : undefined;
+            this.map.updateIndex(hash, elementIds, this.scene, tileArea);
         }
     }
 
@@ -420,15 +420,20 @@ export default class Map {
         const kinds = ["overlap", "lane", "junction", "road",
                        "clearArea", "signal", "stopSign", "crosswalk"];
         for (const kind of kinds) {
-            if (!newData[kind]) {
+            // Map tiles may have all kinds, and overlap each other.
+            if (!newData[kind] || !this.shouldDrawThisElementKind(kind)) {
                 continue;
             }
 
             if (!this.data[kind]) {
                 this.data[kind] = [];
             }
+            const existingIds = new Set(this.data[kind].map(element => element.id.id));
 
             for (let i = 0; i < newData[kind].length; ++i) {
+                if (existingIds.has(newData[kind][i].id.id)) {
+                    continue;
+                }
                 switch (kind) {
                     case "lane":
                         const lane = newData[kind][i];
@@ -493,7 +498,9 @@ export default class Map {
         return STORE.options[optionName] !== false;
     }
 
-    updateIndex(hash, elementIds, scene) {
+    // The elements are loaded from the simplified map tiles covering the
+    // tileArea {center, radius} if given, otherwise by id.
+    updateIndex(hash, elementIds, scene, tileArea) {
         if (STORE.hmi.inNavigationMode) {
             MAP_WS.requestRelativeMapData();
         } else {
@@ -504,13 +511,26 @@ export default class Map {
                 }
             }
 
-            if (hash !== this.hash || this.elementKindsDrawn !== newElementKindsDrawn) {
+            const fromTiles = !!tileArea;
+            if (hash !== this.hash || this.elementKindsDrawn !== newElementKindsDrawn ||
+                fromTiles !== this.fromTiles) {
+                if (fromTiles !== this.fromTiles) {
+                    // Elements from tiles have simplified geometry, which is
+                    // not reused in either direction.
+                    this.removeAllElements(scene);
+                    this.fromTiles = fromTiles;
+                    this.initialized = false;
+                }
                 this.hash = hash;
                 this.elementKindsDrawn = newElementKindsDrawn;
                 const diff = this.diffMapElements(elementIds, this.data);
                 this.removeExpiredElements(elementIds, scene);
                 if (!_.isEmpty(diff) || !this.initialized) {
-                    MAP_WS.requestMapData(diff);
+                    if (fromTiles) {
+                        MAP_WS.requestMapTiles(tileArea.center, tileArea.radius);
+                    } else {
+                        MAP_WS.requestMapData(diff);
+                    }
                     this.initialized = true;
                 }
             }
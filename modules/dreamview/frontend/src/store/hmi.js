@@ -25,6 +25,7 @@ export default class HMI {
 
     @observable moduleStatus = observable.map();
     @observable hardwareStatus = observable.map();
+    @observable topicStatistics = observable.map();
     @observable enableStartAuto = false;
 
     displayName = {};
@@ -83,11 +84,13 @@ export default class HMI {
                 for (const key in newStatus.systemStatus.modules) {
                     this.moduleStatus.set(key,
                         newStatus.systemStatus.modules[key].processStatus.running);
+                    this.updateTopicStatistics(key, newStatus.systemStatus.modules[key]);
                 }
             }
             if (newStatus.systemStatus.hardware) {
                 for (const key in newStatus.systemStatus.hardware) {
                     this.hardwareStatus.set(key, newStatus.systemStatus.hardware[key].summary);
+                    this.updateTopicStatistics(key, newStatus.systemStatus.hardware[key]);
                 }
             }
             if (this.utterance &&
@@ -99,6 +102,12 @@ export default class HMI {
         }
     }
 
+    updateTopicStatistics(key, status) {
+        if (status.topicStatus && status.topicStatus.statistics) {
+            this.topicStatistics.set(key, status.topicStatus.statistics);
+        }
+    }
+
     speakPassengerMessage() {
         if (this.utterance.text) {
             // if speaking, don't interrupt
@@ -1,5 +1,6 @@
 import STORE from "store";
 import RENDERER from "renderer";
+import PARAMETERS from "store/config/parameters.yml";
 import Worker from 'utils/webworker.js';
 
 export default class MapDataWebSocketEndpoint {
@@ -47,6 +48,43 @@ export default class MapDataWebSocketEndpoint {
         }));
     }
 
+    // Loads the map within the radius around the center from the tiles of the
+    // finest level of detail which covers it with a few tiles. Tiles are
+    // served over http, and the browser revalidates its cached ones by ETag.
+    requestMapTiles(center, radius) {
+        const params = PARAMETERS.map;
+        let lod = 0;
+        while (lod < params.maxTileLod &&
+               2 * radius > params.maxTilesPerSide * params.tileSize * Math.pow(2, lod)) {
+            lod++;
+        }
+        const tileSize = params.tileSize * Math.pow(2, lod);
+        const xBegin = Math.floor((center.x - radius) / tileSize);
+        const xEnd = Math.floor((center.x + radius) / tileSize);
+        const yBegin = Math.floor((center.y - radius) / tileSize);
+        const yEnd = Math.floor((center.y + radius) / tileSize);
+        for (let x = xBegin; x <= xEnd; ++x) {
+            for (let y = yBegin; y <= yEnd; ++y) {
+                fetch(`/maptile?x=${x}&y=${y}&lod=${lod}`, { cache: "no-cache" })
+                    .then(response => {
+                        if (!response.ok) {
+                            throw new Error(response.status);
+                        }
+                        return response.arrayBuffer();
+                    })
+                    .then(data => {
+                        this.worker.postMessage({
+                            source: 'map',
+                            data: data,
+                        });
+                    })
+                    .catch(error => {
+                        console.error(`Failed to load map tile ${lod}/${x}/${y}: ${error}`);
+                    });
+            }
+        }
+    }
+
     requestRelativeMapData(elements) {
         this.websocket.send(JSON.stringify({
             type: "RetrieveRelativeMapData",
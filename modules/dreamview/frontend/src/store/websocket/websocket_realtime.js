@@ -117,6 +117,8 @@ export default class RosWebSocketEndpoint {
                 this.websocket.send(JSON.stringify({
                     type : "RequestSimulationWorld",
                     planning : requestPlanningData,
+                    // Ask for the changes since the latest world received.
+                    baseSequenceNum : this.lastSeqNum || 0,
                 }));
             }
         }, this.simWorldUpdatePeriodMs);
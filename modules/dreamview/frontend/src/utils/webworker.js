@@ -3,12 +3,109 @@ const simWorldRoot = protobuf.Root.fromJSON(
     require("proto_bundle/sim_world_proto_bundle.json")
 );
 const SimWorldMessage = simWorldRoot.lookupType("apollo.dreamview.SimulationWorld");
+const SimWorldDeltaMessage = simWorldRoot.lookupType("apollo.dreamview.SimulationWorldDelta");
 const mapMessage = simWorldRoot.lookupType("apollo.hdmap.Map");
 const pointCloudRoot = protobuf.Root.fromJSON(
     require("proto_bundle/point_cloud_proto_bundle.json")
 );
 const pointCloudMessage = pointCloudRoot.lookupType("apollo.dreamview.PointCloud");
 
+// The latest simulation world, which the deltas from backend apply to.
+let simWorld = null;
+
+// The points of the latest point cloud sweep, accumulated over its chunks,
+// and the levels of the chunks received.
+let pointCloudSequenceNum = null;
+let pointCloudLevels = new Set();
+let pointCloudNum = [];
+
+function accumulatePointCloud(pointCloud) {
+    if (!pointCloud.numLevels) {
+        // Not chunked, e.g. the empty point cloud which clears the display.
+        pointCloudSequenceNum = null;
+        pointCloudLevels = new Set();
+        pointCloudNum = [];
+        return { num: pointCloud.num };
+    }
+    // The first level starts a sweep, even one resent with the same sequence
+    // number, e.g. after a reconnection.
+    const level = pointCloud.level || 0;
+    if (pointCloud.sequenceNum !== pointCloudSequenceNum || level === 0) {
+        pointCloudSequenceNum = pointCloud.sequenceNum;
+        pointCloudLevels = new Set();
+        pointCloudNum = [];
+    }
+    if (pointCloudLevels.has(level)) {
+        // A repeated chunk, whose points are already in.
+        return null;
+    }
+    pointCloudLevels.add(level);
+    // Coordinates are little-endian int16 in units of the resolution.
+    const points = pointCloud.points || [];
+    const view = new DataView(points.buffer, points.byteOffset, points.byteLength);
+    for (let i = 0; i + 1 < points.byteLength; i += 2) {
+        pointCloudNum.push(view.getInt16(i, true) * pointCloud.resolution);
+    }
+    return { num: pointCloudNum };
+}
+
+function applySimWorldDelta(delta) {
+    if (!delta.baseSequenceNum) {
+        // A keyframe.
+        simWorld = delta.world;
+        return true;
+    }
+    if (!simWorld || !delta.world ||
+        simWorld.sequenceNum !== delta.baseSequenceNum) {
+        return false;
+    }
+
+    const world = Object.assign({}, simWorld);
+    // Deltas never carry planning data, which is only sent in keyframes.
+    delete world.planningData;
+    // Decoded messages have empty repeated and map fields of their own, which
+    // are not changes.
+    SimWorldMessage.fieldsArray.forEach(field => {
+        const value = delta.world[field.name];
+        if (field.name === "object" || !delta.world.hasOwnProperty(field.name) ||
+            (field.repeated && value.length === 0) ||
+            (field.map && Object.keys(value).length === 0)) {
+            return;
+        }
+        world[field.name] = value;
+    });
+    delta.clearedField.forEach(id => {
+        delete world[SimWorldMessage.fieldsById[id].name];
+    });
+
+    const changedObjects = {};
+    delta.world.object.forEach(object => {
+        changedObjects[object.id] = object;
+    });
+    const removedObjects = new Set(delta.removedObjectId);
+    const objects = [];
+    simWorld.object.forEach(object => {
+        if (removedObjects.has(object.id)) {
+            return;
+        }
+        if (changedObjects[object.id]) {
+            objects.push(changedObjects[object.id]);
+            delete changedObjects[object.id];
+        } else {
+            objects.push(object);
+        }
+    });
+    delta.world.object.forEach(object => {
+        if (changedObjects[object.id]) {
+            objects.push(object);
+        }
+    });
+    world.object = objects;
+
+    simWorld = SimWorldMessage.create(world);
+    return true;
+}
+
 self.addEventListener("message", event => {
     let message = null;
     const data = event.data.data;
@@ -17,10 +114,11 @@ self.addEventListener("message", event => {
             if (typeof data === "string") {
                 message = JSON.parse(data);
             } else {
-                message = SimWorldMessage.toObject(
-                    SimWorldMessage.decode(new Uint8Array(data)),
-                    { enums: String });
-                message.type = "SimWorldUpdate";
+                const delta = SimWorldDeltaMessage.decode(new Uint8Array(data));
+                if (applySimWorldDelta(delta)) {
+                    message = SimWorldMessage.toObject(simWorld, { enums: String });
+                    message.type = "SimWorldUpdate";
+                }
             }
             break;
         case "map":
@@ -33,8 +131,8 @@ self.addEventListener("message", event => {
             if (typeof data === "string") {
                 message = JSON.parse(data);
             } else {
-                message = pointCloudMessage.toObject(
-                    pointCloudMessage.decode(new Uint8Array(data)), {arrays: true});
+                message = accumulatePointCloud(pointCloudMessage.toObject(
+                    pointCloudMessage.decode(new Uint8Array(data)), {arrays: true}));
             }
             break;
     }
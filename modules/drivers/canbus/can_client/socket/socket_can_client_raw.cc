@@ -22,6 +22,10 @@
 
 #include "modules/drivers/canbus/can_client/socket/socket_can_client_raw.h"
 
+#include <sys/time.h>
+
+#include <cerrno>
+
 namespace apollo {
 namespace drivers {
 namespace canbus {
@@ -29,6 +33,35 @@ namespace can {
 
 using apollo::common::ErrorCode;
 
+namespace {
+
+// Gets the receive time of a message from its SCM_TIMESTAMPING control
+// message, preferring the hardware time. Falls back to the current time.
+void GetReceiveTime(struct msghdr *msg, struct timeval *timestamp) {
+  for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET ||
+        cmsg->cmsg_type != SCM_TIMESTAMPING) {
+      continue;
+    }
+    struct scm_timestamping stamps;
+    std::memcpy(&stamps, CMSG_DATA(cmsg), sizeof(stamps));
+    // ts[0] is the software time, and ts[2] the raw hardware one.
+    const struct timespec &ts =
+        (stamps.ts[2].tv_sec != 0 || stamps.ts[2].tv_nsec != 0)
+            ? stamps.ts[2]
+            : stamps.ts[0];
+    if (ts.tv_sec != 0 || ts.tv_nsec != 0) {
+      timestamp->tv_sec = ts.tv_sec;
+      timestamp->tv_usec = ts.tv_nsec / 1000;
+      return;
+    }
+  }
+  gettimeofday(timestamp, nullptr);
+}
+
+}  // namespace
+
 bool SocketCanClientRaw::Init(const CANCardParameter &parameter) {
   if (!parameter.has_channel_id()) {
     AERROR << "Init CAN failed: parameter does not have channel id. The "
@@ -38,6 +71,9 @@ bool SocketCanClientRaw::Init(const CANCardParameter &parameter) {
   }
 
   port_ = parameter.channel_id();
+  interface_name_ = parameter.has_interface_name()
+                        ? parameter.interface_name()
+                        : "can" + std::to_string(port_);
   return true;
 }
 
@@ -95,8 +131,19 @@ ErrorCode SocketCanClientRaw::Start() {
     return ErrorCode::CAN_CLIENT_ERROR_BASE;
   }
 
-  std::string can_name("can" + std::to_string(port_));
-  std::strncpy(ifr.ifr_name, can_name.c_str(), IFNAMSIZ);
+  // 3. enable kernel timestamps of received frames, or hardware ones if the
+  // interface supports them.
+  const int timestamping =
+      SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE |
+      SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+  ret = ::setsockopt(dev_handler_, SOL_SOCKET, SO_TIMESTAMPING, &timestamping,
+                     sizeof(timestamping));
+  if (ret < 0) {
+    AWARN << "enable timestamping error code: " << ret
+          << ", frames are stamped with the time they are read.";
+  }
+
+  std::strncpy(ifr.ifr_name, interface_name_.c_str(), IFNAMSIZ);
   if (ioctl(dev_handler_, SIOCGIFINDEX, &ifr) < 0) {
     AERROR << "ioctl error";
     return ErrorCode::CAN_CLIENT_ERROR_BASE;
@@ -163,7 +210,6 @@ ErrorCode SocketCanClientRaw::Send(const std::vector<CanFrame> &frames,
   return ErrorCode::OK;
 }
 
-// buf size must be 8 bytes, every time, we receive only one frame
 ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
                                       int32_t *const frame_num) {
   if (!is_started_) {
@@ -178,26 +224,51 @@ ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
     return ErrorCode::CAN_CLIENT_ERROR_FRAME_NUM;
   }
 
-  for (int32_t i = 0; i < *frame_num && i < MAX_CAN_RECV_FRAME_LEN; ++i) {
-    CanFrame cf;
-    int ret = read(dev_handler_, &recv_frames_[i], sizeof(recv_frames_[i]));
+  for (int32_t i = 0; i < *frame_num; ++i) {
+    recv_iovecs_[i].iov_base = &recv_frames_[i];
+    recv_iovecs_[i].iov_len = sizeof(recv_frames_[i]);
+    struct msghdr &msg = recv_msgs_[i].msg_hdr;
+    msg.msg_name = nullptr;
+    msg.msg_namelen = 0;
+    msg.msg_iov = &recv_iovecs_[i];
+    msg.msg_iovlen = 1;
+    msg.msg_control = recv_controls_[i];
+    msg.msg_controllen = sizeof(recv_controls_[i]);
+    msg.msg_flags = 0;
+  }
 
-    if (ret < 0) {
-      AERROR << "receive message failed, error code: " << ret;
-      return ErrorCode::CAN_CLIENT_ERROR_BASE;
+  // Block until the first frame, then take the ones already queued.
+  const int ret =
+      recvmmsg(dev_handler_, recv_msgs_, *frame_num, MSG_WAITFORONE, nullptr);
+  if (ret < 0) {
+    if (errno == EINTR) {
+      *frame_num = 0;
+      return ErrorCode::OK;
     }
+    AERROR << "receive message failed, error code: " << ret;
+    return ErrorCode::CAN_CLIENT_ERROR_BASE;
+  }
+
+  int32_t num_received = 0;
+  for (int32_t i = 0; i < ret; ++i) {
     if (recv_frames_[i].can_dlc != CANBUS_MESSAGE_LENGTH) {
-      AERROR << "recv_frames_[" << i
-             << "].can_dlc = " << recv_frames_[i].can_dlc
+      // Drop the bad frame only, the rest of the batch is still good.
+      AERROR << "recv_frames_[" << i << "].can_dlc = "
+             << static_cast<int>(recv_frames_[i].can_dlc)
              << ", which is not equal to can message data length ("
-             << CANBUS_MESSAGE_LENGTH << ").";
-      return ErrorCode::CAN_CLIENT_ERROR_RECV_FAILED;
+             << CANBUS_MESSAGE_LENGTH << "), skip the frame of id 0x"
+             << std::hex << recv_frames_[i].can_id << std::dec << ".";
+      continue;
     }
+    CanFrame cf;
     cf.id = recv_frames_[i].can_id;
     cf.len = recv_frames_[i].can_dlc;
     std::memcpy(cf.data, recv_frames_[i].data, recv_frames_[i].can_dlc);
+    GetReceiveTime(&recv_msgs_[i].msg_hdr, &cf.timestamp);
     frames->push_back(cf);
+    ++num_received;
   }
+  *frame_num = num_received;
   return ErrorCode::OK;
 }
 
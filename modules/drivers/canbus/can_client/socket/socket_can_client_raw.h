@@ -34,6 +34,8 @@
 
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 
 #include <string>
 #include <vector>
@@ -95,9 +97,13 @@ class SocketCanClientRaw : public CanClient {
                                  int32_t *const frame_num) override;
 
   /**
-   * @brief Receive messages
+   * @brief Receive messages. It blocks until a message arrives, and then
+   * drains up to frame_num messages in one system call. The messages carry
+   * the kernel receive time, or the hardware one if the interface supports
+   * it.
    * @param frames The messages to receive.
-   * @param frame_num The amount of messages to receive.
+   * @param frame_num The maximum amount of messages to receive, and output of
+   *        the amount received.
    * @return The status of the receiving action which is defined by
    *         apollo::common::ErrorCode.
    */
@@ -113,8 +119,14 @@ class SocketCanClientRaw : public CanClient {
  private:
   int dev_handler_ = 0;
   CANCardParameter::CANChannelId port_;
+  std::string interface_name_;
   can_frame send_frames_[MAX_CAN_SEND_FRAME_LEN];
   can_frame recv_frames_[MAX_CAN_RECV_FRAME_LEN];
+  // Buffers of recvmmsg.
+  struct mmsghdr recv_msgs_[MAX_CAN_RECV_FRAME_LEN];
+  struct iovec recv_iovecs_[MAX_CAN_RECV_FRAME_LEN];
+  char recv_controls_[MAX_CAN_RECV_FRAME_LEN]
+                     [CMSG_SPACE(sizeof(struct scm_timestamping))];
 };
 
 }  // namespace can
@@ -16,6 +16,13 @@
 
 #include "modules/drivers/canbus/can_client/socket/socket_can_client_raw.h"
 
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <linux/can.h>
+
+#include <cstring>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -50,6 +57,94 @@ TEST(SocketCanClientRawTest, simple_test) {
   socket_can_client.Stop();
 }
 
+TEST(SocketCanClientRawTest, receive_batch) {
+  // Needs a virtual can interface, e.g.
+  //   ip link add dev vcan0 type vcan && ip link set up vcan0
+  if (if_nametoindex("vcan0") == 0) {
+    AINFO << "vcan0 does not exist, skip the test.";
+    return;
+  }
+  CANCardParameter param;
+  param.set_brand(CANCardParameter::SOCKET_CAN_RAW);
+  param.set_channel_id(CANCardParameter::CHANNEL_ID_ZERO);
+  param.set_interface_name("vcan0");
+
+  // A socket does not receive the frames it sends.
+  SocketCanClientRaw sender;
+  SocketCanClientRaw receiver;
+  ASSERT_TRUE(sender.Init(param));
+  ASSERT_TRUE(receiver.Init(param));
+  ASSERT_EQ(ErrorCode::OK, sender.Start());
+  ASSERT_EQ(ErrorCode::OK, receiver.Start());
+
+  for (int32_t i = 0; i < MAX_CAN_RECV_FRAME_LEN; ++i) {
+    std::vector<CanFrame> frames(1);
+    frames[0].id = 0x100 + i;
+    frames[0].len = CANBUS_MESSAGE_LENGTH;
+    frames[0].data[0] = static_cast<uint8_t>(i);
+    ASSERT_EQ(ErrorCode::OK, sender.SendSingleFrame(frames));
+  }
+
+  // The whole burst is queued, and read at once.
+  std::vector<CanFrame> frames;
+  int32_t num = MAX_CAN_RECV_FRAME_LEN;
+  ASSERT_EQ(ErrorCode::OK, receiver.Receive(&frames, &num));
+  ASSERT_EQ(MAX_CAN_RECV_FRAME_LEN, num);
+  ASSERT_EQ(static_cast<size_t>(num), frames.size());
+  for (int32_t i = 0; i < num; ++i) {
+    EXPECT_EQ(static_cast<uint32_t>(0x100 + i), frames[i].id);
+    EXPECT_EQ(i, frames[i].data[0]);
+    EXPECT_TRUE(frames[i].timestamp.tv_sec != 0 ||
+                frames[i].timestamp.tv_usec != 0);
+  }
+  sender.Stop();
+  receiver.Stop();
+}
+
+TEST(SocketCanClientRawTest, receive_skips_bad_frame) {
+  if (if_nametoindex("vcan0") == 0) {
+    AINFO << "vcan0 does not exist, skip the test.";
+    return;
+  }
+  CANCardParameter param;
+  param.set_brand(CANCardParameter::SOCKET_CAN_RAW);
+  param.set_channel_id(CANCardParameter::CHANNEL_ID_ZERO);
+  param.set_interface_name("vcan0");
+  SocketCanClientRaw receiver;
+  ASSERT_TRUE(receiver.Init(param));
+  ASSERT_EQ(ErrorCode::OK, receiver.Start());
+
+  // Send() refuses a short frame, so write it to a raw socket.
+  const int sender = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+  ASSERT_GE(sender, 0);
+  struct sockaddr_can addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.can_family = AF_CAN;
+  addr.can_ifindex = if_nametoindex("vcan0");
+  ASSERT_EQ(0, bind(sender, reinterpret_cast<struct sockaddr *>(&addr),
+                    sizeof(addr)));
+  const uint8_t dlcs[] = {CANBUS_MESSAGE_LENGTH, 4, CANBUS_MESSAGE_LENGTH};
+  for (int i = 0; i < 3; ++i) {
+    struct can_frame frame;
+    std::memset(&frame, 0, sizeof(frame));
+    frame.can_id = 0x200 + i;
+    frame.can_dlc = dlcs[i];
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(frame)),
+              write(sender, &frame, sizeof(frame)));
+  }
+  close(sender);
+
+  // The frames around the short one are kept.
+  std::vector<CanFrame> frames;
+  int32_t num = MAX_CAN_RECV_FRAME_LEN;
+  ASSERT_EQ(ErrorCode::OK, receiver.Receive(&frames, &num));
+  ASSERT_EQ(2, num);
+  ASSERT_EQ(2, frames.size());
+  EXPECT_EQ(0x200u, frames[0].id);
+  EXPECT_EQ(0x202u, frames[1].id);
+  receiver.Stop();
+}
+
 }  // namespace can
 }  // namespace canbus
 }  // namespace drivers
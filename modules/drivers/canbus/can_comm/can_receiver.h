@@ -138,8 +138,9 @@ void CanReceiver<SensorType>::RecvThreadFunc() {
   const int32_t ERROR_COUNT_MAX = 10;
   std::chrono::duration<double, std::micro> default_period{10 * 1000};
 
+  std::vector<CanFrame> buf;
   while (IsRunning()) {
-    std::vector<CanFrame> buf;
+    buf.clear();
     int32_t frame_num = MAX_CAN_RECV_FRAME_LEN;
     if (can_client_->Receive(&buf, &frame_num) !=
         ::apollo::common::ErrorCode::OK) {
@@ -166,12 +167,9 @@ void CanReceiver<SensorType>::RecvThreadFunc() {
     }
     receive_none_count = 0;
 
-    for (const auto &frame : buf) {
-      uint8_t len = frame.len;
-      uint32_t uid = frame.id;
-      const uint8_t *data = frame.data;
-      pt_manager_->Parse(uid, data, len);
-      if (enable_log_) {
+    pt_manager_->ParseFrames(buf);
+    if (enable_log_) {
+      for (const auto &frame : buf) {
         ADEBUG << "recv_can_frame#" << frame.CanFrameString();
       }
     }
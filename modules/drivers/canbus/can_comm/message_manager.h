@@ -32,6 +32,7 @@
 #include "modules/common/log.h"
 #include "modules/common/proto/error_code.pb.h"
 #include "modules/common/time/time.h"
+#include "modules/drivers/canbus/can_client/can_client.h"
 #include "modules/drivers/canbus/can_comm/protocol_data.h"
 #include "modules/drivers/canbus/common/byte.h"
 
@@ -86,6 +87,14 @@ class MessageManager {
   virtual void Parse(const uint32_t message_id, const uint8_t *data,
                      int32_t length);
 
+  /**
+   * @brief parse a batch of received frames, holding the lock of the sensor
+   * data once for the whole batch. Managers which override Parse() should
+   * override this as well, e.g. to parse the frames one by one.
+   * @param frames the received frames
+   */
+  virtual void ParseFrames(const std::vector<CanFrame> &frames);
+
   void ClearSensorData();
 
   std::condition_variable* GetMutableCVar();
@@ -114,6 +123,10 @@ class MessageManager {
   template <class T, bool need_check>
   void AddRecvProtocolData();
 
+  // Records the receipt of a message at the given time in microseconds, and
+  // checks its period.
+  void UpdateReceivedId(const uint32_t message_id, const int64_t time);
+
   template <class T, bool need_check>
   void AddSendProtocolData();
 
@@ -189,11 +202,39 @@ void MessageManager<SensorType>::Parse(const uint32_t message_id,
     std::lock_guard<std::mutex> lock(sensor_data_mutex_);
     protocol_data->Parse(data, length, &sensor_data_);
   }
+  UpdateReceivedId(message_id,
+                   apollo::common::time::AsInt64<micros>(Clock::Now()));
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::ParseFrames(
+    const std::vector<CanFrame> &frames) {
+  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+  for (const auto &frame : frames) {
+    ProtocolData<SensorType> *protocol_data =
+        GetMutableProtocolDataById(frame.id);
+    if (protocol_data == nullptr) {
+      continue;
+    }
+    protocol_data->Parse(frame.data, frame.len, &sensor_data_);
+    // The frames of a batch are read at once, so their periods are checked
+    // against the time they were received, if the can client stamps them.
+    const int64_t time =
+        frame.timestamp.tv_sec == 0 && frame.timestamp.tv_usec == 0
+            ? apollo::common::time::AsInt64<micros>(Clock::Now())
+            : static_cast<int64_t>(frame.timestamp.tv_sec) * 1000000 +
+                  frame.timestamp.tv_usec;
+    UpdateReceivedId(frame.id, time);
+  }
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::UpdateReceivedId(const uint32_t message_id,
+                                                  const int64_t time) {
   received_ids_.insert(message_id);
   // check if need to check period
   const auto it = check_ids_.find(message_id);
   if (it != check_ids_.end()) {
-    const int64_t time = apollo::common::time::AsInt64<micros>(Clock::Now());
     it->second.real_period = time - it->second.last_time;
     // if period 1.5 large than base period, inc error_count
     const double period_multiplier = 1.5;
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -36,13 +37,27 @@ class MockProtocolData : public ProtocolData<::apollo::canbus::ChassisDetail> {
   MockProtocolData() {}
 };
 
+class MockGearProtocolData
+    : public ProtocolData<::apollo::canbus::ChassisDetail> {
+ public:
+  static const int32_t ID = 0x112;
+  void Parse(const uint8_t *bytes, int32_t length,
+             ::apollo::canbus::ChassisDetail *chassis_detail) const override {
+    chassis_detail->mutable_gear()->set_gear_state(
+        static_cast<::apollo::canbus::Chassis::GearPosition>(bytes[0]));
+  }
+};
+
 class MockMessageManager
     : public MessageManager<::apollo::canbus::ChassisDetail> {
  public:
   MockMessageManager() {
     AddRecvProtocolData<MockProtocolData, true>();
     AddSendProtocolData<MockProtocolData, true>();
+    AddRecvProtocolData<MockGearProtocolData, false>();
   }
+
+  const CheckIdArg &check_id(const uint32_t id) { return check_ids_[id]; }
 };
 
 TEST(MessageManagerTest, GetMutableProtocolDataById) {
@@ -59,6 +74,48 @@ TEST(MessageManagerTest, GetMutableProtocolDataById) {
   EXPECT_EQ(manager.GetSensorData(nullptr), ErrorCode::CANBUS_ERROR);
 }
 
+TEST(MessageManagerTest, ParseFrames) {
+  MockMessageManager manager;
+  std::vector<CanFrame> frames(3);
+  frames[0].id = MockGearProtocolData::ID;
+  frames[0].data[0] = ::apollo::canbus::Chassis::GEAR_REVERSE;
+  // Unknown ids are skipped.
+  frames[1].id = 0x999;
+  frames[2].id = MockGearProtocolData::ID;
+  frames[2].data[0] = ::apollo::canbus::Chassis::GEAR_DRIVE;
+  for (auto &frame : frames) {
+    frame.len = 8;
+  }
+  manager.ParseFrames(frames);
+
+  ::apollo::canbus::ChassisDetail chassis_detail;
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_EQ(::apollo::canbus::Chassis::GEAR_DRIVE,
+            chassis_detail.gear().gear_state());
+}
+
+TEST(MessageManagerTest, ParseFramesWithTimestamps) {
+  MockMessageManager manager;
+  // A batch read at once, whose frames were received 100ms apart.
+  std::vector<CanFrame> frames(3);
+  for (size_t i = 0; i < frames.size(); ++i) {
+    frames[i].id = MockProtocolData::ID;
+    frames[i].len = 8;
+    frames[i].timestamp.tv_sec = 1000;
+    frames[i].timestamp.tv_usec = static_cast<int>(i) * 100000;
+  }
+  manager.ParseFrames(frames);
+  EXPECT_EQ(100000, manager.check_id(MockProtocolData::ID).real_period);
+  EXPECT_EQ(0, manager.check_id(MockProtocolData::ID).error_count);
+
+  // A frame received late.
+  frames.resize(1);
+  frames[0].timestamp.tv_sec = 1001;
+  manager.ParseFrames(frames);
+  EXPECT_EQ(800000, manager.check_id(MockProtocolData::ID).real_period);
+  EXPECT_EQ(1, manager.check_id(MockProtocolData::ID).error_count);
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
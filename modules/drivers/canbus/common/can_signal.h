@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the CanFrameBits and CanSignal classes.
+ */
+
+#ifndef MODULES_DRIVERS_CANBUS_COMMON_CAN_SIGNAL_H_
+#define MODULES_DRIVERS_CANBUS_COMMON_CAN_SIGNAL_H_
+
+#include <cstdint>
+
+/**
+ * @namespace apollo::drivers::canbus
+ * @brief apollo::drivers::canbus
+ */
+namespace apollo {
+namespace drivers {
+namespace canbus {
+
+/**
+ * @brief The bit numbering of a signal in a DBC description.
+ */
+enum class ByteOrder {
+  // Big endian, the start bit is the most significant bit of the signal.
+  MOTOROLA,
+  // Little endian, the start bit is the least significant bit of the signal.
+  INTEL,
+};
+
+/**
+ * @class CanFrameBits
+ * @brief The payload of a CAN frame as one 64-bit word, so that all the
+ *        signals of the frame are extracted from it with a shift and a mask.
+ */
+class CanFrameBits {
+ public:
+  CanFrameBits() = default;
+
+  /**
+   * @brief Loads the payload of a frame. Missing bytes of a frame shorter
+   *        than 8 bytes read as zeros.
+   * @param bytes The payload of the frame.
+   * @param length The length of the payload.
+   */
+  CanFrameBits(const uint8_t *bytes, const int32_t length) {
+    if (length >= 8) {
+      for (int i = 0; i < 8; ++i) {
+        bits_ |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+      }
+    } else {
+      for (int i = 0; i < length; ++i) {
+        bits_ |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+      }
+    }
+  }
+
+  /**
+   * @brief Writes the 8 bytes of the payload.
+   * @param bytes The payload of the frame.
+   */
+  void Store(uint8_t *bytes) const {
+    for (int i = 0; i < 8; ++i) {
+      bytes[i] = static_cast<uint8_t>(bits_ >> (8 * i));
+    }
+  }
+
+  /**
+   * @brief The payload with byte 0 as the least significant byte.
+   */
+  uint64_t intel() const { return bits_; }
+  void set_intel(const uint64_t bits) { bits_ = bits; }
+
+  /**
+   * @brief The payload with byte 0 as the most significant byte.
+   */
+  uint64_t motorola() const { return __builtin_bswap64(bits_); }
+  void set_motorola(const uint64_t bits) { bits_ = __builtin_bswap64(bits); }
+
+ private:
+  uint64_t bits_ = 0;
+};
+
+/**
+ * @class CanSignal
+ * @brief The codec of one signal of a DBC message. The layout of the signal
+ *        is resolved at compile time, so that decoding it is a shift, a mask
+ *        and a multiply-add without branches.
+ *
+ * Signals are declared as constants next to the protocol parsing them, e.g.
+ * @code
+ * constexpr CanSignal<7, 16, ByteOrder::MOTOROLA> kManualInput(0.001);
+ *
+ * const CanFrameBits frame(bytes, length);
+ * rpt->set_manual_input(kManualInput.Decode(frame));
+ * @endcode
+ *
+ * @tparam kBit The start bit of the signal, as in the DBC description.
+ * @tparam kLength The number of bits of the signal.
+ * @tparam kOrder The byte order of the signal.
+ * @tparam kSigned Whether the raw value is two's complement.
+ */
+template <int kBit, int kLength, ByteOrder kOrder, bool kSigned = false>
+class CanSignal {
+  static_assert(kBit >= 0 && kBit < 64, "The start bit is out of the frame.");
+  static_assert(kLength > 0 && kLength <= 32,
+                "The signal must have 1 to 32 bits.");
+
+  // Position of the least significant bit in the word of the byte order.
+  static constexpr int kShift =
+      kOrder == ByteOrder::MOTOROLA
+          ? (7 - kBit / 8) * 8 + kBit % 8 - kLength + 1
+          : kBit;
+  static_assert(kShift >= 0 && kShift + kLength <= 64,
+                "The signal is out of the frame.");
+
+  static constexpr uint64_t kMask = (uint64_t{1} << kLength) - 1;
+
+ public:
+  /**
+   * @param precision The scale of the raw value.
+   * @param offset The offset of the physical value.
+   */
+  constexpr explicit CanSignal(const double precision = 1.0,
+                               const double offset = 0.0)
+      : precision_(precision), offset_(offset) {}
+
+  /**
+   * @brief Extracts the raw value of the signal, sign extended if the signal
+   *        is signed.
+   */
+  int64_t Raw(const CanFrameBits &frame) const {
+    const uint64_t raw = (Word(frame) >> kShift) & kMask;
+    if (kSigned) {
+      return static_cast<int64_t>(raw << (64 - kLength)) >> (64 - kLength);
+    }
+    return static_cast<int64_t>(raw);
+  }
+
+  /**
+   * @brief Extracts the physical value of the signal.
+   */
+  double Decode(const CanFrameBits &frame) const {
+    return static_cast<double>(Raw(frame)) * precision_ + offset_;
+  }
+
+  /**
+   * @brief Packs a raw value into the bits of the signal, leaving the other
+   *        bits of the frame untouched. Bits beyond the length are dropped.
+   */
+  void Pack(const int64_t raw, CanFrameBits *frame) const {
+    const uint64_t bits = (Word(*frame) & ~(kMask << kShift)) |
+                          ((static_cast<uint64_t>(raw) & kMask) << kShift);
+    if (kOrder == ByteOrder::MOTOROLA) {
+      frame->set_motorola(bits);
+    } else {
+      frame->set_intel(bits);
+    }
+  }
+
+  /**
+   * @brief Packs a physical value, truncated to the precision of the signal
+   *        like the generated set_p_ functions of the control protocols.
+   */
+  void Encode(const double value, CanFrameBits *frame) const {
+    Pack(static_cast<int64_t>((value - offset_) / precision_), frame);
+  }
+
+ private:
+  static uint64_t Word(const CanFrameBits &frame) {
+    return kOrder == ByteOrder::MOTOROLA ? frame.motorola() : frame.intel();
+  }
+
+  const double precision_;
+  const double offset_;
+};
+
+}  // namespace canbus
+}  // namespace drivers
+}  // namespace apollo
+
+#endif  // MODULES_DRIVERS_CANBUS_COMMON_CAN_SIGNAL_H_
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/canbus/common/can_signal.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/drivers/canbus/common/byte.h"
+
+namespace apollo {
+namespace drivers {
+namespace canbus {
+
+TEST(CanSignalTest, Motorola) {
+  const uint8_t bytes[8] = {0x01, 0x02, 0x03, 0x04, 0x11, 0x12, 0x13, 0x14};
+  const CanFrameBits frame(bytes, 8);
+
+  constexpr CanSignal<7, 16, ByteOrder::MOTOROLA> kWord(0.001);
+  EXPECT_EQ(0x0102, kWord.Raw(frame));
+  EXPECT_DOUBLE_EQ(0.258, kWord.Decode(frame));
+
+  // Bits 5..0 of byte 4 followed by byte 5, as the Byte helpers read them.
+  constexpr CanSignal<37, 14, ByteOrder::MOTOROLA> kSpanning;
+  Byte t0(bytes + 4);
+  Byte t1(bytes + 5);
+  EXPECT_EQ((t0.get_byte(0, 6) << 8) | t1.get_byte(0, 8),
+            kSpanning.Raw(frame));
+
+  constexpr CanSignal<0, 1, ByteOrder::MOTOROLA> kFlag;
+  EXPECT_EQ(1, kFlag.Raw(frame));
+}
+
+TEST(CanSignalTest, Intel) {
+  const uint8_t bytes[8] = {0x34, 0x12, 0xFE, 0xFF, 0x00, 0x00, 0x00, 0x80};
+  const CanFrameBits frame(bytes, 8);
+
+  constexpr CanSignal<0, 16, ByteOrder::INTEL> kWord(1.0, -10.0);
+  EXPECT_EQ(0x1234, kWord.Raw(frame));
+  EXPECT_DOUBLE_EQ(0x1234 - 10.0, kWord.Decode(frame));
+
+  constexpr CanSignal<16, 16, ByteOrder::INTEL, true> kSigned(0.5);
+  EXPECT_EQ(-2, kSigned.Raw(frame));
+  EXPECT_DOUBLE_EQ(-1.0, kSigned.Decode(frame));
+
+  constexpr CanSignal<63, 1, ByteOrder::INTEL> kLastBit;
+  EXPECT_EQ(1, kLastBit.Raw(frame));
+}
+
+TEST(CanSignalTest, ShortFrame) {
+  const uint8_t bytes[2] = {0xFF, 0xFF};
+  const CanFrameBits frame(bytes, 2);
+  constexpr CanSignal<8, 16, ByteOrder::INTEL> kSignal;
+  EXPECT_EQ(0xFF, kSignal.Raw(frame));
+}
+
+TEST(CanSignalTest, Encode) {
+  uint8_t bytes[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+  CanFrameBits frame(bytes, 8);
+
+  constexpr CanSignal<7, 16, ByteOrder::MOTOROLA> kMotorola(0.001);
+  kMotorola.Encode(0.258, &frame);
+  constexpr CanSignal<32, 12, ByteOrder::INTEL, true> kIntel(0.1, 10.0);
+  kIntel.Encode(5.0, &frame);
+  frame.Store(bytes);
+
+  EXPECT_EQ(0x01, bytes[0]);
+  EXPECT_EQ(0x02, bytes[1]);
+  EXPECT_EQ(0xFF, bytes[2]);
+  // -50 in 12 bits, the upper 4 bits of byte 5 are untouched.
+  EXPECT_EQ(0xCE, bytes[4]);
+  EXPECT_EQ(0xFF, bytes[5]);
+
+  const CanFrameBits decoded(bytes, 8);
+  EXPECT_DOUBLE_EQ(0.258, kMotorola.Decode(decoded));
+  EXPECT_DOUBLE_EQ(5.0, kIntel.Decode(decoded));
+}
+
+}  // namespace canbus
+}  // namespace drivers
+}  // namespace apollo
@@ -179,6 +179,20 @@ VelodyneDriver::VelodyneDriver(ros::NodeHandle node,
     input_.reset(new lidar_velodyne::InputSocket(private_nh, udp_port));
   }
 
+  if (driver_node_conf_.use_packet_ring()) {
+    const int ring_size = driver_node_conf_.packet_ring_size();
+    if (ring_size <= 0 || ring_size > MAX_PACKET_RING_SIZE) {
+      AERROR << "packet_ring_size " << ring_size << " is not in (0, "
+             << MAX_PACKET_RING_SIZE << "], reading packets one by one";
+    } else {
+      packet_receiver_.reset(
+          new PacketReceiver(input_.get(), ring_size, config_.time_offset));
+      packet_receiver_->Start();
+      AINFO << "batched packet input, ring size "
+            << packet_receiver_->ring_capacity();
+    }
+  }
+
   // raw packet output topic
   output_ = node.advertise<velodyne_msgs::VelodyneScan>("velodyne_packets", 10);
 }
@@ -194,12 +208,18 @@ bool VelodyneDriver::poll(void) {
 
   // Since the velodyne delivers data at a very high rate, keep
   // reading and publishing scans as fast as possible.
-  for (int i = 0; i < config_.npackets; ++i) {
-    while (true) {
-      // keep reading until full packet received
-      int rc = input_->getPacket(&scan->packets[i], config_.time_offset);
-      if (rc == 0) break;        // got a full packet?
-      if (rc < 0) return false;  // end of file reached?
+  if (packet_receiver_) {
+    if (!packet_receiver_->ReadPackets(&scan->packets[0], config_.npackets)) {
+      return false;  // end of file reached
+    }
+  } else {
+    for (int i = 0; i < config_.npackets; ++i) {
+      while (true) {
+        // keep reading until full packet received
+        int rc = input_->getPacket(&scan->packets[i], config_.time_offset);
+        if (rc == 0) break;        // got a full packet?
+        if (rc < 0) return false;  // end of file reached?
+      }
     }
   }
   // average the time stamp from first package and last package
@@ -31,6 +31,7 @@
 #ifndef MODULES_DRIVERS_LIDAR_VELODYN_DRIVER_DRIVER_H_
 #define MODULES_DRIVERS_LIDAR_VELODYN_DRIVER_DRIVER_H_
 
+#include <memory>
 #include <string>
 
 #include "dynamic_reconfigure/server.h"
@@ -39,6 +40,7 @@
 #include "modules/drivers/lidar_velodyne/proto/driver_node_conf.pb.h"
 
 #include "modules/drivers/lidar_velodyne/driver/input.h"
+#include "modules/drivers/lidar_velodyne/driver/packet_receiver.h"
 
 namespace apollo {
 namespace drivers {
@@ -70,6 +72,9 @@ class VelodyneDriver {
   } config_;
 
   boost::shared_ptr<Input> input_;
+  /// receive thread filling a packet ring from input_, only set when the
+  /// driver runs with use_packet_ring
+  std::unique_ptr<PacketReceiver> packet_receiver_;
   ros::Publisher output_;
 
   /** diagnostics updater */
@@ -46,7 +46,9 @@
 #include <poll.h>
 #include <sys/file.h>
 #include <sys/socket.h>
+#include <time.h>
 #include <unistd.h>
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -72,6 +74,27 @@ Input::Input(ros::NodeHandle private_nh, uint16_t port)
     ROS_INFO_STREAM("Only accepting packets from IP address: " << devip_str_);
 }
 
+/** @brief Get a batch of velodyne packets, one packet at a time. */
+int Input::getPackets(VelodynePacketRing *ring, const double time_offset) {
+  velodyne_msgs::VelodynePacket *slots = nullptr;
+  const int n = std::min(static_cast<int>(ring->WritableSpan(&slots)),
+                         PACKET_BATCH_SIZE);
+  int count = 0;
+  while (count < n) {
+    int rc = getPacket(&slots[count], time_offset);
+    if (rc < 0) {
+      ring->Commit(count);
+      return count > 0 ? count : -1;
+    }
+    if (rc > 0) {
+      break;
+    }
+    ++count;
+  }
+  ring->Commit(count);
+  return count;
+}
+
 // InputSocket class implementation
 
 /** @brief constructor
@@ -112,6 +135,13 @@ InputSocket::InputSocket(ros::NodeHandle private_nh, uint16_t port)
     return;
   }
 
+  // ask the kernel to stamp each datagram on arrival, used by getPackets()
+  int enable = 1;
+  if (setsockopt(sockfd_, SOL_SOCKET, SO_TIMESTAMPNS, &enable,
+                 sizeof(enable)) < 0) {
+    ROS_WARN("SO_TIMESTAMPNS not supported, using receive time instead");
+  }
+
   ROS_DEBUG("Velodyne socket fd is %d\n", sockfd_);
 }
 
@@ -123,49 +153,13 @@ int InputSocket::getPacket(velodyne_msgs::VelodynePacket *pkt,
                            const double time_offset) {
   double time1 = ros::Time::now().toSec();
 
-  struct pollfd fds[1];
-  fds[0].fd = sockfd_;
-  fds[0].events = POLLIN;
-  static const int POLL_TIMEOUT = 1000;  // one second (in msec)
-
   sockaddr_in sender_address;
   socklen_t sender_address_len = sizeof(sender_address);
 
   while (true) {
-    // Unfortunately, the Linux kernel recvfrom() implementation
-    // uses a non-interruptible sleep() when waiting for data,
-    // which would cause this method to hang if the device is not
-    // providing data.  We poll() the device first to make sure
-    // the recvfrom() will not block.
-    //
-    // Note, however, that there is a known Linux kernel bug:
-    //
-    //   Under Linux, select() may report a socket file descriptor
-    //   as "ready for reading", while nevertheless a subsequent
-    //   read blocks.  This could for example happen when data has
-    //   arrived but upon examination has wrong checksum and is
-    //   discarded.  There may be other circumstances in which a
-    //   file descriptor is spuriously reported as ready.  Thus it
-    //   may be safer to use O_NONBLOCK on sockets that should not
-    //   block.
-
-    // poll() until input available
-    do {
-      int retval = poll(fds, 1, POLL_TIMEOUT);
-      if (retval < 0) {  // poll() error?
-        if (errno != EINTR) ROS_ERROR("poll() error: %s", strerror(errno));
-        return 1;
-      }
-      if (retval == 0) {  // poll() timeout?
-        ROS_WARN("Velodyne poll() timeout");
-        return 1;
-      }
-      if ((fds[0].revents & POLLERR) || (fds[0].revents & POLLHUP) ||
-          (fds[0].revents & POLLNVAL)) {  // device error?
-        ROS_ERROR("poll() reports Velodyne error");
-        return 1;
-      }
-    } while ((fds[0].revents & POLLIN) == 0);
+    if (!waitForInput()) {
+      return 1;
+    }
 
     // Receive packets that should now be available from the
     // socket using a blocking read.
@@ -200,6 +194,131 @@ int InputSocket::getPacket(velodyne_msgs::VelodynePacket *pkt,
   return 0;
 }
 
+/** @brief Wait until the socket is readable. */
+bool InputSocket::waitForInput() {
+  struct pollfd fds[1];
+  fds[0].fd = sockfd_;
+  fds[0].events = POLLIN;
+  static const int POLL_TIMEOUT = 1000;  // one second (in msec)
+
+  // Unfortunately, the Linux kernel recvfrom() implementation
+  // uses a non-interruptible sleep() when waiting for data,
+  // which would cause this method to hang if the device is not
+  // providing data.  We poll() the device first to make sure
+  // the recvfrom() will not block.
+  //
+  // Note, however, that there is a known Linux kernel bug:
+  //
+  //   Under Linux, select() may report a socket file descriptor
+  //   as "ready for reading", while nevertheless a subsequent
+  //   read blocks.  This could for example happen when data has
+  //   arrived but upon examination has wrong checksum and is
+  //   discarded.  There may be other circumstances in which a
+  //   file descriptor is spuriously reported as ready.  Thus it
+  //   may be safer to use O_NONBLOCK on sockets that should not
+  //   block.
+
+  // poll() until input available
+  do {
+    int retval = poll(fds, 1, POLL_TIMEOUT);
+    if (retval < 0) {  // poll() error?
+      if (errno != EINTR) ROS_ERROR("poll() error: %s", strerror(errno));
+      return false;
+    }
+    if (retval == 0) {  // poll() timeout?
+      ROS_WARN("Velodyne poll() timeout");
+      return false;
+    }
+    if ((fds[0].revents & POLLERR) || (fds[0].revents & POLLHUP) ||
+        (fds[0].revents & POLLNVAL)) {  // device error?
+      ROS_ERROR("poll() reports Velodyne error");
+      return false;
+    }
+  } while ((fds[0].revents & POLLIN) == 0);
+  return true;
+}
+
+/** @brief Get a batch of velodyne packets with one recvmmsg() call.
+ *
+ *  Datagrams are received straight into the free ring slots and stamped
+ *  with the kernel receive time (SO_TIMESTAMPNS) when available.
+ */
+int InputSocket::getPackets(VelodynePacketRing *ring,
+                            const double time_offset) {
+  velodyne_msgs::VelodynePacket *slots = nullptr;
+  const int n = std::min(static_cast<int>(ring->WritableSpan(&slots)),
+                         PACKET_BATCH_SIZE);
+  if (n == 0) {
+    return 0;
+  }
+  if (!waitForInput()) {
+    return 0;
+  }
+
+  union Control {
+    char buf[CMSG_SPACE(sizeof(struct timespec))];
+    cmsghdr align;
+  };
+  mmsghdr msgs[PACKET_BATCH_SIZE];
+  iovec iovecs[PACKET_BATCH_SIZE];
+  sockaddr_in sender_addresses[PACKET_BATCH_SIZE];
+  Control controls[PACKET_BATCH_SIZE];
+  memset(msgs, 0, sizeof(msgs[0]) * n);
+  for (int i = 0; i < n; ++i) {
+    iovecs[i].iov_base = &slots[i].data[0];
+    iovecs[i].iov_len = packet_size;
+    msgs[i].msg_hdr.msg_iov = &iovecs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_name = &sender_addresses[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(sender_addresses[i]);
+    msgs[i].msg_hdr.msg_control = controls[i].buf;
+    msgs[i].msg_hdr.msg_controllen = sizeof(controls[i].buf);
+  }
+
+  int received = recvmmsg(sockfd_, msgs, n, MSG_DONTWAIT, NULL);
+  if (received < 0) {
+    if (errno != EWOULDBLOCK && errno != EINTR) {
+      ROS_ERROR("recvmmsg() error: %s", strerror(errno));
+    }
+    return 0;
+  }
+
+  const double now = ros::Time::now().toSec();
+  int count = 0;
+  for (int i = 0; i < received; ++i) {
+    if (msgs[i].msg_len != packet_size) {
+      ROS_DEBUG_STREAM("incomplete Velodyne packet read: " << msgs[i].msg_len
+                                                           << " bytes");
+      continue;
+    }
+    if (!devip_str_.empty() &&
+        sender_addresses[i].sin_addr.s_addr != devip_.s_addr) {
+      continue;
+    }
+
+    double stamp = now;
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg != NULL;
+         cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET &&
+          cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+        struct timespec ts;
+        memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        stamp = ts.tv_sec + ts.tv_nsec * 1e-9;
+        break;
+      }
+    }
+
+    // keep the accepted packets contiguous in the ring
+    if (count != i) {
+      memcpy(&slots[count].data[0], &slots[i].data[0], packet_size);
+    }
+    slots[count].stamp = ros::Time(stamp + time_offset);
+    ++count;
+  }
+  ring->Commit(count);
+  return count;
+}
+
 // InputPCAP class implementation
 
 /** @brief constructor
@@ -216,10 +335,10 @@ InputPCAP::InputPCAP(ros::NodeHandle private_nh, uint16_t port,
   pcap_ = NULL;
   empty_ = true;
 
-  // get parameters using private node handle
-  private_nh.param("read_once", read_once_, false);
-  private_nh.param("read_fast", read_fast_, false);
-  private_nh.param("repeat_delay", repeat_delay_, 0.0);
+  // get parameters using private node handle, the arguments are the defaults
+  private_nh.param("read_once", read_once_, read_once);
+  private_nh.param("read_fast", read_fast_, read_fast);
+  private_nh.param("repeat_delay", repeat_delay_, repeat_delay);
 
   if (read_once_) ROS_INFO("Read input file only once.");
   if (read_fast_) ROS_INFO("Read input file as quickly as possible.");
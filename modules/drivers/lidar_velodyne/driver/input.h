@@ -58,6 +58,8 @@
 #include "ros/ros.h"
 #include "velodyne_msgs/VelodynePacket.h"
 
+#include "modules/drivers/lidar_velodyne/driver/packet_ring.h"
+
 namespace apollo {
 namespace drivers {
 namespace lidar_velodyne {
@@ -65,6 +67,11 @@ namespace lidar_velodyne {
 static uint16_t DATA_PORT_NUMBER = 2368;      // default data port
 static uint16_t POSITION_PORT_NUMBER = 8308;  // default position port
 
+/// maximal number of packets pulled from the source in one batch
+static const int PACKET_BATCH_SIZE = 64;
+
+typedef PacketRing<velodyne_msgs::VelodynePacket> VelodynePacketRing;
+
 /** @brief Velodyne input base class */
 class Input {
  public:
@@ -82,6 +89,18 @@ class Input {
   virtual int getPacket(velodyne_msgs::VelodynePacket *pkt,
                         const double time_offset) = 0;
 
+  /** @brief Read a batch of Velodyne packets straight into a ring.
+   *
+   * The default implementation fills the free slots one getPacket() call
+   * at a time, sources able to do better (sockets) override it.
+   *
+   * @param ring preallocated packet ring, packets are committed to it
+   *
+   * @returns number of packets committed (may be 0),
+   *          -1 if end of file
+   */
+  virtual int getPackets(VelodynePacketRing *ring, const double time_offset);
+
  protected:
   ros::NodeHandle private_nh_;
   uint16_t port_;
@@ -97,9 +116,16 @@ class InputSocket : public Input {
 
   virtual int getPacket(velodyne_msgs::VelodynePacket *pkt,
                         const double time_offset);
+  virtual int getPackets(VelodynePacketRing *ring, const double time_offset);
   void setDeviceIP(const std::string &ip);
 
  private:
+  /** @brief Wait until the socket is readable.
+   *
+   * @returns true if data is available, false on timeout or error
+   */
+  bool waitForInput();
+
   int sockfd_;
   in_addr devip_;
 };
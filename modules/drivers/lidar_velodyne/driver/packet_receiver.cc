@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/lidar_velodyne/driver/packet_receiver.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace drivers {
+namespace lidar_velodyne {
+
+PacketReceiver::PacketReceiver(Input *input, int ring_size,
+                               double time_offset)
+    : input_(CHECK_NOTNULL(input)), ring_(ring_size),
+      time_offset_(time_offset) {
+  CHECK_GT(ring_size, 0);
+  CHECK_LE(ring_size, MAX_PACKET_RING_SIZE);
+}
+
+PacketReceiver::~PacketReceiver() { Stop(); }
+
+void PacketReceiver::Start() {
+  if (running_.exchange(true)) {
+    return;
+  }
+  thread_ = std::thread(&PacketReceiver::Run, this);
+}
+
+void PacketReceiver::Stop() {
+  running_ = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    packets_ready_.notify_all();
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void PacketReceiver::Run() {
+  while (running_) {
+    if (ring_.size() == ring_.capacity()) {
+      // the driver thread is behind, the socket buffer holds the datagrams
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    const int n = input_->getPackets(&ring_, time_offset_);
+    if (n < 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      end_of_input_ = true;
+      packets_ready_.notify_all();
+      return;
+    }
+    if (n > 0) {
+      // notify under the lock, so the wait in ReadPackets() does not miss it
+      std::lock_guard<std::mutex> lock(mutex_);
+      packets_ready_.notify_one();
+    }
+  }
+}
+
+bool PacketReceiver::ReadPackets(velodyne_msgs::VelodynePacket *packets,
+                                 int n) {
+  int i = 0;
+  while (i < n) {
+    const velodyne_msgs::VelodynePacket *slots = nullptr;
+    size_t m = ring_.ReadableSpan(&slots);
+    if (m == 0) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      packets_ready_.wait(lock, [this] {
+        return !ring_.empty() || end_of_input_ || !running_;
+      });
+      if (ring_.empty()) {
+        return false;
+      }
+      continue;
+    }
+    m = std::min(m, static_cast<size_t>(n - i));
+    std::copy(slots, slots + m, packets + i);
+    ring_.Release(m);
+    i += m;
+  }
+  return true;
+}
+
+}  // namespace lidar_velodyne
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/** \file
+ *
+ *  Receive thread filling a packet ring from a Velodyne input.
+ *
+ *  The receive thread keeps pulling batches from the input (recvmmsg for
+ *  sockets) while the driver thread assembles and publishes scans, so a slow
+ *  scan does not leave the datagrams waiting in the socket buffer.
+ */
+
+#ifndef MODULES_DRIVERS_LIDAR_VELODYNE_DRIVER_PACKET_RECEIVER_H_
+#define MODULES_DRIVERS_LIDAR_VELODYNE_DRIVER_PACKET_RECEIVER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "velodyne_msgs/VelodynePacket.h"
+
+#include "modules/drivers/lidar_velodyne/driver/input.h"
+#include "modules/drivers/lidar_velodyne/driver/packet_ring.h"
+
+namespace apollo {
+namespace drivers {
+namespace lidar_velodyne {
+
+/// maximal number of slots of the packet ring
+static const int MAX_PACKET_RING_SIZE = 1 << 16;
+
+class PacketReceiver {
+ public:
+  /**
+   * @brief Constructor.
+   * @param input source of the packets, not owned, must outlive the receiver.
+   * @param ring_size number of packet slots, in (0, MAX_PACKET_RING_SIZE].
+   * @param time_offset time in seconds added to each packet stamp.
+   */
+  PacketReceiver(Input *input, int ring_size, double time_offset);
+  ~PacketReceiver();
+
+  /** @brief Start the receive thread. */
+  void Start();
+  /** @brief Stop and join the receive thread. */
+  void Stop();
+
+  /**
+   * @brief Copy the next n packets out of the ring, waiting for them.
+   * @return false at the end of the input, or when the receiver is stopped.
+   */
+  bool ReadPackets(velodyne_msgs::VelodynePacket *packets, int n);
+
+  size_t ring_capacity() const { return ring_.capacity(); }
+
+ private:
+  void Run();
+
+  Input *input_;
+  VelodynePacketRing ring_;
+  double time_offset_;
+
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  // the driver thread waits on it for committed packets
+  std::mutex mutex_;
+  std::condition_variable packets_ready_;
+  bool end_of_input_ = false;
+};
+
+}  // namespace lidar_velodyne
+}  // namespace drivers
+}  // namespace apollo
+
+#endif  // MODULES_DRIVERS_LIDAR_VELODYNE_DRIVER_PACKET_RECEIVER_H_
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/lidar_velodyne/driver/packet_receiver.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pcap/pcap.h"
+#include "ros/ros.h"
+
+namespace apollo {
+namespace drivers {
+namespace lidar_velodyne {
+
+namespace {
+
+// Ethernet, IPv4 and UDP headers in front of the payload, as skipped by
+// InputPCAP.
+const int kHeaderSize = 42;
+const int kPayloadSize = 1206;
+
+// Writes num_packets Velodyne datagrams, the first payload bytes of the
+// i-th one holding i.
+void WritePcap(const std::string &filename, int num_packets) {
+  pcap_t *pcap = pcap_open_dead(DLT_EN10MB, 65535);
+  ASSERT_NE(nullptr, pcap);
+  pcap_dumper_t *dumper = pcap_dump_open(pcap, filename.c_str());
+  ASSERT_NE(nullptr, dumper);
+  std::vector<u_char> frame(kHeaderSize + kPayloadSize, 0);
+  frame[12] = 0x08;  // IPv4
+  frame[14] = 0x45;
+  frame[23] = 17;  // UDP
+  frame[36] = DATA_PORT_NUMBER >> 8;
+  frame[37] = DATA_PORT_NUMBER & 0xff;
+  for (int i = 0; i < num_packets; ++i) {
+    frame[kHeaderSize] = i & 0xff;
+    frame[kHeaderSize + 1] = (i >> 8) & 0xff;
+    pcap_pkthdr header;
+    header.ts.tv_sec = i;
+    header.ts.tv_usec = 0;
+    header.caplen = frame.size();
+    header.len = frame.size();
+    pcap_dump(reinterpret_cast<u_char *>(dumper), &header, frame.data());
+  }
+  pcap_dump_close(dumper);
+  pcap_close(pcap);
+}
+
+int PacketIndex(const velodyne_msgs::VelodynePacket &packet) {
+  return packet.data[0] | (packet.data[1] << 8);
+}
+
+}  // namespace
+
+class PacketReceiverTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    ros::init(std::map<std::string, std::string>(), "packet_receiver_test",
+              ros::init_options::AnonymousName |
+                  ros::init_options::NoRosout);
+  }
+
+  virtual void SetUp() {
+    filename_ = "/tmp/packet_receiver_test_" + std::to_string(getpid()) +
+                ".pcap";
+  }
+
+  virtual void TearDown() { std::remove(filename_.c_str()); }
+
+ protected:
+  std::string filename_;
+};
+
+TEST_F(PacketReceiverTest, ReplaysPcapInOrder) {
+  const int kNumPackets = 1000;
+  WritePcap(filename_, kNumPackets);
+  ros::NodeHandle private_nh("~");
+  InputPCAP input(private_nh, DATA_PORT_NUMBER, 1000.0, filename_,
+                  true /* read_once */, true /* read_fast */);
+
+  // a ring smaller than a scan wraps around several times
+  PacketReceiver receiver(&input, 128, 0.0);
+  EXPECT_EQ(128u, receiver.ring_capacity());
+  receiver.Start();
+
+  const int kScanSize = 300;
+  std::vector<velodyne_msgs::VelodynePacket> scan(kScanSize);
+  int next_index = 0;
+  while (next_index + kScanSize <= kNumPackets) {
+    ASSERT_TRUE(receiver.ReadPackets(scan.data(), kScanSize));
+    for (const auto &packet : scan) {
+      EXPECT_EQ(next_index, PacketIndex(packet));
+      ++next_index;
+    }
+  }
+  // the rest of the file is not a full scan
+  EXPECT_FALSE(receiver.ReadPackets(scan.data(), kScanSize));
+  EXPECT_EQ(900, next_index);
+}
+
+TEST_F(PacketReceiverTest, ReadsOnceStarted) {
+  WritePcap(filename_, 10);
+  ros::NodeHandle private_nh("~");
+  InputPCAP input(private_nh, DATA_PORT_NUMBER, 1000.0, filename_,
+                  true /* read_once */, true /* read_fast */);
+  PacketReceiver receiver(&input, 16, 0.0);
+  // not started, nothing to read
+  velodyne_msgs::VelodynePacket packet;
+  EXPECT_FALSE(receiver.ReadPackets(&packet, 1));
+
+  receiver.Start();
+  EXPECT_TRUE(receiver.ReadPackets(&packet, 1));
+  EXPECT_EQ(0, PacketIndex(packet));
+  receiver.Stop();
+}
+
+}  // namespace lidar_velodyne
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/** \file
+ *
+ *  Preallocated single-producer/single-consumer ring of packets.
+ *
+ *  The receive side writes whole batches straight into the slots (e.g. via
+ *  recvmmsg), the decode side reads contiguous spans of committed slots.
+ *  No allocation happens after construction.
+ */
+
+#ifndef MODULES_DRIVERS_LIDAR_VELODYNE_DRIVER_PACKET_RING_H_
+#define MODULES_DRIVERS_LIDAR_VELODYNE_DRIVER_PACKET_RING_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace apollo {
+namespace drivers {
+namespace lidar_velodyne {
+
+template <typename T>
+class PacketRing {
+ public:
+  /**
+   * @brief Constructor.
+   * @param capacity minimal number of slots, rounded up to a power of two.
+   */
+  explicit PacketRing(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    slots_.resize(size);
+    mask_ = size - 1;
+  }
+
+  size_t capacity() const { return slots_.size(); }
+
+  /** @brief Number of committed slots not yet consumed. */
+  size_t size() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Producer side: contiguous free slots starting at the write head.
+   * @param slots set to the first free slot.
+   * @return number of contiguous free slots, may be 0 when the ring is full.
+   */
+  size_t WritableSpan(T **slots) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    const size_t free_slots = capacity() - (head - tail);
+    const size_t index = head & mask_;
+    *slots = &slots_[index];
+    return std::min(free_slots, capacity() - index);
+  }
+
+  /** @brief Producer side: publish n slots filled through WritableSpan. */
+  void Commit(size_t n) {
+    head_.store(head_.load(std::memory_order_relaxed) + n,
+                std::memory_order_release);
+  }
+
+  /**
+   * @brief Consumer side: contiguous committed slots starting at the tail.
+   * @param slots set to the oldest committed slot.
+   * @return number of contiguous readable slots.
+   */
+  size_t ReadableSpan(const T **slots) const {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t index = tail & mask_;
+    *slots = &slots_[index];
+    return std::min(head - tail, capacity() - index);
+  }
+
+  /** @brief Consumer side: hand n slots back to the producer. */
+  void Release(size_t n) {
+    tail_.store(tail_.load(std::memory_order_relaxed) + n,
+                std::memory_order_release);
+  }
+
+ private:
+  std::vector<T> slots_;
+  size_t mask_ = 0;
+  // head_ and tail_ are written by different threads, keep them apart.
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
+}  // namespace lidar_velodyne
+}  // namespace drivers
+}  // namespace apollo
+
+#endif  // MODULES_DRIVERS_LIDAR_VELODYNE_DRIVER_PACKET_RING_H_
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/lidar_velodyne/driver/packet_ring.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace drivers {
+namespace lidar_velodyne {
+
+TEST(PacketRingTest, CapacityRoundsUp) {
+  PacketRing<int> ring(5);
+  EXPECT_EQ(8u, ring.capacity());
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(PacketRingTest, SpansWrapAround) {
+  PacketRing<int> ring(4);
+  int *write = nullptr;
+  EXPECT_EQ(4u, ring.WritableSpan(&write));
+  for (int i = 0; i < 3; ++i) {
+    write[i] = i;
+  }
+  ring.Commit(3);
+  EXPECT_EQ(3u, ring.size());
+
+  const int *read = nullptr;
+  EXPECT_EQ(3u, ring.ReadableSpan(&read));
+  EXPECT_EQ(0, read[0]);
+  EXPECT_EQ(2, read[2]);
+  ring.Release(2);
+
+  // Only one slot left before the end of the storage.
+  EXPECT_EQ(1u, ring.WritableSpan(&write));
+  write[0] = 3;
+  ring.Commit(1);
+  EXPECT_EQ(2u, ring.WritableSpan(&write));
+  write[0] = 4;
+  write[1] = 5;
+  ring.Commit(2);
+  EXPECT_EQ(0u, ring.WritableSpan(&write));
+
+  EXPECT_EQ(2u, ring.ReadableSpan(&read));
+  EXPECT_EQ(2, read[0]);
+  EXPECT_EQ(3, read[1]);
+  ring.Release(2);
+  EXPECT_EQ(2u, ring.ReadableSpan(&read));
+  EXPECT_EQ(4, read[0]);
+  EXPECT_EQ(5, read[1]);
+  ring.Release(2);
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(PacketRingTest, ProducerConsumer) {
+  const int kTotal = 10000;
+  PacketRing<int> ring(64);
+  std::thread producer([&ring]() {
+    int next = 0;
+    while (next < kTotal) {
+      int *slots = nullptr;
+      size_t n = ring.WritableSpan(&slots);
+      size_t i = 0;
+      for (; i < n && next < kTotal; ++i) {
+        slots[i] = next++;
+      }
+      ring.Commit(i);
+    }
+  });
+  int expected = 0;
+  while (expected < kTotal) {
+    const int *slots = nullptr;
+    size_t n = ring.ReadableSpan(&slots);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(expected++, slots[i]);
+    }
+    ring.Release(n);
+  }
+  producer.join();
+  EXPECT_TRUE(ring.empty());
+}
+
+}  // namespace lidar_velodyne
+}  // namespace drivers
+}  // namespace apollo
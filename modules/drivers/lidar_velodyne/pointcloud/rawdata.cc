@@ -46,6 +46,8 @@
 #include "modules/drivers/lidar_velodyne/pointcloud/rawdata.h"
 
 #include <math.h>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 
 #include "angles/angles.h"
@@ -113,12 +115,7 @@ int RawData::setup(ros::NodeHandle private_nh) {
 
   ROS_INFO_STREAM("Number of lasers: " << calibration_.num_lasers << ".");
 
-  // Set up cached values for sin and cos of all the possible headings
-  for (uint16_t rot_index = 0; rot_index < ROTATION_MAX_UNITS; ++rot_index) {
-    float rotation = angles::from_degrees(ROTATION_RESOLUTION * rot_index);
-    cos_rot_table_[rot_index] = cosf(rotation);
-    sin_rot_table_[rot_index] = sinf(rotation);
-  }
+  setupTables();
   return 0;
 }
 
@@ -141,13 +138,54 @@ int RawData::setupOffline(std::string calibration_file, double max_range_,
     return -1;
   }
 
-  // Set up cached values for sin and cos of all the possible headings
+  setupTables();
+  return 0;
+}
+
+/** Build the lookup tables read by convert_returns() from calibration_ */
+void RawData::setupTables() {
+  // Set up cached values for sin and cos of all the possible headings, and
+  // the azimuth dependent part of the focal intensity correction
   for (uint16_t rot_index = 0; rot_index < ROTATION_MAX_UNITS; ++rot_index) {
     float rotation = angles::from_degrees(ROTATION_RESOLUTION * rot_index);
     cos_rot_table_[rot_index] = cosf(rotation);
     sin_rot_table_[rot_index] = sinf(rotation);
+    focal_azimuth_table_[rot_index] =
+        256 * (1 - static_cast<float>(rot_index) / 65535) *
+        (1 - static_cast<float>(rot_index) / 65535);
+  }
+
+  // Flatten the per-laser corrections. Channels missing from the
+  // calibration get all zero corrections, as std::map::operator[] gave them.
+  int num_channels = VLS128_NUM_CHANS_PER_BLOCK;
+  for (const auto &correction : calibration_.laser_corrections) {
+    num_channels = std::max(num_channels, correction.first + 1);
+  }
+  laser_table_.assign(num_channels, LaserTable());
+  for (const auto &correction : calibration_.laser_corrections) {
+    if (correction.first < 0) {
+      continue;
+    }
+    const LaserCorrection &corrections = correction.second;
+    LaserTable &laser = laser_table_[correction.first];
+    laser.dist_correction = corrections.dist_correction;
+    laser.dist_correction_x = corrections.dist_correction_x;
+    laser.dist_correction_y = corrections.dist_correction_y;
+    laser.cos_vert_correction = corrections.cos_vert_correction;
+    laser.sin_vert_correction = corrections.sin_vert_correction;
+    laser.cos_rot_correction = corrections.cos_rot_correction;
+    laser.sin_rot_correction = corrections.sin_rot_correction;
+    laser.vert_offset_correction = corrections.vert_offset_correction;
+    laser.horiz_offset_correction = corrections.horiz_offset_correction;
+    laser.min_intensity = corrections.min_intensity;
+    laser.max_intensity = corrections.max_intensity;
+    laser.focal_offset = 256 * (1 - corrections.focal_distance / 13100) *
+                         (1 - corrections.focal_distance / 13100);
+    laser.focal_slope = corrections.focal_slope;
+    laser.two_pt_correction_available =
+        corrections.two_pt_correction_available;
+    laser.laser_ring = corrections.laser_ring;
   }
-  return 0;
 }
 
 /** @brief convert raw packet to point cloud
@@ -158,136 +196,166 @@ int RawData::setupOffline(std::string calibration_file, double max_range_,
 void RawData::unpack(const velodyne_msgs::VelodynePacket &pkt,
                      VPointCloud &pc) {
   ROS_DEBUG_STREAM("Received packet, time: " << pkt.stamp);
+  returns_.reserve(NUM_CHANS_PER_PACKET);
+  unpack_packet(pkt);
+  convert_returns(pc);
+}
+
+/** @brief extract the returns of one raw packet into returns_
+ *
+ *  @param pkt raw packet to unpack
+ */
+void RawData::unpack_packet(const velodyne_msgs::VelodynePacket &pkt) {
   // std::cerr << "Sensor ID = " << (unsigned int)(pkt.data[1205]) << std::endl;
   if (pkt.data[1205] == 34) {  // VLP16
-    unpack_vlp16(pkt, pc);
+    unpack_vlp16(pkt);
   } else if (pkt.data[1205] == 40) {  // VLP32 C
-    unpack_vlp32(pkt, pc);
+    unpack_vlp32(pkt);
   } else if (pkt.data[1205] == 33) {  // HDL-32E (NOT TESTED YET)
-    unpack_hdl32(pkt, pc);
+    unpack_hdl32(pkt);
   } else if (pkt.data[1205] == 161) {  // VLS 128
-    unpack_vls128(pkt, pc);
+    unpack_vls128(pkt);
   } else {  // HDL-64E without azimuth compensation from the firing order
-    unpack_hdl64(pkt, pc);
+    unpack_hdl64(pkt);
   }
 }
 
-/** @brief apply fixed correction from the file to each point and convert it to
-   xyzi
-           input : chan_id, azimuth_uint, distance, intensity
-           output : x_coord, y_coord, z_coord, intensity
+/** @brief convert a batch of raw packets to point cloud
+ *
+ *  @param packets first packet of the batch
+ *  @param num_packets number of packets in the batch
+ *  @param pc shared pointer to point cloud (points are appended)
  */
-void RawData::compute_xyzi(const uint8_t chan_id, const uint16_t azimuth_uint,
-                           const float distance, float *intensity,
-                           float *x_coord, float *y_coord, float *z_coord) {
-  CHECK_NOTNULL(intensity);
-  CHECK_NOTNULL(x_coord);
-  CHECK_NOTNULL(y_coord);
-  CHECK_NOTNULL(z_coord);
-
-  float x, y, z;
-  LaserCorrection &corrections = calibration_.laser_corrections[chan_id];
-
-  // convert polar coordinates to Euclidean XYZ
-  float cos_vert_angle = corrections.cos_vert_correction;
-  float sin_vert_angle = corrections.sin_vert_correction;
-  float cos_rot_correction = corrections.cos_rot_correction;
-  float sin_rot_correction = corrections.sin_rot_correction;
-
-  // cos(a-b) = cos(a)*cos(b) + sin(a)*sin(b)
-  // sin(a-b) = sin(a)*cos(b) - cos(a)*sin(b)
-  float cos_rot_angle = cos_rot_table_[azimuth_uint] * cos_rot_correction +
-                        sin_rot_table_[azimuth_uint] * sin_rot_correction;
-  float sin_rot_angle = sin_rot_table_[azimuth_uint] * cos_rot_correction -
-                        cos_rot_table_[azimuth_uint] * sin_rot_correction;
-
-  float horiz_offset = corrections.horiz_offset_correction;
-  float vert_offset = corrections.vert_offset_correction;
-
-  // Compute the distance in the xy plane (w/o accounting for rotation)
-  /**the new term of 'vert_offset * sin_vert_angle'
-   * was added to the expression due to the mathemathical
-   * model we used.
-   */
-  float xy_distance = distance * cos_vert_angle - vert_offset * sin_vert_angle;
-
-  // Calculate temporal X, use absolute value.
-  float xx = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
-  // Calculate temporal Y, use absolute value
-  float yy = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
-  if (xx < 0) xx = -xx;
-  if (yy < 0) yy = -yy;
-
-  // Get 2points calibration values,Linear interpolation to get distance
-  // correction for X and Y, that means distance correction use
-  // different value at different distance
-  float distance_corr_x = 0;
-  float distance_corr_y = 0;
-  if (corrections.two_pt_correction_available) {
-    distance_corr_x =
-        (corrections.dist_correction - corrections.dist_correction_x) *
-            (xx - 2.4) / (25.04 - 2.4) +
-        corrections.dist_correction_x;
-    distance_corr_x -= corrections.dist_correction;
-    distance_corr_y =
-        (corrections.dist_correction - corrections.dist_correction_y) *
-            (yy - 1.93) / (25.04 - 1.93) +
-        corrections.dist_correction_y;
-    distance_corr_y -= corrections.dist_correction;
+void RawData::unpack(const velodyne_msgs::VelodynePacket *packets,
+                     size_t num_packets, VPointCloud &pc) {
+  returns_.reserve(num_packets * NUM_CHANS_PER_PACKET);
+  for (size_t i = 0; i < num_packets; ++i) {
+    unpack_packet(packets[i]);
   }
+  convert_returns(pc);
+}
+
+/** @brief apply fixed correction from the file to all buffered returns and
+ *         append them to the point cloud as xyzi
+ *
+ *  The arithmetic matches the former per-point compute_xyzi() operation by
+ *  operation, so the output is bit-identical; it only reads the flattened
+ *  tables and runs over structure-of-arrays buffers, which keeps the main
+ *  loop free of calls and map lookups.
+ *
+ *  @param pc shared pointer to point cloud (points are appended)
+ */
+void RawData::convert_returns(VPointCloud &pc) {
+  const size_t num_returns = returns_.size;
+  const uint8_t *chan_ids = returns_.chan_id.data();
+  const uint16_t *azimuths = returns_.azimuth.data();
+  const float *distances = returns_.distance.data();
+  float *intensities = returns_.intensity.data();
+  float *xs = returns_.x.data();
+  float *ys = returns_.y.data();
+  float *zs = returns_.z.data();
+
+  for (size_t i = 0; i < num_returns; ++i) {
+    const LaserTable &laser = laser_table_[chan_ids[i]];
+    const uint16_t azimuth_uint = azimuths[i];
+    const float distance = distances[i];
+
+    // convert polar coordinates to Euclidean XYZ
+    const float cos_vert_angle = laser.cos_vert_correction;
+    const float sin_vert_angle = laser.sin_vert_correction;
+
+    // cos(a-b) = cos(a)*cos(b) + sin(a)*sin(b)
+    // sin(a-b) = sin(a)*cos(b) - cos(a)*sin(b)
+    const float cos_rot_angle =
+        cos_rot_table_[azimuth_uint] * laser.cos_rot_correction +
+        sin_rot_table_[azimuth_uint] * laser.sin_rot_correction;
+    const float sin_rot_angle =
+        sin_rot_table_[azimuth_uint] * laser.cos_rot_correction -
+        cos_rot_table_[azimuth_uint] * laser.sin_rot_correction;
+
+    const float horiz_offset = laser.horiz_offset_correction;
+    const float vert_offset = laser.vert_offset_correction;
+
+    // Compute the distance in the xy plane (w/o accounting for rotation)
+    /**the new term of 'vert_offset * sin_vert_angle'
+     * was added to the expression due to the mathemathical
+     * model we used.
+     */
+    float xy_distance =
+        distance * cos_vert_angle - vert_offset * sin_vert_angle;
+
+    // Calculate temporal X, use absolute value.
+    float xx = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
+    // Calculate temporal Y, use absolute value
+    float yy = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
+    if (xx < 0) xx = -xx;
+    if (yy < 0) yy = -yy;
+
+    // Get 2points calibration values,Linear interpolation to get distance
+    // correction for X and Y, that means distance correction use
+    // different value at different distance
+    float distance_corr_x = 0;
+    float distance_corr_y = 0;
+    if (laser.two_pt_correction_available) {
+      distance_corr_x = (laser.dist_correction - laser.dist_correction_x) *
+                            (xx - 2.4) / (25.04 - 2.4) +
+                        laser.dist_correction_x;
+      distance_corr_x -= laser.dist_correction;
+      distance_corr_y = (laser.dist_correction - laser.dist_correction_y) *
+                            (yy - 1.93) / (25.04 - 1.93) +
+                        laser.dist_correction_y;
+      distance_corr_y -= laser.dist_correction;
+    }
 
-  float distance_x = distance + distance_corr_x;
-  /**the new term of 'vert_offset * sin_vert_angle'
-   * was added to the expression due to the mathemathical
-   * model we used.
-   */
-  xy_distance = distance_x * cos_vert_angle - vert_offset * sin_vert_angle;
-  x = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
-
-  float distance_y = distance + distance_corr_y;
-  /**the new term of 'vert_offset * sin_vert_angle'
-   * was added to the expression due to the mathemathical
-   * model we used.
-   */
-  xy_distance = distance_y * cos_vert_angle - vert_offset * sin_vert_angle;
-  y = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
-
-  // Using distance_y is not symmetric, but the velodyne manual
-  // does this.
-  /**the new term of 'vert_offset * cos_vert_angle'
-   * was added to the expression due to the mathemathical
-   * model we used.
-   */
-  z = distance_y * sin_vert_angle + vert_offset * cos_vert_angle;
-
-  /** Use standard ROS coordinate system (right-hand rule) */
-  *x_coord = y;
-  *y_coord = -x;
-  *z_coord = z;
-
-  /** Intensity Calculation */
-  float min_intensity = corrections.min_intensity;
-  float max_intensity = corrections.max_intensity;
-
-  float focal_offset = 256 * (1 - corrections.focal_distance / 13100) *
-                       (1 - corrections.focal_distance / 13100);
-  float focal_slope = corrections.focal_slope;
-  *intensity +=
-      focal_slope * (abs(focal_offset -
-                         256 * (1 - static_cast<float>(azimuth_uint) / 65535) *
-                             (1 - static_cast<float>(azimuth_uint) / 65535)));
-  *intensity = (*intensity < min_intensity) ? min_intensity : *intensity;
-  *intensity = (*intensity > max_intensity) ? max_intensity : *intensity;
+    const float distance_x = distance + distance_corr_x;
+    xy_distance = distance_x * cos_vert_angle - vert_offset * sin_vert_angle;
+    const float x = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
+
+    // Using distance_y is not symmetric, but the velodyne manual
+    // does this.
+    const float distance_y = distance + distance_corr_y;
+    xy_distance = distance_y * cos_vert_angle - vert_offset * sin_vert_angle;
+    const float y = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
+    const float z = distance_y * sin_vert_angle + vert_offset * cos_vert_angle;
+
+    /** Use standard ROS coordinate system (right-hand rule) */
+    xs[i] = y;
+    ys[i] = -x;
+    zs[i] = z;
+
+    /** Intensity Calculation */
+    float intensity =
+        intensities[i] +
+        laser.focal_slope *
+            std::fabs(laser.focal_offset - focal_azimuth_table_[azimuth_uint]);
+    intensity = (intensity < laser.min_intensity) ? laser.min_intensity
+                                                  : intensity;
+    intensity = (intensity > laser.max_intensity) ? laser.max_intensity
+                                                  : intensity;
+    intensities[i] = intensity;
+  }
+
+  // append all points to the cloud at once
+  const size_t offset = pc.points.size();
+  pc.points.resize(offset + num_returns);
+  for (size_t i = 0; i < num_returns; ++i) {
+    VPoint &point = pc.points[offset + i];
+    point.ring = laser_table_[chan_ids[i]].laser_ring;
+    point.x = xs[i];
+    point.y = ys[i];
+    point.z = zs[i];
+    point.intensity = intensities[i];
+  }
+  pc.width += num_returns;
+  returns_.size = 0;
 }
 
 /** @brief convert raw HDL-64E channel packet to point cloud
  *         a default one without any time-domain azimuth correction
  *
  *  @param pkt raw packet to unpack
- *  @param pc shared pointer to point cloud (points are appended)
  */
-void RawData::unpack_hdl64(const velodyne_msgs::VelodynePacket &pkt,
-                           VPointCloud &pc) {
+void RawData::unpack_hdl64(const velodyne_msgs::VelodynePacket &pkt) {
   const raw_packet_t *raw = (const raw_packet_t *)&pkt.data[0];
   for (int i = 0; i < NUM_BLOCKS_PER_PACKET; i++) {
     // upper bank lasers are numbered [0..31]
@@ -306,35 +374,20 @@ void RawData::unpack_hdl64(const velodyne_msgs::VelodynePacket &pkt,
         (config_.min_angle > config_.max_angle)) {
       for (int j = 0, k = 0; j < NUM_CHANS_PER_BLOCK; j++, k += CHANNEL_SIZE) {
         uint8_t laser_number = j + bank_origin;
-        LaserCorrection &corrections =
-            calibration_.laser_corrections[laser_number];
+        const LaserTable &laser = laser_table_[laser_number];
 
         // Distance extraction
         union two_bytes tmp;
         tmp.bytes[0] = raw->blocks[i].data[k];
         tmp.bytes[1] = raw->blocks[i].data[k + 1];
         float distance = tmp.uint * DISTANCE_RESOLUTION;
-        distance += corrections.dist_correction;
+        distance += laser.dist_correction;
 
         if (pointInRange(distance)) {
           // Intensity extraction
           float intensity = raw->blocks[i].data[k + 2];
-          float x_coord, y_coord, z_coord;
-
-          // apply calibration file and convert polar coordinates to Euclidean
-          // XYZ
-          compute_xyzi(laser_number, azimuth, distance, &intensity, &x_coord,
-                       &y_coord, &z_coord);
-
-          // append this point to the cloud
-          VPoint point;
-          point.ring = corrections.laser_ring;
-          point.x = x_coord;
-          point.y = y_coord;
-          point.z = z_coord;
-          point.intensity = intensity;
-          pc.points.push_back(point);
-          ++pc.width;
+          // buffer this return, converted later in convert_returns()
+          returns_.push(laser_number, azimuth, distance, intensity);
         }
       }
     }
@@ -344,14 +397,11 @@ void RawData::unpack_hdl64(const velodyne_msgs::VelodynePacket &pkt,
 /** @brief convert raw VLP16 packet to point cloud
  *
  *  @param pkt raw packet to unpack
- *  @param pc shared pointer to point cloud (points are appended)
  */
-void RawData::unpack_vlp16(const velodyne_msgs::VelodynePacket &pkt,
-                           VPointCloud &pc) {
+void RawData::unpack_vlp16(const velodyne_msgs::VelodynePacket &pkt) {
   float azimuth_diff, azimuth_corrected_f;
   float last_azimuth_diff = 0;
   uint16_t azimuth, azimuth_next, azimuth_corrected;
-  float x_coord, y_coord, z_coord;
   float distance, intensity;
 
   const raw_packet_t *raw = (const raw_packet_t *)&pkt.data[0];
@@ -390,15 +440,14 @@ void RawData::unpack_vlp16(const velodyne_msgs::VelodynePacket &pkt,
       for (int seq_id = 0, k = 0; seq_id < VLP16_NUM_SEQS_PER_BLOCK; seq_id++) {
         for (int chan_id = 0; chan_id < VLP16_NUM_CHANS_PER_SEQ;
              chan_id++, k += CHANNEL_SIZE) {
-          LaserCorrection &corrections =
-              calibration_.laser_corrections[chan_id];
+          const LaserTable &laser = laser_table_[chan_id];
 
           // Distance extraction
           union two_bytes tmp;
           tmp.bytes[0] = raw->blocks[block].data[k];
           tmp.bytes[1] = raw->blocks[block].data[k + 1];
           distance = tmp.uint * DISTANCE_RESOLUTION;
-          distance += corrections.dist_correction;
+          distance += laser.dist_correction;
 
           if (pointInRange(distance)) {
             intensity = static_cast<float>(raw->blocks[block].data[k + 2]);
@@ -411,21 +460,8 @@ void RawData::unpack_vlp16(const velodyne_msgs::VelodynePacket &pkt,
             azimuth_corrected =
                 (static_cast<uint16_t>(round(azimuth_corrected_f))) % 36000;
 
-            // apply calibration file and convert polar coordinates to Euclidean
-            // XYZ
-            compute_xyzi(chan_id, azimuth_corrected, distance, &intensity,
-                         &x_coord, &y_coord, &z_coord);
-
-            // append this point to the cloud
-            VPoint point;
-            point.ring = corrections.laser_ring;
-            point.x = x_coord;
-            point.y = y_coord;
-            point.z = z_coord;
-            point.intensity = intensity;
-
-            pc.points.push_back(point);
-            ++pc.width;
+            // buffer this return, converted later in convert_returns()
+            returns_.push(chan_id, azimuth_corrected, distance, intensity);
           }
         }
       }
@@ -436,15 +472,12 @@ void RawData::unpack_vlp16(const velodyne_msgs::VelodynePacket &pkt,
 /** @brief convert raw VLP32 packet to point cloud
  *
  *  @param pkt raw packet to unpack
- *  @param pc shared pointer to point cloud (points are appended)
  */
-void RawData::unpack_vlp32(const velodyne_msgs::VelodynePacket &pkt,
-                           VPointCloud &pc) {
+void RawData::unpack_vlp32(const velodyne_msgs::VelodynePacket &pkt) {
   float azimuth_diff = 0.0f;
   float azimuth_corrected_f = 0.0f;
   float last_azimuth_diff = 0;
   uint16_t azimuth, azimuth_next, azimuth_corrected;
-  float x_coord, y_coord, z_coord;
   float distance, intensity;
 
   const raw_packet_t *raw = (const raw_packet_t *)&pkt.data[0];
@@ -482,14 +515,14 @@ void RawData::unpack_vlp32(const velodyne_msgs::VelodynePacket &pkt,
       for (int j = 0, k = 0; j < NUM_CHANS_PER_BLOCK; j++, k += CHANNEL_SIZE) {
         uint8_t chan_id = j;
         uint8_t firing_order = chan_id / 2;
-        LaserCorrection &corrections = calibration_.laser_corrections[chan_id];
+        const LaserTable &laser = laser_table_[chan_id];
 
         // distance extraction
         union two_bytes tmp;
         tmp.bytes[0] = raw->blocks[block].data[k];
         tmp.bytes[1] = raw->blocks[block].data[k + 1];
         distance = tmp.uint * VLP32_DISTANCE_RESOLUTION;
-        distance += corrections.dist_correction;
+        distance += laser.dist_correction;
 
         if (pointInRange(distance)) {
           intensity = static_cast<float>(raw->blocks[block].data[k + 2]);
@@ -502,21 +535,8 @@ void RawData::unpack_vlp32(const velodyne_msgs::VelodynePacket &pkt,
           azimuth_corrected =
               (static_cast<uint16_t>(round(azimuth_corrected_f))) % 36000;
 
-          // apply calibration file and convert polar coordinates to Euclidean
-          // XYZ
-          compute_xyzi(chan_id, azimuth_corrected, distance, &intensity,
-                       &x_coord, &y_coord, &z_coord);
-
-          // append this point to the cloud
-          VPoint point;
-          point.ring = corrections.laser_ring;
-          point.x = x_coord;
-          point.y = y_coord;
-          point.z = z_coord;
-          point.intensity = intensity;
-
-          pc.points.push_back(point);
-          ++pc.width;
+          // buffer this return, converted later in convert_returns()
+          returns_.push(chan_id, azimuth_corrected, distance, intensity);
         }
       }
     }
@@ -526,14 +546,11 @@ void RawData::unpack_vlp32(const velodyne_msgs::VelodynePacket &pkt,
 /** @brief convert raw VLS128 packet to point cloud
  *
  *  @param pkt raw packet to unpack
- *  @param pc shared pointer to point cloud (points are appended)
  */
-void RawData::unpack_vls128(const velodyne_msgs::VelodynePacket &pkt,
-                            VPointCloud &pc) {
+void RawData::unpack_vls128(const velodyne_msgs::VelodynePacket &pkt) {
   float azimuth_diff, azimuth_corrected_f;
   float last_azimuth_diff = 0;
   uint16_t azimuth, azimuth_next, azimuth_corrected;
-  float x_coord, y_coord, z_coord;
   float distance, intensity;
   typedef struct vls128_raw_block {
     uint16_t header;    ///< UPPER_BANK or LOWER_BANK
@@ -574,14 +591,14 @@ void RawData::unpack_vls128(const velodyne_msgs::VelodynePacket &pkt,
         uint8_t chan_id = j + group * 32;
         uint8_t firing_order = chan_id / 8;
         firing_order = 0;
-        LaserCorrection &corrections = calibration_.laser_corrections[chan_id];
+        const LaserTable &laser = laser_table_[chan_id];
 
         // distance extraction
         union two_bytes tmp;
         tmp.bytes[0] = raw->blocks[block].data[k];
         tmp.bytes[1] = raw->blocks[block].data[k + 1];
         distance = tmp.uint * VLP32_DISTANCE_RESOLUTION;
-        distance += corrections.dist_correction;
+        distance += laser.dist_correction;
 
         if (pointInRange(distance)) {
           intensity = static_cast<float>(raw->blocks[block].data[k + 2]);
@@ -594,21 +611,8 @@ void RawData::unpack_vls128(const velodyne_msgs::VelodynePacket &pkt,
           azimuth_corrected =
               (static_cast<uint16_t>(round(azimuth_corrected_f))) % 36000;
 
-          // apply calibration file and convert polar coordinates to Euclidean
-          // XYZ
-          compute_xyzi(chan_id, azimuth_corrected, distance, &intensity,
-                       &x_coord, &y_coord, &z_coord);
-
-          // append this point to the cloud
-          VPoint point;
-          point.ring = corrections.laser_ring;
-          point.x = x_coord;
-          point.y = y_coord;
-          point.z = z_coord;
-          point.intensity = intensity;
-
-          pc.points.push_back(point);
-          ++pc.width;
+          // buffer this return, converted later in convert_returns()
+          returns_.push(chan_id, azimuth_corrected, distance, intensity);
         }
       }
     }
@@ -631,14 +635,11 @@ unsigned int swizzle_bytes_in_word(unsigned int a) {
  *         a default one without any time-domain azimuth correction
  *
  *  @param pkt raw packet to unpack
- *  @param pc shared pointer to point cloud (points are appended)
  */
-void RawData::unpack_hdl32(const velodyne_msgs::VelodynePacket &pkt,
-                           VPointCloud &pc) {
+void RawData::unpack_hdl32(const velodyne_msgs::VelodynePacket &pkt) {
   float azimuth_diff, azimuth_corrected_f;
   float last_azimuth_diff = 0;
   uint16_t azimuth, azimuth_next, azimuth_corrected;
-  float x_coord, y_coord, z_coord;
   float distance, intensity;
 
   const raw_packet_t *raw = (const raw_packet_t *)&pkt.data[0];
@@ -676,14 +677,14 @@ void RawData::unpack_hdl32(const velodyne_msgs::VelodynePacket &pkt,
         (config_.min_angle > config_.max_angle)) {
       for (int j = 0, k = 0; j < NUM_CHANS_PER_BLOCK; j++, k += CHANNEL_SIZE) {
         uint8_t chan_id = j;
-        LaserCorrection &corrections = calibration_.laser_corrections[chan_id];
+        const LaserTable &laser = laser_table_[chan_id];
 
         // distance extraction
         union two_bytes tmp;
         tmp.bytes[0] = raw->blocks[block].data[k];
         tmp.bytes[1] = raw->blocks[block].data[k + 1];
         distance = tmp.uint * DISTANCE_RESOLUTION;
-        distance += corrections.dist_correction;
+        distance += laser.dist_correction;
 
         if (pointInRange(distance)) {
           intensity = static_cast<float>(raw->blocks[block].data[k + 2]);
@@ -696,21 +697,8 @@ void RawData::unpack_hdl32(const velodyne_msgs::VelodynePacket &pkt,
           azimuth_corrected =
               (static_cast<uint16_t>(round(azimuth_corrected_f))) % 36000;
 
-          // apply calibration file and convert polar coordinates to Euclidean
-          // XYZ
-          compute_xyzi(chan_id, azimuth_corrected, distance, &intensity,
-                       &x_coord, &y_coord, &z_coord);
-
-          // append this point to the cloud
-          VPoint point;
-          point.ring = corrections.laser_ring;
-          point.x = x_coord;
-          point.y = y_coord;
-          point.z = z_coord;
-          point.intensity = intensity;
-
-          pc.points.push_back(point);
-          ++pc.width;
+          // buffer this return, converted later in convert_returns()
+          returns_.push(chan_id, azimuth_corrected, distance, intensity);
         }
       }
     }
@@ -43,6 +43,7 @@
 #include <math.h>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 #include "boost/format.hpp"
 
@@ -156,6 +157,66 @@ typedef struct raw_packet {
   uint8_t status[PACKET_STATUS_SIZE];
 } raw_packet_t;
 
+/** \brief Per-laser corrections flattened out of Calibration.
+ *
+ *  Built once when the calibration is loaded, so the decode loop indexes
+ *  an array by channel instead of looking up a std::map for every return.
+ */
+struct LaserTable {
+  float dist_correction;
+  float dist_correction_x;
+  float dist_correction_y;
+  float cos_vert_correction;
+  float sin_vert_correction;
+  float cos_rot_correction;
+  float sin_rot_correction;
+  float vert_offset_correction;
+  float horiz_offset_correction;
+  float min_intensity;
+  float max_intensity;
+  float focal_offset;  ///< azimuth independent part of the focal correction
+  float focal_slope;
+  bool two_pt_correction_available;
+  uint16_t laser_ring;
+};
+
+/** \brief Structure-of-arrays buffers of returns awaiting conversion.
+ *
+ *  The unpack_* functions only extract channel, azimuth, distance and raw
+ *  intensity; the geometry is computed afterwards over the whole buffer in
+ *  one tight loop. Storage is grown once per scan and reused afterwards.
+ */
+struct ReturnBuffer {
+  std::vector<uint8_t> chan_id;
+  std::vector<uint16_t> azimuth;
+  std::vector<float> distance;
+  std::vector<float> intensity;
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  size_t size = 0;
+
+  void reserve(size_t n) {
+    if (chan_id.size() < n) {
+      chan_id.resize(n);
+      azimuth.resize(n);
+      distance.resize(n);
+      intensity.resize(n);
+      x.resize(n);
+      y.resize(n);
+      z.resize(n);
+    }
+  }
+
+  void push(uint8_t chan, uint16_t azimuth_uint, float dist, float inten) {
+    chan_id[size] = chan;
+    azimuth[size] = azimuth_uint;
+    distance[size] = dist;
+    intensity[size] = inten;
+    ++size;
+  }
+};
+
 /** \brief Velodyne data conversion class */
 class RawData {
  public:
@@ -193,6 +254,18 @@ class RawData {
 
   void unpack(const velodyne_msgs::VelodynePacket &pkt,
               VPointCloud &pc);  // NOLINT
+
+  /** \brief Convert a batch of contiguous packets to point cloud.
+   *
+   *  Reserves the cloud storage once for the whole batch, so packets can
+   *  be decoded straight from a scan message or a packet ring span.
+   *
+   *  @param packets first packet of the batch
+   *  @param num_packets number of packets in the batch
+   *  @param pc point cloud (points are appended)
+   */
+  void unpack(const velodyne_msgs::VelodynePacket *packets,
+              size_t num_packets, VPointCloud &pc);  // NOLINT
   //    void unpack(const velodyne_msgs::VelodynePacket &pkt, XYZIRBPointCloud
   //    &pc);
 
@@ -223,20 +296,24 @@ class RawData {
   apollo::drivers::lidar_velodyne::Calibration calibration_;
   float sin_rot_table_[ROTATION_MAX_UNITS];
   float cos_rot_table_[ROTATION_MAX_UNITS];
+  /** azimuth dependent part of the focal intensity correction */
+  float focal_azimuth_table_[ROTATION_MAX_UNITS];
+  /** corrections indexed by channel id, see LaserTable */
+  std::vector<LaserTable> laser_table_;
+  ReturnBuffer returns_;
+
+  /** build the lookup tables above from calibration_ */
+  void setupTables();
+  /** extract the returns of one packet into returns_ **/
+  void unpack_packet(const velodyne_msgs::VelodynePacket &pkt);
   /** add private function to handle each sensor **/
-  void unpack_vlp16(const velodyne_msgs::VelodynePacket &pkt,
-                    VPointCloud &pc);  // NOLINT
-  void unpack_vlp32(const velodyne_msgs::VelodynePacket &pkt,
-                    VPointCloud &pc);  // NOLINT
-  void unpack_hdl32(const velodyne_msgs::VelodynePacket &pkt,
-                    VPointCloud &pc);  // NOLINT
-  void unpack_hdl64(const velodyne_msgs::VelodynePacket &pkt,
-                    VPointCloud &pc);  // NOLINT
-  void unpack_vls128(const velodyne_msgs::VelodynePacket &pkt,
-                     VPointCloud &pc);  // NOLINT
-  void compute_xyzi(const uint8_t chan_id, const uint16_t azimuth_uint,
-                    const float distance, float *intensity, float *x_coord,
-                    float *y_coord, float *z_coord);
+  void unpack_vlp16(const velodyne_msgs::VelodynePacket &pkt);
+  void unpack_vlp32(const velodyne_msgs::VelodynePacket &pkt);
+  void unpack_hdl32(const velodyne_msgs::VelodynePacket &pkt);
+  void unpack_hdl64(const velodyne_msgs::VelodynePacket &pkt);
+  void unpack_vls128(const velodyne_msgs::VelodynePacket &pkt);
+  /** apply corrections to all buffered returns and append them to pc */
+  void convert_returns(VPointCloud &pc);  // NOLINT
 
   /** in-line test whether a point is in range */
   bool pointInRange(float range) {
@@ -0,0 +1,217 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/lidar_velodyne/pointcloud/rawdata.h"
+
+#include <math.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "angles/angles.h"
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace drivers {
+namespace lidar_velodyne {
+
+namespace {
+
+const char kCalibrationFile[] =
+    "modules/drivers/lidar_velodyne/pointcloud/params/64e_s2.1-sztaki.yaml";
+const double kMinRange = 0.9;
+const double kMaxRange = 130.0;
+
+// An HDL-64E packet with alternating upper and lower bank blocks, which
+// covers all the 64 lasers, in and out of range returns and the intensity
+// clamping.
+velodyne_msgs::VelodynePacket MakeHdl64Packet() {
+  velodyne_msgs::VelodynePacket pkt;
+  std::memset(pkt.data, 0, sizeof(pkt.data));
+  raw_packet_t *raw = reinterpret_cast<raw_packet_t *>(&pkt.data[0]);
+  uint32_t seed = 20180901;
+  for (int i = 0; i < NUM_BLOCKS_PER_PACKET; ++i) {
+    raw->blocks[i].header = (i % 2 == 0) ? UPPER_BANK : LOWER_BANK;
+    raw->blocks[i].rotation = static_cast<uint16_t>((i * 2999 + 17) % 36000);
+    for (int k = 0; k < BLOCK_DATA_SIZE; ++k) {
+      seed = seed * 1103515245u + 12345u;
+      raw->blocks[i].data[k] = static_cast<uint8_t>(seed >> 16);
+    }
+  }
+  pkt.data[1205] = 0;  // HDL-64E
+  return pkt;
+}
+
+// The former per-point decoding of a HDL-64E return, computing the rotation
+// trigonometry for each point.
+VPoint ComputePoint(const LaserCorrection &corrections,
+                    const uint16_t azimuth_uint, const float distance,
+                    float intensity) {
+  const float rotation = angles::from_degrees(ROTATION_RESOLUTION *
+                                              azimuth_uint);
+  const float cos_rot = cosf(rotation);
+  const float sin_rot = sinf(rotation);
+
+  float cos_vert_angle = corrections.cos_vert_correction;
+  float sin_vert_angle = corrections.sin_vert_correction;
+  float cos_rot_correction = corrections.cos_rot_correction;
+  float sin_rot_correction = corrections.sin_rot_correction;
+  float cos_rot_angle =
+      cos_rot * cos_rot_correction + sin_rot * sin_rot_correction;
+  float sin_rot_angle =
+      sin_rot * cos_rot_correction - cos_rot * sin_rot_correction;
+  float horiz_offset = corrections.horiz_offset_correction;
+  float vert_offset = corrections.vert_offset_correction;
+
+  float xy_distance = distance * cos_vert_angle - vert_offset * sin_vert_angle;
+  float xx = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
+  float yy = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
+  if (xx < 0) xx = -xx;
+  if (yy < 0) yy = -yy;
+
+  float distance_corr_x = 0;
+  float distance_corr_y = 0;
+  if (corrections.two_pt_correction_available) {
+    distance_corr_x =
+        (corrections.dist_correction - corrections.dist_correction_x) *
+            (xx - 2.4) / (25.04 - 2.4) +
+        corrections.dist_correction_x;
+    distance_corr_x -= corrections.dist_correction;
+    distance_corr_y =
+        (corrections.dist_correction - corrections.dist_correction_y) *
+            (yy - 1.93) / (25.04 - 1.93) +
+        corrections.dist_correction_y;
+    distance_corr_y -= corrections.dist_correction;
+  }
+
+  float distance_x = distance + distance_corr_x;
+  xy_distance = distance_x * cos_vert_angle - vert_offset * sin_vert_angle;
+  float x = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
+  float distance_y = distance + distance_corr_y;
+  xy_distance = distance_y * cos_vert_angle - vert_offset * sin_vert_angle;
+  float y = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
+  float z = distance_y * sin_vert_angle + vert_offset * cos_vert_angle;
+
+  float min_intensity = corrections.min_intensity;
+  float max_intensity = corrections.max_intensity;
+  float focal_offset = 256 * (1 - corrections.focal_distance / 13100) *
+                       (1 - corrections.focal_distance / 13100);
+  float focal_slope = corrections.focal_slope;
+  intensity +=
+      focal_slope * (fabs(focal_offset -
+                          256 * (1 - static_cast<float>(azimuth_uint) / 65535) *
+                              (1 - static_cast<float>(azimuth_uint) / 65535)));
+  intensity = (intensity < min_intensity) ? min_intensity : intensity;
+  intensity = (intensity > max_intensity) ? max_intensity : intensity;
+
+  VPoint point;
+  point.ring = corrections.laser_ring;
+  point.x = y;
+  point.y = -x;
+  point.z = z;
+  point.intensity = intensity;
+  return point;
+}
+
+std::vector<VPoint> DecodeHdl64PerPoint(
+    const velodyne_msgs::VelodynePacket &pkt, Calibration *calibration) {
+  std::vector<VPoint> points;
+  const raw_packet_t *raw = reinterpret_cast<const raw_packet_t *>(pkt.data);
+  for (int i = 0; i < NUM_BLOCKS_PER_PACKET; ++i) {
+    const int bank_origin = raw->blocks[i].header == LOWER_BANK ? 32 : 0;
+    const uint16_t azimuth = raw->blocks[i].rotation;
+    for (int j = 0, k = 0; j < NUM_CHANS_PER_BLOCK; j++, k += CHANNEL_SIZE) {
+      const LaserCorrection &corrections =
+          calibration->laser_corrections[j + bank_origin];
+      union two_bytes tmp;
+      tmp.bytes[0] = raw->blocks[i].data[k];
+      tmp.bytes[1] = raw->blocks[i].data[k + 1];
+      float distance = tmp.uint * DISTANCE_RESOLUTION;
+      distance += corrections.dist_correction;
+      if (distance >= kMinRange && distance <= kMaxRange) {
+        points.push_back(ComputePoint(corrections, azimuth, distance,
+                                      raw->blocks[i].data[k + 2]));
+      }
+    }
+  }
+  return points;
+}
+
+void ExpectBitIdentical(const std::vector<VPoint> &expected,
+                        const VPointCloud &cloud) {
+  ASSERT_EQ(expected.size(), cloud.points.size());
+  EXPECT_EQ(expected.size(), cloud.width);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    const VPoint &point = cloud.points[i];
+    EXPECT_EQ(expected[i].ring, point.ring) << i;
+    EXPECT_EQ(0, std::memcmp(&expected[i].x, &point.x, sizeof(float))) << i;
+    EXPECT_EQ(0, std::memcmp(&expected[i].y, &point.y, sizeof(float))) << i;
+    EXPECT_EQ(0, std::memcmp(&expected[i].z, &point.z, sizeof(float))) << i;
+    EXPECT_EQ(0, std::memcmp(&expected[i].intensity, &point.intensity,
+                             sizeof(float)))
+        << i;
+  }
+}
+
+}  // namespace
+
+class RawDataTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(0, raw_data_.setupOffline(kCalibrationFile, kMaxRange,
+                                        kMinRange));
+    // The whole revolution.
+    raw_data_.setParameters(kMinRange, kMaxRange, 0.0, 2 * M_PI);
+    calibration_.read(kCalibrationFile);
+    ASSERT_TRUE(calibration_.initialized);
+  }
+
+  RawData raw_data_;
+  Calibration calibration_{false};
+};
+
+TEST_F(RawDataTest, MatchesPerPointDecoding) {
+  const velodyne_msgs::VelodynePacket pkt = MakeHdl64Packet();
+  const std::vector<VPoint> expected = DecodeHdl64PerPoint(pkt, &calibration_);
+  ASSERT_GT(expected.size(), 100);
+
+  VPointCloud cloud;
+  raw_data_.unpack(pkt, cloud);
+  ExpectBitIdentical(expected, cloud);
+}
+
+TEST_F(RawDataTest, BatchMatchesSinglePackets) {
+  std::vector<velodyne_msgs::VelodynePacket> packets(3, MakeHdl64Packet());
+  packets[1].data[10] ^= 0xff;
+  packets[2].data[300] ^= 0x5a;
+
+  std::vector<VPoint> expected;
+  VPointCloud single;
+  for (const auto &pkt : packets) {
+    const std::vector<VPoint> points = DecodeHdl64PerPoint(pkt, &calibration_);
+    expected.insert(expected.end(), points.begin(), points.end());
+    raw_data_.unpack(pkt, single);
+  }
+  ExpectBitIdentical(expected, single);
+
+  VPointCloud batch;
+  raw_data_.unpack(packets.data(), packets.size(), batch);
+  ExpectBitIdentical(expected, batch);
+}
+
+}  // namespace lidar_velodyne
+}  // namespace drivers
+}  // namespace apollo
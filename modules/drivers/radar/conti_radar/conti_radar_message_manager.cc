@@ -68,6 +68,15 @@ ProtocolData<ContiRadar> *ContiRadarMessageManager::GetMutableProtocolDataById(
   return protocol_data_map_[converted_message_id];
 }
 
+// The frames are parsed one by one, since some of them publish the sensor
+// data parsed so far.
+void ContiRadarMessageManager::ParseFrames(
+    const std::vector<CanFrame> &frames) {
+  for (const auto &frame : frames) {
+    Parse(frame.id, frame.data, frame.len);
+  }
+}
+
 void ContiRadarMessageManager::Parse(const uint32_t message_id,
                                      const uint8_t *data, int32_t length) {
   ProtocolData<ContiRadar> *sensor_protocol_data =
@@ -22,6 +22,7 @@
 #define MODULES_DRIVERS_RADAR_CONTI_RADAR_CONTI_RADAR_MESSAGE_MANAGER_H_
 
 #include <memory>
+#include <vector>
 #include "modules/drivers/canbus/can_client/can_client_factory.h"
 #include "modules/drivers/canbus/can_comm/can_sender.h"
 #include "modules/drivers/canbus/can_comm/message_manager.h"
@@ -53,6 +54,7 @@ class ContiRadarMessageManager : public MessageManager<ContiRadar> {
   ProtocolData<ContiRadar> *GetMutableProtocolDataById(
       const uint32_t message_id);
   void Parse(const uint32_t message_id, const uint8_t *data, int32_t length);
+  void ParseFrames(const std::vector<CanFrame> &frames) override;
   void set_can_client(std::shared_ptr<CanClient> can_client);
 
  private:
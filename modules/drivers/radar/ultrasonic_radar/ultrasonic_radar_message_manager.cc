@@ -39,6 +39,15 @@ void UltrasonicRadarMessageManager::set_can_client(
   can_client_ = can_client;
 }
 
+// The frames are parsed one by one, since some of them publish the sensor
+// data parsed so far.
+void UltrasonicRadarMessageManager::ParseFrames(
+    const std::vector<CanFrame> &frames) {
+  for (const auto &frame : frames) {
+    Parse(frame.id, frame.data, frame.len);
+  }
+}
+
 void UltrasonicRadarMessageManager::Parse(const uint32_t message_id,
                                      const uint8_t *data, int32_t length) {
   if (message_id == 0x301) {
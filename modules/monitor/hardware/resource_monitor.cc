@@ -29,6 +29,9 @@ DEFINE_string(resource_monitor_name, "ResourceMonitor",
 DEFINE_double(resource_monitor_interval, 5,
               "Topic status checking interval (s).");
 
+DEFINE_double(resource_monitor_glob_interval, 60,
+              "Interval (s) to glob the monitored paths again.");
+
 namespace apollo {
 namespace monitor {
 
@@ -39,11 +42,25 @@ ResourceMonitor::ResourceMonitor(const ResourceConf& config)
 }
 
 void ResourceMonitor::RunOnce(const double current_time) {
+  if (current_time >= next_glob_time_) {
+    next_glob_time_ = current_time + FLAGS_resource_monitor_glob_interval;
+    dir_space_paths_.clear();
+    for (const auto& dir_space : config_.dir_spaces()) {
+      dir_space_paths_.push_back(
+          apollo::common::util::Glob(dir_space.path()));
+    }
+  }
+
   // Monitor directory available size.
-  for (const auto& dir_space : config_.dir_spaces()) {
-    const int min_available_gb = dir_space.min_available_gb();
-    for (const auto& path : apollo::common::util::Glob(dir_space.path())) {
-      const auto space = boost::filesystem::space(path);
+  for (int i = 0; i < config_.dir_spaces_size(); ++i) {
+    const int min_available_gb = config_.dir_spaces(i).min_available_gb();
+    for (const auto& path : dir_space_paths_[i]) {
+      boost::system::error_code ec;
+      const auto space = boost::filesystem::space(path, ec);
+      if (ec) {
+        // The path may be gone since it was globbed.
+        continue;
+      }
       const int available_gb = space.available >> 30;
       if (available_gb < min_available_gb) {
         MonitorManager::LogBuffer().ERROR() <<
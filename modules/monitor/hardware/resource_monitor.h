@@ -19,6 +19,8 @@
 #include <string>
 #include <vector>
 
+#include "gtest/gtest_prod.h"
+
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/monitor/proto/monitor_conf.pb.h"
 
@@ -32,6 +34,13 @@ class ResourceMonitor : public RecurrentRunner {
 
  private:
   const ResourceConf& config_;
+
+  // Paths matched by the patterns of config_.dir_spaces(), which are globbed
+  // again only every FLAGS_resource_monitor_glob_interval.
+  std::vector<std::vector<std::string>> dir_space_paths_;
+  double next_glob_time_ = 0.0;
+
+  FRIEND_TEST(ResourceMonitorTest, GlobCache);
 };
 
 }  // namespace monitor
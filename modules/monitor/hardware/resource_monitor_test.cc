@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/hardware/resource_monitor.h"
+
+#include <unistd.h>
+
+#include <string>
+
+#include "boost/filesystem.hpp"
+#include "gflags/gflags.h"
+#include "gtest/gtest.h"
+
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+
+DECLARE_double(resource_monitor_glob_interval);
+
+namespace apollo {
+namespace monitor {
+
+TEST(ResourceMonitorTest, GlobCache) {
+  const std::string root =
+      apollo::common::util::StrCat("/tmp/resource_monitor_test_", getpid());
+  ASSERT_TRUE(apollo::common::util::EnsureDirectory(root + "/a"));
+
+  ResourceConf config;
+  auto *dir_space = config.add_dir_spaces();
+  dir_space->set_path(root + "/*");
+  // Never reports, so that no monitor log is sent.
+  dir_space->set_min_available_gb(0);
+  FLAGS_resource_monitor_glob_interval = 60.0;
+
+  ResourceMonitor monitor(config);
+  monitor.RunOnce(100.0);
+  ASSERT_EQ(1, monitor.dir_space_paths_.size());
+  EXPECT_EQ(1, monitor.dir_space_paths_[0].size());
+
+  // A new match is not globbed until the interval passes.
+  ASSERT_TRUE(apollo::common::util::EnsureDirectory(root + "/b"));
+  monitor.RunOnce(130.0);
+  EXPECT_EQ(1, monitor.dir_space_paths_[0].size());
+  monitor.RunOnce(160.0);
+  EXPECT_EQ(2, monitor.dir_space_paths_[0].size());
+
+  // A cached path which is gone is skipped.
+  boost::filesystem::remove_all(root + "/b");
+  monitor.RunOnce(170.0);
+  EXPECT_EQ(2, monitor.dir_space_paths_[0].size());
+  monitor.RunOnce(220.0);
+  EXPECT_EQ(1, monitor.dir_space_paths_[0].size());
+
+  boost::filesystem::remove_all(root);
+}
+
+}  // namespace monitor
+}  // namespace apollo
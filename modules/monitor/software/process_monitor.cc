@@ -16,6 +16,14 @@
 
 #include "modules/monitor/software/process_monitor.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+
 #include "gflags/gflags.h"
 #include "modules/common/log.h"
 #include "modules/common/util/file.h"
@@ -28,6 +36,10 @@ DEFINE_string(process_monitor_name, "ProcessMonitor",
 DEFINE_double(process_monitor_interval, 1.5,
               "Process status checking interval (s).");
 
+DEFINE_double(process_monitor_exec_window, 10.0,
+              "Within this time (s) since a process started, its command "
+              "line is checked again in case it execs into a module.");
+
 namespace apollo {
 namespace monitor {
 namespace {
@@ -42,47 +54,227 @@ bool ContainsAll(const std::string &full, const Iterable &parts) {
   return true;
 }
 
+bool IsPid(const std::string &name) {
+  for (const char c : name) {
+    if (!std::isdigit(static_cast<unsigned char>(c))) {
+      return false;
+    }
+  }
+  return !name.empty();
+}
+
+// Reads the time since boot in seconds.
+bool ReadUptime(double *uptime) {
+  std::string content;
+  if (!common::util::GetContent("/proc/uptime", &content)) {
+    return false;
+  }
+  std::istringstream fields(content);
+  return static_cast<bool>(fields >> *uptime);
+}
+
+// Reads the change time of /proc/<pid>, which differs once the pid is reused.
+bool ReadDirCtime(const std::string &pid, int64_t *ctime_ns) {
+  struct stat dir_stat;
+  if (stat(common::util::StrCat("/proc/", pid).c_str(), &dir_stat) != 0) {
+    return false;
+  }
+  *ctime_ns = static_cast<int64_t>(dir_stat.st_ctim.tv_sec) * 1000000000 +
+              dir_stat.st_ctim.tv_nsec;
+  return true;
+}
+
+bool ParseUint64(const std::string &field, uint64_t *value) {
+  if (field.empty() || !std::isdigit(static_cast<unsigned char>(field[0]))) {
+    return false;
+  }
+  char *end = nullptr;
+  errno = 0;
+  const auto result = std::strtoull(field.c_str(), &end, 10);
+  if (errno != 0 || *end != '\0') {
+    return false;
+  }
+  *value = result;
+  return true;
+}
+
 }  // namespace
 
+bool ProcessMonitor::ReadStat(const std::string &pid, ProcessStat *stat) {
+  std::string content;
+  return common::util::GetContent(
+             common::util::StrCat("/proc/", pid, "/stat"), &content) &&
+         ParseStat(content, stat);
+}
+
+bool ProcessMonitor::ParseStat(const std::string &content,
+                               ProcessStat *stat) {
+  // The command name in parentheses may contain spaces and parentheses, so
+  // the fields are counted from the last ')', where the state is the first.
+  const auto comm_end = content.rfind(')');
+  if (comm_end == std::string::npos) {
+    return false;
+  }
+  std::istringstream fields(content.substr(comm_end + 1));
+  std::string field;
+  uint64_t utime = 0;
+  uint64_t stime = 0;
+  for (int i = 0; i < 22 && fields >> field; ++i) {
+    if (i == 11) {
+      if (!ParseUint64(field, &utime)) {
+        return false;
+      }
+    } else if (i == 12) {
+      if (!ParseUint64(field, &stime)) {
+        return false;
+      }
+    } else if (i == 19) {
+      if (!ParseUint64(field, &stat->start_ticks)) {
+        return false;
+      }
+    } else if (i == 21) {
+      if (!ParseUint64(field, &stat->resident_pages)) {
+        return false;
+      }
+      stat->cpu_ticks = utime + stime;
+      return true;
+    }
+  }
+  return false;
+}
+
 ProcessMonitor::ProcessMonitor()
     : RecurrentRunner(FLAGS_process_monitor_name,
-                      FLAGS_process_monitor_interval) {
+                      FLAGS_process_monitor_interval),
+      clock_ticks_per_second_(sysconf(_SC_CLK_TCK)),
+      page_size_mb_(sysconf(_SC_PAGESIZE) / 1048576.0) {
 }
 
 void ProcessMonitor::RunOnce(const double current_time) {
-  // Get running processes.
-  std::map<std::string, std::string> running_processes;
-  const auto procs = common::util::ListSubPaths("/proc");
-  for (const auto &proc : procs) {
-    // Get process command string.
-    std::string cmd_string;
-    const auto cmd_file = common::util::StrCat("/proc/", proc, "/cmdline");
-    if (common::util::GetContent(cmd_file, &cmd_string)) {
-      running_processes.emplace(proc, cmd_string);
+  const auto &modules = MonitorManager::GetConfig().modules();
+  std::vector<ModuleUsage> usages(modules.size());
+
+  ++round_;
+  double uptime = 0.0;
+  const bool has_uptime = ReadUptime(&uptime);
+  for (const auto &pid : common::util::ListSubPaths("/proc")) {
+    int64_t dir_ctime_ns = 0;
+    if (!IsPid(pid) || !ReadDirCtime(pid, &dir_ctime_ns)) {
+      continue;
+    }
+    // The stat is read for a new or changed /proc/<pid>, and otherwise only
+    // to sample the usage of the processes which run modules.
+    const auto iter = processes_.find(pid);
+    const bool is_known = iter != processes_.end();
+    ProcessStat stat;
+    bool has_stat = false;
+    if (!is_known || iter->second.dir_ctime_ns != dir_ctime_ns) {
+      if (!ReadStat(pid, &stat)) {
+        continue;
+      }
+      has_stat = true;
+    }
+
+    Process &process = processes_[pid];
+    if (has_stat && (!is_known || process.start_ticks != stat.start_ticks)) {
+      // A new process, which may have reused the pid of an exited one.
+      process = Process();
+      process.start_ticks = stat.start_ticks;
+      MatchModules(pid, &process);
+    } else if (process.modules.empty() && has_uptime &&
+               uptime - process.start_ticks / clock_ticks_per_second_ <
+                   FLAGS_process_monitor_exec_window) {
+      MatchModules(pid, &process);
+    }
+    if (has_stat) {
+      process.dir_ctime_ns = dir_ctime_ns;
+    }
+    process.last_seen_round = round_;
+    if (process.modules.empty() || (!has_stat && !ReadStat(pid, &stat))) {
+      continue;
+    }
+    ModuleUsage usage;
+    SampleUsage(stat, current_time, &process, &usage);
+    for (const int module : process.modules) {
+      ModuleUsage &module_usage = usages[module];
+      if (module_usage.running) {
+        ADEBUG << "Module " << modules.Get(module).name()
+               << " is also running on process " << pid;
+      }
+      module_usage.running = true;
+      module_usage.has_cpu_usage |= usage.has_cpu_usage;
+      module_usage.cpu_usage += usage.cpu_usage;
+      module_usage.memory_usage += usage.memory_usage;
     }
   }
 
-  for (const auto &module : MonitorManager::GetConfig().modules()) {
-    if (module.has_process_conf()) {
-      UpdateModule(module.name(), module.process_conf(), running_processes);
+  // Forget the processes which exited.
+  for (auto iter = processes_.begin(); iter != processes_.end();) {
+    if (iter->second.last_seen_round != round_) {
+      iter = processes_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  for (int i = 0; i < modules.size(); ++i) {
+    if (modules.Get(i).has_process_conf()) {
+      UpdateModule(modules.Get(i).name(), usages[i]);
     }
   }
 }
 
-void ProcessMonitor::UpdateModule(
-    const std::string &module_name, const ProcessConf &config,
-    const std::map<std::string, std::string> &running_processes) {
+void ProcessMonitor::MatchModules(const std::string &pid,
+                                  Process *process) const {
+  process->modules.clear();
+  std::string cmd_string;
+  const auto cmd_file = common::util::StrCat("/proc/", pid, "/cmdline");
+  if (!common::util::GetContent(cmd_file, &cmd_string)) {
+    return;
+  }
+  const auto &modules = MonitorManager::GetConfig().modules();
+  for (int i = 0; i < modules.size(); ++i) {
+    const auto &module = modules.Get(i);
+    if (module.has_process_conf() &&
+        ContainsAll(cmd_string, module.process_conf().process_cmd_keywords())) {
+      ADEBUG << "Module " << module.name() << " is running on process " << pid;
+      process->modules.push_back(i);
+    }
+  }
+}
+
+void ProcessMonitor::SampleUsage(const ProcessStat &stat,
+                                 const double current_time, Process *process,
+                                 ModuleUsage *usage) const {
+  usage->memory_usage = stat.resident_pages * page_size_mb_;
+  if (process->has_cpu_ticks && current_time > process->cpu_sample_time &&
+      stat.cpu_ticks >= process->cpu_ticks) {
+    usage->has_cpu_usage = true;
+    usage->cpu_usage = 100.0 * (stat.cpu_ticks - process->cpu_ticks) /
+                       clock_ticks_per_second_ /
+                       (current_time - process->cpu_sample_time);
+  }
+  process->has_cpu_ticks = true;
+  process->cpu_ticks = stat.cpu_ticks;
+  process->cpu_sample_time = current_time;
+}
+
+void ProcessMonitor::UpdateModule(const std::string &module_name,
+                                  const ModuleUsage &usage) {
   auto *status = MonitorManager::GetModuleStatus(module_name);
-  for (const auto &proc : running_processes) {
-    if (ContainsAll(proc.second, config.process_cmd_keywords())) {
-      status->mutable_process_status()->set_running(true);
-      ADEBUG << "Module " << module_name
-             << " is running on process " << proc.first;
-      return;
+  auto *process_status = status->mutable_process_status();
+  if (usage.running) {
+    process_status->set_running(true);
+    process_status->set_memory_usage(usage.memory_usage);
+    if (usage.has_cpu_usage) {
+      process_status->set_cpu_usage(usage.cpu_usage);
+    } else {
+      process_status->clear_cpu_usage();
     }
+    return;
   }
 
-  if (status->process_status().running()) {
+  if (process_status->running()) {
     // The process stopped. Send monitor log.
     const std::string msg = apollo::common::util::StrCat(
         module_name, " process stopped!");
@@ -94,7 +286,9 @@ void ProcessMonitor::UpdateModule(
     }
   }
 
-  status->mutable_process_status()->set_running(false);
+  process_status->set_running(false);
+  process_status->clear_cpu_usage();
+  process_status->clear_memory_usage();
 }
 
 }  // namespace monitor
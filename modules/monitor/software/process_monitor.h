@@ -18,6 +18,9 @@
 
 #include <map>
 #include <string>
+#include <vector>
+
+#include "gtest/gtest_prod.h"
 
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/monitor/proto/monitor_conf.pb.h"
@@ -25,15 +28,70 @@
 namespace apollo {
 namespace monitor {
 
+// Checks whether the modules are running, and their resource usage.
+//
+// The modules which the processes run are cached by pid, so that a tick only
+// lists /proc, stats the /proc/<pid> directories and reads /proc/<pid>/stat
+// of the processes which run modules. A changed /proc/<pid> directory tells
+// that the pid may be reused, which is confirmed by the start time in its
+// stat. The command line of a process is read again while it is young, in
+// case it execs into a module, e.g. from a launcher script.
 class ProcessMonitor : public RecurrentRunner {
  public:
   ProcessMonitor();
   void RunOnce(const double current_time) override;
 
  private:
-  static void UpdateModule(
-      const std::string &module_name, const ProcessConf &process_conf,
-      const std::map<std::string, std::string> &running_processes);
+  // The fields of /proc/<pid>/stat which are used.
+  struct ProcessStat {
+    // Since boot, in clock ticks.
+    uint64_t start_ticks = 0;
+    uint64_t cpu_ticks = 0;
+    uint64_t resident_pages = 0;
+  };
+
+  struct Process {
+    // Indices of the modules in MonitorConf which the process runs.
+    std::vector<int> modules;
+    uint64_t last_seen_round = 0;
+    // Change time of /proc/<pid> in nanoseconds.
+    int64_t dir_ctime_ns = 0;
+    uint64_t start_ticks = 0;
+    // CPU time in clock ticks at the last sample, if any.
+    bool has_cpu_ticks = false;
+    uint64_t cpu_ticks = 0;
+    double cpu_sample_time = 0.0;
+  };
+
+  struct ModuleUsage {
+    bool running = false;
+    bool has_cpu_usage = false;
+    double cpu_usage = 0.0;
+    double memory_usage = 0.0;
+  };
+
+  static bool ReadStat(const std::string &pid, ProcessStat *stat);
+  static bool ParseStat(const std::string &content, ProcessStat *stat);
+
+  void MatchModules(const std::string &pid, Process *process) const;
+
+  // Samples the resource usage of the process, and adds it to usage.
+  void SampleUsage(const ProcessStat &stat, const double current_time,
+                   Process *process, ModuleUsage *usage) const;
+
+  static void UpdateModule(const std::string &module_name,
+                           const ModuleUsage &usage);
+
+  // Keyed by pid.
+  std::map<std::string, Process> processes_;
+  uint64_t round_ = 0;
+  const double clock_ticks_per_second_;
+  const double page_size_mb_;
+
+  FRIEND_TEST(ProcessMonitorTest, ParseStat);
+  FRIEND_TEST(ProcessMonitorTest, ParseStatWithParenthesesInComm);
+  FRIEND_TEST(ProcessMonitorTest, ParseMalformedStat);
+  FRIEND_TEST(ProcessMonitorTest, ReadStatOfSelf);
 };
 
 }  // namespace monitor
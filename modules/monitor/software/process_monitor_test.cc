@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/process_monitor.h"
+
+#include <unistd.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace monitor {
+
+TEST(ProcessMonitorTest, ParseStat) {
+  // utime 11, stime 7, starttime 12345 and rss 678.
+  const std::string content =
+      "1234 (planning) S 1 1234 1234 0 -1 4194560 100 0 0 0 11 7 0 0 20 0 "
+      "8 0 12345 1000000 678 18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 "
+      "17 3 0 0 0 0 0\n";
+  ProcessMonitor::ProcessStat stat;
+  EXPECT_TRUE(ProcessMonitor::ParseStat(content, &stat));
+  EXPECT_EQ(12345, stat.start_ticks);
+  EXPECT_EQ(18, stat.cpu_ticks);
+  EXPECT_EQ(678, stat.resident_pages);
+}
+
+TEST(ProcessMonitorTest, ParseStatWithParenthesesInComm) {
+  const std::string content =
+      "42 (a) b (c) R 1 42 42 0 -1 0 0 0 0 0 3 4 0 0 20 0 1 0 99 4096 5 "
+      "0 0\n";
+  ProcessMonitor::ProcessStat stat;
+  EXPECT_TRUE(ProcessMonitor::ParseStat(content, &stat));
+  EXPECT_EQ(99, stat.start_ticks);
+  EXPECT_EQ(7, stat.cpu_ticks);
+  EXPECT_EQ(5, stat.resident_pages);
+}
+
+TEST(ProcessMonitorTest, ParseMalformedStat) {
+  ProcessMonitor::ProcessStat stat;
+  EXPECT_FALSE(ProcessMonitor::ParseStat("", &stat));
+  EXPECT_FALSE(ProcessMonitor::ParseStat("42 (planning S 1 42", &stat));
+  // Too few fields.
+  EXPECT_FALSE(ProcessMonitor::ParseStat("42 (planning) S 1 42 42", &stat));
+  // Not a number, negative, or out of range.
+  EXPECT_FALSE(ProcessMonitor::ParseStat(
+      "42 (x) R 1 42 42 0 -1 0 0 0 0 0 abc 4 0 0 20 0 1 0 99 4096 5", &stat));
+  EXPECT_FALSE(ProcessMonitor::ParseStat(
+      "42 (x) R 1 42 42 0 -1 0 0 0 0 0 3 4 0 0 20 0 1 0 -99 4096 5", &stat));
+  EXPECT_FALSE(ProcessMonitor::ParseStat(
+      "42 (x) R 1 42 42 0 -1 0 0 0 0 0 3 4 0 0 20 0 1 0 99 4096 "
+      "99999999999999999999999",
+      &stat));
+}
+
+TEST(ProcessMonitorTest, ReadStatOfSelf) {
+  ProcessMonitor::ProcessStat stat;
+  EXPECT_TRUE(ProcessMonitor::ReadStat(std::to_string(getpid()), &stat));
+  EXPECT_GT(stat.start_ticks, 0);
+  EXPECT_GT(stat.resident_pages, 0);
+}
+
+}  // namespace monitor
+}  // namespace apollo
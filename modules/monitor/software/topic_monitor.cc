@@ -32,6 +32,8 @@ namespace {
 using apollo::common::adapter::AdapterBase;
 using apollo::common::adapter::AdapterConfig;
 using apollo::common::adapter::AdapterManager;
+using apollo::common::adapter::LogHistogram;
+using apollo::common::adapter::TopicStats;
 using apollo::common::util::StrCat;
 using apollo::common::util::StringPrintf;
 
@@ -64,6 +66,18 @@ AdapterBase *GetAdapterByMessageType(const AdapterConfig::MessageType type) {
   return nullptr;
 }
 
+void SetPercentiles(const LogHistogram &histogram, const double scale,
+                    Percentiles *percentiles) {
+  if (histogram.count() == 0) {
+    percentiles->Clear();
+    return;
+  }
+  percentiles->set_p50(histogram.Percentile(0.5) * scale);
+  percentiles->set_p90(histogram.Percentile(0.9) * scale);
+  percentiles->set_p99(histogram.Percentile(0.99) * scale);
+  percentiles->set_max(histogram.max() * scale);
+}
+
 }  // namespace
 
 TopicMonitor::TopicMonitor(const TopicConf &config, TopicStatus *status)
@@ -73,6 +87,7 @@ TopicMonitor::TopicMonitor(const TopicConf &config, TopicStatus *status)
 
 void TopicMonitor::RunOnce(const double current_time) {
   auto *adapter = GetAdapterByMessageType(config_.type());
+  UpdateStatistics(current_time, adapter->GetStats());
   if (!adapter->HasReceived()) {
     status_->set_message_delay(-1);
     return;
@@ -85,5 +100,24 @@ void TopicMonitor::RunOnce(const double current_time) {
   }
 }
 
+void TopicMonitor::UpdateStatistics(const double current_time,
+                                    TopicStats *stats) {
+  if (stats == nullptr) {
+    return;
+  }
+  stats->TakeSnapshot(current_time, &snapshot_);
+  auto *statistics = status_->mutable_statistics();
+  const int message_count = snapshot_.size_bytes.count();
+  statistics->set_message_count(message_count);
+  if (snapshot_.window_sec > 0.0) {
+    statistics->set_frame_rate(message_count / snapshot_.window_sec);
+  } else {
+    statistics->clear_frame_rate();
+  }
+  SetPercentiles(snapshot_.interval_us, 1e-3, statistics->mutable_interval());
+  SetPercentiles(snapshot_.latency_us, 1e-3, statistics->mutable_latency());
+  SetPercentiles(snapshot_.size_bytes, 1.0, statistics->mutable_size());
+}
+
 }  // namespace monitor
 }  // namespace apollo
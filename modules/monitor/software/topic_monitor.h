@@ -31,8 +31,14 @@ class TopicMonitor : public RecurrentRunner {
   void RunOnce(const double current_time) override;
 
  private:
+  // Updates the statistics of the topic over the last interval, if the
+  // adapter keeps them.
+  void UpdateStatistics(const double current_time,
+                        apollo::common::adapter::TopicStats *stats);
+
   const TopicConf &config_;
   TopicStatus *status_;
+  apollo::common::adapter::TopicStats::Snapshot snapshot_;
 };
 
 }  // namespace monitor
@@ -60,10 +60,12 @@ Frame::Frame(uint32_t sequence_num,
              const common::TrajectoryPoint &planning_start_point,
              const double start_time, const common::VehicleState &vehicle_state,
              ReferenceLineProvider *reference_line_provider)
-    : sequence_num_(sequence_num),
+    : arena_(FLAGS_enable_frame_arena ? new FrameArena() : nullptr),
+      sequence_num_(sequence_num),
       planning_start_point_(planning_start_point),
       start_time_(start_time),
       vehicle_state_(vehicle_state),
+      obstacles_(arena_.get()),
       reference_line_provider_(reference_line_provider),
       monitor_logger_(common::monitor::MonitorMessageItem::PLANNING) {
   if (FLAGS_enable_lag_prediction) {
@@ -186,7 +188,8 @@ bool Frame::CreateReferenceLineInfo() {
       is_near_destination_ = true;
     }
     reference_line_info_.emplace_back(vehicle_state_, planning_start_point_,
-                                      *ref_line_iter, *segments_iter);
+                                      *ref_line_iter, *segments_iter,
+                                      arena_.get());
     ++ref_line_iter;
     ++segments_iter;
   }
@@ -479,6 +482,17 @@ void Frame::RecordInputDebug(planning_internal::Debug *debug) {
   }
 }
 
+void Frame::RecordArenaDebug(planning_internal::Debug *debug) const {
+  if (!arena_) {
+    return;
+  }
+  auto *arena_debug = debug->mutable_planning_data()->mutable_frame_arena();
+  arena_debug->set_num_allocations(arena_->num_allocations());
+  arena_debug->set_allocated_bytes(arena_->allocated_bytes());
+  arena_debug->set_reserved_bytes(arena_->reserved_bytes());
+  arena_debug->set_num_chunks(arena_->num_chunks());
+}
+
 void Frame::AlignPredictionTime(const double planning_start_time,
                                 PredictionObstacles *prediction_obstacles) {
   if (!prediction_obstacles || !prediction_obstacles->has_header() ||
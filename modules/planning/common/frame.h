@@ -40,6 +40,7 @@
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/status/status.h"
 #include "modules/planning/common/change_lane_decider.h"
+#include "modules/planning/common/frame_arena.h"
 #include "modules/planning/common/indexed_queue.h"
 #include "modules/planning/common/lag_prediction.h"
 #include "modules/planning/common/obstacle.h"
@@ -75,6 +76,11 @@ class Frame {
 
   void RecordInputDebug(planning_internal::Debug *debug);
 
+  /**
+   * @brief record the allocation counters of the frame arena, if any.
+   */
+  void RecordArenaDebug(planning_internal::Debug *debug) const;
+
   std::list<ReferenceLineInfo> &reference_line_info();
 
   Obstacle *Find(const std::string &id);
@@ -139,6 +145,8 @@ class Frame {
   void AddObstacle(const Obstacle &obstacle);
 
  private:
+  // declared first, the containers below may allocate on it
+  std::unique_ptr<FrameArena> arena_;
   uint32_t sequence_num_ = 0;
   const hdmap::HDMap *hdmap_ = nullptr;
   common::TrajectoryPoint planning_start_point_;
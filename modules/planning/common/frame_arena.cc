@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/frame_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace planning {
+namespace {
+
+// chunks do not grow beyond this size, larger requests get their own chunk
+constexpr std::size_t kMaxChunkSize = 16 * 1024 * 1024;
+
+}  // namespace
+
+FrameArena::FrameArena(const std::size_t initial_chunk_size)
+    : next_chunk_size_(std::max<std::size_t>(initial_chunk_size, 1)) {}
+
+void* FrameArena::Allocate(const std::size_t bytes,
+                           const std::size_t alignment) {
+  CHECK_GT(alignment, 0);
+  CHECK_EQ(alignment & (alignment - 1), 0) << "alignment must be 2^n";
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::size_t padding =
+      (alignment - reinterpret_cast<std::uintptr_t>(current_) % alignment) %
+      alignment;
+  if (current_ == nullptr || padding + bytes > remaining_) {
+    AddChunk(bytes + alignment);
+    padding =
+        (alignment - reinterpret_cast<std::uintptr_t>(current_) % alignment) %
+        alignment;
+  }
+  char* result = current_ + padding;
+  current_ += padding + bytes;
+  remaining_ -= padding + bytes;
+  ++num_allocations_;
+  allocated_bytes_ += padding + bytes;
+  return result;
+}
+
+void FrameArena::AddChunk(const std::size_t min_size) {
+  const std::size_t size = std::max(next_chunk_size_, min_size);
+  chunks_.emplace_back(new char[size]);
+  current_ = chunks_.back().get();
+  remaining_ = size;
+  reserved_bytes_ += size;
+  next_chunk_size_ = std::min(next_chunk_size_ * 2, kMaxChunkSize);
+}
+
+std::size_t FrameArena::num_allocations() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_allocations_;
+}
+
+std::size_t FrameArena::allocated_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocated_bytes_;
+}
+
+std::size_t FrameArena::reserved_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return reserved_bytes_;
+}
+
+std::size_t FrameArena::num_chunks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return chunks_.size();
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#ifndef MODULES_PLANNING_COMMON_FRAME_ARENA_H_
+#define MODULES_PLANNING_COMMON_FRAME_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "modules/common/macro.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class FrameArena
+ * @brief Monotonic memory owned by one planning Frame.
+ *
+ * Memory is handed out from large chunks and never given back one object at
+ * a time: everything is released at once when the arena, i.e. the frame,
+ * is destroyed. The arena is thread safe, so that reference lines planned
+ * in parallel can share the frame arena.
+ */
+class FrameArena {
+ public:
+  static constexpr std::size_t kDefaultChunkSize = 256 * 1024;
+
+  explicit FrameArena(const std::size_t initial_chunk_size = kDefaultChunkSize);
+
+  void* Allocate(const std::size_t bytes, const std::size_t alignment);
+
+  std::size_t num_allocations() const;
+  // bytes handed out, including the alignment padding
+  std::size_t allocated_bytes() const;
+  // bytes reserved from the system
+  std::size_t reserved_bytes() const;
+  std::size_t num_chunks() const;
+
+ private:
+  void AddChunk(const std::size_t min_size);
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  char* current_ = nullptr;
+  std::size_t remaining_ = 0;
+  std::size_t next_chunk_size_ = 0;
+
+  std::size_t num_allocations_ = 0;
+  std::size_t allocated_bytes_ = 0;
+  std::size_t reserved_bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameArena);
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief STL allocator on a FrameArena, or on the heap without arena.
+ *
+ * Copies of a container are made on the heap, so that they may outlive the
+ * frame of the original.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  ArenaAllocator() = default;
+  explicit ArenaAllocator(FrameArena* arena) : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(const std::size_t n) {
+    if (arena_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, const std::size_t n) {
+    if (arena_ == nullptr) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const {
+    return ArenaAllocator();
+  }
+
+  FrameArena* arena() const { return arena_; }
+
+ private:
+  FrameArena* arena_ = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_COMMON_FRAME_ARENA_H_
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/frame_arena.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/indexed_list.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(FrameArenaTest, Allocate) {
+  FrameArena arena(64);
+  void* first = arena.Allocate(3, 1);
+  void* second = arena.Allocate(8, 8);
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(second) % 8);
+  EXPECT_EQ(2, arena.num_allocations());
+  EXPECT_EQ(1, arena.num_chunks());
+
+  // does not fit into the first chunk
+  void* large = arena.Allocate(1000, 16);
+  ASSERT_NE(nullptr, large);
+  EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(large) % 16);
+  EXPECT_EQ(2, arena.num_chunks());
+  EXPECT_EQ(3, arena.num_allocations());
+  EXPECT_GE(arena.allocated_bytes(), 1011);
+  EXPECT_GE(arena.reserved_bytes(), arena.allocated_bytes());
+}
+
+TEST(FrameArenaTest, Allocator) {
+  FrameArena arena;
+  std::vector<int, ArenaAllocator<int>> values((ArenaAllocator<int>(&arena)));
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+  EXPECT_EQ(99, values.back());
+  EXPECT_GT(arena.num_allocations(), 0);
+
+  // copies do not use the arena
+  const std::size_t num_allocations = arena.num_allocations();
+  auto copied_values = values;
+  EXPECT_EQ(nullptr, copied_values.get_allocator().arena());
+  EXPECT_EQ(num_allocations, arena.num_allocations());
+}
+
+TEST(FrameArenaTest, IndexedList) {
+  FrameArena arena;
+  IndexedList<int, std::string> list(&arena);
+  list.Add(1, "one");
+  list.Add(2, "two");
+  ASSERT_NE(nullptr, list.Find(2));
+  EXPECT_EQ("two", *list.Find(2));
+  EXPECT_EQ(2, list.Items().size());
+  EXPECT_GT(arena.num_allocations(), 0);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_COMMON_INDEXED_LIST_H_
 #define MODULES_PLANNING_COMMON_INDEXED_LIST_H_
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -31,6 +32,7 @@
 
 #include "modules/common/log.h"
 #include "modules/common/util/map_util.h"
+#include "modules/planning/common/frame_arena.h"
 
 namespace apollo {
 namespace planning {
@@ -38,6 +40,15 @@ namespace planning {
 template <typename I, typename T>
 class IndexedList {
  public:
+  IndexedList() = default;
+
+  /**
+   * @brief the objects are allocated on the arena, which must outlive the
+   * container. No arena means the heap.
+   */
+  explicit IndexedList(FrameArena* arena)
+      : object_dict_(ArenaAllocator<std::pair<const I, T>>(arena)) {}
+
   /**
    * @brief copy object into the container. If the id is already exist,
    * overwrite the object in the container.
@@ -88,12 +99,19 @@ class IndexedList {
 
  private:
   std::vector<const T*> object_list_;
-  std::unordered_map<I, T> object_dict_;
+  std::unordered_map<I, T, std::hash<I>, std::equal_to<I>,
+                     ArenaAllocator<std::pair<const I, T>>>
+      object_dict_;
 };
 
 template <typename I, typename T>
 class ThreadSafeIndexedList : public IndexedList<I, T> {
  public:
+  ThreadSafeIndexedList() = default;
+
+  explicit ThreadSafeIndexedList(FrameArena* arena)
+      : IndexedList<I, T>(arena) {}
+
   T* Add(const I id, const T& object) {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
     return IndexedList<I, T>::Add(id, object);
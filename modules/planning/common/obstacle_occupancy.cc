@@ -0,0 +1,179 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/obstacle_occupancy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::AABox2d;
+using apollo::common::math::Box2d;
+
+namespace {
+// size of the spatial hash cells, in meters
+constexpr double kCellSize = 10.0;
+// tolerance when deciding whether a time falls on a slice
+constexpr double kTimeEpsilon = 1e-6;
+
+int64_t CellIndex(const double coordinate) {
+  return static_cast<int64_t>(std::floor(coordinate / kCellSize));
+}
+}  // namespace
+
+ObstacleOccupancy::ObstacleOccupancy(const double time_resolution,
+                                     const double total_time)
+    : time_resolution_(time_resolution) {
+  CHECK_GT(time_resolution_, 0.0);
+  num_of_time_slices_ =
+      static_cast<int>(std::floor(total_time / time_resolution_ +
+                                  kTimeEpsilon)) +
+      1;
+}
+
+void ObstacleOccupancy::AddObstacle(const Obstacle* obstacle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  obstacles_.push_back(obstacle);
+  is_indexed_ = false;
+}
+
+int ObstacleOccupancy::TimeSlice(const double t) const {
+  const double slice = t / time_resolution_;
+  const double rounded = std::round(slice);
+  if (std::fabs(slice - rounded) > kTimeEpsilon || rounded < 0.0 ||
+      rounded >= num_of_time_slices_) {
+    return -1;
+  }
+  return static_cast<int>(rounded);
+}
+
+Box2d ObstacleOccupancy::GetBoundingBox(const Obstacle& obstacle,
+                                        const double t) const {
+  const int slice = TimeSlice(t);
+  if (slice >= 0) {
+    const auto* boxes = GetBoundingBoxes(obstacle);
+    if (boxes != nullptr) {
+      return (*boxes)[slice];
+    }
+  }
+  return obstacle.GetBoundingBox(obstacle.GetPointAtTime(t));
+}
+
+const std::vector<Box2d>* ObstacleOccupancy::GetBoundingBoxes(
+    const Obstacle& obstacle) const {
+  EnsureIndex();
+  auto iter = obstacle_index_.find(&obstacle);
+  if (iter == obstacle_index_.end()) {
+    return nullptr;
+  }
+  return &sliced_obstacles_[iter->second].boxes;
+}
+
+std::vector<const Obstacle*> ObstacleOccupancy::QueryObstacles(
+    const int slice, const AABox2d& region) const {
+  std::vector<const Obstacle*> obstacles;
+  if (slice < 0 || slice >= num_of_time_slices_) {
+    return obstacles;
+  }
+  EnsureIndex();
+
+  const auto& slice_hash = slice_hashes_[slice];
+  std::vector<int> indices;
+  const int64_t min_x = CellIndex(region.min_x());
+  const int64_t max_x = CellIndex(region.max_x());
+  const int64_t min_y = CellIndex(region.min_y());
+  const int64_t max_y = CellIndex(region.max_y());
+  for (int64_t x = min_x; x <= max_x; ++x) {
+    for (int64_t y = min_y; y <= max_y; ++y) {
+      auto iter = slice_hash.find(CellKey(x, y));
+      if (iter == slice_hash.end()) {
+        continue;
+      }
+      for (const int index : iter->second) {
+        if (sliced_obstacles_[index].boxes[slice].GetAABox().HasOverlap(
+                region)) {
+          indices.push_back(index);
+        }
+      }
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  for (const int index : indices) {
+    obstacles.push_back(sliced_obstacles_[index].obstacle);
+  }
+  return obstacles;
+}
+
+void ObstacleOccupancy::EnsureIndex() const {
+  if (is_indexed_.load()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_indexed_.load()) {
+    BuildIndex();
+    is_indexed_ = true;
+  }
+}
+
+void ObstacleOccupancy::BuildIndex() const {
+  sliced_obstacles_.clear();
+  obstacle_index_.clear();
+  slice_hashes_.assign(num_of_time_slices_, SliceHash());
+
+  for (const auto* obstacle : obstacles_) {
+    if (obstacle_index_.count(obstacle) > 0) {
+      continue;
+    }
+    const int index = static_cast<int>(sliced_obstacles_.size());
+    obstacle_index_[obstacle] = index;
+    sliced_obstacles_.emplace_back();
+    auto& sliced_obstacle = sliced_obstacles_.back();
+    sliced_obstacle.obstacle = obstacle;
+    sliced_obstacle.boxes.reserve(num_of_time_slices_);
+    for (int slice = 0; slice < num_of_time_slices_; ++slice) {
+      sliced_obstacle.boxes.push_back(obstacle->GetBoundingBox(
+          obstacle->GetPointAtTime(slice * time_resolution_)));
+
+      const AABox2d aabox = sliced_obstacle.boxes.back().GetAABox();
+      const int64_t min_x = CellIndex(aabox.min_x());
+      const int64_t max_x = CellIndex(aabox.max_x());
+      const int64_t min_y = CellIndex(aabox.min_y());
+      const int64_t max_y = CellIndex(aabox.max_y());
+      for (int64_t x = min_x; x <= max_x; ++x) {
+        for (int64_t y = min_y; y <= max_y; ++y) {
+          slice_hashes_[slice][CellKey(x, y)].push_back(index);
+        }
+      }
+    }
+  }
+}
+
+uint64_t ObstacleOccupancy::CellKey(const int64_t x, const int64_t y) const {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+         static_cast<uint64_t>(static_cast<uint32_t>(y));
+}
+
+}  // namespace planning
+}  // namespace apollo
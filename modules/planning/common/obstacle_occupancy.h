@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#ifndef MODULES_PLANNING_COMMON_OBSTACLE_OCCUPANCY_H_
+#define MODULES_PLANNING_COMMON_OBSTACLE_OCCUPANCY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/planning/common/obstacle.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class ObstacleOccupancy
+ * @brief Space-time occupancy of the obstacles of one reference line.
+ *
+ * The bounding box of every registered obstacle is sampled once at fixed
+ * time slices and indexed by a spatial hash per slice, so that planning
+ * tasks can share the geometry instead of interpolating the prediction
+ * trajectories again. The index is built on the first query; obstacles are
+ * expected to be registered before the tasks start querying. Queries are
+ * thread safe.
+ */
+class ObstacleOccupancy {
+ public:
+  /**
+   * @param time_resolution time between two slices
+   * @param total_time time of the last slice
+   */
+  ObstacleOccupancy(const double time_resolution, const double total_time);
+
+  void AddObstacle(const Obstacle* obstacle);
+
+  double time_resolution() const { return time_resolution_; }
+
+  int num_of_time_slices() const { return num_of_time_slices_; }
+
+  /**
+   * @brief the slice at the relative time t, -1 if t does not fall on a
+   * slice.
+   */
+  int TimeSlice(const double t) const;
+
+  /**
+   * @brief the bounding box of the obstacle at relative time t. The cached
+   * box is returned if t falls on a slice and the obstacle is registered.
+   */
+  common::math::Box2d GetBoundingBox(const Obstacle& obstacle,
+                                     const double t) const;
+
+  /**
+   * @brief the boxes of a registered obstacle at all slices, nullptr if the
+   * obstacle is not registered.
+   */
+  const std::vector<common::math::Box2d>* GetBoundingBoxes(
+      const Obstacle& obstacle) const;
+
+  /**
+   * @brief registered obstacles whose box at the slice may overlap the
+   * region, in registration order.
+   */
+  std::vector<const Obstacle*> QueryObstacles(
+      const int slice, const common::math::AABox2d& region) const;
+
+ private:
+  struct SlicedObstacle {
+    const Obstacle* obstacle = nullptr;
+    std::vector<common::math::Box2d> boxes;
+  };
+  using SliceHash = std::unordered_map<uint64_t, std::vector<int>>;
+
+  void EnsureIndex() const;
+  void BuildIndex() const;
+
+  uint64_t CellKey(const int64_t x, const int64_t y) const;
+
+  double time_resolution_ = 0.1;
+  int num_of_time_slices_ = 0;
+
+  std::vector<const Obstacle*> obstacles_;
+
+  mutable std::mutex mutex_;
+  mutable std::atomic<bool> is_indexed_{false};
+  // filled by BuildIndex(), read only afterwards
+  mutable std::vector<SlicedObstacle> sliced_obstacles_;
+  mutable std::unordered_map<const Obstacle*, int> obstacle_index_;
+  mutable std::vector<SliceHash> slice_hashes_;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_COMMON_OBSTACLE_OCCUPANCY_H_
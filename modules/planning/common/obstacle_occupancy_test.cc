@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/obstacle_occupancy.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::AABox2d;
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+class ObstacleOccupancyTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    // a vehicle driving along the x axis at 10 m/s, starting at x = 0
+    perception::PerceptionObstacle perception;
+    perception.set_id(1);
+    perception.mutable_position()->set_x(0.0);
+    perception.mutable_position()->set_y(0.0);
+    perception.set_length(4.0);
+    perception.set_width(2.0);
+    perception.mutable_velocity()->set_x(10.0);
+    prediction::Trajectory trajectory;
+    for (int i = 0; i <= 10; ++i) {
+      auto* point = trajectory.add_trajectory_point();
+      point->mutable_path_point()->set_x(5.0 * i);
+      point->mutable_path_point()->set_y(0.0);
+      point->set_relative_time(0.5 * i);
+    }
+    moving_.reset(new Obstacle("1", perception, trajectory));
+
+    // a static vehicle at (30, 5)
+    perception.set_id(2);
+    perception.mutable_position()->set_x(30.0);
+    perception.mutable_position()->set_y(5.0);
+    perception.mutable_velocity()->set_x(0.0);
+    static_.reset(new Obstacle("2", perception));
+  }
+
+ protected:
+  std::unique_ptr<Obstacle> moving_;
+  std::unique_ptr<Obstacle> static_;
+};
+
+TEST_F(ObstacleOccupancyTest, TimeSlice) {
+  ObstacleOccupancy occupancy(0.1, 5.0);
+  EXPECT_EQ(51, occupancy.num_of_time_slices());
+  EXPECT_EQ(0, occupancy.TimeSlice(0.0));
+  EXPECT_EQ(3, occupancy.TimeSlice(0.3));
+  EXPECT_EQ(50, occupancy.TimeSlice(5.0));
+  EXPECT_EQ(-1, occupancy.TimeSlice(0.25));
+  EXPECT_EQ(-1, occupancy.TimeSlice(5.1));
+  EXPECT_EQ(-1, occupancy.TimeSlice(-0.1));
+}
+
+TEST_F(ObstacleOccupancyTest, BoundingBoxes) {
+  ObstacleOccupancy occupancy(0.1, 5.0);
+  occupancy.AddObstacle(moving_.get());
+  occupancy.AddObstacle(static_.get());
+
+  const auto* boxes = occupancy.GetBoundingBoxes(*moving_);
+  ASSERT_NE(nullptr, boxes);
+  EXPECT_EQ(51, boxes->size());
+  for (const double t : {0.0, 1.2, 2.5, 0.25}) {
+    const Box2d expected =
+        moving_->GetBoundingBox(moving_->GetPointAtTime(t));
+    const Box2d box = occupancy.GetBoundingBox(*moving_, t);
+    EXPECT_NEAR(expected.center_x(), box.center_x(), 1e-9);
+    EXPECT_NEAR(expected.center_y(), box.center_y(), 1e-9);
+  }
+
+  Obstacle unregistered("3", static_->Perception());
+  EXPECT_EQ(nullptr, occupancy.GetBoundingBoxes(unregistered));
+}
+
+TEST_F(ObstacleOccupancyTest, QueryObstacles) {
+  ObstacleOccupancy occupancy(0.1, 5.0);
+  occupancy.AddObstacle(moving_.get());
+  occupancy.AddObstacle(static_.get());
+
+  // at t = 3.0 the moving obstacle is at x = 30, next to the static one
+  auto obstacles = occupancy.QueryObstacles(
+      occupancy.TimeSlice(3.0), AABox2d(Vec2d(25.0, -1.0), Vec2d(35.0, 6.0)));
+  ASSERT_EQ(2, obstacles.size());
+  EXPECT_EQ(moving_.get(), obstacles[0]);
+  EXPECT_EQ(static_.get(), obstacles[1]);
+
+  // at t = 0.0 only the static obstacle is there
+  obstacles = occupancy.QueryObstacles(
+      0, AABox2d(Vec2d(25.0, -1.0), Vec2d(35.0, 6.0)));
+  ASSERT_EQ(1, obstacles.size());
+  EXPECT_EQ(static_.get(), obstacles[0]);
+
+  obstacles = occupancy.QueryObstacles(
+      0, AABox2d(Vec2d(-100.0, -100.0), Vec2d(-90.0, -90.0)));
+  EXPECT_TRUE(obstacles.empty());
+}
+
+}  // namespace planning
+}  // namespace apollo
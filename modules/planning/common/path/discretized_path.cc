@@ -25,6 +25,7 @@
 
 #include "modules/common/log.h"
 #include "modules/common/math/linear_interpolation.h"
+#include "modules/common/math/search.h"
 #include "modules/planning/common/planning_context.h"
 
 namespace apollo {
@@ -60,6 +61,21 @@ common::PathPoint DiscretizedPath::Evaluate(const double path_s) const {
                                                            *it_lower, path_s);
 }
 
+common::PathPoint DiscretizedPath::Evaluate(const double path_s,
+                                            std::size_t *hint) const {
+  CHECK(!path_points_.empty());
+  CHECK_NOTNULL(hint);
+  auto it_lower = QueryLowerBound(path_s, hint);
+  if (it_lower == path_points_.begin()) {
+    return path_points_.front();
+  }
+  if (it_lower == path_points_.end()) {
+    return path_points_.back();
+  }
+  return common::math::InterpolateUsingLinearApproximation(*(it_lower - 1),
+                                                           *it_lower, path_s);
+}
+
 const std::vector<common::PathPoint> &DiscretizedPath::path_points() const {
   return path_points_;
 }
@@ -89,5 +105,14 @@ std::vector<common::PathPoint>::const_iterator DiscretizedPath::QueryLowerBound(
                           func);
 }
 
+std::vector<common::PathPoint>::const_iterator DiscretizedPath::QueryLowerBound(
+    const double path_s, std::size_t *hint) const {
+  auto func = [](const common::PathPoint &tp, const double path_s) {
+    return tp.s() < path_s;
+  };
+  return common::math::HintedLowerBound(path_points_.begin(),
+                                        path_points_.end(), path_s, func, hint);
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_COMMON_PATH_DISCRETIZED_PATH_H_
 #define MODULES_PLANNING_COMMON_PATH_DISCRETIZED_PATH_H_
 
+#include <cstddef>
 #include <vector>
 
 #include "modules/common/proto/pnc_point.pb.h"
@@ -46,6 +47,13 @@ class DiscretizedPath {
 
   common::PathPoint Evaluate(const double path_s) const;
 
+  /**
+   * @brief same as Evaluate(path_s), with the search started from the
+   * previous query, for non-decreasing path_s in a loop.
+   * @param hint index kept between the queries, initialized to 0.
+   */
+  common::PathPoint Evaluate(const double path_s, std::size_t* hint) const;
+
   const std::vector<common::PathPoint>& path_points() const;
 
   std::uint32_t NumOfPoints() const;
@@ -55,6 +63,8 @@ class DiscretizedPath {
  protected:
   std::vector<common::PathPoint>::const_iterator QueryLowerBound(
       const double path_s) const;
+  std::vector<common::PathPoint>::const_iterator QueryLowerBound(
+      const double path_s, std::size_t* hint) const;
 
   std::vector<common::PathPoint> path_points_;
 };
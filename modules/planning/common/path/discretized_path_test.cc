@@ -76,5 +76,27 @@ TEST(DiscretizedPathTest, basic_test) {
   EXPECT_EQ(discretized_path.NumOfPoints(), 0);
 }
 
+TEST(DiscretizedPathTest, hinted_evaluate) {
+  std::vector<PathPoint> path_points;
+  for (int i = 0; i < 20; ++i) {
+    PathPoint point = MakePathPoint(i, 0.5 * i, 0.0, 0.0, 0.0, 0.0, 0.0);
+    point.set_s(std::sqrt(1.25) * i);
+    path_points.push_back(point);
+  }
+  DiscretizedPath discretized_path(path_points);
+
+  std::size_t hint = 0;
+  for (double s = -1.0; s < discretized_path.Length() + 1.0; s += 0.3) {
+    const auto expected = discretized_path.Evaluate(s);
+    const auto point = discretized_path.Evaluate(s, &hint);
+    EXPECT_DOUBLE_EQ(expected.s(), point.s());
+    EXPECT_DOUBLE_EQ(expected.x(), point.x());
+    EXPECT_DOUBLE_EQ(expected.y(), point.y());
+  }
+  // going backward is still correct
+  const auto point = discretized_path.Evaluate(2.5, &hint);
+  EXPECT_DOUBLE_EQ(point.x(), 2.5 / std::sqrt(1.25));
+}
+
 }  // namespace planning
 }  // namespace apollo
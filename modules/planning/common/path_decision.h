@@ -30,6 +30,7 @@
 
 #include "modules/planning/proto/decision.pb.h"
 
+#include "modules/planning/common/frame_arena.h"
 #include "modules/planning/common/indexed_list.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/path_obstacle.h"
@@ -46,6 +47,9 @@ class PathDecision {
  public:
   PathDecision() = default;
 
+  // the path obstacles are allocated on the given frame arena
+  explicit PathDecision(FrameArena *arena) : path_obstacles_(arena) {}
+
   PathObstacle *AddPathObstacle(const PathObstacle &path_obstacle);
 
   const IndexedList<std::string, PathObstacle> &path_obstacles() const;
@@ -75,6 +75,9 @@ DEFINE_double(reference_line_lateral_buffer, 0.5,
 
 DEFINE_bool(enable_smooth_reference_line, true,
             "enable smooth the map reference line");
+DEFINE_bool(enable_incremental_reference_line_smoothing, false,
+            "reuse the smoothed reference lines of previous cycles and only "
+            "smooth the newly exposed tail of a route segment");
 
 DEFINE_bool(prioritize_change_lane, false,
             "change lane strategy has higher priority, always use a valid "
@@ -99,6 +102,9 @@ DEFINE_bool(enable_side_vehicle_st_boundary, false,
             "Add st boundary of side vehicle in st graph.");
 
 DEFINE_int32(max_history_frame_num, 1, "The maximum history frame number");
+DEFINE_bool(enable_frame_arena, false,
+            "True to allocate the obstacles of a frame on a frame arena, "
+            "released together with the frame.");
 
 DEFINE_double(max_collision_distance, 0.1,
               "considered as collision if distance (meters) is smaller than or "
@@ -268,10 +274,21 @@ DEFINE_bool(enable_follow_accel_constraint, true,
 
 // SQP solver
 DEFINE_bool(enable_sqp_solver, true, "True to enable SQP solver.");
+DEFINE_bool(enable_admm_spline_qp_solver, false,
+            "True to solve the spline QPs with the warm-started sparse ADMM "
+            "solver instead of qpOASES.");
 
 /// thread pool
 DEFINE_uint32(max_planning_thread_pool_size, 15,
               "num of thread used in planning thread pool.");
+DEFINE_uint32(planning_thread_pool_max_queue_size, 256,
+              "max num of tasks queued on a planning thread pool thread, "
+              "beyond which the submitting thread runs the task itself.");
+DEFINE_string(planning_thread_pool_cpus, "",
+              "comma separated CPUs to pin the planning thread pool to, "
+              "e.g. 2,3,4,5. Any CPU if empty.");
+DEFINE_int32(planning_thread_pool_nice, 0,
+             "nice value of the planning thread pool threads, 0 to inherit.");
 DEFINE_bool(use_multi_thread_to_add_obstacles, false,
             "use multiple thread to add obstacles.");
 DEFINE_bool(
@@ -279,6 +296,12 @@ DEFINE_bool(
     "Enable multiple thread to calculation curve cost in dp_poly_path.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_multi_thread_in_st_boundary_mapper, false,
+            "Enable multiple thread to map obstacles in st_boundary_mapper.");
+DEFINE_bool(enable_parallel_reference_line_planning, false,
+            "Enable planning on each reference line in its own thread.");
+DEFINE_bool(enable_multi_thread_in_obstacle_distance_grid, false,
+            "Enable multiple thread to build the open space distance grid.");
 
 /// Lattice Planner
 DEFINE_double(lattice_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -380,3 +403,10 @@ DEFINE_bool(enable_stitch_last_trajectory, true,
 
 DEFINE_bool(enable_planning_pad_msg, false,
             "To control whether to enable planning pad message.");
+
+// open space planner
+DEFINE_bool(enable_open_space_hybrid_a_star_warm_start, false,
+            "Warm start the open space planner with a hybrid A* search on an "
+            "obstacle distance grid instead of the warm start problem.");
+DEFINE_double(open_space_distance_grid_resolution, 0.1,
+              "Cell size of the open space obstacle distance grid in meters.");
@@ -41,6 +41,7 @@ DECLARE_double(reference_line_stitch_overlap_distance);
 DECLARE_double(reference_line_lateral_buffer);
 
 DECLARE_bool(enable_smooth_reference_line);
+DECLARE_bool(enable_incremental_reference_line_smoothing);
 
 DECLARE_bool(prioritize_change_lane);
 DECLARE_bool(reckless_change_lane);
@@ -57,6 +58,7 @@ DECLARE_bool(publish_estop);
 DECLARE_bool(enable_trajectory_stitcher);
 
 DECLARE_int32(max_history_frame_num);
+DECLARE_bool(enable_frame_arena);
 
 // parameters for trajectory stitching and reinit planning starting point.
 DECLARE_double(replan_lateral_distance_threshold);
@@ -139,12 +141,19 @@ DECLARE_double(slowdown_profile_deceleration);
 DECLARE_bool(enable_follow_accel_constraint);
 
 DECLARE_bool(enable_sqp_solver);
+DECLARE_bool(enable_admm_spline_qp_solver);
 
 /// thread pool
 DECLARE_uint32(max_planning_thread_pool_size);
+DECLARE_uint32(planning_thread_pool_max_queue_size);
+DECLARE_string(planning_thread_pool_cpus);
+DECLARE_int32(planning_thread_pool_nice);
 DECLARE_bool(use_multi_thread_to_add_obstacles);
 DECLARE_bool(enable_multi_thread_in_dp_poly_path);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_multi_thread_in_st_boundary_mapper);
+DECLARE_bool(enable_parallel_reference_line_planning);
+DECLARE_bool(enable_multi_thread_in_obstacle_distance_grid);
 
 // lattice planner
 DECLARE_double(lattice_epsilon);
@@ -208,4 +217,8 @@ DECLARE_double(navigation_fallback_cruise_time);
 DECLARE_bool(enable_stitch_last_trajectory);
 DECLARE_bool(enable_planning_pad_msg);
 
+// open space planner
+DECLARE_bool(enable_open_space_hybrid_a_star_warm_start);
+DECLARE_double(open_space_distance_grid_resolution);
+
 #endif  // MODULES_PLANNING_COMMON_PLANNING_GFLAGS_H_
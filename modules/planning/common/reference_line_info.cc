@@ -21,6 +21,7 @@
 #include "modules/planning/common/reference_line_info.h"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <utility>
 
@@ -48,15 +49,21 @@ using apollo::common::VehicleSignal;
 using apollo::common::adapter::AdapterManager;
 using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
-using apollo::common::util::ThreadPool;
+using apollo::common::util::TaskGroup;
 
 ReferenceLineInfo::ReferenceLineInfo(const common::VehicleState& vehicle_state,
                                      const TrajectoryPoint& adc_planning_point,
                                      const ReferenceLine& reference_line,
-                                     const hdmap::RouteSegments& segments)
+                                     const hdmap::RouteSegments& segments,
+                                     FrameArena* arena)
     : vehicle_state_(vehicle_state),
       adc_planning_point_(adc_planning_point),
       reference_line_(reference_line),
+      path_decision_(arena),
+      obstacle_occupancy_(new ObstacleOccupancy(
+          FLAGS_trajectory_time_resolution,
+          std::max(FLAGS_prediction_total_time,
+                   FLAGS_trajectory_time_length))),
       lanes_(segments) {}
 
 bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles) {
@@ -235,6 +242,10 @@ const ReferenceLine& ReferenceLineInfo::reference_line() const {
   return reference_line_;
 }
 
+const ObstacleOccupancy* ReferenceLineInfo::obstacle_occupancy() const {
+  return obstacle_occupancy_.get();
+}
+
 void ReferenceLineInfo::SetTrajectory(const DiscretizedTrajectory& trajectory) {
   discretized_trajectory_ = trajectory;
 }
@@ -254,6 +265,9 @@ PathObstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
     AERROR << "failed to add obstacle " << obstacle->Id();
     return nullptr;
   }
+  if (obstacle_occupancy_) {
+    obstacle_occupancy_->AddObstacle(obstacle);
+  }
 
   SLBoundary perception_sl;
   if (!reference_line_.GetSLBoundary(obstacle->PerceptionBoundingBox(),
@@ -289,20 +303,18 @@ PathObstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
 bool ReferenceLineInfo::AddObstacles(
     const std::vector<const Obstacle*>& obstacles) {
   if (FLAGS_use_multi_thread_to_add_obstacles) {
-    std::vector<std::future<bool>> futures;
+    std::atomic<bool> succeeded(true);
+    TaskGroup group;
     for (const auto* obstacle : obstacles) {
-      futures.push_back(ThreadPool::pool()->push(
-          std::bind(&ReferenceLineInfo::AddObstacleHelper, this, obstacle)));
-    }
-
-    for (const auto& f : futures) {
-      f.wait();
+      group.Run([this, obstacle, &succeeded]() {
+        if (!AddObstacleHelper(obstacle)) {
+          succeeded = false;
+        }
+      });
     }
-
-    for (auto& f : futures) {
-      if (!f.get()) {
-        return false;
-      }
+    group.Wait();
+    if (!succeeded) {
+      return false;
     }
   } else {
     for (const auto* obstacle : obstacles) {
@@ -385,6 +397,8 @@ bool ReferenceLineInfo::CombinePathAndSpeedProfile(
     AWARN << "path data is empty";
     return false;
   }
+  // s is non-decreasing with the time
+  std::size_t path_index = 0;
   for (double cur_rel_time = 0.0; cur_rel_time < speed_data_.TotalTime();
        cur_rel_time += (cur_rel_time < kDenseTimeSec ? kDenseTimeResoltuion
                                                      : kSparseTimeResolution)) {
@@ -397,12 +411,8 @@ bool ReferenceLineInfo::CombinePathAndSpeedProfile(
     if (speed_point.s() > path_data_.discretized_path().Length()) {
       break;
     }
-    common::PathPoint path_point;
-    if (!path_data_.GetPathPointWithPathS(speed_point.s(), &path_point)) {
-      AERROR << "Fail to get path data with s " << speed_point.s()
-             << "path total length " << path_data_.discretized_path().Length();
-      return false;
-    }
+    common::PathPoint path_point =
+        path_data_.discretized_path().Evaluate(speed_point.s(), &path_index);
     path_point.set_s(path_point.s() + start_s);
 
     common::TrajectoryPoint trajectory_point;
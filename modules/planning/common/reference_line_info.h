@@ -36,6 +36,8 @@
 #include "modules/planning/proto/planning.pb.h"
 
 #include "modules/map/pnc_map/pnc_map.h"
+#include "modules/planning/common/frame_arena.h"
+#include "modules/planning/common/obstacle_occupancy.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/speed_data.h"
@@ -54,7 +56,8 @@ class ReferenceLineInfo {
   explicit ReferenceLineInfo(const common::VehicleState& vehicle_state,
                              const common::TrajectoryPoint& adc_planning_point,
                              const ReferenceLine& reference_line,
-                             const hdmap::RouteSegments& segments);
+                             const hdmap::RouteSegments& segments,
+                             FrameArena* arena = nullptr);
 
   bool Init(const std::vector<const Obstacle*>& obstacles);
 
@@ -68,6 +71,12 @@ class ReferenceLineInfo {
   const PathDecision& path_decision() const;
   const ReferenceLine& reference_line() const;
 
+  /**
+   * @brief space-time occupancy of the obstacles added to this reference
+   * line, shared by the planning tasks.
+   */
+  const ObstacleOccupancy* obstacle_occupancy() const;
+
   bool ReachedDestination() const;
 
   void SetTrajectory(const DiscretizedTrajectory& trajectory);
@@ -196,6 +205,8 @@ class ReferenceLineInfo {
 
   PathDecision path_decision_;
 
+  std::unique_ptr<ObstacleOccupancy> obstacle_occupancy_;
+
   PathData path_data_;
   SpeedData speed_data_;
 
@@ -94,8 +94,8 @@ class StBoundary : public common::math::Polygon2d {
 
   double Area() const;
 
-  std::vector<STPoint> upper_points() const { return upper_points_; }
-  std::vector<STPoint> lower_points() const { return lower_points_; }
+  const std::vector<STPoint>& upper_points() const { return upper_points_; }
+  const std::vector<STPoint>& lower_points() const { return lower_points_; }
 
   static StBoundary GenerateStBoundary(
       const std::vector<STPoint>& lower_points,
@@ -32,26 +32,54 @@ inline bool fuzzy_within(const double v, const double lower, const double upper,
                          const double e = 1.0e-4) {
   return v > lower - e && v < upper + e;
 }
+
+bool IsValidLongitudinalState(const double v, const double a,
+                              const double j) {
+  return fuzzy_within(v, FLAGS_speed_lower_bound, FLAGS_speed_upper_bound) &&
+         fuzzy_within(a, FLAGS_longitudinal_acceleration_lower_bound,
+                      FLAGS_longitudinal_acceleration_upper_bound) &&
+         fuzzy_within(j, FLAGS_longitudinal_jerk_lower_bound,
+                      FLAGS_longitudinal_jerk_upper_bound);
+}
 }  // namespace
 
 bool ConstraintChecker1d::IsValidLongitudinalTrajectory(
     const Curve1d& lon_trajectory) {
   double t = 0.0;
   while (t < lon_trajectory.ParamLength()) {
-    double v = lon_trajectory.Evaluate(1, t);  // evalute_v
-    if (!fuzzy_within(v, FLAGS_speed_lower_bound, FLAGS_speed_upper_bound)) {
+    if (!IsValidLongitudinalState(lon_trajectory.Evaluate(1, t),
+                                  lon_trajectory.Evaluate(2, t),
+                                  lon_trajectory.Evaluate(3, t))) {
       return false;
     }
+    t += FLAGS_trajectory_time_resolution;
+  }
+  return true;
+}
 
-    double a = lon_trajectory.Evaluate(2, t);  // evaluat_a
-    if (!fuzzy_within(a, FLAGS_longitudinal_acceleration_lower_bound,
-                      FLAGS_longitudinal_acceleration_upper_bound)) {
+bool ConstraintChecker1d::IsValidLongitudinalTrajectory(
+    const LatticeTrajectory1dBundle& lon_bundle, const std::size_t index) {
+  const double param_length = lon_bundle.ParamLength(index);
+  const std::vector<double>& params = lon_bundle.sampled_params();
+  std::size_t i = 0;
+  for (; i < params.size() && params[i] < param_length; ++i) {
+    if (!IsValidLongitudinalState(lon_bundle.Sampled(1, index, i),
+                                  lon_bundle.Sampled(2, index, i),
+                                  lon_bundle.Sampled(3, index, i))) {
       return false;
     }
+  }
+  if (i < params.size()) {
+    return true;
+  }
 
-    double j = lon_trajectory.Evaluate(3, t);
-    if (!fuzzy_within(j, FLAGS_longitudinal_jerk_lower_bound,
-                      FLAGS_longitudinal_jerk_upper_bound)) {
+  // the trajectory is longer than the sampled grid
+  double t = params.empty() ? 0.0
+                            : params.back() + FLAGS_trajectory_time_resolution;
+  while (t < param_length) {
+    if (!IsValidLongitudinalState(lon_bundle.Evaluate(index, 1, t),
+                                  lon_bundle.Evaluate(index, 2, t),
+                                  lon_bundle.Evaluate(index, 3, t))) {
       return false;
     }
     t += FLAGS_trajectory_time_resolution;
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/lattice/trajectory1d/lattice_trajectory1d_bundle.h"
 #include "modules/planning/math/curve1d/curve1d.h"
 
 namespace apollo {
@@ -35,6 +36,11 @@ class ConstraintChecker1d {
 
   static bool IsValidLongitudinalTrajectory(const Curve1d& lon_trajectory);
 
+  // same check on a candidate of the bundle, which uses the sampled values
+  // where the sampled grid covers the trajectory
+  static bool IsValidLongitudinalTrajectory(
+      const LatticeTrajectory1dBundle& lon_bundle, const std::size_t index);
+
   static bool IsValidLateralTrajectory(const Curve1d& lat_trajectory,
                                        const Curve1d& lon_trajectory);
 };
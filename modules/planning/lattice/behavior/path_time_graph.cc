@@ -30,6 +30,7 @@
 #include "modules/common/math/linear_interpolation.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/obstacle_occupancy.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/proto/sl_boundary.pb.h"
 
@@ -41,7 +42,6 @@ using apollo::common::math::Box2d;
 using apollo::common::math::Polygon2d;
 using apollo::common::math::PathMatcher;
 using apollo::common::PathPoint;
-using apollo::common::TrajectoryPoint;
 using apollo::perception::PerceptionObstacle;
 
 PathTimeGraph::PathTimeGraph(
@@ -170,10 +170,17 @@ void PathTimeGraph::SetStaticObstacle(
 void PathTimeGraph::SetDynamicObstacle(
     const Obstacle* obstacle,
     const std::vector<PathPoint>& discretized_ref_points) {
+  // the boxes sampled by the reference line info are shared with the other
+  // tasks, the ones off its slices are interpolated.
+  const ObstacleOccupancy* obstacle_occupancy =
+      ptr_reference_line_info_->obstacle_occupancy();
   double relative_time = time_range_.first;
   while (relative_time < time_range_.second) {
-    TrajectoryPoint point = obstacle->GetPointAtTime(relative_time);
-    Box2d box = obstacle->GetBoundingBox(point);
+    Box2d box = obstacle_occupancy != nullptr
+                    ? obstacle_occupancy->GetBoundingBox(*obstacle,
+                                                         relative_time)
+                    : obstacle->GetBoundingBox(
+                          obstacle->GetPointAtTime(relative_time));
     SLBoundary sl_boundary = ComputeObstacleBoundary(box.GetAllCorners(),
         discretized_ref_points);
 
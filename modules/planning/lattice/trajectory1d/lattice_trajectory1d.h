@@ -41,6 +41,11 @@ class LatticeTrajectory1d : public Curve1d {
 
   virtual std::string ToString() const;
 
+  // the trajectory before the constant acceleration extrapolation
+  const std::shared_ptr<Curve1d>& ptr_trajectory1d() const {
+    return ptr_trajectory1d_;
+  }
+
   bool has_target_position() const;
 
   bool has_target_velocity() const;
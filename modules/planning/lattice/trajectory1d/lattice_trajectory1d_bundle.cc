@@ -0,0 +1,195 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/lattice/trajectory1d/lattice_trajectory1d_bundle.h"
+
+#include <limits>
+
+#include "modules/common/log.h"
+#include "modules/planning/lattice/trajectory1d/lattice_trajectory1d.h"
+
+namespace apollo {
+namespace planning {
+namespace {
+
+constexpr std::size_t kMaxPolynomialOrder = 5;
+
+// the order-th derivative of sum(coef[i] * x^i) at param
+double EvaluatePolynomial(const std::array<double, 6>& coef,
+                          const std::uint32_t order, const double param) {
+  if (order > kMaxPolynomialOrder) {
+    return 0.0;
+  }
+  double result = 0.0;
+  for (std::size_t i = kMaxPolynomialOrder + 1; i-- > order;) {
+    // i! / (i - order)!
+    double factor = 1.0;
+    for (std::size_t k = i - order + 1; k <= i; ++k) {
+      factor *= static_cast<double>(k);
+    }
+    result = result * param + factor * coef[i];
+  }
+  return result;
+}
+
+}  // namespace
+
+std::size_t LatticeTrajectory1dBundle::Add(const Curve1d& trajectory) {
+  const auto* lattice_trajectory =
+      dynamic_cast<const LatticeTrajectory1d*>(&trajectory);
+  if (lattice_trajectory != nullptr) {
+    const auto* polynomial = dynamic_cast<const PolynomialCurve1d*>(
+        lattice_trajectory->ptr_trajectory1d().get());
+    if (polynomial != nullptr && polynomial->Order() <= kMaxPolynomialOrder) {
+      return AddPolynomial(*polynomial, polynomial->ParamLength());
+    }
+  } else {
+    const auto* polynomial =
+        dynamic_cast<const PolynomialCurve1d*>(&trajectory);
+    if (polynomial != nullptr && polynomial->Order() <= kMaxPolynomialOrder) {
+      return AddPolynomial(*polynomial,
+                           std::numeric_limits<double>::infinity());
+    }
+  }
+
+  for (auto& coef : coef_) {
+    coef.push_back(0.0);
+  }
+  end_param_.push_back(std::numeric_limits<double>::infinity());
+  end_position_.push_back(0.0);
+  end_velocity_.push_back(0.0);
+  end_acceleration_.push_back(0.0);
+  param_length_.push_back(trajectory.ParamLength());
+  curves_.push_back(&trajectory);
+  return curves_.size() - 1;
+}
+
+std::size_t LatticeTrajectory1dBundle::AddPolynomial(
+    const PolynomialCurve1d& curve, const double end_param) {
+  for (std::size_t i = 0; i < coef_.size(); ++i) {
+    coef_[i].push_back(i <= curve.Order() ? curve.Coef(i) : 0.0);
+  }
+  end_param_.push_back(end_param);
+  const double param_length = curve.ParamLength();
+  end_position_.push_back(curve.Evaluate(0, param_length));
+  end_velocity_.push_back(curve.Evaluate(1, param_length));
+  end_acceleration_.push_back(curve.Evaluate(2, param_length));
+  param_length_.push_back(param_length);
+  curves_.push_back(nullptr);
+  return curves_.size() - 1;
+}
+
+double LatticeTrajectory1dBundle::ParamLength(const std::size_t index) const {
+  CHECK_LT(index, size());
+  return param_length_[index];
+}
+
+double LatticeTrajectory1dBundle::Evaluate(const std::size_t index,
+                                           const std::uint32_t order,
+                                           const double param) const {
+  CHECK_LT(index, size());
+  if (curves_[index] != nullptr) {
+    return curves_[index]->Evaluate(order, param);
+  }
+  if (param >= end_param_[index]) {
+    const double t = param - end_param_[index];
+    switch (order) {
+      case 0:
+        return end_position_[index] + end_velocity_[index] * t +
+               0.5 * end_acceleration_[index] * t * t;
+      case 1:
+        return end_velocity_[index] + end_acceleration_[index] * t;
+      case 2:
+        return end_acceleration_[index];
+      default:
+        return 0.0;
+    }
+  }
+  std::array<double, 6> coef;
+  for (std::size_t i = 0; i < coef.size(); ++i) {
+    coef[i] = coef_[i][index];
+  }
+  return EvaluatePolynomial(coef, order, param);
+}
+
+void LatticeTrajectory1dBundle::Sample(const std::vector<double>& params) {
+  params_ = params;
+  const std::size_t n = size();
+  for (auto& samples : samples_) {
+    samples.resize(params.size() * n);
+  }
+
+  const double* c0 = coef_[0].data();
+  const double* c1 = coef_[1].data();
+  const double* c2 = coef_[2].data();
+  const double* c3 = coef_[3].data();
+  const double* c4 = coef_[4].data();
+  const double* c5 = coef_[5].data();
+  const double* end_param = end_param_.data();
+  const double* end_position = end_position_.data();
+  const double* end_velocity = end_velocity_.data();
+  const double* end_acceleration = end_acceleration_.data();
+  for (std::size_t j = 0; j < params.size(); ++j) {
+    const double t = params[j];
+    double* position = samples_[0].data() + j * n;
+    double* velocity = samples_[1].data() + j * n;
+    double* acceleration = samples_[2].data() + j * n;
+    double* jerk = samples_[3].data() + j * n;
+    // branch free over the candidates, so that the loop is vectorized
+    for (std::size_t k = 0; k < n; ++k) {
+      const double p =
+          ((((c5[k] * t + c4[k]) * t + c3[k]) * t + c2[k]) * t + c1[k]) * t +
+          c0[k];
+      const double v = (((5.0 * c5[k] * t + 4.0 * c4[k]) * t + 3.0 * c3[k]) *
+                            t +
+                        2.0 * c2[k]) *
+                           t +
+                       c1[k];
+      const double a =
+          ((20.0 * c5[k] * t + 12.0 * c4[k]) * t + 6.0 * c3[k]) * t +
+          2.0 * c2[k];
+      const double dddp = (60.0 * c5[k] * t + 24.0 * c4[k]) * t + 6.0 * c3[k];
+
+      const bool extrapolated = t >= end_param[k];
+      const double dt = extrapolated ? t - end_param[k] : 0.0;
+      position[k] = extrapolated ? end_position[k] + end_velocity[k] * dt +
+                                       0.5 * end_acceleration[k] * dt * dt
+                                 : p;
+      velocity[k] =
+          extrapolated ? end_velocity[k] + end_acceleration[k] * dt : v;
+      acceleration[k] = extrapolated ? end_acceleration[k] : a;
+      jerk[k] = extrapolated ? 0.0 : dddp;
+    }
+  }
+
+  for (std::size_t k = 0; k < n; ++k) {
+    if (curves_[k] == nullptr) {
+      continue;
+    }
+    for (std::size_t j = 0; j < params.size(); ++j) {
+      for (std::uint32_t order = 0; order < kNumSampledOrders; ++order) {
+        samples_[order][j * n + k] = curves_[k]->Evaluate(order, params[j]);
+      }
+    }
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#ifndef MODULES_PLANNING_LATTICE_TRAJECTORY1D_LATTICE_TRAJECTORY1D_BUNDLE_H_
+#define MODULES_PLANNING_LATTICE_TRAJECTORY1D_LATTICE_TRAJECTORY1D_BUNDLE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "modules/planning/math/curve1d/curve1d.h"
+#include "modules/planning/math/curve1d/polynomial_curve1d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class LatticeTrajectory1dBundle
+ * @brief Candidate 1d trajectories of one lattice planning cycle.
+ *
+ * The coefficients of the polynomial candidates (quartic and quintic curves,
+ * plain or wrapped by LatticeTrajectory1d) are stored as structure of
+ * arrays, so that all of them are evaluated at a shared parameter grid in
+ * one pass of Horner loops the compiler vectorizes over the candidates.
+ * Past its param length, a LatticeTrajectory1d candidate is extrapolated
+ * with constant acceleration exactly as LatticeTrajectory1d::Evaluate()
+ * does. Other curves are kept by pointer and evaluated through Curve1d, so
+ * they must outlive the bundle.
+ */
+class LatticeTrajectory1dBundle {
+ public:
+  // evaluated orders: position, velocity, acceleration and jerk
+  static constexpr std::uint32_t kNumSampledOrders = 4;
+
+  LatticeTrajectory1dBundle() = default;
+
+  /**
+   * @brief add a candidate.
+   * @return the index of the candidate in the bundle.
+   */
+  std::size_t Add(const Curve1d& trajectory);
+
+  std::size_t size() const { return curves_.size(); }
+
+  double ParamLength(const std::size_t index) const;
+
+  /**
+   * @brief evaluate one candidate, without virtual dispatch for the
+   * polynomial ones.
+   */
+  double Evaluate(const std::size_t index, const std::uint32_t order,
+                  const double param) const;
+
+  /**
+   * @brief evaluate position to jerk of all candidates at the given grid.
+   */
+  void Sample(const std::vector<double>& params);
+
+  const std::vector<double>& sampled_params() const { return params_; }
+
+  std::size_t num_samples() const { return params_.size(); }
+
+  // value of the given order of a candidate at the sample-th grid param
+  double Sampled(const std::uint32_t order, const std::size_t index,
+                 const std::size_t sample) const {
+    return samples_[order][sample * curves_.size() + index];
+  }
+
+ private:
+  std::size_t AddPolynomial(const PolynomialCurve1d& curve,
+                            const double end_param);
+
+  // f = sum(coef_[i][k] * x^i) for the k-th candidate
+  std::array<std::vector<double>, 6> coef_;
+  // beginning of the extrapolation, infinity when there is none
+  std::vector<double> end_param_;
+  std::vector<double> end_position_;
+  std::vector<double> end_velocity_;
+  std::vector<double> end_acceleration_;
+  std::vector<double> param_length_;
+  // nullptr for the polynomial candidates
+  std::vector<const Curve1d*> curves_;
+
+  std::vector<double> params_;
+  // per order, sample major: samples_[order][sample * size() + index]
+  std::array<std::vector<double>, kNumSampledOrders> samples_;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_LATTICE_TRAJECTORY1D_LATTICE_TRAJECTORY1D_BUNDLE_H_
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/lattice/trajectory1d/lattice_trajectory1d_bundle.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/lattice/trajectory1d/lattice_trajectory1d.h"
+#include "modules/planning/lattice/trajectory1d/standing_still_trajectory1d.h"
+#include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(LatticeTrajectory1dBundleTest, SameAsCurves) {
+  std::vector<std::shared_ptr<Curve1d>> trajectories;
+  trajectories.push_back(std::make_shared<LatticeTrajectory1d>(
+      std::make_shared<QuinticPolynomialCurve1d>(
+          std::array<double, 3>{{0.0, 5.0, 0.5}},
+          std::array<double, 3>{{30.0, 8.0, 0.0}}, 4.0)));
+  trajectories.push_back(std::make_shared<LatticeTrajectory1d>(
+      std::make_shared<QuarticPolynomialCurve1d>(
+          std::array<double, 3>{{0.0, 5.0, 0.5}},
+          std::array<double, 2>{{10.0, 0.0}}, 6.0)));
+  trajectories.push_back(std::make_shared<QuinticPolynomialCurve1d>(
+      std::array<double, 3>{{0.5, 0.1, 0.0}},
+      std::array<double, 3>{{0.0, 0.0, 0.0}}, 20.0));
+  trajectories.push_back(std::make_shared<StandingStillTrajectory1d>(3.0, 8.0));
+
+  LatticeTrajectory1dBundle bundle;
+  for (std::size_t i = 0; i < trajectories.size(); ++i) {
+    EXPECT_EQ(i, bundle.Add(*trajectories[i]));
+  }
+  EXPECT_EQ(trajectories.size(), bundle.size());
+
+  std::vector<double> params;
+  for (double t = 0.0; t <= 8.0; t += 0.1) {
+    params.push_back(t);
+  }
+  bundle.Sample(params);
+  ASSERT_EQ(params.size(), bundle.num_samples());
+
+  for (std::size_t i = 0; i < trajectories.size(); ++i) {
+    const auto& trajectory = *trajectories[i];
+    EXPECT_DOUBLE_EQ(trajectory.ParamLength(), bundle.ParamLength(i));
+    for (std::size_t j = 0; j < params.size(); ++j) {
+      for (std::uint32_t order = 0;
+           order < LatticeTrajectory1dBundle::kNumSampledOrders; ++order) {
+        const double expected = trajectory.Evaluate(order, params[j]);
+        EXPECT_NEAR(expected, bundle.Sampled(order, i, j), 1e-9);
+        EXPECT_NEAR(expected, bundle.Evaluate(i, order, params[j]), 1e-9);
+      }
+    }
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -70,17 +70,39 @@ TrajectoryEvaluator::TrajectoryEvaluator(
   if (planning_target.has_stop_point()) {
     stop_point = planning_target.stop_point().s();
   }
+
+  // all the candidates are evaluated at once on the time grid of the
+  // path blocking intervals, and without virtual calls afterwards
+  std::vector<double> time_grid;
+  for (double t = start_time; t <= end_time;
+       t += FLAGS_trajectory_time_resolution) {
+    time_grid.push_back(t);
+  }
+  DCHECK_EQ(path_time_intervals_.size(), time_grid.size());
+  LatticeTrajectory1dBundle lon_bundle;
   for (const auto& lon_trajectory : lon_trajectories) {
-    double lon_end_s = lon_trajectory->Evaluate(0, end_time);
+    lon_bundle.Add(*lon_trajectory);
+  }
+  lon_bundle.Sample(time_grid);
+  LatticeTrajectory1dBundle lat_bundle;
+  for (const auto& lat_trajectory : lat_trajectories) {
+    lat_bundle.Add(*lat_trajectory);
+  }
+
+  for (std::size_t i = 0; i < lon_trajectories.size(); ++i) {
+    const auto& lon_trajectory = lon_trajectories[i];
+    double lon_end_s = lon_bundle.Evaluate(i, 0, end_time);
     if (init_s[0] < stop_point &&
         lon_end_s + FLAGS_lattice_stop_buffer > stop_point) {
       continue;
     }
 
-    if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
+    if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(lon_bundle, i)) {
       continue;
     }
-    for (const auto& lat_trajectory : lat_trajectories) {
+    const LonCosts lon_costs = EvaluateLon(planning_target, lon_bundle, i);
+    for (std::size_t j = 0; j < lat_trajectories.size(); ++j) {
+      const auto& lat_trajectory = lat_trajectories[j];
       /**
        * The validity of the code needs to be verified.
       if (!ConstraintChecker1d::IsValidLateralTrajectory(*lat_trajectory,
@@ -89,12 +111,12 @@ TrajectoryEvaluator::TrajectoryEvaluator(
       }
       */
       if (!FLAGS_enable_auto_tuning) {
-        double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory);
+        double cost = Evaluate(lon_costs, lon_bundle, i, lat_bundle, j);
         cost_queue_.emplace(Trajectory1dPair(lon_trajectory, lat_trajectory),
                             cost);
       } else {
         std::vector<double> cost_components;
-        double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory,
+        double cost = Evaluate(lon_costs, lon_bundle, i, lat_bundle, j,
                                &cost_components);
         cost_queue_with_components_.emplace(
             Trajectory1dPair(lon_trajectory, lat_trajectory),
@@ -154,11 +176,29 @@ std::vector<double> TrajectoryEvaluator::top_trajectory_pair_component_cost()
   return cost_queue_with_components_.top().second.first;
 }
 
-double TrajectoryEvaluator::Evaluate(
+TrajectoryEvaluator::LonCosts TrajectoryEvaluator::EvaluateLon(
     const PlanningTarget& planning_target,
-    const PtrTrajectory1d& lon_trajectory,
-    const PtrTrajectory1d& lat_trajectory,
-    std::vector<double>* cost_components) const {
+    const LatticeTrajectory1dBundle& lon_bundle,
+    const std::size_t lon_index) const {
+  LonCosts lon_costs;
+  lon_costs.objective = LonObjectiveCost(lon_bundle, lon_index,
+                                         planning_target, reference_s_dot_);
+  lon_costs.jerk = LonComfortCost(lon_bundle, lon_index);
+  lon_costs.collision = LonCollisionCost(lon_bundle, lon_index);
+  lon_costs.centripetal_acceleration =
+      CentripetalAccelerationCost(lon_bundle, lon_index);
+
+  // decides the longitudinal evaluation horizon for lateral trajectories.
+  lon_costs.evaluation_horizon = std::min(
+      FLAGS_decision_horizon,
+      lon_bundle.Evaluate(lon_index, 0, lon_bundle.ParamLength(lon_index)));
+  return lon_costs;
+}
+
+double TrajectoryEvaluator::Evaluate(
+    const LonCosts& lon_costs, const LatticeTrajectory1dBundle& lon_bundle,
+    const std::size_t lon_index, const LatticeTrajectory1dBundle& lat_bundle,
+    const std::size_t lat_index, std::vector<double>* cost_components) const {
   // Costs:
   // 1. Cost of missing the objective, e.g., cruise, stop, etc.
   // 2. Cost of logitudinal jerk
@@ -166,42 +206,30 @@ double TrajectoryEvaluator::Evaluate(
   // 4. Cost of lateral offsets
   // 5. Cost of lateral comfort
 
-  // Longitudinal costs
-  double lon_objective_cost =
-      LonObjectiveCost(lon_trajectory, planning_target, reference_s_dot_);
-
-  double lon_jerk_cost = LonComfortCost(lon_trajectory);
-
-  double lon_collision_cost = LonCollisionCost(lon_trajectory);
-
-  double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
-
-  // decides the longitudinal evaluation horizon for lateral trajectories.
-  double evaluation_horizon =
-      std::min(FLAGS_decision_horizon,
-               lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
   std::vector<double> s_values;
-  for (double s = 0.0; s < evaluation_horizon;
+  for (double s = 0.0; s < lon_costs.evaluation_horizon;
        s += FLAGS_trajectory_space_resolution) {
     s_values.emplace_back(s);
   }
 
   // Lateral costs
-  double lat_offset_cost = LatOffsetCost(lat_trajectory, s_values);
+  double lat_offset_cost = LatOffsetCost(lat_bundle, lat_index, s_values);
 
-  double lat_comfort_cost = LatComfortCost(lon_trajectory, lat_trajectory);
+  double lat_comfort_cost =
+      LatComfortCost(lon_bundle, lon_index, lat_bundle, lat_index);
 
   if (cost_components != nullptr) {
-    cost_components->emplace_back(lon_objective_cost);
-    cost_components->emplace_back(lon_jerk_cost);
-    cost_components->emplace_back(lon_collision_cost);
+    cost_components->emplace_back(lon_costs.objective);
+    cost_components->emplace_back(lon_costs.jerk);
+    cost_components->emplace_back(lon_costs.collision);
     cost_components->emplace_back(lat_offset_cost);
   }
 
-  return lon_objective_cost * FLAGS_weight_lon_objective +
-         lon_jerk_cost * FLAGS_weight_lon_jerk +
-         lon_collision_cost * FLAGS_weight_lon_collision +
-         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration +
+  return lon_costs.objective * FLAGS_weight_lon_objective +
+         lon_costs.jerk * FLAGS_weight_lon_jerk +
+         lon_costs.collision * FLAGS_weight_lon_collision +
+         lon_costs.centripetal_acceleration *
+             FLAGS_weight_centripetal_acceleration +
          lat_offset_cost * FLAGS_weight_lat_offset +
          lat_comfort_cost * FLAGS_weight_lat_comfort;
 }
@@ -237,13 +265,13 @@ double TrajectoryEvaluator::EvaluateDiscreteTrajectory(
 }
 
 double TrajectoryEvaluator::LatOffsetCost(
-    const PtrTrajectory1d& lat_trajectory,
+    const LatticeTrajectory1dBundle& lat_bundle, const std::size_t lat_index,
     const std::vector<double>& s_values) const {
-  double lat_offset_start = lat_trajectory->Evaluate(0, 0.0);
+  double lat_offset_start = lat_bundle.Evaluate(lat_index, 0, 0.0);
   double cost_sqr_sum = 0.0;
   double cost_abs_sum = 0.0;
   for (const auto& s : s_values) {
-    double lat_offset = lat_trajectory->Evaluate(0, s);
+    double lat_offset = lat_bundle.Evaluate(lat_index, 0, s);
     double cost = lat_offset / FLAGS_lat_offset_bound;
     if (lat_offset * lat_offset_start < 0.0) {
       cost_sqr_sum += cost * cost * FLAGS_weight_opposite_side_offset;
@@ -279,16 +307,19 @@ double TrajectoryEvaluator::LatOffsetCost(
 }
 
 double TrajectoryEvaluator::LatComfortCost(
-    const PtrTrajectory1d& lon_trajectory,
-    const PtrTrajectory1d& lat_trajectory) const {
+    const LatticeTrajectory1dBundle& lon_bundle, const std::size_t lon_index,
+    const LatticeTrajectory1dBundle& lat_bundle,
+    const std::size_t lat_index) const {
+  const std::vector<double>& time_grid = lon_bundle.sampled_params();
   double max_cost = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double s_dot = lon_trajectory->Evaluate(1, t);
-    double s_dotdot = lon_trajectory->Evaluate(2, t);
-    double l_prime = lat_trajectory->Evaluate(1, s);
-    double l_primeprime = lat_trajectory->Evaluate(2, s);
+  for (std::size_t i = 0;
+       i < time_grid.size() && time_grid[i] < FLAGS_trajectory_time_length;
+       ++i) {
+    double s = lon_bundle.Sampled(0, lon_index, i);
+    double s_dot = lon_bundle.Sampled(1, lon_index, i);
+    double s_dotdot = lon_bundle.Sampled(2, lon_index, i);
+    double l_prime = lat_bundle.Evaluate(lat_index, 1, s);
+    double l_primeprime = lat_bundle.Evaluate(lat_index, 2, s);
     double cost = l_primeprime * s_dot * s_dot + l_prime * s_dotdot;
     max_cost = std::max(max_cost, std::fabs(cost));
   }
@@ -316,12 +347,15 @@ double TrajectoryEvaluator::LatComfortCost(
 }
 
 double TrajectoryEvaluator::LonComfortCost(
-    const PtrTrajectory1d& lon_trajectory) const {
+    const LatticeTrajectory1dBundle& lon_bundle,
+    const std::size_t lon_index) const {
+  const std::vector<double>& time_grid = lon_bundle.sampled_params();
   double cost_sqr_sum = 0.0;
   double cost_abs_sum = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double jerk = lon_trajectory->Evaluate(3, t);
+  for (std::size_t i = 0;
+       i < time_grid.size() && time_grid[i] < FLAGS_trajectory_time_length;
+       ++i) {
+    double jerk = lon_bundle.Sampled(3, lon_index, i);
     double cost = jerk / FLAGS_longitudinal_jerk_upper_bound;
     cost_sqr_sum += cost * cost;
     cost_abs_sum += std::fabs(cost);
@@ -353,18 +387,20 @@ double TrajectoryEvaluator::LonComfortCost(
 }
 
 double TrajectoryEvaluator::LonObjectiveCost(
-    const PtrTrajectory1d& lon_trajectory,
+    const LatticeTrajectory1dBundle& lon_bundle, const std::size_t lon_index,
     const PlanningTarget& planning_target,
     const std::vector<double>& ref_s_dots) const {
-  double t_max = lon_trajectory->ParamLength();
-  double dist_s =
-      lon_trajectory->Evaluate(0, t_max) - lon_trajectory->Evaluate(0, 0.0);
+  double t_max = lon_bundle.ParamLength(lon_index);
+  double dist_s = lon_bundle.Evaluate(lon_index, 0, t_max) -
+                  lon_bundle.Evaluate(lon_index, 0, 0.0);
 
+  // the reference speeds are sampled on a prefix of the time grid
+  DCHECK_LE(ref_s_dots.size(), lon_bundle.num_samples());
   double speed_cost_sqr_sum = 0.0;
   double speed_cost_weight_sum = 0.0;
   for (std::size_t i = 0; i < ref_s_dots.size(); ++i) {
     double t = i * FLAGS_trajectory_time_resolution;
-    double cost = ref_s_dots[i] - lon_trajectory->Evaluate(1, t);
+    double cost = ref_s_dots[i] - lon_bundle.Sampled(1, lon_index, i);
     speed_cost_sqr_sum += t * t * std::fabs(cost);
     speed_cost_weight_sum += t * t;
   }
@@ -413,7 +449,8 @@ double TrajectoryEvaluator::LonObjectiveCost(
 // TODO(all): consider putting pointer of reference_line_info and frame
 // while constructing trajectory evaluator
 double TrajectoryEvaluator::LonCollisionCost(
-    const PtrTrajectory1d& lon_trajectory) const {
+    const LatticeTrajectory1dBundle& lon_bundle,
+    const std::size_t lon_index) const {
   double cost_sqr_sum = 0.0;
   double cost_abs_sum = 0.0;
   for (std::size_t i = 0; i < path_time_intervals_.size(); ++i) {
@@ -421,8 +458,7 @@ double TrajectoryEvaluator::LonCollisionCost(
     if (pt_interval.empty()) {
       continue;
     }
-    double t = i * FLAGS_trajectory_time_resolution;
-    double traj_s = lon_trajectory->Evaluate(0, t);
+    double traj_s = lon_bundle.Sampled(0, lon_index, i);
     double sigma = FLAGS_lon_collision_cost_std;
     for (const auto& m : pt_interval) {
       double dist = 0.0;
@@ -476,15 +512,18 @@ double TrajectoryEvaluator::LonCollisionCost(
 }
 
 double TrajectoryEvaluator::CentripetalAccelerationCost(
-    const PtrTrajectory1d& lon_trajectory) const {
+    const LatticeTrajectory1dBundle& lon_bundle,
+    const std::size_t lon_index) const {
+  const std::vector<double>& time_grid = lon_bundle.sampled_params();
 
   // Assumes the vehicle is not obviously deviate from the reference line.
   double centripetal_acc_sum = 0.0;
   double centripetal_acc_sqr_sum = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double v = lon_trajectory->Evaluate(1, t);
+  for (std::size_t i = 0;
+       i < time_grid.size() && time_grid[i] < FLAGS_trajectory_time_length;
+       ++i) {
+    double s = lon_bundle.Sampled(0, lon_index, i);
+    double v = lon_bundle.Sampled(1, lon_index, i);
     PathPoint ref_point = PathMatcher::MatchToPath(*reference_line_, s);
     CHECK(ref_point.has_kappa());
     double centripetal_acc = v * v * ref_point.kappa();
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "modules/planning/lattice/behavior/path_time_graph.h"
+#include "modules/planning/lattice/trajectory1d/lattice_trajectory1d_bundle.h"
 #include "modules/planning/math/curve1d/curve1d.h"
 #include "modules/planning/proto/lattice_structure.pb.h"
 #include "modules/planning/proto/planning_config.pb.h"
@@ -77,34 +78,56 @@ class TrajectoryEvaluator {
       std::vector<double>* cost_components);
 
  private:
-  double Evaluate(const PlanningTarget& planning_target,
-                  const std::shared_ptr<Curve1d>& lon_trajectory,
-                  const std::shared_ptr<Curve1d>& lat_trajectory,
+  // costs of a longitudinal candidate, shared by all of its pairs
+  struct LonCosts {
+    double objective = 0.0;
+    double jerk = 0.0;
+    double collision = 0.0;
+    double centripetal_acceleration = 0.0;
+    // longitudinal evaluation horizon for the lateral trajectories
+    double evaluation_horizon = 0.0;
+  };
+
+  LonCosts EvaluateLon(const PlanningTarget& planning_target,
+                       const LatticeTrajectory1dBundle& lon_bundle,
+                       const std::size_t lon_index) const;
+
+  double Evaluate(const LonCosts& lon_costs,
+                  const LatticeTrajectory1dBundle& lon_bundle,
+                  const std::size_t lon_index,
+                  const LatticeTrajectory1dBundle& lat_bundle,
+                  const std::size_t lat_index,
                   std::vector<double>* cost_components = nullptr) const;
 
-  double LatOffsetCost(const std::shared_ptr<Curve1d>& lat_trajectory,
+  double LatOffsetCost(const LatticeTrajectory1dBundle& lat_bundle,
+                       const std::size_t lat_index,
                        const std::vector<double>& s_values) const;
 
   double LatOffsetCost(
       const std::vector<apollo::common::FrenetFramePoint> sl_points) const;
 
-  double LatComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory,
-                        const std::shared_ptr<Curve1d>& lat_trajectory) const;
+  double LatComfortCost(const LatticeTrajectory1dBundle& lon_bundle,
+                        const std::size_t lon_index,
+                        const LatticeTrajectory1dBundle& lat_bundle,
+                        const std::size_t lat_index) const;
 
   double LatComfortCost(
       const std::vector<apollo::common::FrenetFramePoint>& sl_points) const;
 
-  double LonComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory) const;
+  double LonComfortCost(const LatticeTrajectory1dBundle& lon_bundle,
+                        const std::size_t lon_index) const;
 
   double LonComfortCost(
       const std::vector<apollo::common::SpeedPoint>& st_points) const;
 
-  double LonCollisionCost(const std::shared_ptr<Curve1d>& lon_trajectory) const;
+  double LonCollisionCost(const LatticeTrajectory1dBundle& lon_bundle,
+                          const std::size_t lon_index) const;
 
   double LonCollisionCost(
       const std::vector<apollo::common::SpeedPoint>& st_points) const;
 
-  double LonObjectiveCost(const std::shared_ptr<Curve1d>& lon_trajectory,
+  double LonObjectiveCost(const LatticeTrajectory1dBundle& lon_bundle,
+                          const std::size_t lon_index,
                           const PlanningTarget& planning_target,
                           const std::vector<double>& ref_s_dot) const;
 
@@ -114,7 +137,8 @@ class TrajectoryEvaluator {
       const std::vector<double>& ref_s_dots) const;
 
   double CentripetalAccelerationCost(
-      const std::shared_ptr<Curve1d>& lon_trajectory) const;
+      const LatticeTrajectory1dBundle& lon_bundle,
+      const std::size_t lon_index) const;
 
   double CentripetalAccelerationCost(
       const std::vector<apollo::common::SpeedPoint>& st_points) const;
@@ -63,6 +63,11 @@ double CubicPolynomialCurve1d::Evaluate(const std::uint32_t order,
   }
 }
 
+double CubicPolynomialCurve1d::Coef(const std::size_t order) const {
+  CHECK_LT(order, coef_.size());
+  return coef_[order];
+}
+
 std::string CubicPolynomialCurve1d::ToString() const {
   return apollo::common::util::StrCat(
       apollo::common::util::PrintIter(coef_, "\t"), param_, "\n");
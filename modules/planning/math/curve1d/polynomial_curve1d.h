@@ -21,6 +21,8 @@
 #ifndef MODULES_PLANNING_MATH_CURVE1D_POLYNOMIAL_CURVE1D_H_
 #define MODULES_PLANNING_MATH_CURVE1D_POLYNOMIAL_CURVE1D_H_
 
+#include <cstddef>
+
 #include "modules/planning/math/curve1d/curve1d.h"
 
 namespace apollo {
@@ -31,6 +33,10 @@ class PolynomialCurve1d : public Curve1d {
   PolynomialCurve1d() = default;
   virtual ~PolynomialCurve1d() = default;
 
+  // coefficient of x^order, f = sum(Coef(i) * x^i), i from 0 to Order()
+  virtual double Coef(const std::size_t order) const = 0;
+  virtual std::size_t Order() const = 0;
+
  protected:
   double param_ = 0.0;
 };
@@ -96,6 +96,11 @@ void QuarticPolynomialCurve1d::ComputeCoefficients(
   coef_[4] = (-2 * b0 + b1 * p) / (4 * p3);
 }
 
+double QuarticPolynomialCurve1d::Coef(const std::size_t order) const {
+  CHECK_LT(order, coef_.size());
+  return coef_[order];
+}
+
 std::string QuarticPolynomialCurve1d::ToString() const {
   return apollo::common::util::StrCat(
       apollo::common::util::PrintIter(coef_, "\t"), param_, "\n");
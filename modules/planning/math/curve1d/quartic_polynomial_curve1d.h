@@ -49,6 +49,9 @@ class QuarticPolynomialCurve1d : public PolynomialCurve1d {
   double Evaluate(const std::uint32_t order, const double p) const override;
 
   double ParamLength() const override { return param_; }
+
+  double Coef(const std::size_t order) const override;
+  std::size_t Order() const override { return 4; }
   std::string ToString() const override;
 
  private:
@@ -109,6 +109,11 @@ void QuinticPolynomialCurve1d::ComputeCoefficients(
   coef_[5] = (6.0 * c0 - 3.0 * c1 + 0.5 * c2) / p2;
 }
 
+double QuinticPolynomialCurve1d::Coef(const std::size_t order) const {
+  CHECK_LT(order, coef_.size());
+  return coef_[order];
+}
+
 std::string QuinticPolynomialCurve1d::ToString() const {
   return apollo::common::util::StrCat(
       apollo::common::util::PrintIter(coef_, "\t"), param_, "\n");
@@ -50,6 +50,9 @@ class QuinticPolynomialCurve1d : public PolynomialCurve1d {
   double Evaluate(const std::uint32_t order, const double p) const override;
 
   double ParamLength() const { return param_; }
+
+  double Coef(const std::size_t order) const override;
+  std::size_t Order() const override { return 5; }
   std::string ToString() const override;
 
  protected:
@@ -84,6 +84,23 @@ bool Spline1dGenerator::Solve() {
     return false;
   }
 
+  if (FLAGS_enable_admm_spline_qp_solver) {
+    const double start_timestamp = Clock::NowInSeconds();
+    const bool success = admm_solver_.Solve(
+        kernel_matrix, offset, inequality_constraint_matrix,
+        inequality_constraint_boundary, equality_constraint_matrix,
+        equality_constraint_boundary, kMaxBound, kMaxBound);
+    ADEBUG << "Spline1dGenerator ADMM solve time: "
+           << (Clock::NowInSeconds() - start_timestamp) * 1000 << " ms, "
+           << admm_solver_.num_iterations() << " iterations.";
+    if (!success) {
+      AERROR << "ADMM solver failed to solve spline 1d.";
+      return false;
+    }
+    return spline_.SetSplineSegs(MatrixXd(admm_solver_.params()),
+                                 spline_.spline_order());
+  }
+
   int num_param = kernel_matrix.rows();
   int num_constraint =
       equality_constraint_matrix.rows() + inequality_constraint_matrix.rows();
@@ -53,6 +53,7 @@
 #include <memory>
 #include <vector>
 
+#include "modules/common/math/qp_solver/admm_qp_solver.h"
 #include "modules/common/math/qp_solver/qp_solver.h"
 #include "modules/planning/math/smoothing_spline/spline_1d.h"
 #include "modules/planning/math/smoothing_spline/spline_1d_constraint.h"
@@ -85,6 +86,8 @@ class Spline1dGenerator {
   Spline1dKernel spline_kernel_;
 
   std::unique_ptr<::qpOASES::SQProblem> sqp_solver_;
+  // kept across solves for its warm start and cached factorization
+  apollo::common::math::AdmmQpSolver admm_solver_;
 
   int last_num_constraint_ = 0;
   int last_num_param_ = 0;
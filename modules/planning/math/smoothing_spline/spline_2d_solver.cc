@@ -81,6 +81,23 @@ bool Spline2dSolver::Solve() {
     return false;
   }
 
+  if (FLAGS_enable_admm_spline_qp_solver) {
+    const double start_timestamp = Clock::NowInSeconds();
+    const bool success = admm_solver_.Solve(
+        kernel_matrix, offset, inequality_constraint_matrix,
+        inequality_constraint_boundary, equality_constraint_matrix,
+        equality_constraint_boundary, kRoadBound, kRoadBound);
+    ADEBUG << "Spline2dSolver ADMM solve time: "
+           << (Clock::NowInSeconds() - start_timestamp) * 1000 << " ms, "
+           << admm_solver_.num_iterations() << " iterations.";
+    if (!success) {
+      AERROR << "ADMM solver failed to solve spline 2d.";
+      return false;
+    }
+    return spline_.set_splines(MatrixXd(admm_solver_.params()),
+                               spline_.spline_order());
+  }
+
   int num_param = kernel_matrix.rows();
   int num_constraint =
       equality_constraint_matrix.rows() + inequality_constraint_matrix.rows();
@@ -26,6 +26,7 @@
 #include <memory>
 #include <vector>
 
+#include "modules/common/math/qp_solver/admm_qp_solver.h"
 #include "modules/common/math/qp_solver/qp_solver.h"
 #include "modules/planning/math/smoothing_spline/spline_2d.h"
 #include "modules/planning/math/smoothing_spline/spline_2d_constraint.h"
@@ -56,6 +57,8 @@ class Spline2dSolver {
   Spline2dKernel kernel_;
   Spline2dConstraint constraint_;
   std::unique_ptr<::qpOASES::SQProblem> sqp_solver_;
+  // kept across solves for its warm start and cached factorization
+  apollo::common::math::AdmmQpSolver admm_solver_;
 
   int last_num_constraint_ = 0;
   int last_num_param_ = 0;
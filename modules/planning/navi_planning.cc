@@ -275,9 +275,11 @@ void NaviPlanning::GetRightNeighborLanesInfo(
 }
 
 Status NaviPlanning::Start() {
-  timer_ =
-      AdapterManager::CreateTimer(ros::Duration(1.0 / FLAGS_planning_loop_rate),
-                                  &NaviPlanning::OnTimer, this);
+  if (!use_stepped_clock_) {
+    timer_ = AdapterManager::CreateTimer(
+        ros::Duration(1.0 / FLAGS_planning_loop_rate), &NaviPlanning::OnTimer,
+        this);
+  }
 
   start_time_ = Clock::NowInSeconds();
   AINFO << "Planning started";
@@ -21,6 +21,8 @@
 #include "modules/planning/planner/lattice/lattice_planner.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -32,6 +34,7 @@
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/common/time/time.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/constraint_checker/collision_checker.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
@@ -54,6 +57,7 @@ using apollo::common::adapter::AdapterManager;
 using apollo::common::math::PathMatcher;
 using apollo::common::math::CartesianFrenetConverter;
 using apollo::common::time::Clock;
+using apollo::common::util::TaskGroup;
 
 namespace {
 
@@ -97,29 +101,54 @@ void ComputeInitFrenetState(const PathPoint& matched_point,
 
 Status LatticePlanner::Plan(const TrajectoryPoint& planning_start_point,
                             Frame* frame) {
-  std::size_t success_line_count = 0;
-  std::size_t index = 0;
+  std::vector<ReferenceLineInfo*> reference_line_infos;
   for (auto& reference_line_info : frame->reference_line_info()) {
-    if (index != 0) {
+    if (reference_line_infos.empty()) {
+      reference_line_info.SetPriorityCost(0.0);
+    } else {
       reference_line_info.SetPriorityCost(
           FLAGS_cost_non_priority_reference_line);
-    } else {
-      reference_line_info.SetPriorityCost(0.0);
     }
-    auto status =
-        PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
+    reference_line_infos.push_back(&reference_line_info);
+  }
+
+  std::vector<Status> statuses(reference_line_infos.size());
+  if (FLAGS_enable_parallel_reference_line_planning &&
+      reference_line_infos.size() > 1) {
+    // the reference lines share the frame read-only, each is planned in the
+    // planning thread pool and the results are kept in the reference line
+    // order.
+    TaskGroup group;
+    for (std::size_t i = 1; i < reference_line_infos.size(); ++i) {
+      group.Run([this, &planning_start_point, frame, &reference_line_infos,
+                 &statuses, i]() {
+        statuses[i] = PlanOnReferenceLine(planning_start_point, frame,
+                                          reference_line_infos[i]);
+      });
+    }
+    statuses.front() = PlanOnReferenceLine(planning_start_point, frame,
+                                           reference_line_infos.front());
+    group.Wait();
+  } else {
+    for (std::size_t i = 0; i < reference_line_infos.size(); ++i) {
+      statuses[i] = PlanOnReferenceLine(planning_start_point, frame,
+                                        reference_line_infos[i]);
+    }
+  }
 
-    if (status != Status::OK()) {
-      if (reference_line_info.IsChangeLanePath()) {
+  std::size_t success_line_count = 0;
+  for (std::size_t i = 0; i < reference_line_infos.size(); ++i) {
+    const auto* reference_line_info = reference_line_infos[i];
+    if (statuses[i] != Status::OK()) {
+      if (reference_line_info->IsChangeLanePath()) {
         AERROR << "Planner failed to change lane to "
-               << reference_line_info.Lanes().Id();
+               << reference_line_info->Lanes().Id();
       } else {
-        AERROR << "Planner failed to " << reference_line_info.Lanes().Id();
+        AERROR << "Planner failed to " << reference_line_info->Lanes().Id();
       }
     } else {
       success_line_count += 1;
     }
-    ++index;
   }
 
   if (success_line_count > 0) {
@@ -132,8 +161,8 @@ Status LatticePlanner::Plan(const TrajectoryPoint& planning_start_point,
 Status LatticePlanner::PlanOnReferenceLine(
     const TrajectoryPoint& planning_init_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
-  static std::size_t num_planning_cycles = 0;
-  static std::size_t num_planning_succeeded_cycles = 0;
+  static std::atomic<std::size_t> num_planning_cycles(0);
+  static std::atomic<std::size_t> num_planning_succeeded_cycles(0);
 
   double start_time = Clock::NowInSeconds();
   double current_time = start_time;
@@ -0,0 +1,312 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/planner/open_space/hybrid_a_star.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "modules/common/log.h"
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace planning {
+namespace {
+
+using apollo::common::math::AngleDiff;
+using apollo::common::math::NormalizeAngle;
+using apollo::common::math::Vec2d;
+
+struct Node {
+  HybridAStar::Pose pose;
+  double cost = 0.0;
+  std::size_t parent = 0;
+};
+
+}  // namespace
+
+HybridAStar::HybridAStar(const HybridAStarConfig& config,
+                         const ObstacleDistanceGrid& distance_grid,
+                         const common::VehicleParam& vehicle_param)
+    : config_(config),
+      distance_grid_(distance_grid),
+      wheel_base_(vehicle_param.wheel_base()),
+      max_steer_(vehicle_param.max_steer_angle() /
+                 vehicle_param.steer_ratio()) {
+  CHECK_GT(config_.xy_grid_resolution(), 0.0);
+  CHECK_GT(config_.phi_grid_resolution(), 0.0);
+  CHECK_GT(config_.step_size(), 0.0);
+  CHECK_GT(config_.num_steer_samples(), 1);
+  half_length_ = (vehicle_param.front_edge_to_center() +
+                  vehicle_param.back_edge_to_center()) /
+                 2.0;
+  half_width_ = (vehicle_param.left_edge_to_center() +
+                 vehicle_param.right_edge_to_center()) /
+                2.0;
+  CHECK_GT(half_length_, 0.0);
+  CHECK_GT(half_width_, 0.0);
+  center_offset_ = (vehicle_param.front_edge_to_center() -
+                    vehicle_param.back_edge_to_center()) /
+                   2.0;
+}
+
+bool HybridAStar::IsBoxCollisionFree(const Vec2d& center,
+                                     const Vec2d& heading,
+                                     const double half_length,
+                                     const double half_width) const {
+  const double radius = std::hypot(half_length, half_width);
+  if (distance_grid_.DistanceTo(center) > radius) {
+    return true;
+  }
+  // below the grid resolution an obstacle close to the part is taken as a
+  // collision.
+  if (radius <= 0.5 * distance_grid_.resolution()) {
+    return false;
+  }
+  if (half_length >= half_width) {
+    const Vec2d offset = heading * (half_length / 2.0);
+    return IsBoxCollisionFree(center - offset, heading, half_length / 2.0,
+                              half_width) &&
+           IsBoxCollisionFree(center + offset, heading, half_length / 2.0,
+                              half_width);
+  }
+  const Vec2d offset = Vec2d(-heading.y(), heading.x()) * (half_width / 2.0);
+  return IsBoxCollisionFree(center - offset, heading, half_length,
+                            half_width / 2.0) &&
+         IsBoxCollisionFree(center + offset, heading, half_length,
+                            half_width / 2.0);
+}
+
+bool HybridAStar::IsCollisionFree(const double x, const double y,
+                                  const double phi) const {
+  const Vec2d heading(std::cos(phi), std::sin(phi));
+  return IsBoxCollisionFree(Vec2d(x, y) + heading * center_offset_, heading,
+                            half_length_, half_width_);
+}
+
+bool HybridAStar::Plan(const Eigen::MatrixXd& x0, const Eigen::MatrixXd& xF,
+                       const Eigen::MatrixXd& XYbounds,
+                       std::vector<Pose>* path) const {
+  CHECK_NOTNULL(path);
+  path->clear();
+  // only the reference point is bounded, as in the distance approach problem
+  auto in_bounds = [&XYbounds](const double x, const double y) {
+    return x >= XYbounds(0, 0) && x <= XYbounds(1, 0) &&
+           y >= XYbounds(2, 0) && y <= XYbounds(3, 0);
+  };
+  if (!in_bounds(x0(0, 0), x0(1, 0)) ||
+      !IsCollisionFree(x0(0, 0), x0(1, 0), x0(2, 0))) {
+    AERROR << "The start pose of the open space search is out of bounds or "
+              "in collision.";
+    return false;
+  }
+  if (!in_bounds(xF(0, 0), xF(1, 0)) ||
+      !IsCollisionFree(xF(0, 0), xF(1, 0), xF(2, 0))) {
+    AERROR << "The end pose of the open space search is out of bounds or in "
+              "collision.";
+    return false;
+  }
+
+  const double xy_resolution = config_.xy_grid_resolution();
+  const double phi_resolution = config_.phi_grid_resolution();
+  const double step_size = config_.step_size();
+  const std::size_t num_steer_samples = config_.num_steer_samples();
+  const std::uint64_t num_x = static_cast<std::uint64_t>(
+      std::ceil((distance_grid_.x_max() - distance_grid_.x_min()) /
+                xy_resolution));
+  const std::uint64_t num_phi =
+      static_cast<std::uint64_t>(std::ceil(2.0 * M_PI / phi_resolution));
+  auto key = [&](const Pose& pose) {
+    const auto ix = static_cast<std::uint64_t>(
+        (pose.x - distance_grid_.x_min()) / xy_resolution);
+    const auto iy = static_cast<std::uint64_t>(
+        (pose.y - distance_grid_.y_min()) / xy_resolution);
+    const auto iphi = std::min(
+        num_phi - 1, static_cast<std::uint64_t>(
+                         (NormalizeAngle(pose.phi) + M_PI) / phi_resolution));
+    return (iy * num_x + ix) * num_phi + iphi;
+  };
+  const Vec2d goal(xF(0, 0), xF(1, 0));
+  auto heuristic = [&](const Pose& pose) {
+    return config_.heuristic_weight() * goal.DistanceTo(Vec2d(pose.x, pose.y));
+  };
+
+  std::vector<Node> nodes;
+  nodes.emplace_back();
+  nodes.back().pose.x = x0(0, 0);
+  nodes.back().pose.y = x0(1, 0);
+  nodes.back().pose.phi = x0(2, 0);
+
+  typedef std::pair<double, std::size_t> QueueItem;
+  std::priority_queue<QueueItem, std::vector<QueueItem>,
+                      std::greater<QueueItem>>
+      open_set;
+  std::unordered_map<std::uint64_t, double> best_cost;
+  std::unordered_set<std::uint64_t> closed_set;
+  open_set.emplace(heuristic(nodes[0].pose), 0);
+  best_cost[key(nodes[0].pose)] = 0.0;
+
+  const std::size_t num_sub_steps = static_cast<std::size_t>(
+      std::ceil(step_size / distance_grid_.resolution()));
+  const double sub_step = step_size / static_cast<double>(num_sub_steps);
+
+  while (!open_set.empty() && nodes.size() < config_.max_num_nodes()) {
+    const std::size_t current = open_set.top().second;
+    open_set.pop();
+    // copied, the expansion below reallocates the nodes
+    const Node node = nodes[current];
+    if (!closed_set.insert(key(node.pose)).second) {
+      continue;
+    }
+
+    if (goal.DistanceTo(Vec2d(node.pose.x, node.pose.y)) <=
+            config_.goal_xy_tolerance() &&
+        std::fabs(AngleDiff(node.pose.phi, xF(2, 0))) <=
+            config_.goal_phi_tolerance()) {
+      for (std::size_t i = current; i != 0; i = nodes[i].parent) {
+        path->push_back(nodes[i].pose);
+      }
+      path->push_back(nodes[0].pose);
+      std::reverse(path->begin(), path->end());
+      Pose end = path->back();
+      end.x = xF(0, 0);
+      end.y = xF(1, 0);
+      end.phi = xF(2, 0);
+      path->push_back(end);
+      ADEBUG << "Hybrid A* reached the goal after expanding " << nodes.size()
+             << " nodes.";
+      return true;
+    }
+
+    for (std::size_t i = 0; i < 2 * num_steer_samples; ++i) {
+      Pose next = node.pose;
+      next.forward = i < num_steer_samples;
+      next.steer = -max_steer_ +
+                   2.0 * max_steer_ *
+                       static_cast<double>(i % num_steer_samples) /
+                       static_cast<double>(num_steer_samples - 1);
+      const double ds = next.forward ? sub_step : -sub_step;
+      const double dphi = ds * std::tan(next.steer) / wheel_base_;
+      bool collision_free = true;
+      for (std::size_t k = 0; k < num_sub_steps && collision_free; ++k) {
+        next.x += ds * std::cos(next.phi);
+        next.y += ds * std::sin(next.phi);
+        next.phi = NormalizeAngle(next.phi + dphi);
+        collision_free = in_bounds(next.x, next.y) &&
+                         IsCollisionFree(next.x, next.y, next.phi);
+      }
+      if (!collision_free) {
+        continue;
+      }
+      const std::uint64_t next_key = key(next);
+      if (closed_set.count(next_key) > 0) {
+        continue;
+      }
+      double cost =
+          node.cost +
+          step_size * (next.forward ? 1.0 : config_.backward_penalty()) +
+          config_.steer_penalty() * std::fabs(next.steer) +
+          config_.steer_change_penalty() *
+              std::fabs(next.steer - node.pose.steer);
+      if (current != 0 && next.forward != node.pose.forward) {
+        cost += config_.direction_switch_penalty();
+      }
+      auto it = best_cost.find(next_key);
+      if (it != best_cost.end() && it->second <= cost) {
+        continue;
+      }
+      best_cost[next_key] = cost;
+      nodes.emplace_back();
+      nodes.back().pose = next;
+      nodes.back().cost = cost;
+      nodes.back().parent = current;
+      open_set.emplace(cost + heuristic(next), nodes.size() - 1);
+    }
+  }
+  AERROR << "Hybrid A* failed after expanding " << nodes.size() << " nodes.";
+  return false;
+}
+
+void HybridAStar::GetWarmStart(const std::vector<Pose>& path,
+                               const Eigen::MatrixXd& x0,
+                               const Eigen::MatrixXd& xF,
+                               const std::size_t horizon, const float ts,
+                               Eigen::MatrixXd* xWS, Eigen::MatrixXd* uWS,
+                               Eigen::MatrixXd* timeWS) const {
+  CHECK_NOTNULL(xWS);
+  CHECK_NOTNULL(uWS);
+  CHECK_NOTNULL(timeWS);
+  CHECK_GT(horizon, 0);
+  CHECK(!path.empty());
+  *xWS = Eigen::MatrixXd::Zero(4, horizon + 1);
+  *uWS = Eigen::MatrixXd::Zero(2, horizon);
+  *timeWS = Eigen::MatrixXd::Ones(1, horizon + 1);
+
+  std::vector<double> accumulated_s(1, 0.0);
+  for (std::size_t i = 1; i < path.size(); ++i) {
+    accumulated_s.push_back(accumulated_s.back() +
+                            std::hypot(path[i].x - path[i - 1].x,
+                                       path[i].y - path[i - 1].y));
+  }
+  const double length = accumulated_s.back();
+  const double speed =
+      length / (static_cast<double>(horizon) * static_cast<double>(ts));
+
+  std::size_t segment = 0;
+  for (std::size_t i = 0; i <= horizon; ++i) {
+    const double s =
+        length * static_cast<double>(i) / static_cast<double>(horizon);
+    while (segment + 2 < path.size() && accumulated_s[segment + 1] < s) {
+      ++segment;
+    }
+    if (path.size() == 1) {
+      xWS->col(i) << path[0].x, path[0].y, path[0].phi, 0.0;
+      continue;
+    }
+    const Pose& p0 = path[segment];
+    const Pose& p1 = path[segment + 1];
+    const double segment_length =
+        accumulated_s[segment + 1] - accumulated_s[segment];
+    const double r =
+        segment_length > 0.0 ? (s - accumulated_s[segment]) / segment_length
+                             : 0.0;
+    (*xWS)(0, i) = p0.x + r * (p1.x - p0.x);
+    (*xWS)(1, i) = p0.y + r * (p1.y - p0.y);
+    (*xWS)(2, i) = NormalizeAngle(p0.phi + r * AngleDiff(p0.phi, p1.phi));
+    (*xWS)(3, i) = p1.forward ? speed : -speed;
+    if (i < horizon) {
+      (*uWS)(0, i) = p1.steer;
+    }
+  }
+  xWS->col(0) = x0.col(0);
+  xWS->col(horizon) = xF.col(0);
+  for (std::size_t i = 0; i < horizon; ++i) {
+    (*uWS)(1, i) = ((*xWS)(3, i + 1) - (*xWS)(3, i)) / ts;
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
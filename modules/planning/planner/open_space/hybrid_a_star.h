@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#ifndef MODULES_PLANNING_PLANNER_OPEN_SPACE_HYBRID_A_STAR_H_
+#define MODULES_PLANNING_PLANNER_OPEN_SPACE_HYBRID_A_STAR_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "modules/common/configs/proto/vehicle_config.pb.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/planner/open_space/obstacle_distance_grid.h"
+#include "modules/planning/proto/planner_open_space_config.pb.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class HybridAStar
+ * @brief Kinematically feasible warm start of the open space planner.
+ *
+ * A* search over (x, y, heading) cells, expanded with forward and backward
+ * arcs of the bicycle model. Every sampled pose of an arc is checked against
+ * the obstacle distance grid, splitting the vehicle box until either its
+ * parts are clear of the obstacles or they reach the grid resolution.
+ */
+class HybridAStar {
+ public:
+  struct Pose {
+    double x = 0.0;
+    double y = 0.0;
+    double phi = 0.0;
+    // front wheel angle and direction of the arc reaching this pose
+    double steer = 0.0;
+    bool forward = true;
+  };
+
+  /**
+   * @param distance_grid has to cover the vehicle box at any pose whose
+   * reference point is within the bounds given to Plan().
+   */
+  HybridAStar(const HybridAStarConfig& config,
+              const ObstacleDistanceGrid& distance_grid,
+              const common::VehicleParam& vehicle_param);
+
+  /**
+   * @brief search a path between the states [x, y, phi, v] x0 and xF.
+   * @param XYbounds [x_lower, x_upper, y_lower, y_upper] of the reference
+   * point, as in the distance approach problem.
+   * @return false if the goal is not reached within the node budget.
+   */
+  bool Plan(const Eigen::MatrixXd& x0, const Eigen::MatrixXd& xF,
+            const Eigen::MatrixXd& XYbounds, std::vector<Pose>* path) const;
+
+  /**
+   * @brief resample the path onto the horizon of the distance approach
+   * problem, in its xWS, uWS and timeWS layout.
+   */
+  void GetWarmStart(const std::vector<Pose>& path, const Eigen::MatrixXd& x0,
+                    const Eigen::MatrixXd& xF, const std::size_t horizon,
+                    const float ts, Eigen::MatrixXd* xWS, Eigen::MatrixXd* uWS,
+                    Eigen::MatrixXd* timeWS) const;
+
+  bool IsCollisionFree(const double x, const double y,
+                       const double phi) const;
+
+ private:
+  bool IsBoxCollisionFree(const common::math::Vec2d& center,
+                          const common::math::Vec2d& heading,
+                          const double half_length,
+                          const double half_width) const;
+
+  const HybridAStarConfig config_;
+  const ObstacleDistanceGrid& distance_grid_;
+  double wheel_base_ = 0.0;
+  double max_steer_ = 0.0;
+
+  // the vehicle box, with its center as an offset along the heading from the
+  // reference point.
+  double center_offset_ = 0.0;
+  double half_length_ = 0.0;
+  double half_width_ = 0.0;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_PLANNER_OPEN_SPACE_HYBRID_A_STAR_H_
@@ -0,0 +1,168 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+
+#include "modules/planning/planner/open_space/hybrid_a_star.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Vec2d;
+
+class HybridAStarTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    vehicle_param_.set_front_edge_to_center(3.89);
+    vehicle_param_.set_back_edge_to_center(1.04);
+    vehicle_param_.set_left_edge_to_center(1.055);
+    vehicle_param_.set_right_edge_to_center(1.055);
+    vehicle_param_.set_wheel_base(2.8448);
+    vehicle_param_.set_max_steer_angle(8.20304748437);
+    vehicle_param_.set_steer_ratio(16.0);
+    XYbounds_.resize(4, 1);
+    XYbounds_ << -10.5, 10.5, -1.0, 10.5;
+  }
+
+ protected:
+  HybridAStarConfig config_;
+  common::VehicleParam vehicle_param_;
+  Eigen::MatrixXd XYbounds_;
+};
+
+TEST_F(HybridAStarTest, AroundWall) {
+  ObstacleDistanceGrid grid(-15.0, 15.0, -5.0, 15.0, 0.1);
+  const std::vector<Vec2d> wall = {Vec2d(-0.5, -5.0), Vec2d(-0.5, 8.0),
+                                   Vec2d(0.5, 8.0), Vec2d(0.5, -5.0),
+                                   Vec2d(-0.5, -5.0)};
+  grid.Build({wall});
+  HybridAStar hybrid_a_star(config_, grid, vehicle_param_);
+
+  Eigen::MatrixXd x0(4, 1);
+  x0 << -10.0, 2.0, 0.0, 0.0;
+  Eigen::MatrixXd xF(4, 1);
+  xF << 6.0, 2.0, 0.0, 0.0;
+  std::vector<HybridAStar::Pose> path;
+  ASSERT_TRUE(hybrid_a_star.Plan(x0, xF, XYbounds_, &path));
+  ASSERT_GE(path.size(), 2);
+  EXPECT_DOUBLE_EQ(x0(0, 0), path.front().x);
+  EXPECT_DOUBLE_EQ(x0(1, 0), path.front().y);
+  EXPECT_DOUBLE_EQ(xF(0, 0), path.back().x);
+  EXPECT_DOUBLE_EQ(xF(1, 0), path.back().y);
+  for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+    EXPECT_TRUE(hybrid_a_star.IsCollisionFree(path[i].x, path[i].y,
+                                              path[i].phi));
+  }
+
+  const std::size_t horizon = 80;
+  const float ts = 0.1;
+  Eigen::MatrixXd xWS;
+  Eigen::MatrixXd uWS;
+  Eigen::MatrixXd timeWS;
+  hybrid_a_star.GetWarmStart(path, x0, xF, horizon, ts, &xWS, &uWS, &timeWS);
+  ASSERT_EQ(4, xWS.rows());
+  ASSERT_EQ(horizon + 1, xWS.cols());
+  ASSERT_EQ(2, uWS.rows());
+  ASSERT_EQ(horizon, uWS.cols());
+  ASSERT_EQ(horizon + 1, timeWS.cols());
+  EXPECT_TRUE(xWS.col(0).isApprox(x0.col(0)));
+  EXPECT_TRUE(xWS.col(horizon).isApprox(xF.col(0)));
+  // the wall is passed above its end
+  EXPECT_GT(xWS.row(1).maxCoeff(), 8.0);
+}
+
+TEST_F(HybridAStarTest, StartInCollision) {
+  ObstacleDistanceGrid grid(-15.0, 15.0, -5.0, 15.0, 0.1);
+  const std::vector<Vec2d> wall = {Vec2d(-0.5, -5.0), Vec2d(-0.5, 8.0),
+                                   Vec2d(0.5, 8.0), Vec2d(0.5, -5.0),
+                                   Vec2d(-0.5, -5.0)};
+  grid.Build({wall});
+  HybridAStar hybrid_a_star(config_, grid, vehicle_param_);
+
+  Eigen::MatrixXd x0(4, 1);
+  x0 << -1.0, 2.0, 0.0, 0.0;
+  Eigen::MatrixXd xF(4, 1);
+  xF << 6.0, 2.0, 0.0, 0.0;
+  std::vector<HybridAStar::Pose> path;
+  EXPECT_FALSE(hybrid_a_star.Plan(x0, xF, XYbounds_, &path));
+  EXPECT_TRUE(path.empty());
+}
+
+TEST_F(HybridAStarTest, ParkingSlot) {
+  // the start, goal, bounds and obstacles of the open space planner, with the
+  // grid covering the vehicle box around the bounds
+  Eigen::MatrixXd XYbounds(4, 1);
+  XYbounds << -15.0, 15.0, 1.0, 10.0;
+  const double margin = std::hypot(3.89, 1.055);
+  ObstacleDistanceGrid grid(XYbounds(0, 0) - margin, XYbounds(1, 0) + margin,
+                            XYbounds(2, 0) - margin, XYbounds(3, 0) + margin,
+                            0.1);
+  grid.Build({{Vec2d(-20.0, 5.0), Vec2d(-1.3, 5.0), Vec2d(-1.3, -5.0),
+               Vec2d(-20.0, -5.0), Vec2d(-20.0, 5.0)},
+              {Vec2d(1.3, 5.0), Vec2d(20.0, 5.0), Vec2d(20.0, -5.0),
+               Vec2d(1.3, -5.0), Vec2d(1.3, 5.0)},
+              {Vec2d(-20.0, 15.0), Vec2d(20.0, 15.0), Vec2d(20.0, 11.0),
+               Vec2d(-20.0, 11.0), Vec2d(-20.0, 15.0)}});
+  HybridAStar hybrid_a_star(config_, grid, vehicle_param_);
+
+  // the slot leaves 0.245m on either side of the vehicle
+  EXPECT_TRUE(hybrid_a_star.IsCollisionFree(0.0, 1.2, M_PI / 2));
+  EXPECT_FALSE(hybrid_a_star.IsCollisionFree(0.3, 1.2, M_PI / 2));
+
+  Eigen::MatrixXd x0(4, 1);
+  x0 << -12.0, 8.0, 0.0, 0.0;
+  Eigen::MatrixXd xF(4, 1);
+  xF << 0.0, 1.2, M_PI / 2, 0.0;
+  std::vector<HybridAStar::Pose> path;
+  ASSERT_TRUE(hybrid_a_star.Plan(x0, xF, XYbounds, &path));
+  EXPECT_DOUBLE_EQ(xF(0, 0), path.back().x);
+  EXPECT_DOUBLE_EQ(xF(1, 0), path.back().y);
+  for (const auto& pose : path) {
+    EXPECT_TRUE(hybrid_a_star.IsCollisionFree(pose.x, pose.y, pose.phi));
+    EXPECT_GE(pose.x, XYbounds(0, 0));
+    EXPECT_LE(pose.x, XYbounds(1, 0));
+    EXPECT_GE(pose.y, XYbounds(2, 0));
+    EXPECT_LE(pose.y, XYbounds(3, 0));
+  }
+  // parked backward into the slot
+  EXPECT_FALSE(path.back().forward);
+}
+
+TEST_F(HybridAStarTest, OutOfBounds) {
+  ObstacleDistanceGrid grid(-15.0, 15.0, -5.0, 15.0, 0.1);
+  HybridAStar hybrid_a_star(config_, grid, vehicle_param_);
+
+  Eigen::MatrixXd x0(4, 1);
+  x0 << -10.0, 11.0, 0.0, 0.0;
+  Eigen::MatrixXd xF(4, 1);
+  xF << 6.0, 2.0, 0.0, 0.0;
+  std::vector<HybridAStar::Pose> path;
+  EXPECT_FALSE(hybrid_a_star.Plan(x0, xF, XYbounds_, &path));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,267 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/planner/open_space/obstacle_distance_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+
+#include "modules/common/log.h"
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/math_utils.h"
+#include "modules/common/math/polygon2d.h"
+#include "modules/common/util/thread_pool.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+namespace {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Polygon2d;
+using apollo::common::math::Vec2d;
+using apollo::common::util::TaskGroup;
+using apollo::common::util::ThreadPool;
+
+// squared distance of the cells without any obstacle in the grid, large
+// enough to never win against a real one and small enough to keep the
+// precision of the transform.
+constexpr double kFar = 1e10;
+
+constexpr std::size_t kMinLinesPerTask = 32;
+
+// d[q] = min_p((q - p)^2 + f[p]), "Distance Transforms of Sampled Functions"
+// by Felzenszwalb and Huttenlocher.
+void Transform1d(const std::vector<double>& f, std::vector<double>* d,
+                 std::vector<std::size_t>* v, std::vector<double>* z) {
+  const std::size_t n = f.size();
+  auto intersection = [&f](const std::size_t q, const std::size_t p) {
+    const double dq = static_cast<double>(q);
+    const double dp = static_cast<double>(p);
+    return ((f[q] + dq * dq) - (f[p] + dp * dp)) / (2.0 * dq - 2.0 * dp);
+  };
+  std::size_t k = 0;
+  (*v)[0] = 0;
+  (*z)[0] = -std::numeric_limits<double>::infinity();
+  (*z)[1] = std::numeric_limits<double>::infinity();
+  for (std::size_t q = 1; q < n; ++q) {
+    double s = intersection(q, (*v)[k]);
+    // z[0] is -inf, k does not go below 0
+    while (s <= (*z)[k]) {
+      --k;
+      s = intersection(q, (*v)[k]);
+    }
+    ++k;
+    (*v)[k] = q;
+    (*z)[k] = s;
+    (*z)[k + 1] = std::numeric_limits<double>::infinity();
+  }
+  k = 0;
+  for (std::size_t q = 0; q < n; ++q) {
+    while ((*z)[k + 1] < static_cast<double>(q)) {
+      ++k;
+    }
+    const double dq = static_cast<double>(q) - static_cast<double>((*v)[k]);
+    (*d)[q] = dq * dq + f[(*v)[k]];
+  }
+}
+
+// run func on [begin, end) chunks of [0, n), in the planning thread pool if
+// enabled.
+void ForEachChunk(const std::size_t n,
+                  const std::function<void(std::size_t, std::size_t)>& func) {
+  if (!FLAGS_enable_multi_thread_in_obstacle_distance_grid) {
+    func(0, n);
+    return;
+  }
+  const std::size_t num_chunks = std::max<std::size_t>(
+      1, std::min<std::size_t>(ThreadPool::size(),
+                               (n + kMinLinesPerTask - 1) / kMinLinesPerTask));
+  const std::size_t chunk_size = (n + num_chunks - 1) / num_chunks;
+  TaskGroup group;
+  for (std::size_t begin = 0; begin < n; begin += chunk_size) {
+    const std::size_t end = std::min(begin + chunk_size, n);
+    group.Run([&func, begin, end]() { func(begin, end); });
+  }
+  group.Wait();
+}
+
+}  // namespace
+
+ObstacleDistanceGrid::ObstacleDistanceGrid(const double x_min,
+                                           const double x_max,
+                                           const double y_min,
+                                           const double y_max,
+                                           const double resolution)
+    : x_min_(x_min),
+      x_max_(x_max),
+      y_min_(y_min),
+      y_max_(y_max),
+      resolution_(resolution) {
+  CHECK_GT(resolution_, 0.0);
+  CHECK_LT(x_min_, x_max_);
+  CHECK_LT(y_min_, y_max_);
+  num_x_ = static_cast<std::size_t>(std::ceil((x_max_ - x_min_) / resolution_));
+  num_y_ = static_cast<std::size_t>(std::ceil((y_max_ - y_min_) / resolution_));
+  squared_distance_.assign(num_x_ * num_y_, kFar);
+}
+
+void ObstacleDistanceGrid::Build(
+    const std::vector<std::vector<Vec2d>>& obstacles_vertices) {
+  std::fill(squared_distance_.begin(), squared_distance_.end(), kFar);
+  for (const auto& vertices : obstacles_vertices) {
+    Rasterize(vertices);
+  }
+  ForEachChunk(num_y_, [this](const std::size_t begin, const std::size_t end) {
+    TransformRows(begin, end);
+  });
+  ForEachChunk(num_x_, [this](const std::size_t begin, const std::size_t end) {
+    TransformColumns(begin, end);
+  });
+}
+
+void ObstacleDistanceGrid::Rasterize(const std::vector<Vec2d>& vertices) {
+  if (vertices.empty()) {
+    return;
+  }
+  std::vector<Vec2d> points = vertices;
+  const bool closed =
+      points.size() > 3 &&
+      points.front().DistanceTo(points.back()) < common::math::kMathEpsilon;
+  if (closed) {
+    points.pop_back();
+  }
+  double area = 0.0;
+  for (std::size_t i = 2; i < points.size(); ++i) {
+    area += common::math::CrossProd(points[0], points[i - 1], points[i]);
+  }
+  std::unique_ptr<Polygon2d> polygon;
+  if (closed && std::fabs(area) > common::math::kMathEpsilon) {
+    polygon.reset(new Polygon2d(points));
+  }
+  std::vector<LineSegment2d> segments;
+  for (std::size_t i = 0; i + 1 < vertices.size(); ++i) {
+    segments.emplace_back(vertices[i], vertices[i + 1]);
+  }
+
+  // a cell is occupied when an obstacle point lies in its circumcircle
+  const double half_diagonal = resolution_ * M_SQRT1_2;
+  double min_x = points.front().x();
+  double max_x = min_x;
+  double min_y = points.front().y();
+  double max_y = min_y;
+  for (const auto& point : points) {
+    min_x = std::min(min_x, point.x());
+    max_x = std::max(max_x, point.x());
+    min_y = std::min(min_y, point.y());
+    max_y = std::max(max_y, point.y());
+  }
+  auto to_index = [this](const double value, const double min_value,
+                         const std::size_t num) {
+    const double index = std::floor((value - min_value) / resolution_);
+    return static_cast<std::size_t>(
+        common::math::Clamp(index, 0.0, static_cast<double>(num - 1)));
+  };
+  if (max_x + half_diagonal < x_min_ || min_x - half_diagonal > x_max_ ||
+      max_y + half_diagonal < y_min_ || min_y - half_diagonal > y_max_) {
+    return;
+  }
+  const std::size_t ix_begin = to_index(min_x - half_diagonal, x_min_, num_x_);
+  const std::size_t ix_end = to_index(max_x + half_diagonal, x_min_, num_x_);
+  const std::size_t iy_begin = to_index(min_y - half_diagonal, y_min_, num_y_);
+  const std::size_t iy_end = to_index(max_y + half_diagonal, y_min_, num_y_);
+  for (std::size_t iy = iy_begin; iy <= iy_end; ++iy) {
+    for (std::size_t ix = ix_begin; ix <= ix_end; ++ix) {
+      const Vec2d center(x_min_ + (ix + 0.5) * resolution_,
+                         y_min_ + (iy + 0.5) * resolution_);
+      bool occupied = polygon != nullptr && polygon->IsPointIn(center);
+      for (std::size_t i = 0; !occupied && i < segments.size(); ++i) {
+        occupied = segments[i].DistanceTo(center) <= half_diagonal;
+      }
+      if (!occupied && segments.empty()) {
+        occupied = points.front().DistanceTo(center) <= half_diagonal;
+      }
+      if (occupied) {
+        squared_distance_[Index(ix, iy)] = 0.0;
+      }
+    }
+  }
+}
+
+void ObstacleDistanceGrid::TransformRows(const std::size_t begin,
+                                         const std::size_t end) {
+  std::vector<double> f(num_x_);
+  std::vector<double> d(num_x_);
+  std::vector<std::size_t> v(num_x_);
+  std::vector<double> z(num_x_ + 1);
+  for (std::size_t iy = begin; iy < end; ++iy) {
+    std::copy_n(squared_distance_.begin() + Index(0, iy), num_x_, f.begin());
+    Transform1d(f, &d, &v, &z);
+    std::copy(d.begin(), d.end(), squared_distance_.begin() + Index(0, iy));
+  }
+}
+
+void ObstacleDistanceGrid::TransformColumns(const std::size_t begin,
+                                            const std::size_t end) {
+  std::vector<double> f(num_y_);
+  std::vector<double> d(num_y_);
+  std::vector<std::size_t> v(num_y_);
+  std::vector<double> z(num_y_ + 1);
+  for (std::size_t ix = begin; ix < end; ++ix) {
+    for (std::size_t iy = 0; iy < num_y_; ++iy) {
+      f[iy] = squared_distance_[Index(ix, iy)];
+    }
+    Transform1d(f, &d, &v, &z);
+    for (std::size_t iy = 0; iy < num_y_; ++iy) {
+      squared_distance_[Index(ix, iy)] = d[iy];
+    }
+  }
+}
+
+bool ObstacleDistanceGrid::IsInBounds(const Vec2d& point) const {
+  return point.x() >= x_min_ && point.x() < x_max_ && point.y() >= y_min_ &&
+         point.y() < y_max_;
+}
+
+double ObstacleDistanceGrid::DistanceTo(const Vec2d& point) const {
+  if (!IsInBounds(point)) {
+    return 0.0;
+  }
+  const std::size_t ix = std::min(
+      static_cast<std::size_t>((point.x() - x_min_) / resolution_),
+      num_x_ - 1);
+  const std::size_t iy = std::min(
+      static_cast<std::size_t>((point.y() - y_min_) / resolution_),
+      num_y_ - 1);
+  const double squared_distance = squared_distance_[Index(ix, iy)];
+  if (squared_distance >= kFar) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // both the point and the closest obstacle point are up to half a diagonal
+  // away from the centers of their cells.
+  return std::max(0.0,
+                  (std::sqrt(squared_distance) - M_SQRT2) * resolution_);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#ifndef MODULES_PLANNING_PLANNER_OPEN_SPACE_OBSTACLE_DISTANCE_GRID_H_
+#define MODULES_PLANNING_PLANNER_OPEN_SPACE_OBSTACLE_DISTANCE_GRID_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "modules/common/math/vec2d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class ObstacleDistanceGrid
+ * @brief Euclidean distance field of the open space obstacles.
+ *
+ * The obstacles are rasterized on a regular grid over the xy bounds, and the
+ * distance of every cell to the closest occupied one is computed once with
+ * an exact two-pass distance transform, so that collision checks of the warm
+ * start search are constant time lookups.
+ */
+class ObstacleDistanceGrid {
+ public:
+  ObstacleDistanceGrid(const double x_min, const double x_max,
+                       const double y_min, const double y_max,
+                       const double resolution);
+
+  /**
+   * @brief rasterize the obstacles and compute the distance field.
+   * @param obstacles_vertices the vertices of each obstacle, a closed polygon
+   * when its first vertex is repeated at the end, a polyline otherwise.
+   */
+  void Build(
+      const std::vector<std::vector<common::math::Vec2d>>& obstacles_vertices);
+
+  /**
+   * @brief a lower bound of the distance from the point to the obstacles.
+   * It is off by at most two cell diagonals, and 0.0 outside the bounds.
+   */
+  double DistanceTo(const common::math::Vec2d& point) const;
+
+  bool IsInBounds(const common::math::Vec2d& point) const;
+
+  double x_min() const { return x_min_; }
+  double x_max() const { return x_max_; }
+  double y_min() const { return y_min_; }
+  double y_max() const { return y_max_; }
+  double resolution() const { return resolution_; }
+
+ private:
+  void Rasterize(const std::vector<common::math::Vec2d>& vertices);
+
+  // 1d transform of the squared distances of rows [begin, end)
+  void TransformRows(const std::size_t begin, const std::size_t end);
+  // 1d transform of the squared distances of columns [begin, end)
+  void TransformColumns(const std::size_t begin, const std::size_t end);
+
+  std::size_t Index(const std::size_t ix, const std::size_t iy) const {
+    return iy * num_x_ + ix;
+  }
+
+  double x_min_ = 0.0;
+  double x_max_ = 0.0;
+  double y_min_ = 0.0;
+  double y_max_ = 0.0;
+  double resolution_ = 0.0;
+  std::size_t num_x_ = 0;
+  std::size_t num_y_ = 0;
+
+  // squared distance to the closest occupied cell, in cells
+  std::vector<double> squared_distance_;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_PLANNER_OPEN_SPACE_OBSTACLE_DISTANCE_GRID_H_
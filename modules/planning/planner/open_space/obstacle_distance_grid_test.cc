@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+
+#include "modules/planning/planner/open_space/obstacle_distance_grid.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/polygon2d.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Polygon2d;
+using apollo::common::math::Vec2d;
+
+TEST(ObstacleDistanceGridTest, NoObstacle) {
+  ObstacleDistanceGrid grid(-10.0, 10.0, -5.0, 5.0, 0.1);
+  grid.Build({});
+  EXPECT_TRUE(std::isinf(grid.DistanceTo(Vec2d(0.0, 0.0))));
+  EXPECT_DOUBLE_EQ(0.0, grid.DistanceTo(Vec2d(11.0, 0.0)));
+  EXPECT_FALSE(grid.IsInBounds(Vec2d(0.0, -6.0)));
+}
+
+TEST(ObstacleDistanceGridTest, LowerBoundOfDistance) {
+  const double resolution = 0.1;
+  ObstacleDistanceGrid grid(-10.0, 10.0, -10.0, 10.0, resolution);
+  // a closed box and an open polyline
+  const std::vector<Vec2d> box = {Vec2d(-1.0, -1.0), Vec2d(-1.0, 1.0),
+                                  Vec2d(1.0, 1.0), Vec2d(1.0, -1.0),
+                                  Vec2d(-1.0, -1.0)};
+  const std::vector<Vec2d> wall = {Vec2d(-5.0, 5.0), Vec2d(5.0, 5.0)};
+  grid.Build({box, wall});
+
+  const Polygon2d polygon(
+      std::vector<Vec2d>(box.begin(), box.end() - 1));
+  const LineSegment2d segment(wall[0], wall[1]);
+  for (double x = -9.95; x < 10.0; x += 0.37) {
+    for (double y = -9.95; y < 10.0; y += 0.41) {
+      const Vec2d point(x, y);
+      const double expected =
+          std::fmin(polygon.DistanceTo(point), segment.DistanceTo(point));
+      const double distance = grid.DistanceTo(point);
+      EXPECT_LE(distance, expected + 1e-9);
+      EXPECT_GE(distance, expected - 2.0 * M_SQRT2 * resolution - 1e-9);
+    }
+  }
+  EXPECT_DOUBLE_EQ(0.0, grid.DistanceTo(Vec2d(0.0, 0.0)));
+  EXPECT_DOUBLE_EQ(0.0, grid.DistanceTo(Vec2d(0.0, 5.0)));
+}
+
+}  // namespace planning
+}  // namespace apollo
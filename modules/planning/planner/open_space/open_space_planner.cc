@@ -16,6 +16,8 @@
 
 #include "modules/planning/planner/open_space/open_space_planner.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <utility>
 
@@ -32,8 +34,10 @@ using apollo::common::TrajectoryPoint;
 using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
 
-Status OpenSpacePlanner::Init(const PlanningConfig&) {
+Status OpenSpacePlanner::Init(const PlanningConfig& config) {
   AINFO << "In OpenSpacePlanner::Init()";
+  planner_open_space_config_ =
+      config.standard_planning_config().planner_open_space_config();
   return Status::OK();
 }
 
@@ -106,20 +110,49 @@ apollo::common::Status OpenSpacePlanner::Plan(
   Eigen::MatrixXd uWS = Eigen::MatrixXd::Zero(2, horizon);
   Eigen::MatrixXd timeWS = Eigen::MatrixXd::Zero(1, horizon + 1);
 
-  warm_start_.reset(new WarmStartProblem(horizon, ts, x0, xF, XYbounds));
+  bool warm_started = false;
+  if (FLAGS_enable_open_space_hybrid_a_star_warm_start) {
+    // XYbounds only bound the reference point, the grid covers the vehicle
+    // box around it.
+    const double margin =
+        std::hypot(std::max(front_to_center_, back_to_center_),
+                   std::max(left_to_center_, right_to_center_));
+    ObstacleDistanceGrid distance_grid(
+        XYbounds(0, 0) - margin, XYbounds(1, 0) + margin,
+        XYbounds(2, 0) - margin, XYbounds(3, 0) + margin,
+        FLAGS_open_space_distance_grid_resolution);
+    distance_grid.Build(obstacles_vertices_vec);
+    HybridAStar hybrid_a_star(
+        planner_open_space_config_.hybrid_a_star_config(), distance_grid,
+        vehicle_param_);
+    std::vector<HybridAStar::Pose> path;
+    if (hybrid_a_star.Plan(x0, xF, XYbounds, &path)) {
+      hybrid_a_star.GetWarmStart(path, x0, xF, horizon, ts, &xWS, &uWS,
+                                 &timeWS);
+      warm_started = true;
+      ADEBUG << "Hybrid A* warm start found with " << path.size()
+             << " poses.";
+    } else {
+      AWARN << "Hybrid A* warm start failed, solve the warm start problem.";
+    }
+  }
 
-  Eigen::MatrixXd state_result;
-  Eigen::MatrixXd control_result;
-  Eigen::MatrixXd time_result;
+  if (!warm_started) {
+    warm_start_.reset(new WarmStartProblem(horizon, ts, x0, xF, XYbounds));
 
-  bool ret_status =
-      warm_start_->Solve(&state_result, &control_result, &time_result);
+    Eigen::MatrixXd state_result;
+    Eigen::MatrixXd control_result;
+    Eigen::MatrixXd time_result;
 
-  if (ret_status) {
-    ADEBUG << "Warm start problem solved successfully!";
-  } else {
-    return Status(ErrorCode::PLANNING_ERROR,
-                  "Warm start problem failed to solve");
+    bool ret_status =
+        warm_start_->Solve(&state_result, &control_result, &time_result);
+
+    if (ret_status) {
+      ADEBUG << "Warm start problem solved successfully!";
+    } else {
+      return Status(ErrorCode::PLANNING_ERROR,
+                    "Warm start problem failed to solve");
+    }
   }
 
   // TODO(QiL): Step 8 : Formulate distance approach problem
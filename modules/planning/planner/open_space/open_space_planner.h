@@ -28,6 +28,8 @@
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
 #include "modules/planning/common/frame_open_space.h"
 #include "modules/planning/planner/open_space/distance_approach_problem.h"
+#include "modules/planning/planner/open_space/hybrid_a_star.h"
+#include "modules/planning/planner/open_space/obstacle_distance_grid.h"
 #include "modules/planning/planner/open_space/warm_start_problem.h"
 #include "modules/planning/planner/planner.h"
 #include "modules/planning/proto/planning_config.pb.h"
@@ -87,6 +89,7 @@ class OpenSpacePlanner : public Planner {
   std::unique_ptr<::apollo::planning::WarmStartProblem> warm_start_;
   std::unique_ptr<::apollo::planning::DistanceApproachProblem>
       distance_approach_;
+  PlannerOpenSpaceConfig planner_open_space_config_;
   common::VehicleState init_state_;
   const common::VehicleParam& vehicle_param_ =
       common::VehicleConfigHelper::GetConfig().vehicle_param();
@@ -59,6 +59,13 @@ class Planning : public apollo::common::ApolloApp {
 
   virtual void RunOnce() { planning_base_->RunOnce(); }
 
+  /**
+   * @brief Runs on the steps of the given clock instead of the ROS timer.
+   */
+  void UseSteppedClock(apollo::common::time::SteppedClock* clock) {
+    planning_base_->UseSteppedClock(clock);
+  }
+
   /**
    * @brief module initialization function
    * @return initialization status
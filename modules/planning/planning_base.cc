@@ -17,6 +17,7 @@
 #include "modules/planning/planning_base.h"
 
 #include <algorithm>
+#include <cmath>
 #include <list>
 #include <vector>
 
@@ -47,10 +48,21 @@ using apollo::common::VehicleState;
 using apollo::common::VehicleStateProvider;
 using apollo::common::adapter::AdapterManager;
 using apollo::common::time::Clock;
+using apollo::common::time::Duration;
+using apollo::common::time::SteppedClock;
 using apollo::hdmap::HDMapUtil;
 
 PlanningBase::~PlanningBase() {}
 
+void PlanningBase::UseSteppedClock(SteppedClock* clock) {
+  CHECK_NOTNULL(clock);
+  use_stepped_clock_ = true;
+  timer_.stop();
+  const Duration interval(
+      static_cast<int64_t>(std::round(1e9 / FLAGS_planning_loop_rate)));
+  clock->AddTask(interval, [this]() { RunOnce(); });
+}
+
 bool PlanningBase::IsVehicleStateValid(const VehicleState& vehicle_state) {
   if (std::isnan(vehicle_state.x()) || std::isnan(vehicle_state.y()) ||
       std::isnan(vehicle_state.z()) || std::isnan(vehicle_state.heading()) ||
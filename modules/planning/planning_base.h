@@ -22,8 +22,6 @@
 #include <utility>
 #include <vector>
 
-#include "ctpl/ctpl_stl.h"
-
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/planning/proto/planning.pb.h"
 #include "modules/planning/proto/planning_config.pb.h"
@@ -32,6 +30,7 @@
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/apollo_app.h"
 #include "modules/common/status/status.h"
+#include "modules/common/time/stepped_clock.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
 #include "modules/planning/planner/planner.h"
@@ -59,6 +58,16 @@ class PlanningBase : public apollo::common::ApolloApp {
   // Watch dog timer
   virtual void OnTimer(const ros::TimerEvent&) = 0;
 
+  /**
+   * @brief Runs on the steps of the given clock instead of the ROS timer,
+   * so that a closed-loop simulation can run faster than real time. The
+   * reference line provider thread should be disabled for the runs to be
+   * deterministic.
+   * @param clock the stepped clock, which must not be stepped after
+   * planning is destroyed.
+   */
+  void UseSteppedClock(apollo::common::time::SteppedClock* clock);
+
   /**
    * @brief Plan the trajectory given current vehicle state
    */
@@ -91,6 +100,8 @@ class PlanningBase : public apollo::common::ApolloApp {
   std::unique_ptr<Planner> planner_;
   std::unique_ptr<PublishableTrajectory> last_publishable_trajectory_;
   ros::Timer timer_;
+  // Whether it runs on a stepped clock instead of the timer.
+  bool use_stepped_clock_ = false;
   std::unique_ptr<PlannerDispatcher> planner_dispatcher_;
 };
 
@@ -23,13 +23,17 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <functional>
 #include <limits>
+#include <string>
 #include <utility>
 
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/map/pnc_map/path.h"
@@ -55,6 +59,41 @@ using apollo::hdmap::MapPathPoint;
 using apollo::hdmap::PncMap;
 using apollo::hdmap::RouteSegments;
 
+namespace {
+
+// maximum number of smoothed route segments kept between cycles
+constexpr std::size_t kMaxSmoothedSegmentCacheSize = 8;
+
+std::size_t HashCombine(const std::size_t seed, const double value) {
+  // quantize to centimeters so that identical inputs hash identically
+  const auto quantized = static_cast<int64_t>(std::round(value * 100.0));
+  return seed ^ (std::hash<int64_t>()(quantized) + 0x9e3779b9 + (seed << 6) +
+                 (seed >> 2));
+}
+
+std::size_t AnchorPointsHash(const std::vector<AnchorPoint> &anchor_points) {
+  std::size_t seed = anchor_points.size();
+  for (const auto &anchor : anchor_points) {
+    seed = HashCombine(seed, anchor.path_point.x());
+    seed = HashCombine(seed, anchor.path_point.y());
+    seed = HashCombine(seed, anchor.lateral_bound);
+    seed = HashCombine(seed, anchor.longitudinal_bound);
+  }
+  return seed;
+}
+
+std::string LaneSegmentKey(const RouteSegments &segments) {
+  std::string key;
+  for (const auto &segment : segments) {
+    key += common::util::StrCat(segment.lane->id().id(), ":",
+                                std::lround(segment.start_s * 100.0), ":",
+                                std::lround(segment.end_s * 100.0), ";");
+  }
+  return key;
+}
+
+}  // namespace
+
 ReferenceLineProvider::~ReferenceLineProvider() {
   if (thread_ && thread_->joinable()) {
     thread_->join();
@@ -806,9 +845,122 @@ bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
                                                ReferenceLine *reference_line) {
   hdmap::Path path;
   hdmap::PncMap::CreatePathFromLaneSegments(segments, &path);
+  if (FLAGS_enable_smooth_reference_line &&
+      FLAGS_enable_incremental_reference_line_smoothing) {
+    return SmoothRouteSegmentIncrementally(segments, ReferenceLine(path),
+                                           reference_line);
+  }
   return SmoothReferenceLine(ReferenceLine(path), reference_line);
 }
 
+bool ReferenceLineProvider::SmoothRouteSegmentIncrementally(
+    const RouteSegments &segments, const ReferenceLine &raw_reference_line,
+    ReferenceLine *reference_line) {
+  std::vector<AnchorPoint> anchor_points;
+  GetAnchorPoints(raw_reference_line, &anchor_points);
+  const std::size_t anchor_hash = AnchorPointsHash(anchor_points);
+  const std::string lane_key = LaneSegmentKey(segments);
+
+  // the same lanes smoothed with the same anchors: nothing to do.
+  for (auto iter = smoothed_segment_cache_.begin();
+       iter != smoothed_segment_cache_.end(); ++iter) {
+    if (iter->lane_key == lane_key && iter->anchor_hash == anchor_hash) {
+      *reference_line = iter->reference_line;
+      smoothed_segment_cache_.splice(smoothed_segment_cache_.begin(),
+                                     smoothed_segment_cache_, iter);
+      ADEBUG << "Reuse smoothed route segment " << lane_key;
+      return true;
+    }
+  }
+
+  // a connected segment keeps its smoothed part, only the tail beyond it is
+  // smoothed again.
+  for (const auto &cached : smoothed_segment_cache_) {
+    if (!cached.segments.IsConnectedSegment(segments)) {
+      continue;
+    }
+    if (SmoothTailReferenceLine(cached.reference_line, raw_reference_line,
+                                reference_line)) {
+      CacheSmoothedSegment(segments, anchor_hash, *reference_line);
+      return true;
+    }
+  }
+
+  smoother_->SetAnchorPoints(anchor_points);
+  if (!smoother_->Smooth(raw_reference_line, reference_line)) {
+    AERROR << "Failed to smooth reference line with anchor points";
+    return false;
+  }
+  if (!IsReferenceLineSmoothValid(raw_reference_line, *reference_line)) {
+    AERROR << "The smoothed reference line error is too large";
+    return false;
+  }
+  CacheSmoothedSegment(segments, anchor_hash, *reference_line);
+  return true;
+}
+
+bool ReferenceLineProvider::SmoothTailReferenceLine(
+    const ReferenceLine &prefix_ref, const ReferenceLine &raw_ref,
+    ReferenceLine *reference_line) {
+  const auto &prefix_points = prefix_ref.reference_points();
+  if (prefix_points.size() < 2) {
+    return false;
+  }
+  // the prefix has to start before the raw line and end on it
+  common::SLPoint start_sl;
+  common::SLPoint end_sl;
+  if (!raw_ref.XYToSL(prefix_points.front(), &start_sl) ||
+      !raw_ref.XYToSL(prefix_points.back(), &end_sl)) {
+    return false;
+  }
+  if (start_sl.s() > 0.0 || end_sl.s() <= 0.0 ||
+      std::fabs(end_sl.l()) > FLAGS_smoothed_reference_line_max_diff) {
+    return false;
+  }
+
+  const Vec2d raw_start(raw_ref.reference_points().front().x(),
+                        raw_ref.reference_points().front().y());
+  constexpr double kCoverageTolerance = 0.1;
+  if (end_sl.s() + kCoverageTolerance < raw_ref.Length()) {
+    // smooth the newly exposed tail, the start of the window is fixed to the
+    // prefix up to the curvature.
+    const double tail_start_s = std::max(
+        0.0, end_sl.s() - FLAGS_reference_line_stitch_overlap_distance);
+    const auto &raw_points = raw_ref.reference_points();
+    const std::size_t tail_start_index =
+        raw_ref.GetNearestReferenceIndex(tail_start_s);
+    if (tail_start_index + 2 > raw_points.size()) {
+      return false;
+    }
+    const ReferenceLine raw_tail(std::vector<ReferencePoint>(
+        raw_points.begin() + tail_start_index, raw_points.end()));
+    if (!SmoothPrefixedReferenceLine(prefix_ref, raw_tail, reference_line)) {
+      return false;
+    }
+    if (!reference_line->Stitch(prefix_ref)) {
+      AWARN << "Failed to stitch smoothed tail to the cached reference line";
+      return false;
+    }
+  } else {
+    *reference_line = prefix_ref;
+  }
+  return reference_line->Shrink(raw_start, 0.0, raw_ref.Length());
+}
+
+void ReferenceLineProvider::CacheSmoothedSegment(
+    const RouteSegments &segments, const std::size_t anchor_hash,
+    const ReferenceLine &reference_line) {
+  SmoothedSegment smoothed;
+  smoothed.segments = segments;
+  smoothed.lane_key = LaneSegmentKey(segments);
+  smoothed.anchor_hash = anchor_hash;
+  smoothed.reference_line = reference_line;
+  smoothed_segment_cache_.push_front(std::move(smoothed));
+  if (smoothed_segment_cache_.size() > kMaxSmoothedSegmentCacheSize) {
+    smoothed_segment_cache_.pop_back();
+  }
+}
+
 bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
     const ReferenceLine &prefix_ref, const ReferenceLine &raw_ref,
     ReferenceLine *reference_line) {
@@ -834,6 +986,11 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
     point.path_point.set_y(prefix_ref_point.y());
     point.path_point.set_z(0.0);
     point.path_point.set_theta(prefix_ref_point.heading());
+    if (FLAGS_enable_incremental_reference_line_smoothing) {
+      // keep the curvature continuous at the stitching point
+      point.path_point.set_kappa(prefix_ref_point.kappa());
+      point.path_point.set_dkappa(prefix_ref_point.dkappa());
+    }
     point.longitudinal_bound = 1e-6;
     point.lateral_bound = 1e-6;
     point.enforced = true;
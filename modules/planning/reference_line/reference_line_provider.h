@@ -34,6 +34,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "gtest/gtest_prod.h"
+
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
 #include "modules/map/relative_map/proto/navigation.pb.h"
 #include "modules/planning/proto/planning_config.pb.h"
@@ -126,6 +128,23 @@ class ReferenceLineProvider {
   bool SmoothRouteSegment(const hdmap::RouteSegments& segments,
                           ReferenceLine* reference_line);
 
+  /**
+   * @brief Smooth the route segment reusing the cached smoothed segments.
+   * An identical segment is returned from the cache, a connected segment
+   * is kept as prefix and only the uncovered tail is smoothed.
+   */
+  bool SmoothRouteSegmentIncrementally(const hdmap::RouteSegments& segments,
+                                       const ReferenceLine& raw_reference_line,
+                                       ReferenceLine* reference_line);
+
+  bool SmoothTailReferenceLine(const ReferenceLine& prefix_ref,
+                               const ReferenceLine& raw_ref,
+                               ReferenceLine* reference_line);
+
+  void CacheSmoothedSegment(const hdmap::RouteSegments& segments,
+                            const std::size_t anchor_hash,
+                            const ReferenceLine& reference_line);
+
   /**
    * @brief This function creates a smoothed forward reference line
    * based on the given segments.
@@ -159,6 +178,19 @@ class ReferenceLineProvider {
   std::unique_ptr<ReferenceLineSmoother> smoother_;
   ReferenceLineSmootherConfig smoother_config_;
 
+  /**
+   * smoothed route segment, keyed by its lane segments and the hash of the
+   * anchor points it was smoothed with.
+   */
+  struct SmoothedSegment {
+    hdmap::RouteSegments segments;
+    std::string lane_key;
+    std::size_t anchor_hash = 0;
+    ReferenceLine reference_line;
+  };
+  // most recently used first, only accessed by CreateReferenceLine()
+  std::list<SmoothedSegment> smoothed_segment_cache_;
+
   std::mutex pnc_map_mutex_;
   std::unique_ptr<hdmap::PncMap> pnc_map_;
 
@@ -176,6 +208,10 @@ class ReferenceLineProvider {
 
   std::queue<std::list<ReferenceLine>> reference_line_history_;
   std::queue<std::list<hdmap::RouteSegments>> route_segments_history_;
+
+  FRIEND_TEST(ReferenceLineProviderTest, SmoothedSegmentCacheHit);
+  FRIEND_TEST(ReferenceLineProviderTest, SmoothedSegmentCacheEviction);
+  FRIEND_TEST(ReferenceLineProviderTest, SmoothedSegmentPrefixStitch);
 };
 
 }  // namespace planning
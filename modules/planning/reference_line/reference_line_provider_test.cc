@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file reference_line_provider_test.cc
+ **/
+#include "modules/planning/reference_line/reference_line_provider.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/configs/proto/vehicle_config.pb.h"
+
+#include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Vec2d;
+
+namespace {
+
+// Copies the raw reference line, and counts the smoothings.
+class FakeSmoother : public ReferenceLineSmoother {
+ public:
+  explicit FakeSmoother(int* num_smoothed)
+      : ReferenceLineSmoother(ReferenceLineSmootherConfig()),
+        num_smoothed_(num_smoothed) {}
+
+  void SetAnchorPoints(const std::vector<AnchorPoint>&) override {}
+
+  bool Smooth(const ReferenceLine& raw_reference_line,
+              ReferenceLine* const smoothed_reference_line) override {
+    ++*num_smoothed_;
+    *smoothed_reference_line = raw_reference_line;
+    return true;
+  }
+
+ private:
+  int* num_smoothed_;
+};
+
+}  // namespace
+
+class ReferenceLineProviderTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    FLAGS_enable_smooth_reference_line = true;
+    FLAGS_enable_incremental_reference_line_smoothing = true;
+    common::VehicleConfig vehicle_config;
+    vehicle_config.mutable_vehicle_param()->set_width(2.11);
+    common::VehicleConfigHelper::Init(vehicle_config);
+
+    ASSERT_EQ(0, hdmap_.LoadMapFromFile(map_file));
+    lane_ = hdmap_.GetLaneById(hdmap::MakeMapId("1_-1"));
+    ASSERT_TRUE(lane_ != nullptr);
+    provider_.reset(new ReferenceLineProvider(&hdmap_));
+  }
+
+  virtual void TearDown() {
+    FLAGS_enable_incremental_reference_line_smoothing = false;
+  }
+
+  hdmap::RouteSegments Segments(const double start_s,
+                                const double end_s) const {
+    hdmap::RouteSegments segments;
+    segments.emplace_back(lane_, start_s, end_s);
+    return segments;
+  }
+
+  hdmap::Path LanePath(const hdmap::RouteSegments& segments) const {
+    hdmap::Path path;
+    hdmap::PncMap::CreatePathFromLaneSegments(segments, &path);
+    return path;
+  }
+
+  const std::string map_file =
+      "modules/planning/testdata/garage_map/base_map.txt";
+
+  hdmap::HDMap hdmap_;
+  hdmap::LaneInfoConstPtr lane_ = nullptr;
+  std::unique_ptr<ReferenceLineProvider> provider_;
+  int num_smoothed_ = 0;
+};
+
+TEST_F(ReferenceLineProviderTest, SmoothedSegmentCacheHit) {
+  provider_->smoother_.reset(new FakeSmoother(&num_smoothed_));
+  const auto& cache = provider_->smoothed_segment_cache_;
+
+  ReferenceLine first;
+  ASSERT_TRUE(provider_->SmoothRouteSegment(Segments(0.0, 60.0), &first));
+  EXPECT_EQ(1, num_smoothed_);
+  EXPECT_EQ(1, cache.size());
+
+  // the same segment is returned from the cache
+  ReferenceLine second;
+  ASSERT_TRUE(provider_->SmoothRouteSegment(Segments(0.0, 60.0), &second));
+  EXPECT_EQ(1, num_smoothed_);
+  EXPECT_EQ(1, cache.size());
+  EXPECT_EQ(first.reference_points().size(),
+            second.reference_points().size());
+  EXPECT_DOUBLE_EQ(first.Length(), second.Length());
+
+  // a segment apart from the cached one is smoothed
+  ReferenceLine third;
+  ASSERT_TRUE(provider_->SmoothRouteSegment(Segments(90.0, 150.0), &third));
+  EXPECT_EQ(2, num_smoothed_);
+  ASSERT_EQ(2, cache.size());
+  EXPECT_DOUBLE_EQ(90.0, cache.front().segments.front().start_s);
+
+  // a hit becomes the most recently used
+  ASSERT_TRUE(provider_->SmoothRouteSegment(Segments(0.0, 60.0), &second));
+  EXPECT_EQ(2, num_smoothed_);
+  ASSERT_EQ(2, cache.size());
+  EXPECT_DOUBLE_EQ(0.0, cache.front().segments.front().start_s);
+}
+
+TEST_F(ReferenceLineProviderTest, SmoothedSegmentCacheEviction) {
+  const auto& cache = provider_->smoothed_segment_cache_;
+  ReferenceLine reference_line;
+  for (std::size_t i = 0; i < 9; ++i) {
+    provider_->CacheSmoothedSegment(Segments(i * 10.0, i * 10.0 + 5.0), i,
+                                    reference_line);
+  }
+  // the least recently used segment is evicted
+  ASSERT_EQ(8, cache.size());
+  EXPECT_EQ(8, cache.front().anchor_hash);
+  EXPECT_EQ(1, cache.back().anchor_hash);
+}
+
+TEST_F(ReferenceLineProviderTest, SmoothedSegmentPrefixStitch) {
+  provider_->smoother_.reset(new FakeSmoother(&num_smoothed_));
+
+  // a cached segment 1cm to the left of the lane, which tells its points
+  // apart from the ones of the newly smoothed tail.
+  const ReferenceLine raw_prefix(LanePath(Segments(0.0, 80.0)));
+  std::vector<ReferencePoint> prefix_points;
+  for (const auto& point : raw_prefix.reference_points()) {
+    const Vec2d shifted =
+        point + Vec2d::CreateUnitVec2d(point.heading() + M_PI / 2.0) * 0.01;
+    prefix_points.emplace_back(
+        hdmap::MapPathPoint(shifted, point.heading(), point.lane_waypoints()),
+        point.kappa(), point.dkappa());
+  }
+  provider_->CacheSmoothedSegment(Segments(0.0, 80.0), 0,
+                                  ReferenceLine(prefix_points));
+
+  // the vehicle moved on, the new segment overlaps the cached one
+  const ReferenceLine raw(LanePath(Segments(10.0, 120.0)));
+  ReferenceLine stitched;
+  ASSERT_TRUE(provider_->SmoothRouteSegment(Segments(10.0, 120.0), &stitched));
+  // only the tail is smoothed
+  EXPECT_EQ(1, num_smoothed_);
+  EXPECT_NEAR(raw.Length(), stitched.Length(), 0.5);
+  EXPECT_EQ(2, provider_->smoothed_segment_cache_.size());
+
+  // the part covered by the prefix is kept
+  common::SLPoint sl;
+  ASSERT_TRUE(raw.XYToSL(stitched.GetReferencePoint(20.0), &sl));
+  EXPECT_NEAR(20.0, sl.s(), 0.1);
+  EXPECT_NEAR(0.01, sl.l(), 1e-3);
+  ASSERT_TRUE(raw.XYToSL(stitched.GetReferencePoint(100.0), &sl));
+  EXPECT_NEAR(100.0, sl.s(), 0.1);
+  EXPECT_NEAR(0.0, sl.l(), 1e-3);
+}
+
+}  // namespace planning
+}  // namespace apollo
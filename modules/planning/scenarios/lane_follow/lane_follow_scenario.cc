@@ -21,6 +21,7 @@
 #include "modules/planning/scenarios/lane_follow/lane_follow_scenario.h"
 
 #include <fstream>
+#include <functional>
 #include <limits>
 #include <utility>
 
@@ -31,6 +32,7 @@
 #include "modules/common/util/file.h"
 #include "modules/common/util/string_tokenizer.h"
 #include "modules/common/util/string_util.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/map/hdmap/hdmap.h"
 #include "modules/map/hdmap/hdmap_common.h"
@@ -57,6 +59,7 @@ using common::TrajectoryPoint;
 using common::adapter::AdapterManager;
 using common::math::Vec2d;
 using common::time::Clock;
+using common::util::TaskGroup;
 
 namespace {
 constexpr double kPathOptimizationFallbackCost = 2e4;
@@ -104,6 +107,18 @@ bool LaneFollowScenario::Init() {
   return true;
 }
 
+bool LaneFollowScenario::CreateTasks(
+    std::vector<std::unique_ptr<Task>>* tasks) {
+  for (const auto& task_cfg : config_.scenario_task_config()) {
+    tasks->emplace_back(task_factory_.CreateObject(task_cfg.task()));
+    if (!tasks->back()->Init(task_cfg)) {
+      AERROR << "Init task[" << tasks->back()->Name() << "] failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
 void LaneFollowScenario::RecordObstacleDebugInfo(
     ReferenceLineInfo* reference_line_info) {
   if (!FLAGS_enable_record_debug) {
@@ -153,6 +168,9 @@ void LaneFollowScenario::RecordDebugInfo(ReferenceLineInfo* reference_line_info,
 
 Status LaneFollowScenario::Process(const TrajectoryPoint& planning_start_point,
                                    Frame* frame) {
+  if (FLAGS_enable_parallel_reference_line_planning) {
+    return ProcessInParallel(planning_start_point, frame);
+  }
   bool has_drivable_reference_line = false;
   bool disable_low_priority_path = false;
   auto status =
@@ -164,8 +182,8 @@ Status LaneFollowScenario::Process(const TrajectoryPoint& planning_start_point,
     if (!reference_line_info.IsDrivable()) {
       continue;
     }
-    auto cur_status =
-        PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
+    auto cur_status = PlanOnReferenceLine(planning_start_point, frame,
+                                          &reference_line_info, &tasks_);
     if (cur_status.ok() && reference_line_info.IsDrivable()) {
       has_drivable_reference_line = true;
       if (FLAGS_prioritize_change_lane &&
@@ -180,9 +198,69 @@ Status LaneFollowScenario::Process(const TrajectoryPoint& planning_start_point,
   return has_drivable_reference_line ? Status::OK() : status;
 }
 
+Status LaneFollowScenario::ProcessInParallel(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  std::vector<ReferenceLineInfo*> candidates;
+  for (auto& reference_line_info : frame->reference_line_info()) {
+    if (reference_line_info.IsDrivable()) {
+      candidates.push_back(&reference_line_info);
+    }
+  }
+  if (candidates.empty()) {
+    return Status(ErrorCode::PLANNING_ERROR, "reference line not drivable");
+  }
+  while (parallel_tasks_.size() + 1 < candidates.size()) {
+    parallel_tasks_.emplace_back();
+    if (!CreateTasks(&parallel_tasks_.back())) {
+      parallel_tasks_.pop_back();
+      return Status(ErrorCode::PLANNING_ERROR, "failed to create tasks");
+    }
+  }
+
+  // the frame is only read while the reference lines are planned: the
+  // obstacles shared by the reference lines are created by the traffic
+  // deciders beforehand.
+  std::vector<Status> statuses(candidates.size());
+  TaskGroup group;
+  for (size_t i = 1; i < candidates.size(); ++i) {
+    group.Run([this, &planning_start_point, frame, &candidates, &statuses,
+               i]() {
+      statuses[i] = PlanOnReferenceLine(planning_start_point, frame,
+                                        candidates[i], &parallel_tasks_[i - 1]);
+    });
+  }
+  statuses.front() = PlanOnReferenceLine(planning_start_point, frame,
+                                         candidates.front(), &tasks_);
+  group.Wait();
+
+  bool has_drivable_reference_line = false;
+  bool disable_low_priority_path = false;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    auto* reference_line_info = candidates[i];
+    if (disable_low_priority_path) {
+      reference_line_info->SetDrivable(false);
+      continue;
+    }
+    if (statuses[i].ok() && reference_line_info->IsDrivable()) {
+      has_drivable_reference_line = true;
+      if (FLAGS_prioritize_change_lane &&
+          reference_line_info->IsChangeLanePath() &&
+          reference_line_info->Cost() < kStraightForwardLineCost) {
+        disable_low_priority_path = true;
+      }
+    } else {
+      reference_line_info->SetDrivable(false);
+    }
+  }
+  return has_drivable_reference_line
+             ? Status::OK()
+             : Status(ErrorCode::PLANNING_ERROR, "reference line not drivable");
+}
+
 Status LaneFollowScenario::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
-    ReferenceLineInfo* reference_line_info) {
+    ReferenceLineInfo* reference_line_info,
+    std::vector<std::unique_ptr<Task>>* tasks) {
   if (!reference_line_info->IsChangeLanePath()) {
     reference_line_info->AddCost(kStraightForwardLineCost);
   }
@@ -199,7 +277,7 @@ Status LaneFollowScenario::PlanOnReferenceLine(
 
   auto ret = Status::OK();
 
-  for (auto& optimizer : tasks_) {
+  for (auto& optimizer : *tasks) {
     const double start_timestamp = Clock::NowInSeconds();
     ret = optimizer->Execute(frame, reference_line_info);
     if (!ret.ok()) {
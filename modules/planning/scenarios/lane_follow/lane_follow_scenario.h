@@ -59,9 +59,20 @@ class LaneFollowScenario : public Scenario {
  private:
   void RegisterTasks();
 
+  bool CreateTasks(std::vector<std::unique_ptr<Task>>* tasks);
+
+  /**
+   * @brief plan on every drivable reference line in its own thread, each
+   * with its own copy of the tasks, and select among the results in the
+   * order of the reference lines, as the sequential Process() does.
+   */
+  common::Status ProcessInParallel(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
   common::Status PlanOnReferenceLine(
       const common::TrajectoryPoint& planning_start_point, Frame* frame,
-      ReferenceLineInfo* reference_line_info);
+      ReferenceLineInfo* reference_line_info,
+      std::vector<std::unique_ptr<Task>>* tasks);
 
   std::vector<common::SpeedPoint> DummyHotStart(
       const common::TrajectoryPoint& planning_init_point);
@@ -81,6 +92,10 @@ class LaneFollowScenario : public Scenario {
 
   std::vector<std::unique_ptr<Task>> tasks_;
 
+  // tasks of the reference lines after the first one in parallel planning,
+  // since tasks keep the state of the reference line they run on
+  std::vector<std::vector<std::unique_ptr<Task>>> parallel_tasks_;
+
   ScenarioConfig config_;
 
   SpeedProfileGenerator speed_profile_generator_;
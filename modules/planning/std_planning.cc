@@ -16,9 +16,14 @@
 
 #include "modules/planning/std_planning.h"
 
+#include <sched.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <list>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -29,6 +34,7 @@
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/math/quaternion.h"
 #include "modules/common/time/time.h"
+#include "modules/common/util/string_tokenizer.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/common/ego_info.h"
@@ -53,6 +59,30 @@ using apollo::common::time::Clock;
 using apollo::hdmap::HDMapUtil;
 using apollo::routing::RoutingResponse;
 
+namespace {
+
+// Parses the comma separated CPUs of the planning thread pool, skipping the
+// entries which are not valid CPU numbers.
+std::vector<int> ParseThreadPoolCpus(const std::string& cpus) {
+  std::vector<int> result;
+  for (const auto& cpu : common::util::StringTokenizer::Split(cpus, ",")) {
+    char* end = nullptr;
+    errno = 0;
+    const int64_t value = std::strtoll(cpu.c_str(), &end, 10);
+    if (end == cpu.c_str() || *end != '\0' || errno != 0 || value < 0 ||
+        value >= CPU_SETSIZE) {
+      AERROR << "Skip invalid CPU [" << cpu
+             << "] of planning_thread_pool_cpus, which should be in [0, "
+             << CPU_SETSIZE << ").";
+      continue;
+    }
+    result.push_back(static_cast<int>(value));
+  }
+  return result;
+}
+
+}  // namespace
+
 StdPlanning::~StdPlanning() { Stop(); }
 
 std::string StdPlanning::Name() const { return "std_planning"; }
@@ -73,7 +103,14 @@ bool IsDifferentRouting(const RoutingResponse& first,
 }
 
 Status StdPlanning::Init() {
-  common::util::ThreadPool::Init(FLAGS_max_planning_thread_pool_size);
+  common::util::ThreadPoolOptions thread_pool_options;
+  thread_pool_options.num_threads = FLAGS_max_planning_thread_pool_size;
+  thread_pool_options.max_queue_size =
+      FLAGS_planning_thread_pool_max_queue_size;
+  thread_pool_options.cpus =
+      ParseThreadPoolCpus(FLAGS_planning_thread_pool_cpus);
+  thread_pool_options.nice = FLAGS_planning_thread_pool_nice;
+  common::util::ThreadPool::Init(thread_pool_options);
   CHECK(apollo::common::util::GetProtoFromFile(FLAGS_planning_config_file,
                                                &config_))
       << "failed to load planning config file " << FLAGS_planning_config_file;
@@ -140,9 +177,11 @@ void StdPlanning::OnTimer(const ros::TimerEvent&) {
 }
 
 Status StdPlanning::Start() {
-  timer_ =
-      AdapterManager::CreateTimer(ros::Duration(1.0 / FLAGS_planning_loop_rate),
-                                  &StdPlanning::OnTimer, this);
+  if (!use_stepped_clock_) {
+    timer_ = AdapterManager::CreateTimer(
+        ros::Duration(1.0 / FLAGS_planning_loop_rate), &StdPlanning::OnTimer,
+        this);
+  }
 
   reference_line_provider_->Start();
 
@@ -367,6 +406,9 @@ Status StdPlanning::Plan(
   ptr_debug->mutable_planning_data()->set_front_clear_distance(
       EgoInfo::instance()->front_clear_distance());
   ExportReferenceLineDebug(ptr_debug);
+  if (FLAGS_enable_record_debug) {
+    frame_->RecordArenaDebug(ptr_debug);
+  }
 
   const auto* best_ref_info = frame_->FindDriveReferenceLineInfo();
   if (!best_ref_info) {
@@ -452,6 +494,8 @@ Status StdPlanning::Plan(
 
 void StdPlanning::Stop() {
   AWARN << "Planning Stop is called";
+  AINFO << "Planning thread pool: "
+        << common::util::ThreadPool::GetStats().DebugString();
   common::util::ThreadPool::Stop();
   reference_line_provider_->Stop();
   last_publishable_trajectory_.reset(nullptr);
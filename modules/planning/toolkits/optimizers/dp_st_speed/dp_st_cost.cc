@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <limits>
 
+#include "modules/common/log.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/speed/st_point.h"
 
@@ -30,24 +31,44 @@ namespace apollo {
 namespace planning {
 namespace {
 constexpr float kInf = std::numeric_limits<float>::infinity();
+
+// s of the lower and upper edges of the boundary at t, false if t is not
+// strictly inside the boundary, like StBoundary::IsPointInBoundary().
+bool GetBoundaryEdges(const StBoundary& boundary, const double t,
+                      double* lower_s, double* upper_s) {
+  const auto& lower_points = boundary.lower_points();
+  const auto& upper_points = boundary.upper_points();
+  if (lower_points.size() < 2 || t <= boundary.min_t() ||
+      t >= boundary.max_t()) {
+    return false;
+  }
+  auto comp = [](const STPoint& p, const double t) { return p.t() < t; };
+  auto first_ge =
+      std::lower_bound(lower_points.begin(), lower_points.end(), t, comp);
+  if (first_ge == lower_points.begin() || first_ge == lower_points.end()) {
+    return false;
+  }
+  const std::size_t right = std::distance(lower_points.begin(), first_ge);
+  const std::size_t left = right - 1;
+  const double r = (t - upper_points[left].t()) /
+                   (upper_points[right].t() - upper_points[left].t());
+  *upper_s = upper_points[left].s() +
+             r * (upper_points[right].s() - upper_points[left].s());
+  *lower_s = lower_points[left].s() +
+             r * (lower_points[right].s() - lower_points[left].s());
+  return true;
 }
 
+}  // namespace
+
 DpStCost::DpStCost(const DpStSpeedConfig& config,
                    const std::vector<const PathObstacle*>& obstacles,
                    const common::TrajectoryPoint& init_point)
     : config_(config), obstacles_(obstacles), init_point_(init_point) {
-  int index = 0;
-  for (auto& obstacle : obstacles) {
-    boundary_map_[obstacle->st_boundary().id()] = index++;
-  }
   unit_t_ = config_.total_time() / config_.matrix_dimension_t();
 
   AddToKeepClearRange(obstacles);
 
-  boundary_cost_.resize(obstacles_.size());
-  for (auto& vec : boundary_cost_) {
-    vec.resize(config_.matrix_dimension_t(), std::make_pair(-1.0, -1.0));
-  }
   accel_cost_.fill(-1.0);
   jerk_cost_.fill(-1.0);
 }
@@ -103,17 +124,31 @@ bool DpStCost::InKeepClearRange(float s) const {
   return false;
 }
 
-float DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
-  const float s = st_graph_point.point().s();
-  const float t = st_graph_point.point().t();
+void DpStCost::GetObstacleCosts(const std::vector<StGraphPoint>& column,
+                                const uint32_t begin, const uint32_t end,
+                                std::vector<float>* const costs) const {
+  CHECK_NOTNULL(costs);
+  CHECK_LE(end, column.size());
+  costs->assign(end > begin ? end - begin : 0, 0.0);
+  if (costs->empty()) {
+    return;
+  }
+  const std::size_t size = costs->size();
+  const float t = column[begin].point().t();
+  std::vector<float> s(size);
+  for (std::size_t k = 0; k < size; ++k) {
+    s[k] = column[begin + k].point().s();
+  }
+  std::vector<char> blocked(size, 0);
+  float* cost = costs->data();
+  const double weight =
+      config_.obstacle_weight() * config_.default_obstacle_cost();
 
-  float cost = 0.0;
   for (const auto* obstacle : obstacles_) {
     if (!obstacle->IsBlockingObstacle()) {
       continue;
     }
-
-    auto boundary = obstacle->st_boundary();
+    const auto& boundary = obstacle->st_boundary();
     const float kIgnoreDistance = 200.0;
     if (boundary.min_s() > kIgnoreDistance) {
       continue;
@@ -121,42 +156,49 @@ float DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
     if (t < boundary.min_t() || t > boundary.max_t()) {
       continue;
     }
-    if (obstacle->IsBlockingObstacle() &&
-        boundary.IsPointInBoundary(STPoint(s, t))) {
-      return kInf;
-    }
-    double s_upper = 0.0;
-    double s_lower = 0.0;
-
-    int boundary_index = boundary_map_[boundary.id()];
-    if (boundary_cost_[boundary_index][st_graph_point.index_t()].first < 0.0) {
-      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
-      boundary_cost_[boundary_index][st_graph_point.index_t()] =
-          std::make_pair(s_upper, s_lower);
-    } else {
-      s_upper = boundary_cost_[boundary_index][st_graph_point.index_t()].first;
-      s_lower = boundary_cost_[boundary_index][st_graph_point.index_t()].second;
-    }
-    if (s < s_lower) {
-      constexpr float kSafeTimeBuffer = 3.0;
-      const float len = obstacle->obstacle()->Speed() * kSafeTimeBuffer;
-      if (s + len < s_lower) {
-        continue;
-      } else {
-        cost += config_.obstacle_weight() * config_.default_obstacle_cost() *
-                std::pow((len - s_lower + s), 2);
-      }
-    } else if (s > s_upper) {
-      const float kSafeDistance = 20.0;  // or calculated from velocity
-      if (s > s_upper + kSafeDistance) {
-        continue;
-      } else {
-        cost += config_.obstacle_weight() * config_.default_obstacle_cost() *
-                std::pow((kSafeDistance + s_upper - s), 2);
+
+    // the points well inside the boundary are blocked, the ones close to its
+    // edges are checked exactly.
+    constexpr double kEdgeBuffer = 1e-3;
+    double lower_edge = 0.0;
+    double upper_edge = 0.0;
+    if (GetBoundaryEdges(boundary, t, &lower_edge, &upper_edge)) {
+      for (std::size_t k = 0; k < size; ++k) {
+        if (s[k] <= lower_edge - kEdgeBuffer ||
+            s[k] >= upper_edge + kEdgeBuffer) {
+          continue;
+        }
+        if ((s[k] > lower_edge + kEdgeBuffer &&
+             s[k] < upper_edge - kEdgeBuffer) ||
+            boundary.IsPointInBoundary(STPoint(s[k], t))) {
+          blocked[k] = 1;
+        }
       }
     }
+
+    double upper = 0.0;
+    double lower = 0.0;
+    boundary.GetBoundarySRange(t, &upper, &lower);
+    const float s_upper = upper;
+    const float s_lower = lower;
+    constexpr float kSafeTimeBuffer = 3.0;
+    const float len = obstacle->obstacle()->Speed() * kSafeTimeBuffer;
+    const float kSafeDistance = 20.0;  // or calculated from velocity
+    for (std::size_t k = 0; k < size; ++k) {
+      const float curr_s = s[k];
+      const double behind = static_cast<float>(len - s_lower + curr_s);
+      const double ahead = static_cast<float>(kSafeDistance + s_upper - curr_s);
+      const bool close_behind = curr_s < s_lower && !(curr_s + len < s_lower);
+      const bool close_ahead =
+          curr_s > s_upper && !(curr_s > s_upper + kSafeDistance);
+      cost[k] += close_behind ? weight * (behind * behind)
+                              : (close_ahead ? weight * (ahead * ahead) : 0.0);
+    }
+  }
+
+  for (std::size_t k = 0; k < size; ++k) {
+    cost[k] = blocked[k] ? kInf : cost[k] * unit_t_;
   }
-  return cost * unit_t_;
 }
 
 float DpStCost::GetReferenceCost(const STPoint& point,
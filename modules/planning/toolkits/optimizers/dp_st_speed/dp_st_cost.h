@@ -21,8 +21,7 @@
 #ifndef MODULES_PLANNING_TOOLKITS_OPTIMIZERS_DP_ST_SPEED_DP_ST_COST_H_
 #define MODULES_PLANNING_TOOLKITS_OPTIMIZERS_DP_ST_SPEED_DP_ST_COST_H_
 
-#include <string>
-#include <unordered_map>
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -43,7 +42,14 @@ class DpStCost {
                     const std::vector<const PathObstacle*>& obstacles,
                     const common::TrajectoryPoint& init_point);
 
-  float GetObstacleCost(const StGraphPoint& point);
+  /**
+   * @brief obstacle costs of the points [begin, end) of one column of the
+   * graph. The costs are computed obstacle by obstacle over all the points,
+   * in loops the compiler vectorizes.
+   */
+  void GetObstacleCosts(const std::vector<StGraphPoint>& column,
+                        const uint32_t begin, const uint32_t end,
+                        std::vector<float>* const costs) const;
 
   float GetReferenceCost(const STPoint& point,
                           const STPoint& reference_point) const;
@@ -82,9 +88,6 @@ class DpStCost {
 
   float unit_t_ = 0.0;
 
-  std::unordered_map<std::string, int> boundary_map_;
-  std::vector<std::vector<std::pair<float, float>>> boundary_cost_;
-
   std::vector<std::pair<float, float>> keep_clear_range_;
 
   std::array<float, 200> accel_cost_;
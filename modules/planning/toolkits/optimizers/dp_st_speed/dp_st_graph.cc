@@ -21,9 +21,11 @@
 #include "modules/planning/toolkits/optimizers/dp_st_speed/dp_st_graph.h"
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "modules/common/log.h"
 #include "modules/common/math/vec2d.h"
@@ -40,11 +42,14 @@ using apollo::common::SpeedPoint;
 using apollo::common::Status;
 using apollo::common::VehicleParam;
 using apollo::common::math::Vec2d;
+using apollo::common::util::TaskGroup;
 using apollo::common::util::ThreadPool;
 
 namespace {
 
 constexpr float kInf = std::numeric_limits<float>::infinity();
+// rows of a column computed by one task in the thread pool
+constexpr int kMinRowsPerTask = 16;
 
 bool CheckOverlapOnDpStGraph(const std::vector<const StBoundary*>& boundaries,
                              const StGraphPoint& p1, const StGraphPoint& p2) {
@@ -169,6 +174,7 @@ Status DpStGraph::CalculateTotalCost() {
   // s corresponding to row
   uint32_t next_highest_row = 0;
   uint32_t next_lowest_row = 0;
+  std::vector<float> obstacle_costs;
 
   for (size_t c = 0; c < cost_table_.size(); ++c) {
     int highest_row = 0;
@@ -176,19 +182,33 @@ Status DpStGraph::CalculateTotalCost() {
 
     int count = next_highest_row - next_lowest_row + 1;
     if (count > 0) {
-      std::vector<std::future<void>> futures;
-
+      // obstacle costs of the whole column at once
+      dp_st_cost_.GetObstacleCosts(cost_table_[c], next_lowest_row,
+                                   next_highest_row + 1, &obstacle_costs);
       for (uint32_t r = next_lowest_row; r <= next_highest_row; ++r) {
-        if (FLAGS_enable_multi_thread_in_dp_st_graph) {
-          futures.push_back(ThreadPool::pool()->push(
-              std::bind(&DpStGraph::CalculateCostAt, this, c, r)));
-        } else {
-          CalculateCostAt(c, r);
-        }
+        cost_table_[c][r].SetObstacleCost(obstacle_costs[r - next_lowest_row]);
       }
 
-      for (const auto& f : futures) {
-        f.wait();
+      if (FLAGS_enable_multi_thread_in_dp_st_graph) {
+        // a few coarse chunks of rows, one task per row costs more in
+        // scheduling than it saves.
+        const int num_chunks =
+            std::max(1, std::min(ThreadPool::size(),
+                                 (count + kMinRowsPerTask - 1) /
+                                     kMinRowsPerTask));
+        const uint32_t chunk_size = (count + num_chunks - 1) / num_chunks;
+        TaskGroup group;
+        for (uint32_t r_begin = next_lowest_row; r_begin <= next_highest_row;
+             r_begin += chunk_size) {
+          const uint32_t r_end =
+              std::min(r_begin + chunk_size, next_highest_row + 1);
+          group.Run([this, c, r_begin, r_end]() {
+            CalculateCostInRows(c, r_begin, r_end);
+          });
+        }
+        group.Wait();
+      } else {
+        CalculateCostInRows(c, next_lowest_row, next_highest_row + 1);
       }
     }
 
@@ -241,9 +261,15 @@ void DpStGraph::GetRowRange(const StGraphPoint& point, int* next_highest_row,
   }
 }
 
+void DpStGraph::CalculateCostInRows(const uint32_t c, const uint32_t r_begin,
+                                    const uint32_t r_end) {
+  for (uint32_t r = r_begin; r < r_end; ++r) {
+    CalculateCostAt(c, r);
+  }
+}
+
 void DpStGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
   auto& cost_cr = cost_table_[c][r];
-  cost_cr.SetObstacleCost(dp_st_cost_.GetObstacleCost(cost_cr));
   if (cost_cr.obstacle_cost() > std::numeric_limits<float>::max()) {
     return;
   }
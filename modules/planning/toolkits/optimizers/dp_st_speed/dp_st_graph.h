@@ -57,6 +57,9 @@ class DpStGraph {
 
   apollo::common::Status CalculateTotalCost();
   void CalculateCostAt(const uint32_t r, const uint32_t c);
+  // rows [r_begin, r_end) of column c
+  void CalculateCostInRows(const uint32_t c, const uint32_t r_begin,
+                           const uint32_t r_end);
 
   float CalculateEdgeCost(const STPoint& first, const STPoint& second,
                           const STPoint& third, const STPoint& forth,
@@ -19,6 +19,10 @@
  **/
 #include "modules/planning/toolkits/optimizers/dp_st_speed/dp_st_graph.h"
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "modules/common/proto/pnc_point.pb.h"
@@ -33,6 +37,46 @@
 namespace apollo {
 namespace planning {
 
+namespace {
+
+// Obstacle cost of a single point, computed directly from the boundaries.
+float PointObstacleCost(const DpStSpeedConfig& config,
+                        const std::vector<const PathObstacle*>& obstacles,
+                        const STPoint& point) {
+  const float s = point.s();
+  const float t = point.t();
+  float cost = 0.0;
+  for (const auto* obstacle : obstacles) {
+    if (!obstacle->IsBlockingObstacle()) {
+      continue;
+    }
+    const auto& boundary = obstacle->st_boundary();
+    if (boundary.min_s() > 200.0 || t < boundary.min_t() ||
+        t > boundary.max_t()) {
+      continue;
+    }
+    if (boundary.IsPointInBoundary(point)) {
+      return std::numeric_limits<float>::infinity();
+    }
+    double upper = 0.0;
+    double lower = 0.0;
+    boundary.GetBoundarySRange(t, &upper, &lower);
+    const float s_upper = upper;
+    const float s_lower = lower;
+    const float len = obstacle->obstacle()->Speed() * 3.0;
+    if (s < s_lower && s + len >= s_lower) {
+      cost += config.obstacle_weight() * config.default_obstacle_cost() *
+              std::pow(len - s_lower + s, 2);
+    } else if (s > s_upper && s <= s_upper + 20.0) {
+      cost += config.obstacle_weight() * config.default_obstacle_cost() *
+              std::pow(20.0 + s_upper - s, 2);
+    }
+  }
+  return cost * config.total_time() / config.matrix_dimension_t();
+}
+
+}  // namespace
+
 class DpStGraphTest : public ::testing::Test {
  public:
   virtual void SetUp() {
@@ -127,5 +171,47 @@ TEST_F(DpStGraphTest, simple) {
   EXPECT_TRUE(ret.ok());
 }
 
+TEST_F(DpStGraphTest, batched_obstacle_cost) {
+  Obstacle o1;
+  o1.SetId("o1");
+  obstacle_list_.push_back(o1);
+  path_obstacle_list_.emplace_back(&(obstacle_list_.back()));
+  auto& path_obstacle = path_obstacle_list_.back();
+  path_obstacle.SetBlockingObstacle(true);
+
+  std::vector<std::pair<STPoint, STPoint>> point_pairs;
+  point_pairs.emplace_back(STPoint(20.0, 1.0), STPoint(30.0, 1.0));
+  point_pairs.emplace_back(STPoint(35.0, 4.0), STPoint(47.0, 4.0));
+  point_pairs.emplace_back(STPoint(40.0, 7.0), STPoint(50.0, 7.0));
+  path_obstacle.SetStBoundary(StBoundary(point_pairs));
+
+  std::vector<const PathObstacle*> obstacles;
+  obstacles.push_back(&path_obstacle);
+  DpStCost dp_st_cost(dp_config_, obstacles, init_point_);
+
+  constexpr uint32_t kDimS = 150;
+  constexpr float kUnitS = 0.5;
+  const uint32_t dim_t = dp_config_.matrix_dimension_t();
+  for (uint32_t i = 0; i < dim_t; ++i) {
+    const float t = 0.13 + i * 7.5 / dim_t;
+    std::vector<StGraphPoint> column(kDimS);
+    for (uint32_t j = 0; j < kDimS; ++j) {
+      column[j].Init(i, j, STPoint(j * kUnitS, t));
+    }
+    std::vector<float> costs;
+    dp_st_cost.GetObstacleCosts(column, 10, kDimS, &costs);
+    ASSERT_EQ(kDimS - 10, costs.size());
+    for (uint32_t j = 10; j < kDimS; ++j) {
+      const float expected =
+          PointObstacleCost(dp_config_, obstacles, column[j].point());
+      if (std::isinf(expected)) {
+        EXPECT_TRUE(std::isinf(costs[j - 10]));
+      } else {
+        EXPECT_NEAR(expected, costs[j - 10], 1e-4 * expected);
+      }
+    }
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -46,7 +46,7 @@ using apollo::common::SLPoint;
 using apollo::common::Status;
 using apollo::common::math::CartesianFrenetConverter;
 using apollo::common::util::MakeSLPoint;
-using apollo::common::util::ThreadPool;
+using apollo::common::util::TaskGroup;
 
 DpRoadGraph::DpRoadGraph(const DpPolyPathConfig &config,
                          const ReferenceLineInfo &reference_line_info,
@@ -140,7 +140,8 @@ bool DpRoadGraph::GenerateMinCostPath(
 
   TrajectoryCost trajectory_cost(
       config_, reference_line_, reference_line_info_.IsChangeLanePath(),
-      obstacles, vehicle_config.vehicle_param(), speed_data_, init_sl_point_);
+      obstacles, vehicle_config.vehicle_param(), speed_data_, init_sl_point_,
+      reference_line_info_.obstacle_occupancy());
 
   std::list<std::list<DpRoadGraphNode>> graph_nodes;
   graph_nodes.emplace_back();
@@ -154,7 +155,7 @@ bool DpRoadGraph::GenerateMinCostPath(
 
     graph_nodes.emplace_back();
 
-    std::vector<std::future<void>> futures;
+    TaskGroup group;
 
     for (size_t i = 0; i < level_points.size(); ++i) {
       const auto &cur_point = level_points[i];
@@ -162,19 +163,18 @@ bool DpRoadGraph::GenerateMinCostPath(
       graph_nodes.back().emplace_back(cur_point, nullptr);
       auto &cur_node = graph_nodes.back().back();
       if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-        futures.push_back(ThreadPool::pool()->push(std::bind(
-            &DpRoadGraph::UpdateNode, this, std::ref(prev_dp_nodes), level,
-            total_level, &trajectory_cost, &(front), &(cur_node))));
-
+        group.Run([this, &prev_dp_nodes, level, total_level,
+                   &trajectory_cost, &front, &cur_node]() {
+          UpdateNode(prev_dp_nodes, level, total_level, &trajectory_cost,
+                     &front, &cur_node);
+        });
       } else {
         UpdateNode(prev_dp_nodes, level, total_level, &trajectory_cost, &front,
                    &cur_node);
       }
     }
 
-    for (const auto &f : futures) {
-      f.wait();
-    }
+    group.Wait();
   }
 
   // find best path
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include "modules/common/proto/pnc_point.pb.h"
 
@@ -36,22 +37,32 @@ namespace apollo {
 namespace planning {
 
 using apollo::common::TrajectoryPoint;
+using apollo::common::math::AABox2d;
 using apollo::common::math::Box2d;
 using apollo::common::math::Sigmoid;
 using apollo::common::math::Vec2d;
 
+namespace {
+
+// expansion of the dynamic obstacle boxes
+constexpr float kDynamicObstacleBuff = 0.5;
+
+}  // namespace
+
 TrajectoryCost::TrajectoryCost(
     const DpPolyPathConfig &config, const ReferenceLine &reference_line,
     const bool is_change_lane_path,
     const std::vector<const PathObstacle *> &obstacles,
     const common::VehicleParam &vehicle_param,
-    const SpeedData &heuristic_speed_data, const common::SLPoint &init_sl_point)
+    const SpeedData &heuristic_speed_data, const common::SLPoint &init_sl_point,
+    const ObstacleOccupancy *obstacle_occupancy)
     : config_(config),
       reference_line_(&reference_line),
       is_change_lane_path_(is_change_lane_path),
       vehicle_param_(vehicle_param),
       heuristic_speed_data_(heuristic_speed_data),
-      init_sl_point_(init_sl_point) {
+      init_sl_point_(init_sl_point),
+      obstacle_occupancy_(obstacle_occupancy) {
   const float total_time =
       std::min(heuristic_speed_data_.TotalTime(), FLAGS_prediction_total_time);
 
@@ -92,19 +103,33 @@ TrajectoryCost::TrajectoryCost(
     } else {
       std::vector<Box2d> box_by_time;
       for (uint32_t t = 0; t <= num_of_time_stamps_; ++t) {
-        TrajectoryPoint trajectory_point =
-            ptr_obstacle->GetPointAtTime(t * config.eval_time_interval());
-
-        Box2d obstacle_box = ptr_obstacle->GetBoundingBox(trajectory_point);
-        constexpr float kBuff = 0.5;
+        const double relative_time = t * config.eval_time_interval();
+        Box2d obstacle_box =
+            obstacle_occupancy_ != nullptr
+                ? obstacle_occupancy_->GetBoundingBox(*ptr_obstacle,
+                                                      relative_time)
+                : ptr_obstacle->GetBoundingBox(
+                      ptr_obstacle->GetPointAtTime(relative_time));
         Box2d expanded_obstacle_box =
             Box2d(obstacle_box.center(), obstacle_box.heading(),
-                  obstacle_box.length() + kBuff, obstacle_box.width() + kBuff);
+                  obstacle_box.length() + kDynamicObstacleBuff,
+                  obstacle_box.width() + kDynamicObstacleBuff);
         box_by_time.push_back(expanded_obstacle_box);
       }
+      dynamic_obstacle_index_[ptr_obstacle] = dynamic_obstacle_boxes_.size();
       dynamic_obstacle_boxes_.push_back(std::move(box_by_time));
     }
   }
+
+  // the index can only prune the obstacles it knows about
+  if (obstacle_occupancy_ != nullptr) {
+    for (const auto &entry : dynamic_obstacle_index_) {
+      if (obstacle_occupancy_->GetBoundingBoxes(*entry.first) == nullptr) {
+        obstacle_occupancy_ = nullptr;
+        break;
+      }
+    }
+  }
 }
 
 ComparableCost TrajectoryCost::CalculatePathCost(
@@ -194,9 +219,37 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
 
     const common::SLPoint sl = common::util::MakeSLPoint(ref_s, l);
     const Box2d ego_box = GetBoxFromSLPoint(sl, dl);
-    for (const auto &obstacle_trajectory : dynamic_obstacle_boxes_) {
-      obstacle_cost +=
-          GetCostBetweenObsBoxes(ego_box, obstacle_trajectory.at(index));
+    const int slice = obstacle_occupancy_ != nullptr
+                          ? obstacle_occupancy_->TimeSlice(
+                                index * config_.eval_time_interval())
+                          : -1;
+    if (slice < 0) {
+      for (const auto &obstacle_trajectory : dynamic_obstacle_boxes_) {
+        obstacle_cost +=
+            GetCostBetweenObsBoxes(ego_box, obstacle_trajectory.at(index));
+      }
+      continue;
+    }
+
+    // obstacles farther than the ignore distance do not add any cost, only
+    // visit the ones the occupancy index finds around the ego box.
+    const AABox2d ego_aabox = ego_box.GetAABox();
+    const double margin =
+        2.0 * (config_.obstacle_ignore_distance() + kDynamicObstacleBuff);
+    const AABox2d region(ego_aabox.center(), ego_aabox.length() + margin,
+                         ego_aabox.width() + margin);
+    std::vector<size_t> candidates;
+    for (const auto *obstacle :
+         obstacle_occupancy_->QueryObstacles(slice, region)) {
+      auto iter = dynamic_obstacle_index_.find(obstacle);
+      if (iter != dynamic_obstacle_index_.end()) {
+        candidates.push_back(iter->second);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const size_t i : candidates) {
+      obstacle_cost += GetCostBetweenObsBoxes(
+          ego_box, dynamic_obstacle_boxes_[i].at(index));
     }
   }
   constexpr float kDynamicObsWeight = 1e-6;
@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_TOOLKITS_OPTIMIZERS_DP_POLY_PATH_TRAJECTORY_COST_H_
 #define MODULES_PLANNING_TOOLKITS_OPTIMIZERS_DP_POLY_PATH_TRAJECTORY_COST_H_
 
+#include <unordered_map>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
@@ -28,6 +29,7 @@
 
 #include "modules/common/math/box2d.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/obstacle_occupancy.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/speed_data.h"
 #include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
@@ -40,13 +42,14 @@ namespace planning {
 class TrajectoryCost {
  public:
   TrajectoryCost() = default;
-  explicit TrajectoryCost(const DpPolyPathConfig &config,
-                          const ReferenceLine &reference_line,
-                          const bool is_change_lane_path,
-                          const std::vector<const PathObstacle *> &obstacles,
-                          const common::VehicleParam &vehicle_param,
-                          const SpeedData &heuristic_speed_data,
-                          const common::SLPoint &init_sl_point);
+  explicit TrajectoryCost(
+      const DpPolyPathConfig &config, const ReferenceLine &reference_line,
+      const bool is_change_lane_path,
+      const std::vector<const PathObstacle *> &obstacles,
+      const common::VehicleParam &vehicle_param,
+      const SpeedData &heuristic_speed_data,
+      const common::SLPoint &init_sl_point,
+      const ObstacleOccupancy *obstacle_occupancy = nullptr);
   ComparableCost Calculate(const QuinticPolynomialCurve1d &curve,
                            const float start_s, const float end_s,
                            const uint32_t curr_level,
@@ -82,6 +85,10 @@ class TrajectoryCost {
   const common::SLPoint init_sl_point_;
   uint32_t num_of_time_stamps_ = 0;
   std::vector<std::vector<common::math::Box2d>> dynamic_obstacle_boxes_;
+  // shared space-time index of the reference line obstacles, may be nullptr
+  const ObstacleOccupancy *obstacle_occupancy_ = nullptr;
+  // index into dynamic_obstacle_boxes_ of each dynamic obstacle
+  std::unordered_map<const Obstacle *, size_t> dynamic_obstacle_index_;
   std::vector<float> obstacle_probabilities_;
 
   std::vector<SLBoundary> static_obstacle_sl_boundaries_;
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/toolkits/optimizers/st_graph/path_box_hierarchy.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::AABox2d;
+using apollo::common::math::Box2d;
+
+namespace {
+// ranges of at most this many boxes are not split further
+constexpr int kLeafSize = 4;
+}  // namespace
+
+PathBoxHierarchy::PathBoxHierarchy(std::vector<Box2d> boxes)
+    : boxes_(std::move(boxes)) {
+  if (boxes_.empty()) {
+    return;
+  }
+  node_aaboxes_.resize(4 * boxes_.size());
+  Build(0, 0, size());
+}
+
+void PathBoxHierarchy::Build(const int node, const int lo, const int hi) {
+  if (hi - lo <= kLeafSize) {
+    AABox2d aabox = boxes_[lo].GetAABox();
+    for (int i = lo + 1; i < hi; ++i) {
+      aabox.MergeFrom(boxes_[i].GetAABox());
+    }
+    node_aaboxes_[node] = aabox;
+    return;
+  }
+  const int mid = lo + (hi - lo) / 2;
+  Build(2 * node + 1, lo, mid);
+  Build(2 * node + 2, mid, hi);
+  node_aaboxes_[node] = node_aaboxes_[2 * node + 1];
+  node_aaboxes_[node].MergeFrom(node_aaboxes_[2 * node + 2]);
+}
+
+int PathBoxHierarchy::FirstOverlap(const Box2d& box, const int begin,
+                                   const int end) const {
+  if (boxes_.empty() || begin >= end) {
+    return -1;
+  }
+  return Query(0, 0, size(), box, box.GetAABox(), std::max(begin, 0),
+               std::min(end, size()), true);
+}
+
+int PathBoxHierarchy::LastOverlap(const Box2d& box, const int begin,
+                                  const int end) const {
+  if (boxes_.empty() || begin >= end) {
+    return -1;
+  }
+  return Query(0, 0, size(), box, box.GetAABox(), std::max(begin, 0),
+               std::min(end, size()), false);
+}
+
+int PathBoxHierarchy::Query(const int node, const int lo, const int hi,
+                            const Box2d& box, const AABox2d& aabox,
+                            const int begin, const int end,
+                            const bool first) const {
+  if (hi <= begin || lo >= end || !node_aaboxes_[node].HasOverlap(aabox)) {
+    return -1;
+  }
+  if (hi - lo <= kLeafSize) {
+    const int from = std::max(lo, begin);
+    const int to = std::min(hi, end);
+    if (first) {
+      for (int i = from; i < to; ++i) {
+        if (boxes_[i].HasOverlap(box)) {
+          return i;
+        }
+      }
+    } else {
+      for (int i = to - 1; i >= from; --i) {
+        if (boxes_[i].HasOverlap(box)) {
+          return i;
+        }
+      }
+    }
+    return -1;
+  }
+  const int mid = lo + (hi - lo) / 2;
+  const int near_node = first ? 2 * node + 1 : 2 * node + 2;
+  const int far_node = first ? 2 * node + 2 : 2 * node + 1;
+  const int near_lo = first ? lo : mid;
+  const int near_hi = first ? mid : hi;
+  const int far_lo = first ? mid : lo;
+  const int far_hi = first ? hi : mid;
+  const int index =
+      Query(near_node, near_lo, near_hi, box, aabox, begin, end, first);
+  if (index >= 0) {
+    return index;
+  }
+  return Query(far_node, far_lo, far_hi, box, aabox, begin, end, first);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Bounding volume hierarchy over the ADC boxes along a path.
+ **/
+
+#ifndef MODULES_PLANNING_TOOLKITS_OPTIMIZERS_ST_GRAPH_PATH_BOX_HIERARCHY_H_
+#define MODULES_PLANNING_TOOLKITS_OPTIMIZERS_ST_GRAPH_PATH_BOX_HIERARCHY_H_
+
+#include <vector>
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/box2d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class PathBoxHierarchy
+ * @brief Answers which of a sequence of boxes, ordered along the path,
+ * overlaps a query box.
+ *
+ * Consecutive boxes along a path are spatially coherent, so the hierarchy is
+ * built over index ranges: every node keeps the axis-aligned bounding box of
+ * its range and the two children split the range in halves. Queries descend
+ * in path order and skip the ranges whose bounding box misses the query box.
+ */
+class PathBoxHierarchy {
+ public:
+  explicit PathBoxHierarchy(std::vector<common::math::Box2d> boxes);
+
+  /**
+   * @brief the index of the first box in [begin, end) overlapping the
+   * given box, -1 if there is none.
+   */
+  int FirstOverlap(const common::math::Box2d& box, const int begin,
+                   const int end) const;
+
+  /**
+   * @brief the index of the last box in [begin, end) overlapping the given
+   * box, -1 if there is none.
+   */
+  int LastOverlap(const common::math::Box2d& box, const int begin,
+                  const int end) const;
+
+  int size() const { return static_cast<int>(boxes_.size()); }
+
+  const common::math::Box2d& box(const int index) const {
+    return boxes_[index];
+  }
+
+ private:
+  void Build(const int node, const int lo, const int hi);
+
+  int Query(const int node, const int lo, const int hi,
+            const common::math::Box2d& box,
+            const common::math::AABox2d& aabox, const int begin,
+            const int end, const bool first) const;
+
+  std::vector<common::math::Box2d> boxes_;
+  // bounding box of every node, node i has children 2i + 1 and 2i + 2
+  std::vector<common::math::AABox2d> node_aaboxes_;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_TOOLKITS_OPTIMIZERS_ST_GRAPH_PATH_BOX_HIERARCHY_H_
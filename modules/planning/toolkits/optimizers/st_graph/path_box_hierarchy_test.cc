@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/toolkits/optimizers/st_graph/path_box_hierarchy.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+class PathBoxHierarchyTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    // a car-sized box every meter along a quarter circle of radius 50
+    for (int i = 0; i < 80; ++i) {
+      const double theta = i / 50.0;
+      boxes_.emplace_back(
+          Vec2d(50.0 * std::sin(theta), 50.0 - 50.0 * std::cos(theta)), theta,
+          4.0, 2.0);
+    }
+  }
+
+  // the answer of a linear scan
+  int FirstOverlap(const Box2d& box, const int begin, const int end) const {
+    for (int i = begin; i < end; ++i) {
+      if (boxes_[i].HasOverlap(box)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  int LastOverlap(const Box2d& box, const int begin, const int end) const {
+    for (int i = end - 1; i >= begin; --i) {
+      if (boxes_[i].HasOverlap(box)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+ protected:
+  std::vector<Box2d> boxes_;
+};
+
+TEST_F(PathBoxHierarchyTest, MatchesLinearScan) {
+  PathBoxHierarchy hierarchy(boxes_);
+  EXPECT_EQ(80, hierarchy.size());
+
+  for (double x = -5.0; x < 60.0; x += 2.5) {
+    for (double y = -5.0; y < 40.0; y += 2.5) {
+      const Box2d box(Vec2d(x, y), 0.3, 5.0, 2.0);
+      EXPECT_EQ(FirstOverlap(box, 0, 80), hierarchy.FirstOverlap(box, 0, 80));
+      EXPECT_EQ(LastOverlap(box, 0, 80), hierarchy.LastOverlap(box, 0, 80));
+      EXPECT_EQ(FirstOverlap(box, 13, 37),
+                hierarchy.FirstOverlap(box, 13, 37));
+      EXPECT_EQ(LastOverlap(box, 13, 37), hierarchy.LastOverlap(box, 13, 37));
+    }
+  }
+}
+
+TEST_F(PathBoxHierarchyTest, NoOverlap) {
+  PathBoxHierarchy hierarchy(boxes_);
+  const Box2d far_away(Vec2d(-100.0, -100.0), 0.0, 5.0, 2.0);
+  EXPECT_EQ(-1, hierarchy.FirstOverlap(far_away, 0, 80));
+  EXPECT_EQ(-1, hierarchy.LastOverlap(far_away, 0, 80));
+
+  const Box2d at_start(Vec2d(0.0, 0.0), 0.0, 1.0, 1.0);
+  EXPECT_EQ(-1, hierarchy.FirstOverlap(at_start, 10, 80));
+  EXPECT_EQ(-1, hierarchy.FirstOverlap(at_start, 5, 5));
+
+  PathBoxHierarchy empty_hierarchy({});
+  EXPECT_EQ(-1, empty_hierarchy.FirstOverlap(at_start, 0, 1));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -21,6 +21,8 @@
 #include "modules/planning/toolkits/optimizers/st_graph/st_boundary_mapper.h"
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <limits>
 #include <unordered_map>
 #include <utility>
@@ -34,6 +36,7 @@
 #include "modules/common/math/vec2d.h"
 #include "modules/common/util/file.h"
 #include "modules/common/util/string_util.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/common/util/util.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/planning/common/frame.h"
@@ -51,10 +54,13 @@ using apollo::common::VehicleParam;
 using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
 using apollo::common::util::StrCat;
+using apollo::common::util::TaskGroup;
 
 namespace {
 constexpr double boundary_t_buffer = 0.1;
 constexpr double boundary_s_buffer = 1.0;
+// number of points the path is resampled to for dynamic obstacles
+constexpr int default_num_point = 50;
 }  // namespace
 
 StBoundaryMapper::StBoundaryMapper(const SLBoundary& adc_sl_boundary,
@@ -71,7 +77,51 @@ StBoundaryMapper::StBoundaryMapper(const SLBoundary& adc_sl_boundary,
       vehicle_param_(common::VehicleConfigHelper::GetConfig().vehicle_param()),
       planning_distance_(planning_distance),
       planning_time_(planning_time),
-      is_change_lane_(is_change_lane) {}
+      is_change_lane_(is_change_lane) {
+  BuildPathBoxes();
+}
+
+void StBoundaryMapper::BuildPathBoxes() {
+  const auto& path_points = path_data_.discretized_path().path_points();
+  if (path_points.empty()) {
+    return;
+  }
+  const double buffer = st_boundary_config_.boundary_buffer();
+
+  std::vector<Box2d> point_boxes;
+  for (const auto& path_point : path_points) {
+    if (path_point.s() > planning_distance_) {
+      break;
+    }
+    point_boxes.push_back(GetAdcBox(path_point, buffer));
+  }
+  path_point_boxes_.reset(new PathBoxHierarchy(std::move(point_boxes)));
+
+  if (path_points.size() > 2 * default_num_point) {
+    const int ratio = path_points.size() / default_num_point;
+    std::vector<PathPoint> sampled_path_points;
+    for (size_t i = 0; i < path_points.size(); ++i) {
+      if (i % ratio == 0) {
+        sampled_path_points.push_back(path_points[i]);
+      }
+    }
+    sampled_path_.set_path_points(sampled_path_points);
+  } else {
+    sampled_path_.set_path_points(path_points);
+  }
+
+  std::vector<Box2d> sampled_boxes;
+  const double step_length = vehicle_param_.front_edge_to_center();
+  if (step_length > 0.0) {
+    for (double path_s = 0.0; path_s < sampled_path_.Length();
+         path_s += step_length) {
+      sampled_boxes.push_back(GetAdcBox(
+          sampled_path_.Evaluate(path_s + sampled_path_.StartPoint().s()),
+          buffer));
+    }
+  }
+  sampled_path_boxes_.reset(new PathBoxHierarchy(std::move(sampled_boxes)));
+}
 
 Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   const auto& path_obstacles = path_decision->path_obstacles();
@@ -90,14 +140,35 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
                   "Fail to get params because of too few path points");
   }
 
+  // every obstacle except the stop obstacle is mapped on its own
+  std::vector<PathObstacle*> mutable_path_obstacles;
+  for (const auto* const_path_obstacle : path_obstacles.Items()) {
+    mutable_path_obstacles.push_back(
+        path_decision->Find(const_path_obstacle->Id()));
+  }
+  std::vector<Status> map_status(mutable_path_obstacles.size());
+  if (FLAGS_enable_multi_thread_in_st_boundary_mapper) {
+    TaskGroup group;
+    for (size_t i = 0; i < mutable_path_obstacles.size(); ++i) {
+      group.Run([this, &mutable_path_obstacles, &map_status, i]() {
+        map_status[i] = MapObstacle(mutable_path_obstacles[i]);
+      });
+    }
+    group.Wait();
+  } else {
+    for (size_t i = 0; i < mutable_path_obstacles.size(); ++i) {
+      map_status[i] = MapObstacle(mutable_path_obstacles[i]);
+    }
+  }
+
   PathObstacle* stop_obstacle = nullptr;
   ObjectDecisionType stop_decision;
   double min_stop_s = std::numeric_limits<double>::max();
 
-  for (const auto* const_path_obstacle : path_obstacles.Items()) {
-    auto* path_obstacle = path_decision->Find(const_path_obstacle->Id());
+  for (size_t i = 0; i < mutable_path_obstacles.size(); ++i) {
+    auto* path_obstacle = mutable_path_obstacles[i];
     if (!path_obstacle->HasLongitudinalDecision()) {
-      if (!MapWithoutDecision(path_obstacle).ok()) {
+      if (!map_status[i].ok()) {
         std::string msg = StrCat("Fail to map obstacle ", path_obstacle->Id(),
                                  " without decision.");
         AERROR << msg;
@@ -126,7 +197,7 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
       }
     } else if (decision.has_follow() || decision.has_overtake() ||
                decision.has_yield()) {
-      if (!MapWithDecision(path_obstacle, decision).ok()) {
+      if (!map_status[i].ok()) {
         AERROR << "Fail to map obstacle " << path_obstacle->Id()
                << " with decision: " << decision.DebugString();
         return Status(ErrorCode::PLANNING_ERROR,
@@ -247,6 +318,18 @@ Status StBoundaryMapper::CreateStBoundaryWithHistory(
   return Status::OK();
 }
 
+Status StBoundaryMapper::MapObstacle(PathObstacle* path_obstacle) const {
+  if (!path_obstacle->HasLongitudinalDecision()) {
+    return MapWithoutDecision(path_obstacle);
+  }
+  const auto& decision = path_obstacle->LongitudinalDecision();
+  if (decision.has_follow() || decision.has_overtake() ||
+      decision.has_yield()) {
+    return MapWithDecision(path_obstacle, decision);
+  }
+  return Status::OK();
+}
+
 bool StBoundaryMapper::MapStopDecision(
     PathObstacle* stop_obstacle,
     const ObjectDecisionType& stop_decision) const {
@@ -301,8 +384,7 @@ Status StBoundaryMapper::MapWithoutDecision(PathObstacle* path_obstacle) const {
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path().path_points(),
-                                *(path_obstacle->obstacle()), &upper_points,
+  if (!GetOverlapBoundaryPoints(*(path_obstacle->obstacle()), &upper_points,
                                 &lower_points)) {
     return Status::OK();
   }
@@ -325,16 +407,15 @@ Status StBoundaryMapper::MapWithoutDecision(PathObstacle* path_obstacle) const {
 }
 
 bool StBoundaryMapper::GetOverlapBoundaryPoints(
-    const std::vector<PathPoint>& path_points, const Obstacle& obstacle,
-    std::vector<STPoint>* upper_points,
+    const Obstacle& obstacle, std::vector<STPoint>* upper_points,
     std::vector<STPoint>* lower_points) const {
   DCHECK_NOTNULL(upper_points);
   DCHECK_NOTNULL(lower_points);
   DCHECK(upper_points->empty());
   DCHECK(lower_points->empty());
-  DCHECK_GT(path_points.size(), 0);
 
-  if (path_points.empty()) {
+  const auto& path_points = path_data_.discretized_path().path_points();
+  if (path_points.empty() || !path_point_boxes_ || !sampled_path_boxes_) {
     AERROR << "No points in path_data_.discretized_path().";
     return false;
   }
@@ -346,112 +427,95 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
             << "] has NO prediction trajectory."
             << obstacle.Perception().ShortDebugString();
     }
-    for (const auto& curr_point_on_path : path_points) {
-      if (curr_point_on_path.s() > planning_distance_) {
-        break;
-      }
-      const Box2d obs_box = obstacle.PerceptionBoundingBox();
-
-      if (CheckOverlap(curr_point_on_path, obs_box,
-                       st_boundary_config_.boundary_buffer())) {
-        const double backward_distance = -vehicle_param_.front_edge_to_center();
-        const double forward_distance = vehicle_param_.length() +
-                                        vehicle_param_.width() +
-                                        obs_box.length() + obs_box.width();
-        double low_s =
-            std::fmax(0.0, curr_point_on_path.s() + backward_distance);
-        double high_s = std::fmin(planning_distance_,
-                                  curr_point_on_path.s() + forward_distance);
-        lower_points->emplace_back(low_s, 0.0);
-        lower_points->emplace_back(low_s, planning_time_);
-        upper_points->emplace_back(high_s, 0.0);
-        upper_points->emplace_back(high_s, planning_time_);
-        break;
-      }
+    const Box2d obs_box = obstacle.PerceptionBoundingBox();
+    const int index =
+        path_point_boxes_->FirstOverlap(obs_box, 0, path_point_boxes_->size());
+    if (index >= 0) {
+      const auto& curr_point_on_path = path_points[index];
+      const double backward_distance = -vehicle_param_.front_edge_to_center();
+      const double forward_distance = vehicle_param_.length() +
+                                      vehicle_param_.width() +
+                                      obs_box.length() + obs_box.width();
+      double low_s = std::fmax(0.0, curr_point_on_path.s() + backward_distance);
+      double high_s = std::fmin(planning_distance_,
+                                curr_point_on_path.s() + forward_distance);
+      lower_points->emplace_back(low_s, 0.0);
+      lower_points->emplace_back(low_s, planning_time_);
+      upper_points->emplace_back(high_s, 0.0);
+      upper_points->emplace_back(high_s, planning_time_);
     }
   } else {
-    const int default_num_point = 50;
-    DiscretizedPath discretized_path;
-    if (path_points.size() > 2 * default_num_point) {
-      const int ratio = path_points.size() / default_num_point;
-      std::vector<PathPoint> sampled_path_points;
-      for (size_t i = 0; i < path_points.size(); ++i) {
-        if (i % ratio == 0) {
-          sampled_path_points.push_back(path_points[i]);
-        }
-      }
-      discretized_path.set_path_points(sampled_path_points);
-    } else {
-      discretized_path.set_path_points(path_points);
-    }
+    const double buffer = st_boundary_config_.boundary_buffer();
+    const double step_length = vehicle_param_.front_edge_to_center();
+    const double path_length = sampled_path_.Length();
+    const double default_min_step = 0.1;  // in meters
+    const double fine_tuning_step_length =
+        std::fmin(default_min_step, path_length / default_num_point);
+    auto overlap_at = [this, buffer](const double s, const Box2d& obs_box) {
+      return CheckOverlap(
+          sampled_path_.Evaluate(s + sampled_path_.StartPoint().s()), obs_box,
+          buffer);
+    };
+
     for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
       const auto& trajectory_point = trajectory.trajectory_point(i);
-      const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
-
       double trajectory_point_time = trajectory_point.relative_time();
       constexpr double kNegtiveTimeThreshold = -1.0;
       if (trajectory_point_time < kNegtiveTimeThreshold) {
         continue;
       }
 
-      const double step_length = vehicle_param_.front_edge_to_center();
-      for (double path_s = 0.0; path_s < discretized_path.Length();
-           path_s += step_length) {
-        const auto curr_adc_path_point = discretized_path.Evaluate(
-            path_s + discretized_path.StartPoint().s());
-        if (CheckOverlap(curr_adc_path_point, obs_box,
-                         st_boundary_config_.boundary_buffer())) {
-          // found overlap, start searching with higher resolution
-          const double backward_distance = -step_length;
-          const double forward_distance = vehicle_param_.length() +
-                                          vehicle_param_.width() +
-                                          obs_box.length() + obs_box.width();
-          const double default_min_step = 0.1;  // in meters
-          const double fine_tuning_step_length = std::fmin(
-              default_min_step, discretized_path.Length() / default_num_point);
-
-          bool find_low = false;
-          bool find_high = false;
-          double low_s = std::fmax(0.0, path_s + backward_distance);
-          double high_s =
-              std::fmin(discretized_path.Length(), path_s + forward_distance);
-
-          while (low_s < high_s) {
-            if (find_low && find_high) {
-              break;
-            }
-            if (!find_low) {
-              const auto& point_low = discretized_path.Evaluate(
-                  low_s + discretized_path.StartPoint().s());
-              if (!CheckOverlap(point_low, obs_box,
-                                st_boundary_config_.boundary_buffer())) {
-                low_s += fine_tuning_step_length;
-              } else {
-                find_low = true;
-              }
-            }
-            if (!find_high) {
-              const auto& point_high = discretized_path.Evaluate(
-                  high_s + discretized_path.StartPoint().s());
-              if (!CheckOverlap(point_high, obs_box,
-                                st_boundary_config_.boundary_buffer())) {
-                high_s -= fine_tuning_step_length;
-              } else {
-                find_high = true;
-              }
-            }
+      const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
+      const int first_index = sampled_path_boxes_->FirstOverlap(
+          obs_box, 0, sampled_path_boxes_->size());
+      if (first_index < 0) {
+        continue;
+      }
+
+      // found overlap, bisect the s-interval between the coarse boxes
+      const double path_s = first_index * step_length;
+      const double forward_distance = vehicle_param_.length() +
+                                      vehicle_param_.width() +
+                                      obs_box.length() + obs_box.width();
+      double low_s = std::fmax(0.0, path_s - step_length);
+      double high_s = std::fmin(path_length, path_s + forward_distance);
+
+      if (!overlap_at(low_s, obs_box)) {
+        double s_outside = low_s;
+        double s_inside = path_s;
+        while (s_inside - s_outside > fine_tuning_step_length) {
+          const double s_mid = 0.5 * (s_inside + s_outside);
+          if (overlap_at(s_mid, obs_box)) {
+            s_inside = s_mid;
+          } else {
+            s_outside = s_mid;
           }
-          if (find_high && find_low) {
-            lower_points->emplace_back(
-                low_s - st_boundary_config_.point_extension(),
-                trajectory_point_time);
-            upper_points->emplace_back(
-                high_s + st_boundary_config_.point_extension(),
-                trajectory_point_time);
+        }
+        low_s = s_inside;
+      }
+
+      if (!overlap_at(high_s, obs_box)) {
+        // the last coarse box overlapping before high_s brackets the exit
+        const int last_index = sampled_path_boxes_->LastOverlap(
+            obs_box, first_index,
+            static_cast<int>(std::floor(high_s / step_length)) + 1);
+        double s_inside = std::max(first_index, last_index) * step_length;
+        double s_outside = std::fmin(high_s, s_inside + step_length);
+        while (s_outside - s_inside > fine_tuning_step_length) {
+          const double s_mid = 0.5 * (s_inside + s_outside);
+          if (overlap_at(s_mid, obs_box)) {
+            s_inside = s_mid;
+          } else {
+            s_outside = s_mid;
           }
-          break;
         }
+        high_s = s_inside;
       }
+
+      lower_points->emplace_back(low_s - st_boundary_config_.point_extension(),
+                                 trajectory_point_time);
+      upper_points->emplace_back(high_s + st_boundary_config_.point_extension(),
+                                 trajectory_point_time);
     }
   }
   DCHECK_EQ(lower_points->size(), upper_points->size());
@@ -468,8 +532,7 @@ Status StBoundaryMapper::MapWithDecision(
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path().path_points(),
-                                *(path_obstacle->obstacle()), &upper_points,
+  if (!GetOverlapBoundaryPoints(*(path_obstacle->obstacle()), &upper_points,
                                 &lower_points)) {
     return Status::OK();
   }
@@ -520,6 +583,11 @@ Status StBoundaryMapper::MapWithDecision(
 bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
                                     const Box2d& obs_box,
                                     const double buffer) const {
+  return obs_box.HasOverlap(GetAdcBox(path_point, buffer));
+}
+
+Box2d StBoundaryMapper::GetAdcBox(const PathPoint& path_point,
+                                  const double buffer) const {
   double left_delta_l = 0.0;
   double right_delta_l = 0.0;
   if (is_change_lane_) {
@@ -541,10 +609,8 @@ bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
           .rotate(path_point.theta());
   Vec2d center = Vec2d(path_point.x(), path_point.y()) + vec_to_center;
 
-  const Box2d adc_box =
-      Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
-            vehicle_param_.width() + 2 * buffer);
-  return obs_box.HasOverlap(adc_box);
+  return Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
+               vehicle_param_.width() + 2 * buffer);
 }
 
 }  // namespace planning
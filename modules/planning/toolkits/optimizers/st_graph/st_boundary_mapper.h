@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_TOOLKITS_OPTIMIZERS_ST_GRAPH_ST_BOUNDARY_MAPPER_H_
 #define MODULES_PLANNING_TOOLKITS_OPTIMIZERS_ST_GRAPH_ST_BOUNDARY_MAPPER_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -33,6 +34,7 @@
 #include "modules/planning/common/speed/st_boundary.h"
 #include "modules/planning/common/speed_limit.h"
 #include "modules/planning/reference_line/reference_line.h"
+#include "modules/planning/toolkits/optimizers/st_graph/path_box_hierarchy.h"
 
 namespace apollo {
 namespace planning {
@@ -63,15 +65,29 @@ class StBoundaryMapper {
                     const apollo::common::math::Box2d& obs_box,
                     const double buffer) const;
 
+  apollo::common::math::Box2d GetAdcBox(
+      const apollo::common::PathPoint& path_point, const double buffer) const;
+
+  /**
+   * Builds the adc boxes along the path once, they are shared by all
+   * obstacles.
+   */
+  void BuildPathBoxes();
+
   /**
    * Creates valid st boundary upper_points and lower_points
    * If return true, upper_points.size() > 1 and
    * upper_points.size() = lower_points.size()
    */
-  bool GetOverlapBoundaryPoints(
-      const std::vector<apollo::common::PathPoint>& path_points,
-      const Obstacle& obstacle, std::vector<STPoint>* upper_points,
-      std::vector<STPoint>* lower_points) const;
+  bool GetOverlapBoundaryPoints(const Obstacle& obstacle,
+                                std::vector<STPoint>* upper_points,
+                                std::vector<STPoint>* lower_points) const;
+
+  /**
+   * Maps an obstacle that does not need a stop decision, independent of all
+   * other obstacles.
+   */
+  apollo::common::Status MapObstacle(PathObstacle* path_obstacle) const;
 
   apollo::common::Status MapWithoutDecision(PathObstacle* path_obstacle) const;
 
@@ -90,6 +106,14 @@ class StBoundaryMapper {
   const double planning_distance_;
   const double planning_time_;
   bool is_change_lane_ = false;
+
+  // discretized path resampled for obstacles with prediction trajectories
+  DiscretizedPath sampled_path_;
+  // adc boxes on sampled_path_, one every front_edge_to_center meters
+  std::unique_ptr<PathBoxHierarchy> sampled_path_boxes_;
+  // adc boxes on every point of the discretized path within
+  // planning_distance_, for static obstacles
+  std::unique_ptr<PathBoxHierarchy> path_point_boxes_;
 };
 
 }  // namespace planning
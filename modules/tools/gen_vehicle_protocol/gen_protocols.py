@@ -22,6 +22,7 @@ import datetime
 import os
 import shutil
 import sys
+import textwrap
 import yaml
 
 
@@ -37,19 +38,9 @@ def gen_report_header(car_type, p, output_dir):
         fmt_val["car_type_lower"] = car_type.lower()
         fmt_val["car_type_upper"] = car_type.upper()
         fmt_val["protocol_name_upper"] = p["name"].upper()
-        fmt_val["classname"] = p["name"].replace('_', '').capitalize()
-        func_declare_list = []
-        for var in p["vars"]:
-            fmt = """
-  // config detail: %s
-  %s %s(const std::uint8_t* bytes, const int32_t length) const;"""
-            returntype = var["type"]
-            if var["type"] == "enum":
-                returntype = p["name"].capitalize(
-                ) + "::" + var["name"].capitalize() + "Type"
-            declare = fmt % (str(var), returntype, var["name"].lower())
-            func_declare_list.append(declare)
-        fmt_val["func_declare_list"] = "\n".join(func_declare_list)
+        classname = p["name"].replace('_', '').capitalize()
+        fmt_val["classname"] = classname
+        fmt_val["base_indent"] = " " * (len("class %s : " % classname) + 4)
         h_fp.write(FMT % fmt_val)
 
 
@@ -66,90 +57,111 @@ def gen_report_cpp(car_type, p, output_dir):
         fmt_val["protocol_name_lower"] = p["name"]
         classname = p["name"].replace('_', '').capitalize()
         fmt_val["classname"] = classname
+        fmt_val["parse_indent"] = " " * len("void %s::Parse(" % classname)
         fmt_val["id_upper"] = p["id"].upper()
+        fmt_val["mutable_report"] = gen_mutable_report(car_type, p)
+        signal_list = []
         set_var_to_protocol_list = []
-        func_impl_list = []
         for var in p["vars"]:
             var["name"] = var["name"].lower()
-
-            returntype = var["type"]
-            if var["type"] == "enum":
-                returntype = p["name"].capitalize(
-                ) + "::" + var["name"].capitalize() + "Type"
-            # gen func top
-            fmt = """
-// config detail: %s
-%s %s::%s(const std::uint8_t* bytes, int32_t length) const {"""
-            impl = fmt % (str(var), returntype, classname, var["name"])
-
-            byte_info = get_byte_info(var)
-            impl = impl + gen_parse_value_impl(var, byte_info)
-
-            impl = impl + gen_report_value_offset_precision(var, p)
-            impl = impl + "}"
-
-            func_impl_list.append(impl)
-            proto_set_fmt = "  chassis->mutable_%s()->mutable_%s()->set_%s(%s(bytes, length));"
-            func_name = var["name"]
-            proto_set = proto_set_fmt % (car_type, p["name"], var["name"],
-                                         func_name)
-            set_var_to_protocol_list.append(proto_set)
+            signal_list.append(gen_report_signal(var))
+            set_var_to_protocol_list.append(gen_report_set_value(var, p))
+        fmt_val["signal_list"] = "\n\n".join(signal_list)
         fmt_val["set_var_to_protocol_list"] = "\n".join(
             set_var_to_protocol_list)
-        fmt_val["func_impl_list"] = "\n".join(func_impl_list)
         fp.write(FMT % fmt_val)
 
 
-def gen_report_value_offset_precision(var, p):
+def gen_mutable_report(car_type, p):
     """
-        doc string:
+        get the report of the protocol from the chassis detail
     """
-    impl = ""
-    if var["is_signed_var"]:
-        fmt = "\n  x <<= %d;\n  x >>= %d;\n"
-        # x is a int32_t var
-        shift_bit = 32 - var["len"]
-        impl = impl + fmt % (shift_bit, shift_bit)
+    impl = "  auto* report = chassis->mutable_%s()->mutable_%s();" % (
+        car_type, p["name"])
+    if len(impl) > 80:
+        impl = "  auto* report =\n      chassis->mutable_%s()->mutable_%s();" % (
+            car_type, p["name"])
+    return impl
 
-    returntype = var["type"]
-    if var["type"] == "enum":
-        returntype = p["name"].capitalize() + "::" + var["name"].capitalize(
-        ) + "Type"
-    impl = impl + "\n  " + returntype + " ret = "
 
-    if var["type"] == "enum":
-        impl = impl + " static_cast<" + returntype + ">(x);\n"
+def get_signal_name(var):
+    """
+        the name of the CanSignal constant of a variable, like kManualInput
+    """
+    return "k" + "".join(
+        [item.capitalize() for item in var["name"].lower().split("_")])
+
+
+def gen_comment(prefix, text):
+    """
+        wrap a comment within 80 columns
+    """
+    return "\n".join(
+        textwrap.wrap(
+            text,
+            width=80,
+            initial_indent=prefix,
+            subsequent_indent=prefix,
+            break_long_words=False,
+            break_on_hyphens=False))
+
+
+def gen_report_signal(var):
+    """
+        declare the CanSignal of a variable, whose layout is resolved at
+        compile time
+    """
+    if var["len"] > 32:
+        print "This generator not support big than four bytes var." + \
+              "var_name:%s " % var["name"]
+    order = "MOTOROLA" if var["order"] == "motorola" else "INTEL"
+    signal_type = "CanSignal<%d, %d, ByteOrder::%s" % (var["bit"], var["len"],
+                                                      order)
+    if var["is_signed_var"]:
+        signal_type = signal_type + ", true"
+    signal_type = signal_type + ">"
+    args = []
+    if var["precision"] != 1.0 or var["offset"] != 0.0:
+        args.append(repr(float(var["precision"])))
+    if var["offset"] != 0.0:
+        args.append(repr(float(var["offset"])))
+    decl = "constexpr %s %s" % (signal_type, get_signal_name(var))
+    if args:
+        decl = decl + "(" + ", ".join(args) + ");"
+        if len(decl) > 80:
+            decl = decl.replace("(", "(\n    ", 1)
     else:
-        impl = impl + "x"
-        if var["precision"] != 1.0:
-            impl = impl + " * %f" % var["precision"]
-        if var["offset"] != 0.0:
-            impl = impl + " + %f" % (var["offset"])
-        impl = impl + ";\n"
-    return impl + "  return ret;\n"
+        decl = decl + ";"
+    return gen_comment("// ", "config detail: %s" % str(var)) + "\n" + decl
 
 
-def gen_parse_value_impl(var, byte_info):
+def gen_report_set_value(var, p):
     """
-        doc string:
+        set a variable of the report to its value decoded from the frame
     """
-    impl = ""
-    fmt = "\n  Byte t%d(bytes + %d);\n"
-    shift_bit = 0
-    for i in range(0, len(byte_info)):
-        info = byte_info[i]
-        impl = impl + fmt % (i, info["byte"])
-        if i == 0:
-            impl = impl + "  int32_t x = t%d.get_byte(%d, %d);\n" %\
-                      (i, info["start_bit"], info["len"])
-        elif i == 1:
-            impl = impl + "  int32_t t = t%d.get_byte(%d, %d);\n  x <<= %d;\n  x |= t;\n" %\
-                      (i, info["start_bit"], info["len"], info["len"])
+    signal_name = get_signal_name(var)
+    setter = "  report->set_%s(" % var["name"]
+    if var["type"] == "enum":
+        cast = "static_cast<%s::%sType>(" % (p["name"].capitalize(),
+                                            var["name"].capitalize())
+        value = "%s.Raw(frame))" % signal_name
+        if len(setter + cast + value + ");") <= 80:
+            return setter + cast + value + ");"
+        if len(setter + cast) <= 80:
+            return setter + cast + "\n      " + value + ");"
+        return setter + "\n      " + cast + "\n          " + value + ");"
+    if var["type"] == "bool":
+        value = "%s.Raw(frame) != 0" % signal_name
+    elif var["type"] == "int":
+        if var["precision"] == 1.0 and var["offset"] == 0.0:
+            value = "static_cast<int>(%s.Raw(frame))" % signal_name
         else:
-            impl = impl + "  t = t%d.get_byte(%d, %d);\n  x <<= %d;\n  x |= t;\n" %\
-                      (i, info["start_bit"], info["len"], info["len"])
-        shift_bit = shift_bit + info["len"]
-    return impl
+            value = "static_cast<int>(%s.Decode(frame))" % signal_name
+    else:
+        value = "%s.Decode(frame)" % signal_name
+    if len(setter + value + ");") <= 80:
+        return setter + value + ");"
+    return setter + "\n      " + value + ");"
 
 
 def gen_control_header(car_type, p, output_dir):
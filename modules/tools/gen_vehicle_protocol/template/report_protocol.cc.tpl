@@ -16,25 +16,32 @@
 
 #include "modules/canbus/vehicle/%(car_type_lower)s/protocol/%(protocol_name_lower)s.h"
 
-#include "glog/logging.h"
-
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace %(car_type_lower)s {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::ByteOrder;
+using ::apollo::drivers::canbus::CanFrameBits;
+using ::apollo::drivers::canbus::CanSignal;
+
+namespace {
+
+%(signal_list)s
+
+}  // namespace
 
 %(classname)s::%(classname)s() {}
 const int32_t %(classname)s::ID = 0x%(id_upper)s;
 
 void %(classname)s::Parse(const std::uint8_t* bytes, int32_t length,
-                         ChassisDetail* chassis) const {
+%(parse_indent)sChassisDetail* chassis) const {
+  const CanFrameBits frame(bytes, length);
+%(mutable_report)s
 %(set_var_to_protocol_list)s
 }
-%(func_impl_list)s
+
 }  // namespace %(car_type_lower)s
 }  // namespace canbus
 }  // namespace apollo
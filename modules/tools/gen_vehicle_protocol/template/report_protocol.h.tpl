@@ -17,23 +17,20 @@
 #ifndef MODULES_CANBUS_VEHICLE_%(car_type_upper)s_PROTOCOL_%(protocol_name_upper)s_H_
 #define MODULES_CANBUS_VEHICLE_%(car_type_upper)s_PROTOCOL_%(protocol_name_upper)s_H_
 
-#include "modules/drivers/canbus/can_comm/protocol_data.h"
 #include "modules/canbus/proto/chassis_detail.pb.h"
+#include "modules/drivers/canbus/can_comm/protocol_data.h"
 
 namespace apollo {
 namespace canbus {
 namespace %(car_type_lower)s {
 
 class %(classname)s : public ::apollo::drivers::canbus::ProtocolData<
-                    ::apollo::canbus::ChassisDetail> {
+%(base_indent)s::apollo::canbus::ChassisDetail> {
  public:
   static const int32_t ID;
   %(classname)s();
   void Parse(const std::uint8_t* bytes, int32_t length,
-                     ChassisDetail* chassis) const override;
-
- private:
-%(func_declare_list)s
+             ChassisDetail* chassis) const override;
 };
 
 }  // namespace %(car_type_lower)s